@@ -0,0 +1,28 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// жٽ ѭжϹĶС޸
+// ʱ PRIMASK ˳ʱָ Ƕ жѹжʱҲǰж
+// CRIT_ENTER ֲ primask ͬһֻܽһ ദʹʱԷ { } 
+
+#ifndef _common_critical_h_
+#define _common_critical_h_
+
+#include "common_headfile.h"
+
+#define CRIT_ENTER()            uint32 primask = __get_PRIMASK(); __disable_irq()
+#define CRIT_EXIT()             __set_PRIMASK(primask)
+
+#endif
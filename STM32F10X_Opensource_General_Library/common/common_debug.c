@@ -423,6 +423,7 @@ void debug_init (void)
     fifo_init(&debug_uart_fifo, FIFO_DATA_8BIT, debug_uart_buffer, DEBUG_RING_BUFFER_LEN);
 //    uart_rx_interrupt(DEBUG_UART_INDEX, 1);                                     // ʹܶӦڽж
 #endif
+    profile_init();                             // ̽ PROFILE_ENABLE Ϊ 0 ʱΪղ
 }
 
 
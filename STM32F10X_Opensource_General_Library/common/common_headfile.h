@@ -28,8 +28,10 @@
 
 //========================================================================================================
 #include "common_typedef.h"
+#include "common_critical.h"
 #include "common_clock.h"
 #include "common_debug.h"
+#include "common_profile.h"
 #include "common_mqttkit.h"
 #include "common_cjson.h"
 #include "zf_common_fifo.h"
@@ -74,6 +76,9 @@
 #include "device_w25q64.h"
 #include "device_dht11.h"
 #include "device_esp8266.h"
+#include "device_lcd_glyph.h"
+#include "device_lcd_canvas.h"
+#include "device_lcd_image.h"
 //===================================================豸===================================================
 
 //======================================================================================================
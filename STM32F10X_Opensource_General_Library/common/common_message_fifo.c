@@ -0,0 +1,421 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "common_message_fifo.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡһ֡ĳǰ׺
+// ˵     *fifo               Ϣ FIFO ָ
+// ز     uint32              ֡
+// ʹʾ     message_fifo_header(fifo);
+// עϢ     ļڲ ǰȷ count Ϊ 0
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 message_fifo_header (message_fifo_struct *fifo)
+{
+    uint8 header[MESSAGE_FIFO_HEADER_SIZE];
+    uint32 length = MESSAGE_FIFO_HEADER_SIZE;
+
+    fifo_read_buffer(&fifo->fifo, header, &length, FIFO_READ_ONLY);
+    return (uint32)header[0] | ((uint32)header[1] << 8);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ɵһ֡
+// ˵     *fifo               Ϣ FIFO ָ
+// ز     void
+// ʹʾ     message_fifo_discard(fifo);
+// עϢ     ļڲ ǰȷ count Ϊ 0 ѽٽ
+//-------------------------------------------------------------------------------------------------------------------
+static void message_fifo_discard (message_fifo_struct *fifo)
+{
+    fifo_read_consume(&fifo->fifo, MESSAGE_FIFO_HEADER_SIZE + message_fifo_header(fifo));
+    fifo->count --;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      д㿽
+// ˵     *region             fifo_write_reserve ص
+// ˵     offset              ڵʼֽ
+// ˵     *dat                
+// ˵     length              ֽ
+// ز     void
+// ʹʾ     message_fifo_region_write(&region, 0, header, MESSAGE_FIFO_HEADER_SIZE);
+// עϢ     ļڲ Ҫж
+//-------------------------------------------------------------------------------------------------------------------
+static void message_fifo_region_write (fifo_region_struct *region, uint32 offset, const uint8 *dat, uint32 length)
+{
+    uint32 chunk = 0;
+
+    for(uint8 i = 0; 2 > i && length; i ++)
+    {
+        if(offset >= region->length[i])
+        {
+            offset -= region->length[i];
+            continue;
+        }
+        chunk = region->length[i] - offset;
+        chunk = (chunk < length) ? chunk : length;
+        memcpy((uint8 *)region->buffer[i] + offset, dat, chunk);
+        dat += chunk;
+        length -= chunk;
+        offset = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      㿽
+// ˵     *region             fifo_read_peek ص
+// ˵     offset              ڵʼֽ
+// ˵     *dat                Ŀ껺
+// ˵     length              ֽ
+// ز     void
+// ʹʾ     message_fifo_region_read(&region, MESSAGE_FIFO_HEADER_SIZE, dat, frame_length);
+// עϢ     ļڲ Ҫж
+//-------------------------------------------------------------------------------------------------------------------
+static void message_fifo_region_read (const fifo_region_struct *region, uint32 offset, uint8 *dat, uint32 length)
+{
+    uint32 chunk = 0;
+
+    for(uint8 i = 0; 2 > i && length; i ++)
+    {
+        if(offset >= region->length[i])
+        {
+            offset -= region->length[i];
+            continue;
+        }
+        chunk = region->length[i] - offset;
+        chunk = (chunk < length) ? chunk : length;
+        memcpy(dat, (const uint8 *)region->buffer[i] + offset, chunk);
+        dat += chunk;
+        length -= chunk;
+        offset = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Ϣ FIFO
+// ˵     *fifo               Ϣ FIFO ָ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     message_fifo_clear(&fifo);
+// עϢ      дȡһ֡ʱ FIFO_CLEAR_UNDO
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum message_fifo_clear (message_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    fifo_state_enum return_state = FIFO_CLEAR_UNDO;
+    CRIT_ENTER();
+    if(!(FIFO_WRITE & fifo->fifo.execution) && !fifo->reading)
+    {
+        return_state = fifo_clear(&fifo->fifo);
+        fifo->count = 0;
+    }
+    CRIT_EXIT();
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯǰ֡
+// ˵     *fifo               Ϣ FIFO ָ
+// ز     uint32              ֡
+// ʹʾ     while(message_fifo_count(&fifo)) { ... }
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 message_fifo_count (message_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    return fifo->count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯһ֡ĳ
+// ˵     *fifo               Ϣ FIFO ָ
+// ز     uint32              ֡ ûʱ 0
+// ʹʾ     uint32 length = message_fifo_next_length(&fifo);
+// עϢ      message_fifo_pop ֮ǰ׼㹻Ļ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 message_fifo_next_length (message_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    uint32 length = 0;
+    CRIT_ENTER();
+    if(fifo->count)
+    {
+        length = message_fifo_header(fifo);
+    }
+    CRIT_EXIT();
+    return length;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      дһ֡
+// ˵     *fifo               Ϣ FIFO ָ
+// ˵     *dat                ֡
+// ˵     length              ֡ Ϊ 0
+// ز     fifo_state_enum     ״̬ FIFO_SPACE_NO_ENOUGH ʾ֡
+// ʹʾ     message_fifo_push(&fifo, frame, frame_length);
+// עϢ     ֡ȳ 65535 ǰ׺󳬹Сʱ ִʽᶪ֡
+//              ֻڳռύʱж ֡ʱж
+//              һд뷽ڿʱ FIFO_WRITE_UNDO ֡д
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum message_fifo_push (message_fifo_struct *fifo, const void *dat, uint32 length)
+{
+    zf_assert(NULL != fifo);
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+    uint32 need = length + MESSAGE_FIFO_HEADER_SIZE;
+    uint8 header[MESSAGE_FIFO_HEADER_SIZE];
+    fifo_region_struct region;
+
+    if(NULL == dat && 0 != length)
+    {
+        return FIFO_BUFFER_NULL;                                                // û쳣
+    }
+    {
+        CRIT_ENTER();
+        do
+        {
+            if(MESSAGE_FIFO_LENGTH_MAX < length || fifo->fifo.max < need)
+            {
+                fifo->dropped ++;
+                return_state = FIFO_SPACE_NO_ENOUGH;                            // ֡ ԶŲ
+                break;
+            }
+            if(FIFO_WRITE & fifo->fifo.execution)
+            {
+                return_state = FIFO_WRITE_UNDO;                                 // һд뷽ڿ ֡
+                break;
+            }
+            while(fifo->fifo.size < need)
+            {
+                if(MESSAGE_FIFO_REJECT_NEW == fifo->policy || 0 == fifo->count || fifo->reading)
+                {
+                    return_state = FIFO_SPACE_NO_ENOUGH;                        // ڱȡһ֡Ҳܶ
+                    break;
+                }
+                message_fifo_discard(fifo);                                     // ɵ֡ڳռ
+                fifo->dropped ++;
+            }
+            if(FIFO_SUCCESS != return_state)
+            {
+                fifo->dropped ++;
+                break;
+            }
+            return_state = fifo_write_reserve(&fifo->fifo, &region);            // Ԥڼд뷽 FIFO_WRITE_UNDO
+        }while(0);
+        CRIT_EXIT();
+    }
+    if(FIFO_SUCCESS != return_state)
+    {
+        return return_state;
+    }
+
+    header[0] = (uint8)(length);
+    header[1] = (uint8)(length >> 8);
+    message_fifo_region_write(&region, 0, header, MESSAGE_FIFO_HEADER_SIZE);
+    message_fifo_region_write(&region, MESSAGE_FIFO_HEADER_SIZE, (const uint8 *)dat, length);
+
+    {
+        CRIT_ENTER();
+        fifo_write_commit(&fifo->fifo, need);                                   // ռȷ ʧ
+        fifo->count ++;
+        CRIT_EXIT();
+    }
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡɵһ֡
+// ˵     *fifo               Ϣ FIFO ָ
+// ˵     *dat                Ŀ껺ָ
+// ˵     *length             ΪĿ껺С Ϊ֡
+// ز     fifo_state_enum     ״̬
+// ʹʾ     uint32 length = sizeof(frame); if(FIFO_SUCCESS == message_fifo_pop(&fifo, frame, &length)) { ... }
+// עϢ     ûʱ FIFO_DATA_NO_ENOUGH  *length Ϊ 0
+//              Ŀ껺ʱ FIFO_SPACE_NO_ENOUGH ֡ FIFO  *length ΪС
+//              ֻȡ֡ͷʱж ֡ʱж
+//              һȡڿʱ FIFO_READ_UNDO
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum message_fifo_pop (message_fifo_struct *fifo, void *dat, uint32 *length)
+{
+    zf_assert(NULL != fifo);
+    zf_assert(NULL != length);
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+    uint32 frame_length = 0;
+    fifo_region_struct region;
+
+    {
+        CRIT_ENTER();
+        do
+        {
+            if(fifo->reading)
+            {
+                return_state = FIFO_READ_UNDO;                                  // һȡڿһ֡
+                break;
+            }
+            if(0 == fifo->count)
+            {
+                *length = 0;
+                return_state = FIFO_DATA_NO_ENOUGH;                             // û֡
+                break;
+            }
+            frame_length = message_fifo_header(fifo);
+            if(frame_length > *length)
+            {
+                *length = frame_length;
+                return_state = FIFO_SPACE_NO_ENOUGH;                            // û
+                break;
+            }
+            if(NULL == dat && 0 != frame_length)
+            {
+                return_state = FIFO_BUFFER_NULL;                                // û쳣
+                break;
+            }
+            fifo_read_peek(&fifo->fifo, &region);
+            fifo->reading = 1;                                                  // ڼд뷽ᶪ֡
+        }while(0);
+        CRIT_EXIT();
+    }
+    if(FIFO_SUCCESS != return_state)
+    {
+        return return_state;
+    }
+
+    message_fifo_region_read(&region, MESSAGE_FIFO_HEADER_SIZE, (uint8 *)dat, frame_length);
+    *length = frame_length;
+
+    {
+        CRIT_ENTER();
+        fifo_read_consume(&fifo->fifo, MESSAGE_FIFO_HEADER_SIZE + frame_length);
+        fifo->count --;
+        fifo->reading = 0;
+        CRIT_EXIT();
+    }
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡһ֡ڻеλ 
+// ˵     *fifo               Ϣ FIFO ָ
+// ˵     *region             ֡  length[0] + length[1] Ϊ֡
+// ز     fifo_state_enum     ״̬
+// ʹʾ     message_fifo_peek(&fifo, &region); parse(region.buffer[0], region.length[0]); message_fifo_drop(&fifo);
+// עϢ     ɺ message_fifo_drop ͷŸ֡
+//              ʹ MESSAGE_FIFO_DROP_OLDEST ʱ д뷽ڴڼ䶪֡ ʱ message_fifo_pop
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum message_fifo_peek (message_fifo_struct *fifo, fifo_region_struct *region)
+{
+    zf_assert(NULL != fifo);
+    CRIT_ENTER();
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+    uint32 frame_length = 0;
+    uint32 skip = MESSAGE_FIFO_HEADER_SIZE;
+
+    do
+    {
+        if(NULL == region)
+        {
+            return_state = FIFO_BUFFER_NULL;                                    // û쳣
+            break;
+        }
+        if(0 == fifo->count)
+        {
+            region->buffer[0] = NULL;
+            region->length[0] = 0;
+            region->buffer[1] = NULL;
+            region->length[1] = 0;
+            return_state = FIFO_DATA_NO_ENOUGH;                                 // û֡
+            break;
+        }
+        frame_length = message_fifo_header(fifo);
+        fifo_read_peek(&fifo->fifo, region);
+
+        if(region->length[0] > skip)                                            // ǰ׺
+        {
+            region->buffer[0] = (uint8 *)region->buffer[0] + skip;
+            region->length[0] -= skip;
+        }
+        else
+        {
+            skip -= region->length[0];                                          // ǰ׺Խβ ֡ȫڵڶ
+            region->buffer[0] = (uint8 *)region->buffer[1] + skip;
+            region->length[0] = region->length[1] - skip;
+            region->buffer[1] = NULL;
+            region->length[1] = 0;
+        }
+
+        if(region->length[0] >= frame_length)                                   // ص֡
+        {
+            region->length[0] = frame_length;
+            region->buffer[1] = NULL;
+            region->length[1] = 0;
+        }
+        else
+        {
+            region->length[1] = frame_length - region->length[0];
+        }
+    }while(0);
+    CRIT_EXIT();
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ɵһ֡
+// ˵     *fifo               Ϣ FIFO ָ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     message_fifo_drop(&fifo);
+// עϢ     һ message_fifo_peek ɺ  dropped
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum message_fifo_drop (message_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    CRIT_ENTER();
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+
+    if(fifo->reading)
+    {
+        return_state = FIFO_READ_UNDO;                                          // һ֡ message_fifo_pop 
+    }
+    else if(0 == fifo->count)
+    {
+        return_state = FIFO_DATA_NO_ENOUGH;                                     // û֡
+    }
+    else
+    {
+        message_fifo_discard(fifo);
+    }
+    CRIT_EXIT();
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Ϣ FIFO ʼ ضӦ
+// ˵     *fifo               Ϣ FIFO ָ
+// ˵     *buffer_addr        ҪصĻ uint8 
+// ˵     size                ֽ ÿ֡ռ 2 ֽ
+// ˵     policy              ռ䲻ʱĴʽ MESSAGE_FIFO_REJECT_NEW / MESSAGE_FIFO_DROP_OLDEST
+// ز     fifo_state_enum     ״̬
+// ʹʾ     message_fifo_init(&frame_fifo, frame_buffer, 256, MESSAGE_FIFO_DROP_OLDEST);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum message_fifo_init (message_fifo_struct *fifo, void *buffer_addr, uint32 size, message_fifo_policy_enum policy)
+{
+    zf_assert(NULL != fifo);
+    zf_assert(NULL != buffer_addr);
+    fifo->policy    = policy;
+    fifo->count     = 0;
+    fifo->dropped   = 0;
+    fifo->reading   = 0;
+    return fifo_init(&fifo->fifo, FIFO_DATA_8BIT, buffer_addr, size);
+}
@@ -0,0 +1,67 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// 䳤Ϣ FIFO ֡Ϊλȡ
+// ʺ GNSS  +IPD   NRF24L01 ݰȱһ֡һ֡
+// շһȡһ֡ Ҫֽ \n ֡ͷ
+//
+// 洢ʽ
+// ײһ 8bit  fifo_struct ÿ֡ǰд 2 ֽڳȣֽǰ д֡
+// ֡ 65535 ֽ ÿ֡ռ 2 ֽ  fifo_struct 
+//
+// ռ䲻ʱĴʽڳʼʱָ
+// MESSAGE_FIFO_REJECT_NEW      ֡ ݲ
+// MESSAGE_FIFO_DROP_OLDEST     ɵ֡ʼ ֱŵ֡
+//
+// ж
+// ֻ޸Ķдλ֡ʱݹж ֡ʱж ᳤֡ʱж
+// ͬһʱֻһд뷽һȡڿ һʱ÷ FIFO_WRITE_UNDO / FIFO_READ_UNDO
+// message_fifo_pop ڿһ֡ʱ MESSAGE_FIFO_DROP_OLDEST ᶪ ռ䲻ʱΪ֡
+
+#ifndef _common_message_fifo_h_
+#define _common_message_fifo_h_
+
+#include "common_headfile.h"
+
+#define MESSAGE_FIFO_HEADER_SIZE    (2)                                         // ÿ֡ǰ׺ֽ
+#define MESSAGE_FIFO_LENGTH_MAX     (0xFFFF)                                    // ֡󳤶
+
+typedef enum
+{
+    MESSAGE_FIFO_REJECT_NEW,                                                    // ռ䲻ʱ֡
+    MESSAGE_FIFO_DROP_OLDEST,                                                   // ռ䲻ʱɵ֡
+}message_fifo_policy_enum;
+
+typedef struct
+{
+    fifo_struct                 fifo;                                           // ײֽ FIFO
+    message_fifo_policy_enum    policy;                                         // ռ䲻ʱĴʽ
+    volatile uint32             count;                                          // ǰ֡
+    volatile uint32             dropped;                                        // ռ䲻㶪֡ ܾ֡
+    volatile uint8              reading;                                        // message_fifo_pop ڿһ֡
+}message_fifo_struct;
+
+fifo_state_enum message_fifo_clear          (message_fifo_struct *fifo);
+uint32          message_fifo_count          (message_fifo_struct *fifo);
+uint32          message_fifo_next_length    (message_fifo_struct *fifo);
+
+fifo_state_enum message_fifo_push           (message_fifo_struct *fifo, const void *dat, uint32 length);
+fifo_state_enum message_fifo_pop            (message_fifo_struct *fifo, void *dat, uint32 *length);
+fifo_state_enum message_fifo_peek           (message_fifo_struct *fifo, fifo_region_struct *region);
+fifo_state_enum message_fifo_drop           (message_fifo_struct *fifo);
+
+fifo_state_enum message_fifo_init           (message_fifo_struct *fifo, void *buffer_addr, uint32 size, message_fifo_policy_enum policy);
+
+#endif
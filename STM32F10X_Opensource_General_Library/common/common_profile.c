@@ -0,0 +1,217 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "common_profile.h"
+
+#if PROFILE_ENABLE                                                              //  ֻ̽ű
+
+static profile_probe_struct *profile_probe_list = NULL;                        // ѵǼ̽ͷ
+static profile_probe_struct *profile_probe_tail = NULL;                        // ѵǼ̽β ֵǼ˳
+static uint32                profile_overhead = 0;                              // һ̽Ŀ
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ڵֱͼͰ
+// ˵     cycles          
+// ز     uint32          Ͱ [0, PROFILE_HISTOGRAM_NUM-1]
+// ʹʾ     profile_bucket(cycles);
+// עϢ     ļڲ ûùע Ҳ޸
+//-------------------------------------------------------------------------------------------------------------------
+static uint32 profile_bucket (uint32 cycles)
+{
+    uint32 bucket = 0;
+
+    cycles >>= PROFILE_HISTOGRAM_SHIFT;
+    while(cycles && bucket < PROFILE_HISTOGRAM_NUM - 1)
+    {
+        cycles >>= 1;
+        bucket ++;
+    }
+    return bucket;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      㵥̽ͳ
+// ˵     *probe          ̽
+// ز     void
+// ʹʾ     profile_probe_clear(probe);
+// עϢ     ļڲ ûùע Ҳ޸
+//-------------------------------------------------------------------------------------------------------------------
+static void profile_probe_clear (profile_probe_struct *probe)
+{
+    probe->count = 0;
+    probe->min = 0xFFFFFFFF;
+    probe->max = 0;
+    probe->sum = 0;
+    memset(probe->histogram, 0, sizeof(probe->histogram));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ¼һ̽ʱ
+// ˵     *probe          ̽
+// ˵     cycles          κʱδ۳̽뿪
+// ز     void
+// ʹʾ     profile_record(&probe, cycles);
+// עϢ      PROFILE_END  һ㲻Ҫֱʹ
+//              ͬһֻ̽Ӧͬһȼִ ͳֵܱжϴϺ󸲸
+//-------------------------------------------------------------------------------------------------------------------
+void profile_record (profile_probe_struct *probe, uint32 cycles)
+{
+    cycles = (cycles > profile_overhead) ? (cycles - profile_overhead) : 0;
+
+    if(!probe->registered)
+    {
+        CRIT_ENTER();
+        if(!probe->registered)                                                  // жϺȷһ ֹжѵǼ
+        {
+            profile_probe_clear(probe);
+            probe->next = NULL;
+            if(NULL == profile_probe_tail)
+            {
+                profile_probe_list = probe;
+            }
+            else
+            {
+                profile_probe_tail->next = probe;
+            }
+            profile_probe_tail = probe;
+            probe->registered = 1;
+        }
+        CRIT_EXIT();
+    }
+
+    probe->count ++;
+    probe->sum += cycles;
+    if(cycles < probe->min)
+    {
+        probe->min = cycles;
+    }
+    if(cycles > probe->max)
+    {
+        probe->max = cycles;
+    }
+    probe->histogram[profile_bucket(cycles)] ++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȫѵǼ̽ͳ
+// ˵     void
+// ز     void
+// ʹʾ     profile_reset();
+// עϢ     ̽뱣ֵǼ״̬ ´ִʱͳ
+//-------------------------------------------------------------------------------------------------------------------
+void profile_reset (void)
+{
+    CRIT_ENTER();
+    for(profile_probe_struct *probe = profile_probe_list; NULL != probe; probe = probe->next)
+    {
+        profile_probe_clear(probe);
+    }
+    CRIT_EXIT();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ͨ debug ȫ̽ͳƽ
+// ˵     void
+// ز     void
+// ʹʾ     profile_dump();
+// עϢ     ÿ̽ һΪС//ƽ ڶΪǿյֱͼͰ
+//              
+//              [profile] gray_image n=10 min=812345 max=815002 mean=813120 cycles 11293.3us
+//                >=524288:10
+//              ֱͼͰޱע >=0 Ͱʾ 64 
+//               ҪڱͳƵĴڵ
+//-------------------------------------------------------------------------------------------------------------------
+void profile_dump (void)
+{
+    char output_buffer[128];
+    uint32 cycles_per_us = SystemCoreClock / 1000000;
+    uint32 length;
+
+    for(profile_probe_struct *probe = profile_probe_list; NULL != probe; probe = probe->next)
+    {
+        profile_probe_struct snapshot;
+        uint32 mean = 0;
+        uint32 mean_us10 = 0;
+
+        CRIT_ENTER();
+        snapshot = *probe;                                                      // ȡ бжϸ
+        CRIT_EXIT();
+
+        if(0 == snapshot.count)
+        {
+            length = (uint32)snprintf(output_buffer, sizeof(output_buffer), "[profile] %s n=0\r\n", snapshot.name);
+            debug_send_buffer((const uint8 *)output_buffer, length);
+            continue;
+        }
+        mean = (uint32)(snapshot.sum / snapshot.count);
+        if(cycles_per_us)
+        {
+            mean_us10 = (uint32)(snapshot.sum * 10 / snapshot.count / cycles_per_us);
+        }
+        length = (uint32)snprintf(output_buffer, sizeof(output_buffer), "[profile] %s n=%lu min=%lu max=%lu mean=%lu cycles %lu.%luus\r\n",
+                                  snapshot.name, (unsigned long)snapshot.count, (unsigned long)snapshot.min, (unsigned long)snapshot.max,
+                                  (unsigned long)mean, (unsigned long)(mean_us10 / 10), (unsigned long)(mean_us10 % 10));
+        debug_send_buffer((const uint8 *)output_buffer, length);
+
+        length = (uint32)snprintf(output_buffer, sizeof(output_buffer), " ");
+        for(uint32 i = 0; i < PROFILE_HISTOGRAM_NUM; i ++)
+        {
+            if(0 == snapshot.histogram[i])
+            {
+                continue;
+            }
+            if(length > sizeof(output_buffer) - 24)                             // һзŲ ȷ
+            {
+                debug_send_buffer((const uint8 *)output_buffer, length);
+                length = (uint32)snprintf(output_buffer, sizeof(output_buffer), " ");
+            }
+            length += (uint32)snprintf(output_buffer + length, sizeof(output_buffer) - length, " >=%lu:%lu",
+                                       (unsigned long)(i ? (1UL << (i + PROFILE_HISTOGRAM_SHIFT - 1)) : 0), (unsigned long)snapshot.histogram[i]);
+        }
+        length += (uint32)snprintf(output_buffer + length, sizeof(output_buffer) - length, "\r\n");
+        debug_send_buffer((const uint8 *)output_buffer, length);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ̽ʼ  DWT ڼ
+// ˵     void
+// ز     void
+// ʹʾ     profile_init();
+// עϢ     debug_init ѵ һ㲻Ҫû
+//              ͬʱһ̽Ŀ ֮ÿμ¼۳
+//-------------------------------------------------------------------------------------------------------------------
+void profile_init (void)
+{
+    uint32 overhead = 0xFFFFFFFF;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                             // ʹ DWT ITM ȵԸٵԪ
+    PROFILE_DWT_CYCCNT = 0;
+    PROFILE_DWT_CTRL |= PROFILE_DWT_CTRL_CYCCNTENA;
+
+    for(uint32 i = 0; i < 8; i ++)
+    {
+        uint32 start = PROFILE_CYCLE();
+        uint32 cycles = PROFILE_CYCLE() - start;
+        if(cycles < overhead)
+        {
+            overhead = cycles;
+        }
+    }
+    profile_overhead = overhead;
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+//  DWT ڼCYCCNT̽
+// ҪʱĴǰ PROFILE_BEGIN(name) / PROFILE_END(name)
+// ÿ̽ͳ ִд С//ƽ Լ 2 ݻֵĺʱֱͼ
+//  profile_dump() ͨ debug ȫ̽ͳƽ
+//
+// PROFILE_ENABLE Ϊ 0 ʱ̽չΪ ͳƺҲ ʽûκζ⿪
+// Ҳڹ̵Ԥд PROFILE_ENABLE=1 ʱ ޸ıļ
+//
+// ʹõ core_cm3.h û DWT Ĵ ﰴ ARMv7-M ֱֲܹӶַ
+
+#ifndef _common_profile_h_
+#define _common_profile_h_
+
+#include "common_headfile.h"
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE              (0)                                         // ̽ܿ 0-޳ 1-
+#endif
+
+#define PROFILE_HISTOGRAM_NUM       (16)                                        // ֱͼͰ
+#define PROFILE_HISTOGRAM_SHIFT     (6)                                         //  0 Ͱ 2^6=64 
+
+// Ͱ  0 Ͱ [0, 64)   i Ͱ [2^(i+5), 2^(i+6))  һͰ 2^20 
+// 72MHz һͰԼΪ 14.6ms
+
+#define PROFILE_DWT_CTRL            (*(volatile uint32 *)0xE0001000)            // DWT ƼĴ
+#define PROFILE_DWT_CYCCNT          (*(volatile uint32 *)0xE0001004)            // DWT ڼ
+#define PROFILE_DWT_CTRL_CYCCNTENA  (0x00000001)                                // CYCCNT ʹ
+
+typedef struct profile_probe_struct
+{
+    const char                  *name;                                          // ̽
+    struct profile_probe_struct *next;                                          // ѵǼ̽
+    uint8                       registered;                                     // ǷѵǼ
+    uint32                      count;                                          // ִд
+    uint32                      min;                                            // С
+    uint32                      max;                                            // 
+    uint64_t                    sum;                                            // ۼ ƽ
+    uint32                      histogram[PROFILE_HISTOGRAM_NUM];               // ʱֱͼ
+}profile_probe_struct;
+
+#if PROFILE_ENABLE
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡǰ CPU ڼ
+// ˵     void
+// ز     uint32          CYCCNT ǰֵ 72MHz Լ 59.6s һ
+// ʹʾ     uint32 start = PROFILE_CYCLE();
+// עϢ     ζֱ ƲӰ 59s ڵĲֵ
+//-------------------------------------------------------------------------------------------------------------------
+#define PROFILE_CYCLE()             (PROFILE_DWT_CYCCNT)
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ̽
+// ˵     name            ̽ ΪϷ C ʶ ͬ̽ profile_dump зֱг
+// ز     void
+// ʹʾ     PROFILE_BEGIN(gray_image); ... PROFILE_END(gray_image);
+// עϢ     ̽Ϊھ̬ ״ִ PROFILE_END ʱԶǼ
+//              PROFILE_END  PROFILE_BEGIN λͬһڲ
+//              ھֲ жǶײụ
+//-------------------------------------------------------------------------------------------------------------------
+#define PROFILE_BEGIN(name)                                                                 \
+    static profile_probe_struct profile_probe_##name = {#name};                             \
+    uint32 profile_begin_##name = PROFILE_CYCLE()
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ̽յ
+// ˵     name             PROFILE_BEGIN ͬ̽
+// ز     void
+// ʹʾ     PROFILE_END(gray_image);
+// עϢ     ͬһ̽жյ ÿǰص·Ҫ
+//-------------------------------------------------------------------------------------------------------------------
+#define PROFILE_END(name)                                                                   \
+    profile_record(&profile_probe_##name, PROFILE_CYCLE() - profile_begin_##name)
+
+void    profile_record              (profile_probe_struct *probe, uint32 cycles);
+void    profile_reset               (void);
+void    profile_dump                (void);
+void    profile_init                (void);
+
+#else
+
+#define PROFILE_CYCLE()             (0)
+#define PROFILE_BEGIN(name)
+#define PROFILE_END(name)
+
+#define profile_record(probe, cycles)
+#define profile_reset()
+#define profile_dump()
+#define profile_init()
+
+#endif
+
+#endif
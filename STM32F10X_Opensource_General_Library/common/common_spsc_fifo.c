@@ -0,0 +1,277 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "common_spsc_fifo.h"
+
+//  head/tail ǰ֤ݿѾ ͬʱֹѿŲ֮
+#define SPSC_FIFO_BARRIER()         __DMB()
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ݿ뻷λ βĲִͷ
+// ˵     *fifo               FIFO ָ
+// ˵     index               ʼδȡ룩
+// ˵     *dat                Դ
+// ˵     length              ݸ
+// ز     void
+// ʹʾ     spsc_fifo_copy_in(fifo, head, dat, length);
+// עϢ     ļڲ ûùע Ҳ޸
+//-------------------------------------------------------------------------------------------------------------------
+static void spsc_fifo_copy_in (spsc_fifo_struct *fifo, uint32 index, const void *dat, uint32 length)
+{
+    uint32 offset = index & fifo->mask;
+    uint32 first = fifo->mask + 1 - offset;                                     // 뻺βݸ
+
+    if(first > length)
+    {
+        first = length;
+    }
+    memcpy((uint8 *)fifo->buffer + offset * fifo->element, dat, first * fifo->element);
+    if(length > first)
+    {
+        memcpy(fifo->buffer, (const uint8 *)dat + first * fifo->element, (length - first) * fifo->element);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ӻλ βĲִͷ
+// ˵     *fifo               FIFO ָ
+// ˵     index               ʼδȡ룩
+// ˵     *dat                Ŀ껺
+// ˵     length              ݸ
+// ز     void
+// ʹʾ     spsc_fifo_copy_out(fifo, tail, dat, length);
+// עϢ     ļڲ ûùע Ҳ޸
+//-------------------------------------------------------------------------------------------------------------------
+static void spsc_fifo_copy_out (spsc_fifo_struct *fifo, uint32 index, void *dat, uint32 length)
+{
+    uint32 offset = index & fifo->mask;
+    uint32 first = fifo->mask + 1 - offset;
+
+    if(first > length)
+    {
+        first = length;
+    }
+    memcpy(dat, (const uint8 *)fifo->buffer + offset * fifo->element, first * fifo->element);
+    if(length > first)
+    {
+        memcpy((uint8 *)dat + first * fifo->element, fifo->buffer, (length - first) * fifo->element);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       FIFO
+// ˵     *fifo               FIFO ָ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     spsc_fifo_clear(&fifo);
+// עϢ     ֻڶȡ ǰȫ 㻺
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum spsc_fifo_clear (spsc_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    fifo->tail = fifo->head;
+    return FIFO_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      FIFO ѯǰݸ
+// ˵     *fifo               FIFO ָ
+// ز     uint32              ʹó
+// ʹʾ     uint32 len = spsc_fifo_used(&fifo);
+// עϢ     д뷽ʱʵֻ ȡʱʵֻ ֵǰȫ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 spsc_fifo_used (spsc_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    return fifo->head - fifo->tail;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      FIFO ѯǰʣռ
+// ˵     *fifo               FIFO ָ
+// ز     uint32              ʣдݸ
+// ʹʾ     uint32 len = spsc_fifo_free(&fifo);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 spsc_fifo_free (spsc_fifo_struct *fifo)
+{
+    zf_assert(NULL != fifo);
+    return fifo->mask + 1 - (fifo->head - fifo->tail);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       FIFO д
+// ˵     *fifo               FIFO ָ
+// ˵     dat                 
+// ز     fifo_state_enum     ״̬
+// ʹʾ     zf_log(spsc_fifo_write_element(&fifo, data) == FIFO_SUCCESS, "spsc_fifo_write_element error");
+// עϢ     ֻд뷽
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum spsc_fifo_write_element (spsc_fifo_struct *fifo, uint32 dat)
+{
+    zf_assert(NULL != fifo);
+    uint32 head = fifo->head;
+    uint32 offset = head & fifo->mask;
+
+    if(head - fifo->tail > fifo->mask)
+    {
+        return FIFO_SPACE_NO_ENOUGH;                                            // ǰ FIFO  д ؿռ䲻
+    }
+    switch(fifo->type)
+    {
+        case FIFO_DATA_8BIT:    ((uint8 *)fifo->buffer)[offset]  = (uint8)dat;  break;
+        case FIFO_DATA_16BIT:   ((uint16 *)fifo->buffer)[offset] = (uint16)dat; break;
+        case FIFO_DATA_32BIT:   ((uint32 *)fifo->buffer)[offset] = dat;         break;
+    }
+    SPSC_FIFO_BARRIER();
+    fifo->head = head + 1;                                                      // 
+    return FIFO_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       FIFO д
+// ˵     *fifo               FIFO ָ
+// ˵     *dat                Դָ
+// ˵     length              Ҫдݳ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     zf_log(spsc_fifo_write_buffer(&fifo, data, 32) == FIFO_SUCCESS, "spsc_fifo_write_buffer error");
+// עϢ     ֻд뷽 ռ䲻ʱβд
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum spsc_fifo_write_buffer (spsc_fifo_struct *fifo, const void *dat, uint32 length)
+{
+    zf_assert(NULL != fifo);
+    uint32 head = fifo->head;
+
+    if(NULL == dat)
+    {
+        return FIFO_BUFFER_NULL;                                                // û쳣
+    }
+    if(length > fifo->mask + 1 - (head - fifo->tail))
+    {
+        return FIFO_SPACE_NO_ENOUGH;                                            // ʣռ䲻 ؿռ䲻
+    }
+    spsc_fifo_copy_in(fifo, head, dat, length);
+    SPSC_FIFO_BARRIER();
+    fifo->head = head + length;                                                 // 
+    return FIFO_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       FIFO ȡ
+// ˵     *fifo               FIFO ָ
+// ˵     *dat                Ŀ껺ָ
+// ˵     flag                Ƿ FIFO ״̬ ѡǷնȡ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     zf_log(spsc_fifo_read_element(&fifo, data, FIFO_READ_ONLY) == FIFO_SUCCESS, "spsc_fifo_read_element error");
+// עϢ     ֻڶȡ
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum spsc_fifo_read_element (spsc_fifo_struct *fifo, void *dat, fifo_operation_enum flag)
+{
+    zf_assert(NULL != fifo);
+    uint32 tail = fifo->tail;
+    uint32 offset = tail & fifo->mask;
+
+    if(NULL == dat)
+    {
+        return FIFO_BUFFER_NULL;                                                // û쳣
+    }
+    if(fifo->head == tail)
+    {
+        return FIFO_DATA_NO_ENOUGH;                                             // û ݳȲ
+    }
+    switch(fifo->type)
+    {
+        case FIFO_DATA_8BIT:    *((uint8 *)dat)  = ((uint8 *)fifo->buffer)[offset];     break;
+        case FIFO_DATA_16BIT:   *((uint16 *)dat) = ((uint16 *)fifo->buffer)[offset];    break;
+        case FIFO_DATA_32BIT:   *((uint32 *)dat) = ((uint32 *)fifo->buffer)[offset];    break;
+    }
+    if(FIFO_READ_AND_CLEAN == flag)                                             // ѡȡ FIFO ״̬
+    {
+        SPSC_FIFO_BARRIER();
+        fifo->tail = tail + 1;                                                  // ͷſռ
+    }
+    return FIFO_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       FIFO ȡ
+// ˵     *fifo               FIFO ָ
+// ˵     *dat                Ŀ껺ָ
+// ˵     *length             ȡݳ ûôᱻ޸
+// ˵     flag                Ƿ FIFO ״̬ ѡǷնȡ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     zf_log(spsc_fifo_read_buffer(&fifo, data, &length, FIFO_READ_ONLY) == FIFO_SUCCESS, "spsc_fifo_read_buffer error");
+// עϢ     ֻڶȡ ݲʱݲ FIFO_DATA_NO_ENOUGH  fifo_read_buffer һ
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum spsc_fifo_read_buffer (spsc_fifo_struct *fifo, void *dat, uint32 *length, fifo_operation_enum flag)
+{
+    zf_assert(NULL != fifo);
+    zf_assert(NULL != length);
+    fifo_state_enum return_state = FIFO_SUCCESS;
+    uint32 tail = fifo->tail;
+    uint32 used = fifo->head - tail;                                            // ֻһ head ֮д´
+
+    if(NULL == dat)
+    {
+        return FIFO_BUFFER_NULL;                                                // û쳣
+    }
+    if(*length > used)
+    {
+        *length = used;                                                         // ȡĳ
+        return_state = FIFO_DATA_NO_ENOUGH;                                     // ־ݲ
+    }
+    if(*length)
+    {
+        spsc_fifo_copy_out(fifo, tail, dat, *length);
+        if(FIFO_READ_AND_CLEAN == flag)                                         // ѡȡ FIFO ״̬
+        {
+            SPSC_FIFO_BARRIER();
+            fifo->tail = tail + *length;                                        // ͷſռ
+        }
+    }
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      FIFO ʼ ضӦ
+// ˵     *fifo               FIFO ָ
+// ˵     type                FIFO λ
+// ˵     *buffer_addr        ҪصĻ
+// ˵     size                С Ϊ 2 
+// ز     fifo_state_enum     ״̬
+// ʹʾ     spsc_fifo_init(&uart_fifo, FIFO_DATA_8BIT, uart_buffer, 64);
+// עϢ     Ԫ type Ӧ uint8 / uint16 / uint32
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum spsc_fifo_init (spsc_fifo_struct *fifo, fifo_data_type_enum type, void *buffer_addr, uint32 size)
+{
+    zf_assert(NULL != fifo);
+    zf_assert(0 != size && 0 == (size & (size - 1)));                           // СΪ 2 
+    if(NULL == buffer_addr || 0 == size || 0 != (size & (size - 1)))
+    {
+        return FIFO_BUFFER_NULL;
+    }
+    fifo->type      = type;
+    fifo->buffer    = buffer_addr;
+    fifo->mask      = size - 1;
+    fifo->head      = 0;
+    fifo->tail      = 0;
+    switch(type)
+    {
+        case FIFO_DATA_8BIT:    fifo->element = sizeof(uint8);  break;
+        case FIFO_DATA_16BIT:   fifo->element = sizeof(uint16); break;
+        case FIFO_DATA_32BIT:   fifo->element = sizeof(uint32); break;
+    }
+    return FIFO_SUCCESS;
+}
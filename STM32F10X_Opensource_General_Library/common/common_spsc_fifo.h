@@ -0,0 +1,54 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// ߵߣSPSC FIFO
+//  һжд ѭȡ򷴹ĳ д˫Ҫж ҲΪǶ׷ FIFO_WRITE_UNDO
+//
+// ʹԼ
+// 1. ȱ 2  ±ͨ
+// 2. ͬһʱֻһд뷽һȡ дຯֻд뷽 ȡຯ spsc_fifo_clear ֻڶȡ
+// 3. ж϶Ҫдͬһ FIFO ʱ ʹ zf_common_fifo
+//
+// ʵ˵
+// head ֻд뷽޸ tail ֻɶȡ޸ ߶ɵ 32 λ ƺԵõȷݸ
+// д뷽ȿٷ head ȡȿٷ tail η֮ǰڴ
+
+#ifndef _common_spsc_fifo_h_
+#define _common_spsc_fifo_h_
+
+#include "common_headfile.h"
+
+typedef struct
+{
+    fifo_data_type_enum type;                                                   //   zf_common_fifo ͬ
+    uint8               element;                                                // ռֽ
+    void                *buffer;                                                // ָ
+    uint32              mask;                                                   // ܴСһ
+    volatile uint32     head;                                                   // д ֻд뷽޸
+    volatile uint32     tail;                                                   // ȡ ֻɶȡ޸
+}spsc_fifo_struct;
+
+fifo_state_enum spsc_fifo_clear             (spsc_fifo_struct *fifo);
+uint32          spsc_fifo_used              (spsc_fifo_struct *fifo);
+uint32          spsc_fifo_free              (spsc_fifo_struct *fifo);
+
+fifo_state_enum spsc_fifo_write_element     (spsc_fifo_struct *fifo, uint32 dat);
+fifo_state_enum spsc_fifo_write_buffer      (spsc_fifo_struct *fifo, const void *dat, uint32 length);
+fifo_state_enum spsc_fifo_read_element      (spsc_fifo_struct *fifo, void *dat, fifo_operation_enum flag);
+fifo_state_enum spsc_fifo_read_buffer       (spsc_fifo_struct *fifo, void *dat, uint32 *length, fifo_operation_enum flag);
+
+fifo_state_enum spsc_fifo_init              (spsc_fifo_struct *fifo, fifo_data_type_enum type, void *buffer_addr, uint32 size);
+
+#endif
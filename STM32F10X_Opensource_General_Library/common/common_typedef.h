@@ -237,6 +237,17 @@ typedef enum            // ö
 }uart_index_enum;
 
 
+/* IIC  Ӳ IIC  IIC  */
+typedef enum
+{
+    IIC_ERROR_NONE,                                                             // ɹ
+    IIC_ERROR_NACK,                                                             // ַӦ
+    IIC_ERROR_BUS,                                                              // ߴ Ƿ START/STOP ޷ͷ
+    IIC_ERROR_ARBITRATION,                                                      // ٲöʧ
+    IIC_ERROR_OVERRUN,                                                          // 
+    IIC_ERROR_TIMEOUT,                                                          // ӻ SCL ʱ Ӳ IIC ʱûнչ
+}iic_error_enum;
+
 /*  IIC Ϣṹ */
 typedef struct
 {
@@ -244,6 +255,12 @@ typedef struct
     gpio_pin_enum       sda_pin;                                                // ڼ¼Ӧű
     uint8               addr;                                                   // ַ λַģʽ
     uint32              delay;                                                  // ģ IIC ʱʱ
+    GPIO_TypeDef        *scl_port;                                              // ŶӦĶ˿ ʼʱ ֱӶдĴ
+    uint16              scl_mask;
+    GPIO_TypeDef        *sda_port;
+    uint16              sda_mask;
+    uint32              stretch;                                                // ʱչѯ SCL Ĵ 0-
+    iic_error_enum      error;                                                  // һδĽ
 }soft_iic_info_struct;
 // öֹû޸
 typedef enum
@@ -274,6 +291,7 @@ typedef struct //ö
     uint8       use_miso    :1;                                         // Ƿʹ MISO 
     uint8       use_cs      :1;                                         // Ƿʹ CS 
 }spi_config_info_struct;
+typedef uint8 (*soft_spi_fast_handler)(uint8 dat);                     // ڰŵ 8bit д  SOFT_SPI_FAST_DEFINE 
 typedef struct
 {
     spi_config_info_struct  config;                                     // 
@@ -282,6 +300,7 @@ typedef struct
     gpio_pin_enum           miso_pin;                                   // ڼ¼Ӧű
     gpio_pin_enum           cs_pin;                                     // ڼ¼Ӧű
     uint32                  delay;                                      // ģ SPI ʱʱ
+    soft_spi_fast_handler   fast;                                       // ͨ Ϊ NULL ʱűλ
 }soft_spi_info_struct;
 
 /* Ӳ SPI Ϣṹ */
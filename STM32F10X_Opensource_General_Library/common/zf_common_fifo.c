@@ -36,9 +36,6 @@
 
 //#include "zf_common_debug.h"
 #include "zf_common_fifo.h"
-/* /˳ٽ꣬ KEIL / GCC */
-#define CRIT_ENTER()  uint32 primask = __get_PRIMASK(); __disable_irq()
-#define CRIT_EXIT()   __set_PRIMASK(primask)
 //-------------------------------------------------------------------------------------------------------------------
 //      FIFO ͷָλ
 // ˵     *fifo               FIFO ָ
@@ -537,6 +534,201 @@ fifo_state_enum fifo_read_tail_buffer (fifo_struct *fifo, void *dat, uint32 *len
     return return_state;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//       FIFO ָλõĵַ
+// ˵     *fifo               FIFO ָ
+// ˵     index               ±
+// ز     void *              Ӧַ
+// ʹʾ     fifo_element_address(fifo, fifo->head);
+// עϢ     ļڲ ûùע Ҳ޸
+//-------------------------------------------------------------------------------------------------------------------
+static void *fifo_element_address (fifo_struct *fifo, uint32 index)
+{
+    void *address = NULL;
+    switch(fifo->type)
+    {
+        case FIFO_DATA_8BIT:    address = &(((uint8 *)fifo->buffer)[index]);    break;
+        case FIFO_DATA_16BIT:   address = &(((uint16 *)fifo->buffer)[index]);   break;
+        case FIFO_DATA_32BIT:   address = &(((uint32 *)fifo->buffer)[index]);   break;
+    }
+    return address;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ָ±꿪ʼ Ϊ length Ļ
+// ˵     *fifo               FIFO ָ
+// ˵     *region             
+// ˵     index               ʼ±
+// ˵     length              ܳ
+// ز     void
+// ʹʾ     fifo_region_build(fifo, region, fifo->end, fifo_used(fifo));
+// עϢ     ļڲ ûùע Ҳ޸
+//-------------------------------------------------------------------------------------------------------------------
+static void fifo_region_build (fifo_struct *fifo, fifo_region_struct *region, uint32 index, uint32 length)
+{
+    uint32 temp_length = fifo->max - index;                                     // βĳ
+
+    region->buffer[0] = fifo_element_address(fifo, index);
+    if(length > temp_length)                                                    // β Ϊ
+    {
+        region->length[0] = temp_length;
+        region->buffer[1] = fifo->buffer;
+        region->length[1] = length - temp_length;
+    }
+    else
+    {
+        region->length[0] = length;
+        region->buffer[1] = NULL;
+        region->length[1] = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ FIFO ȫпռ ֱд
+// ˵     *fifo               FIFO ָ
+// ˵     *region               ˳д length[0] + length[1] Ϊʣռ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     fifo_write_reserve(&fifo, &region); memcpy(region.buffer[0], src, n); fifo_write_commit(&fifo, n);
+// עϢ     ɹ FIFO д״̬ д᷵ FIFO_WRITE_UNDO ֱ fifo_write_commit
+//              ԰ DMA Ŀֱַָ region.buffer[0] ɺύ
+//              ԤڼȡԿȡͷ Ҫ fifo_clear
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum fifo_write_reserve (fifo_struct *fifo, fifo_region_struct *region)
+{
+    zf_assert(NULL != fifo);
+    CRIT_ENTER();
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+
+    do
+    {
+        if(NULL == region)
+        {
+            return_state = FIFO_BUFFER_NULL;                                    // û쳣
+            break;
+        }
+        if((FIFO_RESET | FIFO_WRITE) & fifo->execution)                         // д״̬ д뾺ָ
+        {
+            return_state = FIFO_WRITE_UNDO;                                     // дδ
+            break;
+        }
+        fifo->execution |= FIFO_WRITE;                                          // дλ  fifo_write_commit λ
+        fifo_region_build(fifo, region, fifo->head, fifo->size);
+        if(0 == fifo->size)
+        {
+            return_state = FIFO_SPACE_NO_ENOUGH;                                // ûппռ  fifo_write_commit(fifo, 0) д
+        }
+    }while(0);
+    CRIT_EXIT();
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ύ fifo_write_reserve Ԥռʵд
+// ˵     *fifo               FIFO ָ
+// ˵     length              ʵдݸ 0 ʾд
+// ز     fifo_state_enum     ״̬
+// ʹʾ     fifo_write_commit(&fifo, n);
+// עϢ     ݱ region.buffer[0] д дһκдڶ
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum fifo_write_commit (fifo_struct *fifo, uint32 length)
+{
+    zf_assert(NULL != fifo);
+    CRIT_ENTER();
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+
+    do
+    {
+        if(!(FIFO_WRITE & fifo->execution))                                     // ûԤ ύ
+        {
+            return_state = FIFO_WRITE_UNDO;
+            break;
+        }
+        if(length > fifo->size)
+        {
+            length = fifo->size;                                                // ԤռĲֶ
+            return_state = FIFO_SPACE_NO_ENOUGH;
+        }
+        fifo_head_offset(fifo, length);                                         // ͷָƫ
+        fifo->size -= length;                                                   // ʣ೤ȼС
+        fifo->execution &= ~FIFO_WRITE;                                         // дλ
+    }while(0);
+    CRIT_EXIT();
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ FIFO ȫݵλ ԭؽ
+// ˵     *fifo               FIFO ָ
+// ˵     *region                buffer[0]  buffer[1]
+// ز     fifo_state_enum     ״̬
+// ʹʾ     fifo_read_peek(&fifo, &region); parse(region.buffer[0], region.length[0]); fifo_read_consume(&fifo, n);
+// עϢ     ı FIFO ״̬  FIFO_READ_ONLY ȡͬ 
+//              еڵ fifo_read_consume ֮ǰᱻд뷽
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum fifo_read_peek (fifo_struct *fifo, fifo_region_struct *region)
+{
+    zf_assert(NULL != fifo);
+    CRIT_ENTER();
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+
+    do
+    {
+        if(NULL == region)
+        {
+            return_state = FIFO_BUFFER_NULL;                                    // û쳣
+            break;
+        }
+        if((FIFO_RESET | FIFO_CLEAR) & fifo->execution)                         // жǷǰ FIFO Ƿִջò
+        {
+            fifo_region_build(fifo, region, fifo->end, 0);
+            return_state = FIFO_READ_UNDO;                                      // ȡδ
+            break;
+        }
+        fifo_region_build(fifo, region, fifo->end, fifo_used(fifo));
+        if(0 == region->length[0])
+        {
+            return_state = FIFO_DATA_NO_ENOUGH;                                 // û ݳȲ
+        }
+    }while(0);
+    CRIT_EXIT();
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ͷ FIFO ͷѴ
+// ˵     *fifo               FIFO ָ
+// ˵     length              ͷŵݸ
+// ز     fifo_state_enum     ״̬
+// ʹʾ     fifo_read_consume(&fifo, n);
+// עϢ     һ fifo_read_peek ʹ ʱȫͷŲ FIFO_DATA_NO_ENOUGH
+//-------------------------------------------------------------------------------------------------------------------
+fifo_state_enum fifo_read_consume (fifo_struct *fifo, uint32 length)
+{
+    zf_assert(NULL != fifo);
+    CRIT_ENTER();
+    fifo_state_enum return_state = FIFO_SUCCESS;                                // ֵ
+
+    do
+    {
+        if((FIFO_RESET | FIFO_CLEAR) & fifo->execution)                         //    ״̬ 쳣
+        {
+            return_state = FIFO_CLEAR_UNDO;                                     // ղδ
+            break;
+        }
+        if(length > fifo_used(fifo))
+        {
+            length = fifo_used(fifo);
+            return_state = FIFO_DATA_NO_ENOUGH;                                 // ־ݲ
+        }
+        fifo->execution |= FIFO_CLEAR;                                          // λ
+        fifo_end_offset(fifo, length);                                          // ƶ FIFO βָ
+        fifo->size += length;                                                   // ͷŶӦȿռ
+        fifo->execution &= ~FIFO_CLEAR;                                         // λ
+    }while(0);
+    CRIT_EXIT();
+    return return_state;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      FIFO ʼ ضӦ
 // ˵     *fifo               FIFO ָ
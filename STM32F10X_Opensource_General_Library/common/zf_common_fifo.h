@@ -92,6 +92,12 @@ typedef struct
     uint32              size;                                                   // ʣС
     uint32              max;                                                    // ܴС
 }fifo_struct;
+
+typedef struct
+{
+    void                *buffer[2];                                             // ʼַ ڶβʱΪ NULL
+    uint32              length[2];                                              // ݸ λ ֽ
+}fifo_region_struct;                                                            // FIFO 㿽 λʱΪ
 fifo_state_enum fifo_clear              (fifo_struct *fifo);
 uint32          fifo_used               (fifo_struct *fifo);
 
@@ -101,6 +107,14 @@ fifo_state_enum fifo_read_element       (fifo_struct *fifo, void *dat, fifo_oper
 fifo_state_enum fifo_read_buffer        (fifo_struct *fifo, void *dat, uint32 *length, fifo_operation_enum flag);
 fifo_state_enum fifo_read_tail_buffer   (fifo_struct *fifo, void *dat, uint32 *length, fifo_operation_enum flag);
 
+fifo_state_enum fifo_write_reserve      (fifo_struct *fifo, fifo_region_struct *region);
+fifo_state_enum fifo_write_commit       (fifo_struct *fifo, uint32 length);
+fifo_state_enum fifo_read_peek          (fifo_struct *fifo, fifo_region_struct *region);
+fifo_state_enum fifo_read_consume       (fifo_struct *fifo, uint32 length);
+
 fifo_state_enum fifo_init               (fifo_struct *fifo, fifo_data_type_enum type, void *buffer_addr, uint32 size);
 
+#include "common_spsc_fifo.h"                                                   // SPSC  FIFO ö ﱣ֤˳
+#include "common_message_fifo.h"                                                // 䳤Ϣ FIFO  fifo_struct
+
 #endif
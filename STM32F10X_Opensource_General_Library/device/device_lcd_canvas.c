@@ -0,0 +1,471 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "device_lcd_canvas.h"
+
+//-------------------------------------------------------------------------------------------------------------------
+//      дһ ɫıʱڿ
+// ˵     canvas          
+// ˵     x                ΧĵֱӶ
+// ˵     y               
+// ˵     color           RGB565 ɫ
+// ز     void
+// ʹʾ     lcd_canvas_write_pixel(canvas, 0, 0, RGB565_RED);
+// עϢ     ڲ û
+//-------------------------------------------------------------------------------------------------------------------
+static void lcd_canvas_write_pixel (lcd_canvas_struct *canvas, uint16 x, uint16 y, uint16 color)
+{
+    if(x >= canvas->width || y >= canvas->height)
+    {
+        return;
+    }
+
+    uint8 *pixel = canvas->buffer + ((uint32)y * canvas->width + x) * 2;
+    uint8 high = (uint8)(color >> 8);
+    uint8 low = (uint8)(color & 0xFF);
+
+    if(pixel[0] != high || pixel[1] != low)
+    {
+        pixel[0] = high;
+        pixel[1] = low;
+        canvas->dirty[y / LCD_CANVAS_TILE_HEIGHT] |= ((uint32)1 << (x / LCD_CANVAS_TILE_WIDTH));
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʼ
+// ˵     canvas          
+// ˵     buffer          ػ  LCD_CANVAS_BUFFER_SIZE(width, height) ֽ
+// ˵     x               ϽĻϵ
+// ˵     y               ϽĻϵ
+// ˵     width             32 * LCD_CANVAS_TILE_WIDTH
+// ˵     height          ߶  LCD_CANVAS_TILE_ROW_MAX * LCD_CANVAS_TILE_HEIGHT
+// ˵     window          Ļд뺯 ips200_write_window  tft180_write_window
+// ز     void
+// ʹʾ     lcd_canvas_init(&canvas, canvas_buffer, 0, 32, 128, 32, tft180_write_window);
+// עϢ     ΪɫΪ һ lcd_canvas_flush 򷢸Ļ
+//              ĻҪɳʼ Ļֱ ԽĻĶԷ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_init (lcd_canvas_struct *canvas, uint8 *buffer, uint16 x, uint16 y, uint16 width, uint16 height, lcd_canvas_window_handler window)
+{
+    zf_assert(NULL != canvas);
+    zf_assert(NULL != buffer);
+    zf_assert(NULL != window);
+    zf_assert(0 < width && 32 * LCD_CANVAS_TILE_WIDTH >= width);
+    zf_assert(0 < height && LCD_CANVAS_TILE_ROW_MAX * LCD_CANVAS_TILE_HEIGHT >= height);
+
+    canvas->buffer      = buffer;
+    canvas->x           = x;
+    canvas->y           = y;
+    canvas->width       = width;
+    canvas->height      = height;
+    canvas->pencolor    = RGB565_RED;
+    canvas->bgcolor     = RGB565_WHITE;
+    canvas->font        = LCD_CANVAS_8X16_FONT;
+    canvas->window      = window;
+
+    lcd_canvas_clear(canvas);
+    lcd_canvas_invalidate(canvas);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ûʾɫ
+// ˵     canvas          
+// ˵     pen             ɫʽ RGB565 ߿ʹ zf_common_font.h  rgb565_color_enum öֵд
+// ˵     bgcolor         ɫʽ RGB565 ߿ʹ zf_common_font.h  rgb565_color_enum öֵд
+// ز     void
+// ʹʾ     lcd_canvas_set_color(&canvas, RGB565_RED, RGB565_GRAY);
+// עϢ     ɫͱɫҲʱ úЧ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_set_color (lcd_canvas_struct *canvas, const uint16 pen, const uint16 bgcolor)
+{
+    canvas->pencolor = pen;
+    canvas->bgcolor = bgcolor;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ûʾ
+// ˵     canvas          
+// ˵     font              lcd_canvas_font_enum
+// ز     void
+// ʹʾ     lcd_canvas_set_font(&canvas, LCD_CANVAS_6X8_FONT);
+// עϢ     ʱ úЧ ʾµС
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_set_font (lcd_canvas_struct *canvas, lcd_canvas_font_enum font)
+{
+    canvas->font = font;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Ϊɫ
+// ˵     canvas          
+// ز     void
+// ʹʾ     lcd_canvas_clear(&canvas);
+// עϢ     ֻɫıĿ´ˢʱ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_clear (lcd_canvas_struct *canvas)
+{
+    lcd_canvas_fill_rect(canvas, 0, 0, canvas->width, canvas->height, canvas->bgcolor);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     width           ο ֱõ
+// ˵     height          θ߶ ֱõ
+// ˵     color           ɫʽ RGB565
+// ز     void
+// ʹʾ     lcd_canvas_fill_rect(&canvas, 0, 0, 20, 10, RGB565_BLUE);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_fill_rect (lcd_canvas_struct *canvas, uint16 x, uint16 y, uint16 width, uint16 height, const uint16 color)
+{
+    zf_assert(x < canvas->width);
+    zf_assert(y < canvas->height);
+
+    uint16 x_end = (width > canvas->width - x) ? canvas->width : x + width;
+    uint16 y_end = (height > canvas->height - y) ? canvas->height : y + height;
+    uint16 i = 0, j = 0;
+
+    for(j = y; y_end > j; j ++)
+    {
+        for(i = x; x_end > i; i ++)
+        {
+            lcd_canvas_write_pixel(canvas, i, j, color);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     color           ɫʽ RGB565
+// ز     void
+// ʹʾ     lcd_canvas_draw_point(&canvas, 0, 0, RGB565_RED);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_draw_point (lcd_canvas_struct *canvas, uint16 x, uint16 y, const uint16 color)
+{
+    zf_assert(x < canvas->width);
+    zf_assert(y < canvas->height);
+
+    lcd_canvas_write_pixel(canvas, x, y, color);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      
+// ˵     canvas          
+// ˵     x_start          Χ [0, canvas->width-1]
+// ˵     y_start          Χ [0, canvas->height-1]
+// ˵     x_end           յ Χ [0, canvas->width-1]
+// ˵     y_end           յ Χ [0, canvas->height-1]
+// ˵     color           ɫʽ RGB565
+// ز     void
+// ʹʾ     lcd_canvas_draw_line(&canvas, 0, 0, 10, 10, RGB565_RED);
+// עϢ      Bresenham ʹø
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_draw_line (lcd_canvas_struct *canvas, uint16 x_start, uint16 y_start, uint16 x_end, uint16 y_end, const uint16 color)
+{
+    zf_assert(x_start < canvas->width);
+    zf_assert(y_start < canvas->height);
+    zf_assert(x_end < canvas->width);
+    zf_assert(y_end < canvas->height);
+
+    int32 dx = func_abs((int32)x_end - (int32)x_start);
+    int32 dy = -func_abs((int32)y_end - (int32)y_start);
+    int32 x_dir = (x_start < x_end ? 1 : -1);
+    int32 y_dir = (y_start < y_end ? 1 : -1);
+    int32 err = dx + dy;
+    int32 x = x_start, y = y_start;
+
+    while(1)
+    {
+        lcd_canvas_write_pixel(canvas, (uint16)x, (uint16)y, color);
+        if(x == x_end && y == y_end)
+        {
+            break;
+        }
+        if(2 * err >= dy)
+        {
+            err += dy;
+            x += x_dir;
+        }
+        if(2 * err <= dx)
+        {
+            err += dx;
+            y += y_dir;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʾַ
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     dat             Ҫʾַ
+// ز     void
+// ʹʾ     lcd_canvas_show_char(&canvas, 0, 0, 'x');
+// עϢ     Ĳֱõ ʾַո
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_show_char (lcd_canvas_struct *canvas, uint16 x, uint16 y, const char dat)
+{
+    zf_assert(x < canvas->width);
+    zf_assert(y < canvas->height);
+
+    const uint8 *glyph = ascii_font_8x16_safe((uint8)dat);
+    uint8 i = 0, j = 0;
+
+    switch(canvas->font)
+    {
+        case LCD_CANVAS_6X8_FONT:
+        {
+            // 6x8 ֻֿȡģ 'z' ַ֮ͬո
+            glyph = ascii_font_6x8[(0x20 > (uint8)dat || 'z' < (uint8)dat) ? 0 : (uint8)dat - 32];
+            for(i = 0; 6 > i; i ++)
+            {
+                uint8 temp_top = glyph[i];
+                for(j = 0; 8 > j; j ++)
+                {
+                    lcd_canvas_write_pixel(canvas, x + i, y + j, (temp_top & 0x01) ? canvas->pencolor : canvas->bgcolor);
+                    temp_top >>= 1;
+                }
+            }
+        }break;
+        case LCD_CANVAS_8X16_FONT:
+        {
+            for(i = 0; 8 > i; i ++)
+            {
+                uint8 temp_top = glyph[i];
+                uint8 temp_bottom = glyph[i + 8];
+                for(j = 0; 8 > j; j ++)
+                {
+                    lcd_canvas_write_pixel(canvas, x + i, y + j, (temp_top & 0x01) ? canvas->pencolor : canvas->bgcolor);
+                    lcd_canvas_write_pixel(canvas, x + i, y + j + 8, (temp_bottom & 0x01) ? canvas->pencolor : canvas->bgcolor);
+                    temp_top >>= 1;
+                    temp_bottom >>= 1;
+                }
+            }
+        }break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʾַ
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     dat             Ҫʾַ
+// ز     void
+// ʹʾ     lcd_canvas_show_string(&canvas, 0, 0, "seekfree");
+// עϢ     ȵַٻ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_show_string (lcd_canvas_struct *canvas, uint16 x, uint16 y, const char dat[])
+{
+    zf_assert(x < canvas->width);
+    zf_assert(y < canvas->height);
+
+    uint8 step = (LCD_CANVAS_6X8_FONT == canvas->font) ? 6 : 8;
+    uint16 j = 0;
+
+    while('\0' != dat[j] && canvas->width > x)
+    {
+        lcd_canvas_show_char(canvas, x, y, dat[j]);
+        x += step;
+        j ++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʾ32λз (ȥЧ0)
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     dat             Ҫʾı  int32
+// ˵     num             Ҫʾλ 10λ  
+// ز     void
+// ʹʾ     lcd_canvas_show_int(&canvas, 0, 0, x, 3);
+// עϢ     ʾһ -
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_show_int (lcd_canvas_struct *canvas, uint16 x, uint16 y, const int32 dat, uint8 num)
+{
+    zf_assert(0 < num);
+    zf_assert(10 >= num);
+
+    int32 dat_temp = dat;
+    int32 offset = 1;
+    char data_buffer[12];
+
+    memset(data_buffer, 0, 12);
+    memset(data_buffer, ' ', num+1);
+
+    // ʾ 123 ʾ 2 λӦʾ 23
+    if(10 > num)
+    {
+        for(; 0 < num; num --)
+        {
+            offset *= 10;
+        }
+        dat_temp %= offset;
+    }
+    func_int_to_str(data_buffer, dat_temp);
+    lcd_canvas_show_string(canvas, x, y, (const char *)&data_buffer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʾ32λ޷ (ȥЧ0)
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     dat             Ҫʾı  uint32
+// ˵     num             Ҫʾλ 10λ  
+// ز     void
+// ʹʾ     lcd_canvas_show_uint(&canvas, 0, 0, x, 3);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_show_uint (lcd_canvas_struct *canvas, uint16 x, uint16 y, const uint32 dat, uint8 num)
+{
+    zf_assert(0 < num);
+    zf_assert(10 >= num);
+
+    uint32 dat_temp = dat;
+    int32 offset = 1;
+    char data_buffer[12];
+    memset(data_buffer, 0, 12);
+    memset(data_buffer, ' ', num);
+
+    // ʾ 123 ʾ 2 λӦʾ 23
+    if(10 > num)
+    {
+        for(; 0 < num; num --)
+        {
+            offset *= 10;
+        }
+        dat_temp %= offset;
+    }
+    func_uint_to_str(data_buffer, dat_temp);
+    lcd_canvas_show_string(canvas, x, y, (const char *)&data_buffer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʾ(ȥЧ0)
+// ˵     canvas          
+// ˵     x                Χ [0, canvas->width-1]
+// ˵     y                Χ [0, canvas->height-1]
+// ˵     dat             Ҫʾı  double
+// ˵     num             λʾ   8λ
+// ˵     pointnum        Сλʾ   6λ
+// ز     void
+// ʹʾ     lcd_canvas_show_float(&canvas, 0, 0, x, 2, 3);   // ʾ   ʾ2λ   Сʾλ
+// עϢ     ʾһ -
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_show_float (lcd_canvas_struct *canvas, uint16 x, uint16 y, const double dat, uint8 num, uint8 pointnum)
+{
+    zf_assert(0 < num);
+    zf_assert(8 >= num);
+    zf_assert(0 < pointnum);
+    zf_assert(6 >= pointnum);
+
+    double dat_temp = dat;
+    double offset = 1.0;
+    char data_buffer[17];
+    memset(data_buffer, 0, 17);
+    memset(data_buffer, ' ', num+pointnum+2);
+
+    // ʾ 123 ʾ 2 λӦʾ 23
+    for(; 0 < num; num --)
+    {
+        offset *= 10;
+    }
+    dat_temp = dat_temp - ((int)dat_temp / (int)offset) * offset;
+    func_double_to_str(data_buffer, dat_temp, pointnum);
+    lcd_canvas_show_string(canvas, x, y, data_buffer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Ϊ
+// ˵     canvas          
+// ز     void
+// ʹʾ     lcd_canvas_invalidate(&canvas);
+// עϢ     Ļĺ( clear) ´ˢط
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_canvas_invalidate (lcd_canvas_struct *canvas)
+{
+    uint16 columns = (canvas->width + LCD_CANVAS_TILE_WIDTH - 1) / LCD_CANVAS_TILE_WIDTH;
+    uint16 rows = (canvas->height + LCD_CANVAS_TILE_HEIGHT - 1) / LCD_CANVAS_TILE_HEIGHT;
+    uint32 mask = (32 == columns) ? 0xFFFFFFFF : (((uint32)1 << columns) - 1);
+    uint16 i = 0;
+
+    for(i = 0; LCD_CANVAS_TILE_ROW_MAX > i; i ++)
+    {
+        canvas->dirty[i] = (rows > i) ? mask : 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѻиı͵Ļ
+// ˵     canvas          
+// ز     uint32          η͵Ĵ 0-ûб仯 ûκ SPI 
+// ʹʾ     lcd_canvas_flush(&canvas);
+// עϢ     ͬһڵϲΪһ һͬҲȫΪʱºϲ
+//              ÿֻһʾ ڸǻпʱһ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 lcd_canvas_flush (lcd_canvas_struct *canvas)
+{
+    uint16 rows = (canvas->height + LCD_CANVAS_TILE_HEIGHT - 1) / LCD_CANVAS_TILE_HEIGHT;
+    uint32 stride = (uint32)canvas->width * 2;
+    uint32 count = 0;
+    uint16 row = 0, row_end = 0;
+
+    for(row = 0; rows > row; row ++)
+    {
+        while(canvas->dirty[row])
+        {
+            uint8 first = 0, last = 0;
+            uint32 mask = 0;
+
+            while(!(canvas->dirty[row] & ((uint32)1 << first)))
+            {
+                first ++;
+            }
+            for(last = first; 31 > last && (canvas->dirty[row] & ((uint32)1 << (last + 1))); last ++);
+            mask = ((31 == last) ? 0xFFFFFFFF : (((uint32)1 << (last + 1)) - 1)) & ~(((uint32)1 << first) - 1);
+
+            for(row_end = row; rows > row_end + 1 && mask == (canvas->dirty[row_end + 1] & mask); row_end ++);
+
+            uint16 x = first * LCD_CANVAS_TILE_WIDTH;
+            uint16 y = row * LCD_CANVAS_TILE_HEIGHT;
+            uint16 x_end = (last + 1) * LCD_CANVAS_TILE_WIDTH;
+            uint16 y_end = (row_end + 1) * LCD_CANVAS_TILE_HEIGHT;
+            uint16 i = 0;
+
+            x_end = (x_end > canvas->width) ? canvas->width : x_end;
+            y_end = (y_end > canvas->height) ? canvas->height : y_end;
+            for(i = row; row_end >= i; i ++)
+            {
+                canvas->dirty[i] &= ~mask;
+            }
+
+            canvas->window(canvas->x + x, canvas->y + y, x_end - x, y_end - y, canvas->buffer + (uint32)y * stride + (uint32)x * 2, stride);
+            count ++;
+        }
+    }
+    return count;
+}
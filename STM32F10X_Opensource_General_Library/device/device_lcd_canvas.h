@@ -0,0 +1,81 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// LCD ģʽ
+// Ļϻһ ֻд RAM е lcd_canvas_flush ʱŰѱ仯ĲַĻ
+//
+// ʹ÷
+// 1. ׼ LCD_CANVAS_BUFFER_SIZE(, ) ֽڵĻ F103 ֻ 20KB RAM һֻǱ̡״̬ʹ
+// 2. lcd_canvas_init ָĻϵλĻĴд뺯 ips200_write_window  tft180_write_window
+// 3.  lcd_canvas_*  Ե lcd_canvas_flush
+//
+// ʵ˵
+//  LCD_CANVAS_TILE_WIDTH x LCD_CANVAS_TILE_HEIGHT ֳɿ ֵıʱŰڿΪ
+// ͬһֵÿ֡ػκ SPI  ˢʱͬһڵϲһ һͬλҲʱºϲ
+// ذֽǰ RGB565  Ļ˳һ ʱҪת Ҳ uint16 ʵʿӰ
+
+#ifndef _device_lcd_canvas_h_
+#define _device_lcd_canvas_h_
+
+#include "common_headfile.h"
+
+#define LCD_CANVAS_TILE_WIDTH           (16)                                    //  
+#define LCD_CANVAS_TILE_HEIGHT          (16)                                    // ߶ 
+#define LCD_CANVAS_TILE_ROW_MAX         (20)                                    //  ߶Ȳ 20 * 16 = 320
+                                                                                // ÿ 32 λ¼ Ȳ 32 * 16 = 512
+
+#define LCD_CANVAS_BUFFER_SIZE(w, h)    ((uint32)(w) * (h) * 2)                 // ֽ
+
+typedef enum
+{
+    LCD_CANVAS_6X8_FONT                 = 0,                                    // 6x8      
+    LCD_CANVAS_8X16_FONT                = 1,                                    // 8x16     
+}lcd_canvas_font_enum;
+
+// Ļд뺯 data Ϊֽǰ RGB565 stride Ϊеֽڼ
+typedef void (*lcd_canvas_window_handler)(uint16 x, uint16 y, uint16 width, uint16 height, const uint8 *data, uint32 stride);
+
+typedef struct
+{
+    uint8                       *buffer;                                        //  ÿ 2 ֽ ֽǰ
+    uint16                      x;                                              // ϽĻϵ
+    uint16                      y;
+    uint16                      width;
+    uint16                      height;
+    uint16                      pencolor;                                       // ɫ(ɫ)
+    uint16                      bgcolor;                                        // ɫ
+    lcd_canvas_font_enum        font;
+    lcd_canvas_window_handler   window;
+    uint32                      dirty[LCD_CANVAS_TILE_ROW_MAX];                 // ÿһλͼ bit n Ӧ n п
+}lcd_canvas_struct;
+
+//====================================================LCD ====================================================
+void    lcd_canvas_init         (lcd_canvas_struct *canvas, uint8 *buffer, uint16 x, uint16 y, uint16 width, uint16 height, lcd_canvas_window_handler window);
+void    lcd_canvas_set_color    (lcd_canvas_struct *canvas, const uint16 pen, const uint16 bgcolor);
+void    lcd_canvas_set_font     (lcd_canvas_struct *canvas, lcd_canvas_font_enum font);
+void    lcd_canvas_clear        (lcd_canvas_struct *canvas);
+void    lcd_canvas_fill_rect    (lcd_canvas_struct *canvas, uint16 x, uint16 y, uint16 width, uint16 height, const uint16 color);
+void    lcd_canvas_draw_point   (lcd_canvas_struct *canvas, uint16 x, uint16 y, const uint16 color);
+void    lcd_canvas_draw_line    (lcd_canvas_struct *canvas, uint16 x_start, uint16 y_start, uint16 x_end, uint16 y_end, const uint16 color);
+void    lcd_canvas_show_char    (lcd_canvas_struct *canvas, uint16 x, uint16 y, const char dat);
+void    lcd_canvas_show_string  (lcd_canvas_struct *canvas, uint16 x, uint16 y, const char dat[]);
+void    lcd_canvas_show_int     (lcd_canvas_struct *canvas, uint16 x, uint16 y, const int32 dat, uint8 num);
+void    lcd_canvas_show_uint    (lcd_canvas_struct *canvas, uint16 x, uint16 y, const uint32 dat, uint8 num);
+void    lcd_canvas_show_float   (lcd_canvas_struct *canvas, uint16 x, uint16 y, const double dat, uint8 num, uint8 pointnum);
+void    lcd_canvas_invalidate   (lcd_canvas_struct *canvas);
+uint32  lcd_canvas_flush        (lcd_canvas_struct *canvas);
+//====================================================LCD ====================================================
+
+#endif
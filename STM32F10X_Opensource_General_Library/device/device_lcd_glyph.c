@@ -0,0 +1,196 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "device_lcd_glyph.h"
+
+typedef struct
+{
+    uint32      used;                                                           // һʹõ 0-
+    uint16      pen;
+    uint16      bgcolor;
+    char        dat;
+    uint8       font;
+    uint8       pixel[8 * 16 * 2];                                              // д ֽǰ
+}lcd_glyph_struct;
+
+static lcd_glyph_struct lcd_glyph_cache[LCD_GLYPH_CACHE_SIZE ? LCD_GLYPH_CACHE_SIZE : 1];  // ʱһΪչ
+static uint32           lcd_glyph_tick;
+static uint32           lcd_glyph_hit;
+static uint32           lcd_glyph_miss;
+static uint8            lcd_glyph_run_buffer[LCD_GLYPH_RUN_BUFFER_SIZE];
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һַչ RGB565 
+// ˵     glyph            dat/font/pen/bgcolor 
+// ز     void
+// ʹʾ     lcd_glyph_render(glyph);
+// עϢ     ڲ û
+//              ģд λΪһ 8x16 ģǰ 8 ֽΪϰ벿  8 ֽΪ°벿
+//-------------------------------------------------------------------------------------------------------------------
+static void lcd_glyph_render (lcd_glyph_struct *glyph)
+{
+    uint8 ch = (uint8)glyph->dat;
+    uint8 width = LCD_GLYPH_WIDTH(glyph->font);
+    uint8 height = LCD_GLYPH_HEIGHT(glyph->font);
+    const uint8 *font = NULL;
+    uint8 i = 0, j = 0;
+
+    if(LCD_GLYPH_6X8_FONT == glyph->font)
+    {
+        // 6x8 ֻֿȡģ 'z' ַ֮ͬո
+        font = ascii_font_6x8[(0x20 > ch || 'z' < ch) ? 0 : ch - 32];
+    }
+    else
+    {
+        font = ascii_font_8x16_safe(ch);
+    }
+
+    for(i = 0; width > i; i ++)
+    {
+        uint16 column = font[i];
+        if(LCD_GLYPH_8X16_FONT == glyph->font)
+        {
+            column |= (uint16)font[i + 8] << 8;
+        }
+        for(j = 0; height > j; j ++)
+        {
+            uint16 color = (column & 0x01) ? glyph->pen : glyph->bgcolor;
+            uint8 *pixel = &glyph->pixel[(j * width + i) * 2];
+            pixel[0] = (uint8)(color >> 8);
+            pixel[1] = (uint8)(color & 0xFF);
+            column >>= 1;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡһַ RGB565 
+// ˵     dat             ַ ʾַո
+// ˵     font            LCD_GLYPH_6X8_FONT  LCD_GLYPH_8X16_FONT
+// ˵     pen             ɫ RGB565
+// ˵     bgcolor         ɫ RGB565
+// ز     const uint8 *   дŵ ÿ 2 ֽڸֽǰ   *  * 2 ֽ
+// ʹʾ     ips200_write_8bit_data_array(lcd_glyph_get('A', IPS200_8X16_FONT, RGB565_RED, RGB565_WHITE), 8 * 16 * 2);
+// עϢ     лʱֱӷ δʱ滻δʹõĻ LCD_GLYPH_CACHE_SIZE Ϊ 0 ʱÿζչ
+//              صָһεñģ麯ǰЧ
+//-------------------------------------------------------------------------------------------------------------------
+const uint8 *lcd_glyph_get (const char dat, uint8 font, const uint16 pen, const uint16 bgcolor)
+{
+    zf_assert(LCD_GLYPH_6X8_FONT == font || LCD_GLYPH_8X16_FONT == font);
+
+    lcd_glyph_struct *glyph = &lcd_glyph_cache[0];
+    uint16 i = 0;
+
+#if LCD_GLYPH_CACHE_SIZE
+    for(i = 0; LCD_GLYPH_CACHE_SIZE > i; i ++)
+    {
+        lcd_glyph_struct *entry = &lcd_glyph_cache[i];
+        if(entry->used && entry->dat == dat && entry->font == font && entry->pen == pen && entry->bgcolor == bgcolor)
+        {
+            glyph = entry;
+            break;
+        }
+        if(entry->used < glyph->used)
+        {
+            glyph = entry;                                                      // δʹõһ δʱ滻
+        }
+    }
+#endif
+    if(LCD_GLYPH_CACHE_SIZE == i)
+    {
+        glyph->dat = dat;
+        glyph->font = font;
+        glyph->pen = pen;
+        glyph->bgcolor = bgcolor;
+        lcd_glyph_render(glyph);
+        lcd_glyph_miss ++;
+    }
+    else
+    {
+        lcd_glyph_hit ++;
+    }
+    glyph->used = ++ lcd_glyph_tick;
+    return glyph->pixel;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һַƴһڵ RGB565 
+// ˵     dat             ַ
+// ˵     font            LCD_GLYPH_6X8_FONT  LCD_GLYPH_8X16_FONT
+// ˵     pen             ɫ RGB565
+// ˵     bgcolor         ɫ RGB565
+// ˵     **buffer         ƴõ д Ϊ ֵ * ַ
+// ز     uint16          ƴӵַ 0-ַѽ
+// ʹʾ     count = lcd_glyph_compose(dat, IPS200_8X16_FONT, pen, bgcolor, &buffer);
+// עϢ     һƴ LCD_GLYPH_RUN_BUFFER_SIZE ɵַ ֵ߰ƶַ
+//-------------------------------------------------------------------------------------------------------------------
+uint16 lcd_glyph_compose (const char dat[], uint8 font, const uint16 pen, const uint16 bgcolor, const uint8 **buffer)
+{
+    uint8 width = LCD_GLYPH_WIDTH(font);
+    uint8 height = LCD_GLYPH_HEIGHT(font);
+    uint16 count_max = LCD_GLYPH_RUN_BUFFER_SIZE / (width * height * 2);
+    uint16 count = 0;
+    uint16 k = 0;
+    uint8 j = 0;
+
+    while(count_max > count && '\0' != dat[count])
+    {
+        count ++;
+    }
+    for(k = 0; count > k; k ++)
+    {
+        const uint8 *pixel = lcd_glyph_get(dat[k], font, pen, bgcolor);
+        for(j = 0; height > j; j ++)
+        {
+            memcpy(&lcd_glyph_run_buffer[((uint32)j * count * width + k * width) * 2], &pixel[j * width * 2], width * 2);
+        }
+    }
+    *buffer = lcd_glyph_run_buffer;
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡλͳ
+// ˵     *hit             д Ϊ NULL
+// ˵     *miss            δд Ϊ NULL
+// ز     void
+// ʹʾ     lcd_glyph_get_stats(&hit, &miss);
+// עϢ     ڰʵʾݵ LCD_GLYPH_CACHE_SIZE ѭˢµֶȶ miss Ӧ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_glyph_get_stats (uint32 *hit, uint32 *miss)
+{
+    if(NULL != hit)
+    {
+        *hit = lcd_glyph_hit;
+    }
+    if(NULL != miss)
+    {
+        *miss = lcd_glyph_miss;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      λͳ
+// ˵     void
+// ز     void
+// ʹʾ     lcd_glyph_clear_stats();
+// עϢ     Ӱѻ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_glyph_clear_stats (void)
+{
+    lcd_glyph_hit = 0;
+    lcd_glyph_miss = 0;
+}
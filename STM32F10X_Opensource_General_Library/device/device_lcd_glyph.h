@@ -0,0 +1,50 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// LCD λ
+//  ascii_font_6x8/ascii_font_8x16  (ַ, , ɫ, ɫ) չɸֽǰ RGB565 ز
+// ʱ滻δʹõ ͬһֶηˢʱλչģ
+// lcd_glyph_compose һַƴһڵ Ļһʾ鷢
+// ips200_show_string/tft180_show_string Լ show_char/show_int/show_uint/show_float 
+
+#ifndef _device_lcd_glyph_h_
+#define _device_lcd_glyph_h_
+
+#include "common_headfile.h"
+
+// θ ÿռ 8 * 16 * 2 + 8 = 264 ֽ Ĭ 4 Լ 1KB
+// ֶõ 0-9  '-' '.' ' '  13  Сڹʱ˳ѭˢ»ÿַδ
+// ڱѡ¶ ˢֶʱΪ 16 RAM ʱΪ 0  ÿֱչ ֻռһ RAM
+#ifndef LCD_GLYPH_CACHE_SIZE
+#define LCD_GLYPH_CACHE_SIZE            (4)
+#endif
+#ifndef LCD_GLYPH_RUN_BUFFER_SIZE
+#define LCD_GLYPH_RUN_BUFFER_SIZE       (512)                                   // ַƴӻ һ 2  8x16  5  6x8 ַ
+#endif                                                                          // ֳַɶڷ Ӵ󴰿
+
+#define LCD_GLYPH_6X8_FONT              (0)                                     //  IPS200_6X8_FONT/TFT180_6X8_FONT ȡֵһ
+#define LCD_GLYPH_8X16_FONT             (1)                                     //  IPS200_8X16_FONT/TFT180_8X16_FONT ȡֵһ
+
+#define LCD_GLYPH_WIDTH(font)           ((LCD_GLYPH_6X8_FONT == (font)) ? 6 : 8)
+#define LCD_GLYPH_HEIGHT(font)          ((LCD_GLYPH_6X8_FONT == (font)) ? 8 : 16)
+
+//====================================================LCD λ====================================================
+const uint8    *lcd_glyph_get           (const char dat, uint8 font, const uint16 pen, const uint16 bgcolor);
+uint16          lcd_glyph_compose       (const char dat[], uint8 font, const uint16 pen, const uint16 bgcolor, const uint8 **buffer);
+void            lcd_glyph_get_stats     (uint32 *hit, uint32 *miss);
+void            lcd_glyph_clear_stats   (void);
+//====================================================LCD λ====================================================
+
+#endif
@@ -0,0 +1,224 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "device_lcd_image.h"
+
+// Ҷ g Ӧ RGB565 (g >> 3, g >> 2, g >> 3) ԭĽͬ ÿֽǰ
+const uint8 lcd_image_gray_rgb565[256][2] =
+{
+    {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x20}, {0x00, 0x20}, {0x00, 0x20}, {0x00, 0x20},
+    {0x08, 0x41}, {0x08, 0x41}, {0x08, 0x41}, {0x08, 0x41}, {0x08, 0x61}, {0x08, 0x61}, {0x08, 0x61}, {0x08, 0x61},
+    {0x10, 0x82}, {0x10, 0x82}, {0x10, 0x82}, {0x10, 0x82}, {0x10, 0xA2}, {0x10, 0xA2}, {0x10, 0xA2}, {0x10, 0xA2},
+    {0x18, 0xC3}, {0x18, 0xC3}, {0x18, 0xC3}, {0x18, 0xC3}, {0x18, 0xE3}, {0x18, 0xE3}, {0x18, 0xE3}, {0x18, 0xE3},
+    {0x21, 0x04}, {0x21, 0x04}, {0x21, 0x04}, {0x21, 0x04}, {0x21, 0x24}, {0x21, 0x24}, {0x21, 0x24}, {0x21, 0x24},
+    {0x29, 0x45}, {0x29, 0x45}, {0x29, 0x45}, {0x29, 0x45}, {0x29, 0x65}, {0x29, 0x65}, {0x29, 0x65}, {0x29, 0x65},
+    {0x31, 0x86}, {0x31, 0x86}, {0x31, 0x86}, {0x31, 0x86}, {0x31, 0xA6}, {0x31, 0xA6}, {0x31, 0xA6}, {0x31, 0xA6},
+    {0x39, 0xC7}, {0x39, 0xC7}, {0x39, 0xC7}, {0x39, 0xC7}, {0x39, 0xE7}, {0x39, 0xE7}, {0x39, 0xE7}, {0x39, 0xE7},
+    {0x42, 0x08}, {0x42, 0x08}, {0x42, 0x08}, {0x42, 0x08}, {0x42, 0x28}, {0x42, 0x28}, {0x42, 0x28}, {0x42, 0x28},
+    {0x4A, 0x49}, {0x4A, 0x49}, {0x4A, 0x49}, {0x4A, 0x49}, {0x4A, 0x69}, {0x4A, 0x69}, {0x4A, 0x69}, {0x4A, 0x69},
+    {0x52, 0x8A}, {0x52, 0x8A}, {0x52, 0x8A}, {0x52, 0x8A}, {0x52, 0xAA}, {0x52, 0xAA}, {0x52, 0xAA}, {0x52, 0xAA},
+    {0x5A, 0xCB}, {0x5A, 0xCB}, {0x5A, 0xCB}, {0x5A, 0xCB}, {0x5A, 0xEB}, {0x5A, 0xEB}, {0x5A, 0xEB}, {0x5A, 0xEB},
+    {0x63, 0x0C}, {0x63, 0x0C}, {0x63, 0x0C}, {0x63, 0x0C}, {0x63, 0x2C}, {0x63, 0x2C}, {0x63, 0x2C}, {0x63, 0x2C},
+    {0x6B, 0x4D}, {0x6B, 0x4D}, {0x6B, 0x4D}, {0x6B, 0x4D}, {0x6B, 0x6D}, {0x6B, 0x6D}, {0x6B, 0x6D}, {0x6B, 0x6D},
+    {0x73, 0x8E}, {0x73, 0x8E}, {0x73, 0x8E}, {0x73, 0x8E}, {0x73, 0xAE}, {0x73, 0xAE}, {0x73, 0xAE}, {0x73, 0xAE},
+    {0x7B, 0xCF}, {0x7B, 0xCF}, {0x7B, 0xCF}, {0x7B, 0xCF}, {0x7B, 0xEF}, {0x7B, 0xEF}, {0x7B, 0xEF}, {0x7B, 0xEF},
+    {0x84, 0x10}, {0x84, 0x10}, {0x84, 0x10}, {0x84, 0x10}, {0x84, 0x30}, {0x84, 0x30}, {0x84, 0x30}, {0x84, 0x30},
+    {0x8C, 0x51}, {0x8C, 0x51}, {0x8C, 0x51}, {0x8C, 0x51}, {0x8C, 0x71}, {0x8C, 0x71}, {0x8C, 0x71}, {0x8C, 0x71},
+    {0x94, 0x92}, {0x94, 0x92}, {0x94, 0x92}, {0x94, 0x92}, {0x94, 0xB2}, {0x94, 0xB2}, {0x94, 0xB2}, {0x94, 0xB2},
+    {0x9C, 0xD3}, {0x9C, 0xD3}, {0x9C, 0xD3}, {0x9C, 0xD3}, {0x9C, 0xF3}, {0x9C, 0xF3}, {0x9C, 0xF3}, {0x9C, 0xF3},
+    {0xA5, 0x14}, {0xA5, 0x14}, {0xA5, 0x14}, {0xA5, 0x14}, {0xA5, 0x34}, {0xA5, 0x34}, {0xA5, 0x34}, {0xA5, 0x34},
+    {0xAD, 0x55}, {0xAD, 0x55}, {0xAD, 0x55}, {0xAD, 0x55}, {0xAD, 0x75}, {0xAD, 0x75}, {0xAD, 0x75}, {0xAD, 0x75},
+    {0xB5, 0x96}, {0xB5, 0x96}, {0xB5, 0x96}, {0xB5, 0x96}, {0xB5, 0xB6}, {0xB5, 0xB6}, {0xB5, 0xB6}, {0xB5, 0xB6},
+    {0xBD, 0xD7}, {0xBD, 0xD7}, {0xBD, 0xD7}, {0xBD, 0xD7}, {0xBD, 0xF7}, {0xBD, 0xF7}, {0xBD, 0xF7}, {0xBD, 0xF7},
+    {0xC6, 0x18}, {0xC6, 0x18}, {0xC6, 0x18}, {0xC6, 0x18}, {0xC6, 0x38}, {0xC6, 0x38}, {0xC6, 0x38}, {0xC6, 0x38},
+    {0xCE, 0x59}, {0xCE, 0x59}, {0xCE, 0x59}, {0xCE, 0x59}, {0xCE, 0x79}, {0xCE, 0x79}, {0xCE, 0x79}, {0xCE, 0x79},
+    {0xD6, 0x9A}, {0xD6, 0x9A}, {0xD6, 0x9A}, {0xD6, 0x9A}, {0xD6, 0xBA}, {0xD6, 0xBA}, {0xD6, 0xBA}, {0xD6, 0xBA},
+    {0xDE, 0xDB}, {0xDE, 0xDB}, {0xDE, 0xDB}, {0xDE, 0xDB}, {0xDE, 0xFB}, {0xDE, 0xFB}, {0xDE, 0xFB}, {0xDE, 0xFB},
+    {0xE7, 0x1C}, {0xE7, 0x1C}, {0xE7, 0x1C}, {0xE7, 0x1C}, {0xE7, 0x3C}, {0xE7, 0x3C}, {0xE7, 0x3C}, {0xE7, 0x3C},
+    {0xEF, 0x5D}, {0xEF, 0x5D}, {0xEF, 0x5D}, {0xEF, 0x5D}, {0xEF, 0x7D}, {0xEF, 0x7D}, {0xEF, 0x7D}, {0xEF, 0x7D},
+    {0xF7, 0x9E}, {0xF7, 0x9E}, {0xF7, 0x9E}, {0xF7, 0x9E}, {0xF7, 0xBE}, {0xF7, 0xBE}, {0xF7, 0xBE}, {0xF7, 0xBE},
+    {0xFF, 0xDF}, {0xFF, 0xDF}, {0xFF, 0xDF}, {0xFF, 0xDF}, {0xFF, 0xFF}, {0xFF, 0xFF}, {0xFF, 0xFF}, {0xFF, 0xFF}
+};
+
+static uint16_t         lcd_image_column[LCD_IMAGE_WIDTH_MAX];
+static uint16           lcd_image_column_width;                                 // Ӧͼʾ 0-δ
+static uint16           lcd_image_column_dis_width;
+static uint8            lcd_image_line[2][LCD_IMAGE_LINE_MAX ? LCD_IMAGE_LINE_MAX * 2 : 1];    // δòɫʱֻռһֽ
+#if SPI_TX_USE_DMA
+static spi_xfer_struct  lcd_image_xfer[2];
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ
+// ˵     width           ͼʵʿ
+// ˵     dis_width       ʾ Χ [1, LCD_IMAGE_WIDTH_MAX]
+// ز     const uint16_t*  i ʾжӦԭͼк i * width / dis_width
+// ʹʾ     column = lcd_image_column_table(MT9V03X_W, 128);
+// עϢ     һεĿͬʱֱӷ ¼
+//-------------------------------------------------------------------------------------------------------------------
+const uint16_t *lcd_image_column_table (uint16 width, uint16 dis_width)
+{
+    zf_assert(0 < dis_width && LCD_IMAGE_WIDTH_MAX >= dis_width);
+
+    if(width != lcd_image_column_width || dis_width != lcd_image_column_dis_width)
+    {
+        uint32 position = 0;
+        uint16 i = 0;
+
+        for(i = 0; i < dis_width; i ++)
+        {
+            lcd_image_column[i] = (uint16_t)(position / dis_width);
+            position += width;
+        }
+        lcd_image_column_width = width;
+        lcd_image_column_dis_width = dis_width;
+    }
+    return lcd_image_column;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һͼת RGB565 
+// ˵     image           ͼ
+// ˵     column          
+// ˵     j               ʾк
+// ˵     line             ÿ 2 ֽڸֽǰ
+// ز     void
+// ʹʾ     lcd_image_convert(image, column, j, lcd_image_line[0]);
+// עϢ     ڲ û
+//-------------------------------------------------------------------------------------------------------------------
+static void lcd_image_convert (const lcd_image_struct *image, const uint16_t *column, uint16 j, uint8 *line)
+{
+    uint32 row = (uint32)j * image->height / image->dis_height;
+    uint16 i = 0;
+
+    switch(image->format)
+    {
+        case LCD_IMAGE_BINARY:
+        {
+            const uint8 *source = (const uint8 *)image->data + row * image->width / 8;
+            for(i = 0; i < image->dis_width; i ++)
+            {
+                uint8 color = (0x80 & (source[column[i] / 8] << (column[i] % 8))) ? 0xFF : 0x00;
+                line[i * 2] = color;
+                line[i * 2 + 1] = color;
+            }
+        }break;
+        case LCD_IMAGE_GRAY:
+        {
+            const uint8 *source = (const uint8 *)image->data + row * image->width;
+            if(0 == image->option)
+            {
+                for(i = 0; i < image->dis_width; i ++)
+                {
+                    const uint8 *color = lcd_image_gray_rgb565[source[column[i]]];
+                    line[i * 2] = color[0];
+                    line[i * 2 + 1] = color[1];
+                }
+            }
+            else
+            {
+                for(i = 0; i < image->dis_width; i ++)
+                {
+                    uint8 color = (source[column[i]] < image->option) ? 0x00 : 0xFF;
+                    line[i * 2] = color;
+                    line[i * 2 + 1] = color;
+                }
+            }
+        }break;
+        case LCD_IMAGE_RGB565:
+        {
+            const uint16 *source = (const uint16 *)image->data + row * image->width;
+            uint8 high = image->option ? 0 : 8;                                 // λǰͼڴǷ˳
+            for(i = 0; i < image->dis_width; i ++)
+            {
+                uint16 color = source[column[i]];
+                line[i * 2] = (uint8)(color >> high);
+                line[i * 2 + 1] = (uint8)(color >> (8 - high));
+            }
+        }break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʾͼ
+// ˵     image           ͼ
+// ˵     write           д뺯
+// ز     void
+// ʹʾ     lcd_image_show(&image, ips200_write_8bit_data_array);
+// עϢ     ǰĻƬѡúʾ  SPI 벢ʹ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_image_show (const lcd_image_struct *image, lcd_image_line_handler write)
+{
+    zf_assert(NULL != image->data);
+    zf_assert(NULL != write);
+    zf_assert(LCD_IMAGE_LINE_MAX >= image->dis_width);                         // ڱѡﶨ LCD_IMAGE_USE_IPS200  LCD_IMAGE_USE_TFT180 Ϊ 1
+
+    const uint16_t *column = lcd_image_column_table(image->width, image->dis_width);
+    uint16 j = 0;
+
+    for(j = 0; j < image->dis_height; j ++)
+    {
+        lcd_image_convert(image, column, j, lcd_image_line[0]);
+        write(lcd_image_line[0], (uint32)image->dis_width * 2);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Ӳ SPI ʾͼ
+// ˵     image           ͼ
+// ˵     spi_n           Ļ SPI
+// ز     void
+// ʹʾ     lcd_image_show_spi(&image, IPS200_SPI);
+// עϢ     ǰĻƬѡúʾ ʱѷ
+//               DMA ʱлύ һڷʱתһ ʱ
+//-------------------------------------------------------------------------------------------------------------------
+void lcd_image_show_spi (const lcd_image_struct *image, spi_index_enum spi_n)
+{
+    zf_assert(NULL != image->data);
+    zf_assert(LCD_IMAGE_LINE_MAX >= image->dis_width);                         // ڱѡﶨ LCD_IMAGE_USE_IPS200  LCD_IMAGE_USE_TFT180 Ϊ 1
+
+    const uint16_t *column = lcd_image_column_table(image->width, image->dis_width);
+    uint32 length = (uint32)image->dis_width * 2;
+    uint16 j = 0;
+#if SPI_TX_USE_DMA
+    uint8 index = 0;
+
+    for(j = 0; j < image->dis_height; j ++)
+    {
+        spi_xfer_struct *xfer = &lcd_image_xfer[index];
+        while(SPI_XFER_QUEUED == xfer->state || SPI_XFER_ACTIVE == xfer->state);   // 黺һύķͽ
+
+        lcd_image_convert(image, column, j, lcd_image_line[index]);
+        xfer->cs_pin    = SPI_XFER_CS_NONE;                                     // ƬѡĻ
+        xfer->cs_hold   = 0;
+        xfer->tx        = lcd_image_line[index];
+        xfer->rx        = NULL;
+        xfer->length    = length;
+        xfer->flags     = 0;
+        xfer->callback  = NULL;
+        xfer->user_data = NULL;
+        while(spi_submit(spi_n, xfer));                                         // ʱǰĴóλ
+        index ^= 1;
+    }
+    spi_flush(spi_n);
+#else
+    for(j = 0; j < image->dis_height; j ++)
+    {
+        lcd_image_convert(image, column, j, lcd_image_line[0]);
+        spi_write_8bit_array(spi_n, lcd_image_line[0], length);
+    }
+#endif
+}
@@ -0,0 +1,76 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// LCD ͼʾ
+// ips200/tft180  show_binary_image/show_gray_image/show_rgb565_image  oled_show_gray_image 
+//
+// ʵ˵
+// ÿʾжӦԭͼкԤ÷ Ȳʱһֱ֡Ӹ ÿز
+// Ҷת RGB565  lcd_image_gray_rgb565  Ļյĸֽǰ˳
+// Ӳ SPI  DMA ʱʹлύ DMA ͵ N еͬʱ CPU ת N+1 
+
+#ifndef _device_lcd_image_h_
+#define _device_lcd_image_h_
+
+#include "common_headfile.h"
+
+// ʹͼʾĲɫ лĴС ڱѡﶨΪ 1
+// Ϊ 0 ʱֻ OLED  ʱ ips200/tft180  show_xxx_image 
+#ifndef LCD_IMAGE_USE_IPS200
+#define LCD_IMAGE_USE_IPS200            (0)
+#endif
+#ifndef LCD_IMAGE_USE_TFT180
+#define LCD_IMAGE_USE_TFT180            (0)
+#endif
+
+#if LCD_IMAGE_USE_IPS200
+#define LCD_IMAGE_LINE_MAX              (320)                                   // л IPS200 
+#elif LCD_IMAGE_USE_TFT180
+#define LCD_IMAGE_LINE_MAX              (160)                                   // л TFT180 
+#else
+#define LCD_IMAGE_LINE_MAX              (0)
+#endif
+#define LCD_IMAGE_WIDTH_MAX             ((128 < LCD_IMAGE_LINE_MAX) ? LCD_IMAGE_LINE_MAX : 128)    // ʾ С OLED  128
+
+typedef enum
+{
+    LCD_IMAGE_BINARY,                                                           // ÿֽ 8  λǰ Сѹֵͼ
+    LCD_IMAGE_GRAY,                                                             // 8bit Ҷ option Ϊֵֵ 0-ֵ
+    LCD_IMAGE_RGB565,                                                           // RGB565 option Ϊɫģʽ 0-λǰ 1-λǰ
+}lcd_image_format_enum;
+
+typedef struct
+{
+    const void                  *data;                                          // ͼ BINARY/GRAY Ϊ uint8 RGB565 Ϊ uint16
+    lcd_image_format_enum       format;
+    uint16                      width;                                          // ͼʵʿ
+    uint16                      height;                                         // ͼʵʸ߶
+    uint16                      dis_width;                                      // ʾ  LCD_IMAGE_LINE_MAX
+    uint16                      dis_height;                                     // ʾ߶
+    uint8                       option;                                         //  lcd_image_format_enum
+}lcd_image_struct;
+
+// д뺯 data Ϊֽǰ RGB565 len Ϊֽ
+typedef void (*lcd_image_line_handler)(const uint8 *data, uint32 len);
+
+extern const uint8 lcd_image_gray_rgb565[256][2];
+
+//====================================================LCD ͼ====================================================
+const uint16_t *lcd_image_column_table  (uint16 width, uint16 dis_width);
+void            lcd_image_show          (const lcd_image_struct *image, lcd_image_line_handler write);
+void            lcd_image_show_spi      (const lcd_image_struct *image, spi_index_enum spi_n);
+//====================================================LCD ͼ====================================================
+
+#endif
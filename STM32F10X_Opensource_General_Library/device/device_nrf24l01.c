@@ -40,12 +40,15 @@ const uint8 nrf24l01_rx_address[NRF24L01_RX_ADR_WIDTH]={0x34,0x43,0x10,0x10,0x01
 
 #if NRF24L01_USE_SOFT_SPI
 static soft_spi_info_struct nrf24l01_spi_struct;
+SOFT_SPI_FAST_DEFINE(nrf24l01_spi_fast, NRF24L01_SCL_PIN, NRF24L01_MOSI_PIN, NRF24L01_MISO_PIN, 0, NRF24L01_SOFT_SPI_DELAY)
 
 #define nrf24l01_write_register(reg, data)        (soft_spi_write_8bit_register (&nrf24l01_spi_struct, (reg|NRF24L01_W_REGISTER), (data)))
 #define nrf24l01_write_registers(reg, data, len)  (soft_spi_write_8bit_registers(&nrf24l01_spi_struct, (reg|NRF24L01_W_REGISTER), (data), (len)))
 #define nrf24l01_read_register(reg)               (soft_spi_read_8bit_register  (&nrf24l01_spi_struct, (reg|NRF24L01_R_REGISTER)))
 #define nrf24l01_read_registers(reg, data, len)   (soft_spi_read_8bit_registers (&nrf24l01_spi_struct, (reg|NRF24L01_R_REGISTER), (data), (len)))
 #else
+static spi_device_struct nrf24l01_spi_device;
+
 //-------------------------------------------------------------------------------------------------------------------
 //      NRF24L01 дĴ
 // ˵     reg             Ĵַ
@@ -56,9 +59,11 @@ static soft_spi_info_struct nrf24l01_spi_struct;
 //-------------------------------------------------------------------------------------------------------------------
 static void nrf24l01_write_register (uint8 reg, uint8 data)
 {
-   	NRF24L01_CS(0);                 //ʹSPI
-	  spi_write_8bit_register(NRF24L01_SPI, reg | NRF24L01_W_REGISTER, data);
-  	NRF24L01_CS(1);                 //ֹSPI	   
+    while(spi_device_acquire(&nrf24l01_spi_device));
+    NRF24L01_CS(0);                 //ʹSPI
+    spi_write_8bit_register(NRF24L01_SPI, reg | NRF24L01_W_REGISTER, data);
+    NRF24L01_CS(1);                 //ֹSPI	   
+    spi_device_release(&nrf24l01_spi_device);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -71,9 +76,11 @@ static void nrf24l01_write_register (uint8 reg, uint8 data)
 //-------------------------------------------------------------------------------------------------------------------
 static void nrf24l01_write_registers (uint8 reg, const uint8 *data, uint32 len)
 {
+    while(spi_device_acquire(&nrf24l01_spi_device));
     NRF24L01_CS(0);
     spi_write_8bit_registers(NRF24L01_SPI, reg | NRF24L01_W_REGISTER, data, len);
     NRF24L01_CS(1);
+    spi_device_release(&nrf24l01_spi_device);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -86,9 +93,11 @@ static void nrf24l01_write_registers (uint8 reg, const uint8 *data, uint32 len)
 static uint8 nrf24l01_read_register (uint8 reg)
 {
     uint8 data[2];
+    while(spi_device_acquire(&nrf24l01_spi_device));
     NRF24L01_CS(0);
     spi_read_8bit_registers(NRF24L01_SPI, reg | NRF24L01_R_REGISTER, data, 2);
     NRF24L01_CS(1);
+    spi_device_release(&nrf24l01_spi_device);
     return data[1];
 }
 
@@ -104,9 +113,11 @@ static uint8 nrf24l01_read_register (uint8 reg)
 static void nrf24l01_read_registers (uint8 reg, uint8 *data, uint32 len)
 {
     uint8 temp_data[33];
+    while(spi_device_acquire(&nrf24l01_spi_device));
     NRF24L01_CS(0);
     spi_read_8bit_registers(NRF24L01_SPI, reg | NRF24L01_R_REGISTER, temp_data, len + 1);
     NRF24L01_CS(1);
+    spi_device_release(&nrf24l01_spi_device);
     for(int i = 0; i < len; i ++)
     {
         *(data ++) = temp_data[i + 1];
@@ -145,8 +156,10 @@ uint8 nrf24l01_init (void)
 
 #if NRF24L01_USE_SOFT_SPI
     soft_spi_init(&nrf24l01_spi_struct, (uint8)0, (uint32)NRF24L01_SOFT_SPI_DELAY, (gpio_pin_enum)NRF24L01_SCL_PIN, (gpio_pin_enum)NRF24L01_MOSI_PIN, (gpio_pin_enum)NRF24L01_MISO_PIN, (gpio_pin_enum)SOFT_SPI_PIN_NULL);
+    soft_spi_set_fast(&nrf24l01_spi_struct, nrf24l01_spi_fast);
 #else
     spi_init(NRF24L01_SPI, SPI_MODE0, NRF24L01_SPI_SPEED, NRF24L01_SPC_PIN, NRF24L01_SDI_PIN, NRF24L01_SDO_PIN, SPI_CS_NULL);   //  NRF24L01  SPI ˿
+    spi_device_init(&nrf24l01_spi_device, NRF24L01_SPI, SPI_MODE0, NRF24L01_SPI_SPEED, NRF24L01_CS_PIN);
 #endif
 	  gpio_init(NRF24L01_CS_PIN, GPO_PUSH_PULL, 1);                  //  NRF24L01 CS˿
     gpio_init(NRF24L01_CE_PIN, GPO_PUSH_PULL, 0);                  // ʹ NRF24L01 
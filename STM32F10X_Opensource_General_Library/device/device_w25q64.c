@@ -34,16 +34,24 @@
 
 #if W25Q64_USE_SOFT_SPI
 static soft_spi_info_struct w25q64_spi_struct;
+SOFT_SPI_FAST_DEFINE(w25q64_spi_fast, W25Q64_SCL_PIN, W25Q64_MOSI_PIN, W25Q64_MISO_PIN, SPI_MODE0, W25Q64_SOFT_SPI_DELAY)
 
 #define w25q64_write_byte(dat)        soft_spi_write_8bit(&w25q64_spi_struct, (dat))
 #define w25q64_write_bytes(data, len) soft_spi_write_8bit_array(&w25q64_spi_struct, (data), (len))
 #define w25q64_read_byte()            soft_spi_read_8bit(&w25q64_spi_struct)
 #define w25q64_read_bytes(data, len)  soft_spi_read_8bit_array(&w25q64_spi_struct, (data), (len))   
+#define w25q64_select()               W25Q64_CS(0)
+#define w25q64_deselect()             W25Q64_CS(1)
 #else
+static spi_device_struct w25q64_spi_device;
+
 #define w25q64_write_byte(dat)        spi_write_8bit(W25Q64_SPI, (dat))
 #define w25q64_write_bytes(data, len) spi_write_8bit_array(W25Q64_SPI, (data), (len))
 #define w25q64_read_byte()            spi_read_8bit(W25Q64_SPI)
 #define w25q64_read_bytes(data, len)  spi_read_8bit_array(W25Q64_SPI, (data), (len))               
+/* ͬһ SPI ϵ Ƭѡǰռ Ƭѡͷź黹 */
+#define w25q64_select()               do { while (spi_device_acquire(&w25q64_spi_device)); W25Q64_CS(0); } while (0)
+#define w25q64_deselect()             do { W25Q64_CS(1); spi_device_release(&w25q64_spi_device); } while (0)
 #endif
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -57,10 +65,10 @@ static void w25q64_wait_busy(void)
 {
     uint8 sr;
     do {
-        W25Q64_CS(0);
+        w25q64_select();
         w25q64_write_byte(W25Q64_READ_STATUS_REGISTER_1);
         sr = w25q64_read_byte();
-        W25Q64_CS(1);
+        w25q64_deselect();
     } while (sr & 0x01);
 }
 
@@ -73,9 +81,9 @@ static void w25q64_wait_busy(void)
 //-------------------------------------------------------------------------------------------------------------------
 static void w25q64_write_enable(void)
 {
-    W25Q64_CS(0);
+    w25q64_select();
     w25q64_write_byte(W25Q64_WRITE_ENABLE);
-    W25Q64_CS(1);
+    w25q64_deselect();
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -88,10 +96,10 @@ static void w25q64_write_enable(void)
 static uint8 w25q64_self_check(void)
 {
     uint8 id[3];
-    W25Q64_CS(0);
+    w25q64_select();
     w25q64_write_byte(W25Q64_JEDEC_ID);
     w25q64_read_bytes(id, 3);
-    W25Q64_CS(1);
+    w25q64_deselect();
     /* W25Q64 ̶ 0xEF 0x40 0x17 */
     if (id[0] == 0xEF && id[1] == 0x40 && id[2] == 0x17)
         return 0;
@@ -108,12 +116,12 @@ static uint8 w25q64_self_check(void)
 void w25q64_sector_erase(uint32 addr)
 {
     w25q64_write_enable();
-    W25Q64_CS(0);
+    w25q64_select();
     w25q64_write_byte(W25Q64_SECTOR_ERASE_4KB);
     w25q64_write_byte((addr >> 16) & 0xFF);
     w25q64_write_byte((addr >> 8)  & 0xFF);
     w25q64_write_byte(addr & 0xFF);
-    W25Q64_CS(1);
+    w25q64_deselect();
     w25q64_wait_busy();
 }
 
@@ -130,13 +138,13 @@ void w25q64_page_program(uint32 addr, const uint8 *buf, uint16 len)
 {
     if (!len || len > 256) return;
     w25q64_write_enable();
-    W25Q64_CS(0);
+    w25q64_select();
     w25q64_write_byte(W25Q64_PAGE_PROGRAM);
     w25q64_write_byte((addr >> 16) & 0xFF);
     w25q64_write_byte((addr >> 8)  & 0xFF);
     w25q64_write_byte(addr & 0xFF);
     w25q64_write_bytes(buf, len);
-    W25Q64_CS(1);
+    w25q64_deselect();
     w25q64_wait_busy();
 }
 
@@ -151,13 +159,13 @@ void w25q64_page_program(uint32 addr, const uint8 *buf, uint16 len)
 //-------------------------------------------------------------------------------------------------------------------
 void w25q64_read_data(uint32 addr, uint8 *buf, uint32 len)
 {
-    W25Q64_CS(0);
+    w25q64_select();
     w25q64_write_byte(W25Q64_READ_DATA);
     w25q64_write_byte((addr >> 16) & 0xFF);
     w25q64_write_byte((addr >> 8)  & 0xFF);
     w25q64_write_byte(addr & 0xFF);
     w25q64_read_bytes(buf, len);        
-    W25Q64_CS(1);
+    w25q64_deselect();
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -171,11 +179,15 @@ uint8 w25q64_init(void)
 {
 #if W25Q64_USE_SOFT_SPI
     soft_spi_init(&w25q64_spi_struct, (uint8)SPI_MODE0, (uint32)W25Q64_SOFT_SPI_DELAY, (gpio_pin_enum)W25Q64_SCL_PIN, (gpio_pin_enum)W25Q64_MOSI_PIN, (gpio_pin_enum)W25Q64_MISO_PIN, (gpio_pin_enum)SOFT_SPI_PIN_NULL);   /* CS ֶ */
+    soft_spi_set_fast(&w25q64_spi_struct, w25q64_spi_fast);
 #else
     spi_init(W25Q64_SPI, SPI_MODE0, W25Q64_SPI_SPEED, W25Q64_SPC_PIN, W25Q64_SDI_PIN, W25Q64_SDO_PIN, SPI_CS_NULL);          /* CS ֶ */
 #endif
     gpio_init(W25Q64_CS_PIN, GPO_PUSH_PULL, 1);
     W25Q64_CS(1);
+#if !W25Q64_USE_SOFT_SPI
+    spi_device_init(&w25q64_spi_device, W25Q64_SPI, SPI_MODE0, W25Q64_SPI_SPEED, W25Q64_CS_PIN);
+#endif
 
     if (w25q64_self_check())
     {
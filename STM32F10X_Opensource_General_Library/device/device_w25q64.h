@@ -93,6 +93,7 @@
 void w25q64_sector_erase(uint32 addr);
 void w25q64_page_program(uint32 addr, const uint8 *buf, uint16 len);
 void w25q64_read_data(uint32 addr, uint8 *buf, uint32 len);
+uint8 w25q64_init(void);
 
 
 #endif
@@ -85,7 +85,7 @@ static uint8 get_parameter_index (uint8 num, char *str)
 
     if(NULL != temp)
     {
-        len = (uint8)((uint32)temp - (uint32)str + 1);
+        len = (uint8)(temp - str + 1);
     }
 
     for(i = 0; i < len; i ++)
@@ -413,6 +413,7 @@ uint8 gnss_data_parse (void)
     uint8 bbc_xor_calculation = 0;
     uint32 data_len = 0;
 
+    PROFILE_BEGIN(gnss_data_parse);
     do
     {
         if(GPS_STATE_RECEIVED == gnss_rmc_state)
@@ -478,6 +479,7 @@ uint8 gnss_data_parse (void)
         gnss_ths_state = GPS_STATE_RECEIVING;
         
     }while(0);
+    PROFILE_END(gnss_data_parse);
     return return_state;
 }
 
@@ -497,9 +499,30 @@ void gnss_uart_callback (void)
     if(gnss_state)
     {
         uint8 dat;
+        fifo_region_struct region;
+        uint32 write_length = 0;
+        fifo_state_enum reserve_state = fifo_write_reserve(&gnss_receiver_fifo, &region);   // ֱд FIFO пռ ʡȥֽ
+
+        if(FIFO_SUCCESS != reserve_state && FIFO_SPACE_NO_ENOUGH != reserve_state)
+        {
+            region.length[0] = 0;
+            region.length[1] = 0;
+        }
         while(uart_query_byte(GNSS_UART, &dat))
         {
-            fifo_write_buffer(&gnss_receiver_fifo, &dat, 1);
+            if(write_length < region.length[0])
+            {
+                ((uint8 *)region.buffer[0])[write_length ++] = dat;
+            }
+            else if(write_length < region.length[0] + region.length[1])
+            {
+                ((uint8 *)region.buffer[1])[write_length - region.length[0]] = dat;
+                write_length ++;
+            }
+        }
+        if(FIFO_SUCCESS == reserve_state || FIFO_SPACE_NO_ENOUGH == reserve_state)
+        {
+            fifo_write_commit(&gnss_receiver_fifo, write_length);
         }
         
         if('\n' == dat)
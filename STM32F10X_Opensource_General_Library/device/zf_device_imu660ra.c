@@ -70,11 +70,19 @@ float imu660ra_transition_factor[2] = {4096, 16.4};
 #if IMU660RA_USE_SOFT_IIC
 static soft_iic_info_struct imu660ra_iic_struct;
 
+#define imu660ra_bus_acquire()                    (0)
+#define imu660ra_bus_release()
+
 #define imu660ra_write_register(reg, data)        (soft_iic_write_8bit_register (&imu660ra_iic_struct, (reg), (data)))
 #define imu660ra_write_registers(reg, data, len)  (soft_iic_write_8bit_registers(&imu660ra_iic_struct, (reg), (data), (len)))
 #define imu660ra_read_register(reg)               (soft_iic_read_8bit_register  (&imu660ra_iic_struct, (reg)))
 #define imu660ra_read_registers(reg, data, len)   (soft_iic_read_8bit_registers (&imu660ra_iic_struct, (reg), (data), (len)))
 #else
+static spi_device_struct imu660ra_spi_device;
+
+#define imu660ra_bus_acquire()                    (spi_device_acquire(&imu660ra_spi_device))
+#define imu660ra_bus_release()                    (spi_device_release(&imu660ra_spi_device))
+
 //-------------------------------------------------------------------------------------------------------------------
 //      IMU660RA дĴ
 // ˵     reg             Ĵַ
@@ -179,10 +187,17 @@ void imu660ra_get_acc (void)
 {
     uint8 dat[6];
 
+    if(imu660ra_bus_acquire())                                                  // SPI ռ ϴ
+    {
+        return;
+    }
+    PROFILE_BEGIN(imu660ra_get_acc);
     imu660ra_read_registers(IMU660RA_ACC_ADDRESS, dat, 6);
+    imu660ra_bus_release();
     imu660ra_acc_x = (int16)(((uint16)dat[1] << 8 | dat[0]));
     imu660ra_acc_y = (int16)(((uint16)dat[3] << 8 | dat[2]));
     imu660ra_acc_z = (int16)(((uint16)dat[5] << 8 | dat[4]));
+    PROFILE_END(imu660ra_get_acc);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      ȡ IMU660RA 
@@ -196,7 +211,12 @@ void imu660ra_get_gyro (void)
 {
     uint8 dat[6];
 
+    if(imu660ra_bus_acquire())                                                  // SPI ռ ϴ
+    {
+        return;
+    }
     imu660ra_read_registers(IMU660RA_GYRO_ADDRESS, dat, 6);
+    imu660ra_bus_release();
     imu660ra_gyro_x = (int16)(((uint16)dat[1] << 8 | dat[0]));
     imu660ra_gyro_y = (int16)(((uint16)dat[3] << 8 | dat[2]));
     imu660ra_gyro_z = (int16)(((uint16)dat[5] << 8 | dat[4]));
@@ -221,9 +241,9 @@ uint8 imu660ra_init (void)
 
 #else
     spi_init(IMU660RA_SPI, SPI_MODE0, IMU660RA_SPI_SPEED, IMU660RA_SPC_PIN, IMU660RA_SDI_PIN, IMU660RA_SDO_PIN, SPI_CS_NULL);   //  IMU660RA  SPI ˿
-//    gpio_init(IMU660RA_CS_PIN, GPO, GPIO_HIGH, GPO_PUSH_PULL);                  //  IMU660RA CS˿
-    gpio_init(IMU660RA_CS_PIN, GPO_PUSH_PULL, 1);                  //  IMU660RA CS˿
-	imu660ra_read_register(IMU660RA_CHIP_ID);                                   // ȡһ豸ID 豸ΪSPIģʽ
+    spi_device_init(&imu660ra_spi_device, IMU660RA_SPI, SPI_MODE0, IMU660RA_SPI_SPEED, IMU660RA_CS_PIN);   //  IMU660RA CS˿
+    while(imu660ra_bus_acquire());                                              // ʼڼһֱռ
+    imu660ra_read_register(IMU660RA_CHIP_ID);                                   // ȡһ豸ID 豸ΪSPIģʽ
 #endif
     do{
         if(imu660ra_self_check())                                               // IMU660RA Լ
@@ -337,5 +357,6 @@ uint8 imu660ra_init (void)
             break;
         }
     }while(0);
+    imu660ra_bus_release();
     return return_state;
 }
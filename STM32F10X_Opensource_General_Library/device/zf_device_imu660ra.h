@@ -63,7 +63,7 @@
 
 #if IMU660RA_USE_SOFT_IIC                                                       //  ɫĲȷ ɫҵľûõ
 //==================================================== IIC ====================================================
-#define IMU660RA_SOFT_IIC_DELAY     (59)                                        //  IIC ʱʱ ֵԽС IIC ͨԽ
+#define IMU660RA_SOFT_IIC_DELAY     (SOFT_IIC_DELAY_400KHZ)                     //  IIC ʱʱ ֵԽС IIC ͨԽ Ĭ 400KHz
 #define IMU660RA_SCL_PIN            (PA0)                                    //  IIC SCL   IMU660RA  SCL 
 #define IMU660RA_SDA_PIN            (PA1)                                    //  IIC SDA   IMU660RA  SDA 
 //==================================================== IIC ====================================================
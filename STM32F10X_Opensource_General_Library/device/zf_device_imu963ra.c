@@ -68,6 +68,9 @@ float imu963ra_transition_factor[3] = {4098, 14.3, 3000};                  // ת
 #if IMU963RA_USE_SOFT_IIC
 static soft_iic_info_struct imu963ra_iic_struct;
 
+#define imu963ra_bus_acquire()                           (0)
+#define imu963ra_bus_release()
+
 //-------------------------------------------------------------------------------------------------------------------
 //      IMU963RA дĴ
 // ˵     reg             Ĵַ
@@ -98,6 +101,11 @@ static soft_iic_info_struct imu963ra_iic_struct;
 //-------------------------------------------------------------------------------------------------------------------
 #define imu963ra_read_acc_gyro_registers(reg,data,len)   (soft_iic_read_8bit_registers(&imu963ra_iic_struct,reg,data,len))
 #else
+static spi_device_struct imu963ra_spi_device;
+
+#define imu963ra_bus_acquire()                           (spi_device_acquire(&imu963ra_spi_device))
+#define imu963ra_bus_release()                           (spi_device_release(&imu963ra_spi_device))
+
 //-------------------------------------------------------------------------------------------------------------------
 //      IMU963RA дĴ
 // ˵     reg             Ĵַ
@@ -296,7 +304,12 @@ void imu963ra_get_acc (void)
 {
     uint8 dat[6];
 
+    if(imu963ra_bus_acquire())                                                  // SPI ռ ϴ
+    {
+        return;
+    }
     imu963ra_read_acc_gyro_registers(IMU963RA_OUTX_L_A, dat, 6);
+    imu963ra_bus_release();
     imu963ra_acc_x = (int16)(((uint16)dat[1]<<8 | dat[0]));
     imu963ra_acc_y = (int16)(((uint16)dat[3]<<8 | dat[2]));
     imu963ra_acc_z = (int16)(((uint16)dat[5]<<8 | dat[4]));
@@ -314,7 +327,12 @@ void imu963ra_get_gyro (void)
 {
     uint8 dat[6];
 
+    if(imu963ra_bus_acquire())                                                  // SPI ռ ϴ
+    {
+        return;
+    }
     imu963ra_read_acc_gyro_registers(IMU963RA_OUTX_L_G, dat, 6);
+    imu963ra_bus_release();
     imu963ra_gyro_x = (int16)(((uint16)dat[1]<<8 | dat[0]));
     imu963ra_gyro_y = (int16)(((uint16)dat[3]<<8 | dat[2]));
     imu963ra_gyro_z = (int16)(((uint16)dat[5]<<8 | dat[4]));
@@ -333,6 +351,10 @@ void imu963ra_get_mag (void)
     uint8 temp_status;
     uint8 dat[6];
 
+    if(imu963ra_bus_acquire())                                                  // SPI ռ ϴ
+    {
+        return;
+    }
     imu963ra_write_acc_gyro_register(IMU963RA_FUNC_CFG_ACCESS, 0x40);
     temp_status = imu963ra_read_acc_gyro_register(IMU963RA_STATUS_MASTER);
     if(0x01 & temp_status)
@@ -343,6 +365,7 @@ void imu963ra_get_mag (void)
         imu963ra_mag_z = (int16)(((uint16)dat[5]<<8 | dat[4]));
     }
     imu963ra_write_acc_gyro_register(IMU963RA_FUNC_CFG_ACCESS, 0x00);
+    imu963ra_bus_release();
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -361,9 +384,9 @@ uint8 imu963ra_init (void)
     soft_iic_init(&imu963ra_iic_struct, IMU963RA_DEV_ADDR, IMU963RA_SOFT_IIC_DELAY, IMU963RA_SCL_PIN, IMU963RA_SDA_PIN);
 #else
     spi_init(IMU963RA_SPI, SPI_MODE0, IMU963RA_SPI_SPEED, IMU963RA_SPC_PIN, IMU963RA_SDI_PIN, IMU963RA_SDO_PIN, SPI_CS_NULL);
-//    gpio_init(IMU963RA_CS_PIN, GPO, GPIO_LOW, GPO_PUSH_PULL);
-    gpio_init(IMU963RA_CS_PIN, GPO_PUSH_PULL, 0);
+    spi_device_init(&imu963ra_spi_device, IMU963RA_SPI, SPI_MODE0, IMU963RA_SPI_SPEED, IMU963RA_CS_PIN);
 #endif
+    while(imu963ra_bus_acquire());                                              // ʼڼһֱռ
 
     do
     {
@@ -526,5 +549,6 @@ uint8 imu963ra_init (void)
 
         system_delay_ms(20);                                                    // ȴƻȡ
     }while(0);
+    imu963ra_bus_release();
     return return_state;
 }
@@ -64,7 +64,7 @@
 #define IMU963RA_USE_SOFT_IIC                       (0)                         // ĬʹӲ SPI ʽ
 #if IMU963RA_USE_SOFT_IIC                                                       //  ɫĲȷ ɫҵľûõ
 //==================================================== IIC ====================================================
-#define IMU963RA_SOFT_IIC_DELAY                     (59)                       //  IIC ʱʱ ֵԽС IIC ͨԽ
+#define IMU963RA_SOFT_IIC_DELAY                     (SOFT_IIC_DELAY_400KHZ)    //  IIC ʱʱ ֵԽС IIC ͨԽ Ĭ 400KHz
 #define IMU963RA_SCL_PIN                            (PA0)                    //  IIC SCL   IMU963RA  SCL 
 #define IMU963RA_SDA_PIN                            (PA1)                    //  IIC SDA   IMU963RA  SDA 
 //==================================================== IIC ====================================================
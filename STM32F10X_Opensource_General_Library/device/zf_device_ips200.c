@@ -85,6 +85,7 @@ static gpio_pin_enum            ips_cs_pin          = IPS200_CS_PIN_SPI;
 
 #if IPS200_USE_SOFT_SPI
 static soft_spi_info_struct                 ips200_spi;
+SOFT_SPI_FAST_DEFINE(ips200_spi_fast, IPS200_SCL_PIN, IPS200_SDA_PIN, SOFT_SPI_PIN_NULL, 0, IPS200_SOFT_SPI_DELAY)
 //-------------------------------------------------------------------------------------------------------------------
 //      IPS200  SPI д 8bit 
 // ˵     data            
@@ -122,6 +123,16 @@ static soft_spi_info_struct                 ips200_spi;
 // עϢ     ڲ
 //-------------------------------------------------------------------------------------------------------------------
 #define ips200_write_16bit_data_spi_array(data, len)    (soft_spi_write_16bit_array(&ips200_spi, (data), (len)))
+
+//-------------------------------------------------------------------------------------------------------------------
+//      IPS200  SPI ظдͬһ 16bit 
+// ˵     data            
+// ˵     len             ظ
+// ز     void
+// ʹʾ     ips200_write_16bit_data_spi_repeat(RGB565_WHITE, 240 * 320);
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+#define ips200_write_16bit_data_spi_repeat(data, len)   (soft_spi_write_16bit_repeat(&ips200_spi, (data), (len)))
 #else
 //-------------------------------------------------------------------------------------------------------------------
 //      IPS200 SPI д 8bit 
@@ -159,6 +170,16 @@ static soft_spi_info_struct                 ips200_spi;
 // עϢ     ڲ
 //-------------------------------------------------------------------------------------------------------------------
 #define ips200_write_16bit_data_spi_array(data, len)    (spi_write_16bit_array(IPS200_SPI, (data), (len)))
+
+//-------------------------------------------------------------------------------------------------------------------
+//      IPS200 SPI ظдͬһ 16bit 
+// ˵     data            
+// ˵     len             ظ
+// ز     void
+// ʹʾ     ips200_write_16bit_data_spi_repeat(RGB565_WHITE, 240 * 320);
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+#define ips200_write_16bit_data_spi_repeat(data, len)   (spi_write_16bit_repeat(IPS200_SPI, (data), (len)))
 #endif
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -323,6 +344,36 @@ static void ips200_write_16bit_data_array (const uint16 *dat, uint32 len)
     }
 }
 //-------------------------------------------------------------------------------------------------------------------
+//      IPS200 ظдͬһ 16bit 
+// ˵     dat             
+// ˵     len             ظ
+// ز     void
+// ʹʾ     ips200_write_16bit_data_repeat(RGB565_WHITE, 240 * 320);
+// עϢ     ڲ û
+//-------------------------------------------------------------------------------------------------------------------
+static void ips200_write_16bit_data_repeat (const uint16 dat, uint32 len)
+{
+    if(IPS200_TYPE_SPI == ips200_display_type)
+    {
+        ips200_write_16bit_data_spi_repeat(dat, len);
+    }
+    else
+    {
+        IPS200_CS(0);
+        IPS200_RD(1);
+        while(len --)
+        {
+            IPS200_WR(0);
+            ips200_write_data((uint8)(dat >> 8));
+            IPS200_WR(1);
+            IPS200_WR(0);
+            ips200_write_data((uint8)(dat & 0xFF));
+            IPS200_WR(1);
+        }
+        IPS200_CS(1);
+    }
+}
+//-------------------------------------------------------------------------------------------------------------------
 //      ʾ
 // ˵     x1              ʼx
 // ˵     y1              ʼy
@@ -353,6 +404,30 @@ static void ips200_set_region (uint16 x1, uint16 y1, uint16 x2, uint16 y2)
     ips200_write_command(0x2c);
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//      IPS200 ͼ
+// ˵     *image          ͼ
+// ز     void
+// ʹʾ     ips200_write_image(&image_info);
+// עϢ     ڲ ǰƬѡúʾ
+//              Ӳ SPI ʱл DMA  תһ뷢һͬʱ
+//-------------------------------------------------------------------------------------------------------------------
+static void ips200_write_image (const lcd_image_struct *image)
+{
+#if IPS200_USE_SOFT_SPI
+    lcd_image_show(image, ips200_write_8bit_data_array);
+#else
+    if(IPS200_TYPE_SPI == ips200_display_type)
+    {
+        lcd_image_show_spi(image, IPS200_SPI);
+    }
+    else
+    {
+        lcd_image_show(image, ips200_write_8bit_data_array);
+    }
+#endif
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      IPS200 ʾDEBUGϢʼ
 // ˵     void
@@ -401,26 +476,7 @@ static void ips200_debug_init (void)
 //-------------------------------------------------------------------------------------------------------------------
 void ips200_clear (void)
 {
-    uint16 color_buffer[ips200_width_max];
-    uint16 i = 0, j = 0;
-
-    if(IPS200_TYPE_SPI == ips200_display_type)
-    {
-        IPS200_CS(0);
-    }
-    ips200_set_region(0, 0, ips200_width_max - 1, ips200_height_max - 1);
-    for(i = 0; i < ips200_width_max; i ++)
-    {
-        color_buffer[i] = ips200_bgcolor;
-    }
-    for (j = 0; j < ips200_height_max; j ++)
-    {
-        ips200_write_16bit_data_array(color_buffer, ips200_width_max);
-    }
-    if(IPS200_TYPE_SPI == ips200_display_type)
-    {
-        IPS200_CS(1);
-    }
+    ips200_fill_rect(0, 0, ips200_width_max, ips200_height_max, ips200_bgcolor);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -432,22 +488,39 @@ void ips200_clear (void)
 //-------------------------------------------------------------------------------------------------------------------
 void ips200_full (const uint16 color)
 {
-    uint16 color_buffer[ips200_width_max];
-    uint16 i = 0, j = 0;
+    ips200_fill_rect(0, 0, ips200_width_max, ips200_height_max, color);
+}
 
-    if(IPS200_TYPE_SPI == ips200_display_type)
-    {
-        IPS200_CS(0);
-    }
-    ips200_set_region(0, 0, ips200_width_max - 1, ips200_height_max - 1);
-    for(i = 0; i < ips200_width_max; i ++)
+//-------------------------------------------------------------------------------------------------------------------
+//      IPS200 
+// ˵     x               x Χ [0, ips200_width_max-1]
+// ˵     y               y Χ [0, ips200_height_max-1]
+// ˵     width           ο x + width  ips200_width_max
+// ˵     height          θ߶ y + height  ips200_height_max
+// ˵     color           ɫʽ RGB565 ߿ʹ zf_common_font.h  rgb565_color_enum öֵд
+// ز     void
+// ʹʾ     ips200_fill_rect(0, 0, 40, 20, RGB565_BLUE);
+// עϢ     ֻһʾ Ӳ SPI  DMA ʱԴַ 16bit DMA ͬһɫ
+//               65535  SPI Զֶ Ҫɫ
+//-------------------------------------------------------------------------------------------------------------------
+void ips200_fill_rect (uint16 x, uint16 y, uint16 width, uint16 height, const uint16 color)
+{
+    // ˶Ϣ ʾλ
+    // ôһĻʾʱ򳬹ĻֱʷΧ
+    zf_assert(x < ips200_width_max);
+    zf_assert(y < ips200_height_max);
+
+    if(0 == width || 0 == height)
     {
-        color_buffer[i] = color;
+        return;
     }
-    for (j = 0; j < ips200_height_max; j ++)
+
+    if(IPS200_TYPE_SPI == ips200_display_type)
     {
-        ips200_write_16bit_data_array(color_buffer, ips200_width_max);
+        IPS200_CS(0);
     }
+    ips200_set_region(x, y, x + width - 1, y + height - 1);
+    ips200_write_16bit_data_repeat(color, (uint32)width * height);
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(1);
@@ -616,77 +689,20 @@ void ips200_show_char (uint16 x, uint16 y, const char dat)
     zf_assert(x < ips200_width_max);
     zf_assert(y < ips200_height_max);
 
-    uint8 i = 0, j = 0;
+    if(IPS200_16X16_FONT == ips200_display_font)
+    {
+        return;                                                                 // ݲ֧
+    }
+
+    uint8 width = LCD_GLYPH_WIDTH(ips200_display_font);
+    uint8 height = LCD_GLYPH_HEIGHT(ips200_display_font);
 
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(0);
     }
-    switch(ips200_display_font)
-    {
-        case IPS200_6X8_FONT:
-        {
-            uint16 display_buffer[6*8];
-            ips200_set_region(x, y, x + 5, y + 7);
-            for(i = 0; 6 > i; i ++)
-            {
-                //  32 ΪȡģǴӿոʼȡ ո ascii  32
-                uint8 temp_top = ascii_font_6x8[dat - 32][i];
-                for(j = 0; 8 > j; j ++)
-                {
-                    if(temp_top & 0x01)
-                    {
-                        display_buffer[i + j * 6] = (ips200_pencolor);
-                    }
-                    else
-                    {
-                        display_buffer[i + j * 6] = (ips200_bgcolor);
-                    }
-                    temp_top >>= 1;
-                }
-            }
-            ips200_write_16bit_data_array(display_buffer, 6*8);
-        }break;
-        case IPS200_8X16_FONT:
-        {
-            uint16 display_buffer[8*16];
-            ips200_set_region(x, y, x + 7, y + 15);
-            for(i = 0; 8 > i; i ++)
-            {
-                uint8 temp_top = ascii_font_8x16[dat - 32][i];
-                uint8 temp_bottom = ascii_font_8x16[dat - 32][i + 8];
-                for(j = 0; 8 > j; j ++)
-                {
-                    if(temp_top & 0x01)
-                    {
-                        display_buffer[i + j * 8] = (ips200_pencolor);
-                    }
-                    else
-                    {
-                        display_buffer[i + j * 8] = (ips200_bgcolor);
-                    }
-                    temp_top >>= 1;
-                }
-                for(j = 0; 8 > j; j ++)
-                {
-                    if(temp_bottom & 0x01)
-                    {
-                        display_buffer[i + j * 8 + 4 * 16] = (ips200_pencolor);
-                    }
-                    else
-                    {
-                        display_buffer[i + j * 8 + 4 * 16] = (ips200_bgcolor);
-                    }
-                    temp_bottom >>= 1;
-                }
-            }
-            ips200_write_16bit_data_array(display_buffer, 8 * 16);
-        }break;
-        case IPS200_16X16_FONT:
-        {
-            // ݲ֧
-        }break;
-    }
+    ips200_set_region(x, y, x + width - 1, y + height - 1);
+    ips200_write_8bit_data_array(lcd_glyph_get(dat, ips200_display_font, ips200_pencolor, ips200_bgcolor), width * height * 2);
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(1);
@@ -700,7 +716,7 @@ void ips200_show_char (uint16 x, uint16 y, const char dat)
 // ˵     dat             Ҫʾַ
 // ز     void
 // ʹʾ     ips200_show_string(0, 0, "seekfree");
-// עϢ     
+// עϢ     ַƴӳһ鷢  LCD_GLYPH_RUN_BUFFER_SIZE Ĳֶַη
 //-------------------------------------------------------------------------------------------------------------------
 void ips200_show_string (uint16 x, uint16 y, const char dat[])
 {
@@ -708,17 +724,32 @@ void ips200_show_string (uint16 x, uint16 y, const char dat[])
     // ôһĻʾʱ򳬹ĻֱʷΧ
     zf_assert(x < ips200_width_max);
     zf_assert(y < ips200_height_max);
-    
-    uint16 j = 0;
-    while('\0' != dat[j])
+
+    if(IPS200_16X16_FONT == ips200_display_font)
     {
-        switch(ips200_display_font)
-        {
-            case IPS200_6X8_FONT:   ips200_show_char(x + 6 * j, y, dat[j]); break;
-            case IPS200_8X16_FONT:  ips200_show_char(x + 8 * j, y, dat[j]); break;
-            case IPS200_16X16_FONT: break;                                      // ݲ֧
-        }
-        j ++;
+        return;                                                                 // ݲ֧
+    }
+
+    uint8 width = LCD_GLYPH_WIDTH(ips200_display_font);
+    uint8 height = LCD_GLYPH_HEIGHT(ips200_display_font);
+    const uint8 *buffer = NULL;
+    uint16 count = 0;
+
+    if(IPS200_TYPE_SPI == ips200_display_type)
+    {
+        IPS200_CS(0);
+    }
+    while(0 != (count = lcd_glyph_compose(dat, ips200_display_font, ips200_pencolor, ips200_bgcolor, &buffer)))
+    {
+        // һַֻһʾ ƴõһη
+        ips200_set_region(x, y, x + width * count - 1, y + height - 1);
+        ips200_write_8bit_data_array(buffer, (uint32)width * height * count * 2);
+        x += width * count;
+        dat += count;
+    }
+    if(IPS200_TYPE_SPI == ips200_display_type)
+    {
+        IPS200_CS(1);
     }
 }
 
@@ -864,36 +895,14 @@ void ips200_show_binary_image (uint16 x, uint16 y, const uint8 *image, uint16 wi
     zf_assert(y < ips200_height_max);
     zf_assert(NULL != image);
 
-    uint32 i = 0, j = 0;
-    uint8 temp = 0;
-    uint32 width_index = 0;
-    uint16 data_buffer[dis_width];
-    const uint8 *image_temp;
+    lcd_image_struct image_info = {image, LCD_IMAGE_BINARY, width, height, dis_width, dis_height, 0};
 
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(0);
     }
     ips200_set_region(x, y, x + dis_width - 1, y + dis_height - 1);             // ʾ
-
-    for(j = 0; j < dis_height; j ++)
-    {
-        image_temp = image + j * height / dis_height * width / 8;               // ֱӶ image  Hardfault ʱ֪Ϊʲô
-        for(i = 0; i < dis_width; i ++)
-        {
-            width_index = i * width / dis_width;
-            temp = *(image_temp + width_index / 8);                             // ȡص
-            if(0x80 & (temp << (width_index % 8)))
-            {
-                data_buffer[i] = (RGB565_WHITE);
-            }
-            else
-            {
-                data_buffer[i] = (RGB565_BLACK);
-            }
-        }
-        ips200_write_16bit_data_array(data_buffer, dis_width);
-    }
+    ips200_write_image(&image_info);
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(1);
@@ -925,45 +934,20 @@ void ips200_show_gray_image (uint16 x, uint16 y, const uint8 *image, uint16 widt
     zf_assert(y < ips200_height_max);
     zf_assert(NULL != image);
 
-    uint32 i = 0, j = 0;
-    uint16 color = 0,temp = 0;
-    uint16 data_buffer[dis_width];
-    const uint8 *image_temp;
+    lcd_image_struct image_info = {image, LCD_IMAGE_GRAY, width, height, dis_width, dis_height, threshold};
 
+    PROFILE_BEGIN(ips200_show_gray_image);
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(0);
     }
     ips200_set_region(x, y, x + dis_width - 1, y + dis_height - 1);             // ʾ
-
-    for(j = 0; j < dis_height; j ++)
-    {
-        image_temp = image + j * height / dis_height * width;                   // ֱӶ image  Hardfault ʱ֪Ϊʲô
-        for(i = 0; i < dis_width; i ++)
-        {
-            temp = *(image_temp + i * width / dis_width);                       // ȡص
-            if(threshold == 0)
-            {
-                color = (0x001f & ((temp) >> 3)) << 11;
-                color = color | (((0x003f) & ((temp) >> 2)) << 5);
-                color = color | (0x001f & ((temp) >> 3));
-                data_buffer[i] = (color);
-            }
-            else if(temp < threshold)
-            {
-                data_buffer[i] = (RGB565_BLACK);
-            }
-            else
-            {
-                data_buffer[i] = (RGB565_WHITE);
-            }
-        }
-        ips200_write_16bit_data_array(data_buffer, dis_width);
-    }
+    ips200_write_image(&image_info);
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(1);
     }
+    PROFILE_END(ips200_show_gray_image);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -991,30 +975,60 @@ void ips200_show_rgb565_image (uint16 x, uint16 y, const uint16 *image, uint16 w
     zf_assert(y < ips200_height_max);
     zf_assert(NULL != image);
 
-    uint32 i = 0, j = 0;
-    uint16 data_buffer[dis_width];
-    const uint16 *image_temp;
+    lcd_image_struct image_info = {image, LCD_IMAGE_RGB565, width, height, dis_width, dis_height, color_mode};
 
     if(IPS200_TYPE_SPI == ips200_display_type)
     {
         IPS200_CS(0);
     }
     ips200_set_region(x, y, x + dis_width - 1, y + dis_height - 1);             // ʾ
+    ips200_write_image(&image_info);
+    if(IPS200_TYPE_SPI == ips200_display_type)
+    {
+        IPS200_CS(1);
+    }
+}
 
-    for(j = 0; j < dis_height; j ++)
+//-------------------------------------------------------------------------------------------------------------------
+//      IPS200 һδд
+// ˵     x               x Χ [0, ips200_width_max-1]
+// ˵     y               y Χ [0, ips200_height_max-1]
+// ˵     width           ڿ
+// ˵     height          ڸ߶
+// ˵     *data            ÿ 2 ֽ ֽǰ RGB565
+// ˵     stride          data еֽڼ  width * 2 ʾ
+// ز     void
+// ʹʾ     ips200_write_window(0, 0, 16, 16, buffer, 128 * 2);
+// עϢ     ֻһʾ ʱһη з
+//              ԭ lcd_canvas_window_handler һ ֱΪˢº
+//-------------------------------------------------------------------------------------------------------------------
+void ips200_write_window (uint16 x, uint16 y, uint16 width, uint16 height, const uint8 *data, uint32 stride)
+{
+    // ˶Ϣ ʾλ
+    // ôһĻʾʱ򳬹ĻֱʷΧ
+    zf_assert(x < ips200_width_max);
+    zf_assert(y < ips200_height_max);
+    zf_assert(0 < width && 0 < height);
+    zf_assert(NULL != data);
+
+    uint16 j = 0;
+
+    if(IPS200_TYPE_SPI == ips200_display_type)
     {
-        image_temp = image + j * height / dis_height * width;                   // ֱӶ image  Hardfault ʱ֪Ϊʲô
-        for(i = 0; i < dis_width; i ++)
-        {
-            data_buffer[i] = *(image_temp + i * width / dis_width);             // ȡص
-        }
-        if(color_mode)
-        {
-            ips200_write_8bit_data_array((uint8 *)data_buffer, dis_width * 2);
-        }
-        else
+        IPS200_CS(0);
+    }
+    ips200_set_region(x, y, x + width - 1, y + height - 1);
+
+    if((uint32)width * 2 == stride)
+    {
+        ips200_write_8bit_data_array(data, (uint32)width * height * 2);
+    }
+    else
+    {
+        for(j = 0; j < height; j ++)
         {
-            ips200_write_16bit_data_array(data_buffer, dis_width);
+            ips200_write_8bit_data_array(data, (uint32)width * 2);
+            data += stride;
         }
     }
     if(IPS200_TYPE_SPI == ips200_display_type)
@@ -1154,6 +1168,7 @@ void ips200_init (ips200_type_enum type_select)
         ips_cs_pin =  IPS200_CS_PIN_SPI;
 #if IPS200_USE_SOFT_SPI
         soft_spi_init(&ips200_spi, (uint8)0, (uint32)IPS200_SOFT_SPI_DELAY, (gpio_pin_enum)IPS200_SCL_PIN, (gpio_pin_enum)IPS200_SDA_PIN, (gpio_pin_enum)SOFT_SPI_PIN_NULL, (gpio_pin_enum)SOFT_SPI_PIN_NULL);
+        soft_spi_set_fast(&ips200_spi, ips200_spi_fast);
 #else
         spi_init(IPS200_SPI, SPI_MODE0, IPS200_SPI_SPEED, IPS200_SCL_PIN_SPI, IPS200_SDA_PIN_SPI, IPS200_SDA_IN_PIN_SPI, SPI_CS_NULL);
 #endif
@@ -171,6 +171,7 @@ extern  uint16  ips200_height_max;
 //================================================== IPS200 ================================================
 void    ips200_clear                    (void);                                                                                // IPS200 
 void    ips200_full                     (const uint16 color);                                                                  // IPS200 Ļ亯
+void    ips200_fill_rect                (uint16 x, uint16 y, uint16 width, uint16 height, const uint16 color);                 // IPS200 亯
 void    ips200_set_dir                  (ips200_dir_enum dir);                                                                 // IPS200 ʾ
 void    ips200_set_font                 (ips200_font_size_enum font);                                                          // IPS200 ʾ
 void    ips200_set_color                (const uint16 pen, const uint16 bgcolor);                                              // IPS200 ʾɫ
@@ -186,6 +187,7 @@ void    ips200_show_float               (uint16 x, uint16 y, const double dat, u
 void    ips200_show_binary_image        (uint16 x, uint16 y, const uint8 *image, uint16 width, uint16 height, uint16 dis_width, uint16 dis_height);                      // IPS200 ʾֵͼ ÿ˸һֽ
 void    ips200_show_gray_image          (uint16 x, uint16 y, const uint8 *image, uint16 width, uint16 height, uint16 dis_width, uint16 dis_height, uint8 threshold);     // IPS200 ʾ 8bit Ҷͼ ֵֵ
 void    ips200_show_rgb565_image        (uint16 x, uint16 y, const uint16 *image, uint16 width, uint16 height, uint16 dis_width, uint16 dis_height, uint8 color_mode);   // IPS200 ʾ RGB565 ɫͼ
+void    ips200_write_window             (uint16 x, uint16 y, uint16 width, uint16 height, const uint8 *data, uint32 stride);                                             // IPS200 δд RGB565 
 
 void    ips200_show_wave                (uint16 x, uint16 y, const uint16 *wave, uint16 width, uint16 value_max, uint16 dis_width, uint16 dis_value_max);                // IPS200 ʾ
 void    ips200_show_chinese             (uint16 x, uint16 y, uint8 size, const uint8 *chinese_buffer, uint8 number, const uint16 color);                                 // IPS200 ʾ
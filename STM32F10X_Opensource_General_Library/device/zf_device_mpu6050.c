@@ -68,7 +68,9 @@ static soft_iic_info_struct mpu6050_iic_struct;
 #define mpu6050_read_register(reg)              (soft_iic_read_8bit_register(&mpu6050_iic_struct, (reg)))
 #define mpu6050_read_registers(reg, data, len)  (soft_iic_read_8bit_registers(&mpu6050_iic_struct, (reg), (data), (len)))
 #else
-#error "ݲ֧ӲIICͨѶ"
+#define mpu6050_write_register(reg, data)       (iic_write_8bit_register(MPU6050_IIC, (reg), (data)))
+#define mpu6050_read_register(reg)              (iic_read_8bit_register(MPU6050_IIC, (reg)))
+#define mpu6050_read_registers(reg, data, len)  (iic_read_8bit_registers(MPU6050_IIC, (reg), (data), (len)))
 #endif
 
 //-------------------------------------------------------------------------------------------------------------------
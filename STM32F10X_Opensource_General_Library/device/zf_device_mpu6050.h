@@ -62,12 +62,17 @@
 #define MPU6050_USE_SOFT_IIC        (1)                                         // Ĭʹ IIC ʽ ʹ IIC ʽ
 #if MPU6050_USE_SOFT_IIC                                                        //  ɫĲȷ ɫҵľûõ
 //==================================================== IIC ====================================================
-#define MPU6050_SOFT_IIC_DELAY      (59 )                                       //  IIC ʱʱ ֵԽС IIC ͨԽ
+#define MPU6050_SOFT_IIC_DELAY      (SOFT_IIC_DELAY_400KHZ)                     //  IIC ʱʱ ֵԽС IIC ͨԽ Ĭ 400KHz
 #define MPU6050_SCL_PIN             (PA11)                                    //  IIC SCL   MPU6050  SCL 
 #define MPU6050_SDA_PIN             (PA14)                                    //  IIC SDA   MPU6050  SDA 
 //==================================================== IIC ====================================================
 #else
-#error "ݲ֧ӲIICͨѶ"
+//====================================================Ӳ IIC ====================================================
+#define MPU6050_IIC_SPEED           (400)                                       // Ӳ IIC ͨ λ KHz  400KHz
+#define MPU6050_IIC                 (IIC_1)                                     // Ӳ IIC 
+#define MPU6050_SCL_PIN             (IIC1_SCL_PB6)                              // Ӳ IIC SCL   MPU6050  SCL 
+#define MPU6050_SDA_PIN             (IIC1_SDA_PB7)                              // Ӳ IIC SDA   MPU6050  SDA 
+//====================================================Ӳ IIC ====================================================
 #endif
 
 #define MPU6050_TIMEOUT_COUNT       (0x00FF)                                    // MPU6050 ʱ
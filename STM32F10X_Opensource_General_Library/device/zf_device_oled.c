@@ -57,26 +57,22 @@
 
 #if OLED_USE_SOFT_SPI
 static soft_spi_info_struct             oled_spi;
+SOFT_SPI_FAST_DEFINE(oled_spi_fast, OLED_D0_PIN, OLED_D1_PIN, SOFT_SPI_PIN_NULL, 0, OLED_SOFT_SPI_DELAY)
 #define oled_spi_write_8bit(data)       (soft_spi_write_8bit(&oled_spi, (data)))
+#define oled_spi_write_8bit_array(data, len)    (soft_spi_write_8bit_array(&oled_spi, (data), (len)))
 #else
 #define oled_spi_write_8bit(data)       (spi_write_8bit(OLED_SPI, (data)))
+#define oled_spi_write_8bit_array(data, len)    (spi_write_8bit_array(OLED_SPI, (data), (len)))
 #endif
 
 static oled_dir_enum        oled_display_dir    = OLED_DEFAULT_DISPLAY_DIR;     // ʾ
 static oled_font_size_enum  oled_display_font   = OLED_DEFAULT_DISPLAY_FONT;    // ʾ
 
-//-------------------------------------------------------------------------------------------------------------------
-//      д8λ
-// ˵     data            
-// ز     void
-// ʹʾ     oled_write_data(color);
-// עϢ     ڲ û
-//-------------------------------------------------------------------------------------------------------------------
-static void oled_write_data (const uint8 data)
-{
-    OLED_DC(1);
-    oled_spi_write_8bit(data);
-}
+#if OLED_USE_FRAME_BUFFER
+static uint8                oled_frame_buffer[OLED_PAGE_MAX][OLED_X_MAX];       // Դ滺 ĻԴͬҳ
+static uint8                oled_dirty_start[OLED_PAGE_MAX];                    // ÿҳ͵зΧ [start, end) start >= end ʾҳûб仯
+static uint8                oled_dirty_end[OLED_PAGE_MAX];
+#endif
 
 //-------------------------------------------------------------------------------------------------------------------
 //      д
@@ -112,6 +108,85 @@ static void oled_set_coordinate (uint8 x, uint8 y)
     oled_write_command((x & 0x0f) | 0x00);
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//      Ļһҳд
+// ˵     x               ʼ 0-127
+// ˵     page            ҳ 0-7
+// ˵     *data            ÿֽΪһ 8 
+// ˵     length          ֽ
+// ز     void
+// ʹʾ     oled_send_page(0, 0, data, 128);
+// עϢ     ڲʹû һƬѡ鷢 Ӳ SPI  DMA ʱ DMA 
+//-------------------------------------------------------------------------------------------------------------------
+static void oled_send_page (uint16 x, uint16 page, const uint8 *data, uint16 length)
+{
+    OLED_CS(0);
+    oled_set_coordinate((uint8)x, (uint8)page);
+    OLED_DC(1);
+    oled_spi_write_8bit_array(data, length);
+    OLED_CS(1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      дһҳʾ
+// ˵     x               ʼ 0-127
+// ˵     page            ҳ 0-7
+// ˵     *data            ÿֽΪһ 8 
+// ˵     length          ֽ Ļұ߽Ĳֶ
+// ز     void
+// ʹʾ     oled_write_page(x, y, page_buffer, dis_width);
+// עϢ     ڲʹû ʾ
+//               OLED_USE_FRAME_BUFFER ʱֻдԴ滺 ıвҳͷΧ
+//-------------------------------------------------------------------------------------------------------------------
+static void oled_write_page (uint16 x, uint16 page, const uint8 *data, uint16 length)
+{
+    // ˶Ϣ ʾλ
+    // ôһĻʾʱ򳬹ĻֱʷΧ
+    // һʾõĺ ԼһﳬĻʾΧ
+    zf_assert(OLED_X_MAX > x);
+    zf_assert(OLED_PAGE_MAX > page);
+
+    if(OLED_X_MAX - x < length)
+    {
+        length = OLED_X_MAX - x;
+    }
+#if OLED_USE_FRAME_BUFFER
+    uint8 *buffer = &oled_frame_buffer[page][x];
+    uint16 first = length, last = 0, i = 0;
+
+    for(i = 0; i < length; i ++)
+    {
+        if(buffer[i] != data[i])
+        {
+            buffer[i] = data[i];
+            if(first == length)
+            {
+                first = i;
+            }
+            last = i + 1;
+        }
+    }
+    if(last)
+    {
+        if(oled_dirty_start[page] >= oled_dirty_end[page])
+        {
+            oled_dirty_start[page] = (uint8)(x + first);
+            oled_dirty_end[page] = (uint8)(x + last);
+        }
+        else
+        {
+            oled_dirty_start[page] = (uint8)((oled_dirty_start[page] < x + first) ? oled_dirty_start[page] : (x + first));
+            oled_dirty_end[page] = (uint8)((oled_dirty_end[page] > x + last) ? oled_dirty_end[page] : (x + last));
+        }
+    }
+#else
+    if(length)
+    {
+        oled_send_page(x, page, data, length);
+    }
+#endif
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      OLEDʾDEBUGϢʼ
 // ˵     void
@@ -160,20 +235,7 @@ static void oled_debug_init (void)
 //-------------------------------------------------------------------------------------------------------------------
 void oled_clear (void)
 {
-    uint8 y = 0, x = 0;
-
-    OLED_CS(0);
-    for(y = 0; 8 > y; y ++)
-    {
-        oled_write_command(0xb0 + y);
-        oled_write_command(0x01);
-        oled_write_command(0x10);
-        for(x = 0; OLED_X_MAX > x; x ++)
-        {
-            oled_write_data(0x00);
-        }
-    }
-    OLED_CS(1);
+    oled_full(0x00);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -185,20 +247,14 @@ void oled_clear (void)
 //-------------------------------------------------------------------------------------------------------------------
 void oled_full (const uint8 color)
 {
-    uint8 y = 0, x = 0;
+    uint8 page_buffer[OLED_X_MAX];
+    uint8 y = 0;
 
-    OLED_CS(0);
-    for(y = 0; 8 > y; y ++)
+    memset(page_buffer, color, OLED_X_MAX);
+    for(y = 0; OLED_PAGE_MAX > y; y ++)
     {
-        oled_write_command(0xb0 + y);
-        oled_write_command(0x01);
-        oled_write_command(0x10);
-        for(x = 0; OLED_X_MAX > x; x ++)
-        {
-            oled_write_data(color);
-        }
+        oled_write_page(0, y, page_buffer, OLED_X_MAX);
     }
-    OLED_CS(1);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -242,14 +298,33 @@ void oled_draw_point (uint16 x, uint16 y, const uint8 color)
     zf_assert(x < 128);
     zf_assert(y < 8);
 
-    OLED_CS(0);
-    oled_set_coordinate((uint8)x, (uint8)y);
-    oled_write_command(0xb0 + y);
-    oled_write_command(((x & 0xf0) >> 4) | 0x10);
-    oled_write_command((x & 0x0f) | 0x00);
-    oled_write_data(color);
-    OLED_CS(1);
+    oled_write_page(x, y, &color, 1);
+}
+
+#if OLED_USE_FRAME_BUFFER
+//-------------------------------------------------------------------------------------------------------------------
+//      ص
+// ˵     x               x  0-127
+// ˵     y               y  0-63
+// ˵     color           1- 0-Ϩ
+// ز     void
+// ʹʾ     oled_draw_pixel(64, 32, 1);
+// עϢ     ֻڿ OLED_USE_FRAME_BUFFER ʱ Դ滺ȡֻֽһλ Ӱͬ 7 
+//-------------------------------------------------------------------------------------------------------------------
+void oled_draw_pixel (uint16 x, uint16 y, const uint8 color)
+{
+    // ˶Ϣ ʾλ
+    // ôһĻʾʱ򳬹ĻֱʷΧ
+    // һʾõĺ ԼһﳬĻʾΧ
+    zf_assert(OLED_X_MAX > x);
+    zf_assert(OLED_Y_MAX > y);
+
+    uint8 dat = oled_frame_buffer[y / 8][x];
+
+    dat = color ? (uint8)(dat | (0x01 << (y % 8))) : (uint8)(dat & ~(0x01 << (y % 8)));
+    oled_write_page(x, y / 8, &dat, 1);
 }
+#endif
 
 //-------------------------------------------------------------------------------------------------------------------
 //      OLED ʾַ
@@ -258,7 +333,7 @@ void oled_draw_point (uint16 x, uint16 y, const uint8 color)
 // ˵     ch[]            ַ
 // ز     void
 // ʹʾ     oled_show_string(0, 0, "SEEKFREE");
-// עϢ
+// עϢ     8x16 ڵ 7 ҳʱֻʾϰ벿 г 7 ҳַʾ
 //-------------------------------------------------------------------------------------------------------------------
 void oled_show_string (uint16 x, uint16 y, const char ch[])
 {
@@ -268,57 +343,53 @@ void oled_show_string (uint16 x, uint16 y, const char ch[])
     zf_assert(128 > x);
     zf_assert(8 > y);
 
-    OLED_CS(0);
+    uint8 line_buffer[2][OLED_X_MAX];                                           // һ 8x16 ҳ
+    uint8 font_width = 0, font_page = 0, wrap = 0;
     uint8 c = 0, i = 0, j = 0;
+    uint16 start = x;
+
+    switch(oled_display_font)
+    {
+        case OLED_6X8_FONT:     font_width = 6; font_page = 1; wrap = 126;  break;
+        case OLED_8X16_FONT:    font_width = 8; font_page = 2; wrap = 120;  break;
+        case OLED_16X16_FONT:   return;                                         // ݲ֧
+    }
     while ('\0' != ch[j])
     {
-        switch(oled_display_font)
+        if(x > wrap)                                                            // ǰƴõһҳд
         {
-            case OLED_6X8_FONT:
+            for(i = 0; font_page > i && OLED_PAGE_MAX > y + i; i ++)
             {
-                c = ch[j] - 32;
-                if(x > 126)
-                {
-                    x = 0;
-                    y ++;
-                }
-                oled_set_coordinate((uint8)x, (uint8)y);
-                for(i = 0; 6 > i; i ++)
-                {
-                    oled_write_data(ascii_font_6x8[c][i]);
-                }
-                x += 6;
-                j ++;
-            }break;
-            case OLED_8X16_FONT:
+                oled_write_page(start, y + i, line_buffer[i], x - start);
+            }
+            x = 0;
+            y ++;
+            start = 0;
+            if(OLED_PAGE_MAX <= y)                                              // ѳĻײ
             {
-                c = ch[j] - 32;
-                if(x > 120)
-                {
-                    x = 0;
-                    y ++;
-                }
-                oled_set_coordinate((uint8)x, (uint8)y);
-                for(i = 0; 8 > i; i ++)
-                {
-                    oled_write_data(ascii_font_8x16[c][i]);
-                }
-
-                oled_set_coordinate((uint8)x, (uint8)(y + 1));
-                for(i = 0; 8 > i; i ++)
-                {
-                    oled_write_data(ascii_font_8x16[c][i + 8]);
-                }
-                x += 8;
-                j ++;
-            }break;
-            case OLED_16X16_FONT:
+                return;
+            }
+        }
+        c = ch[j] - 32;
+        for(i = 0; font_width > i && OLED_X_MAX > x + i; i ++)
+        {
+            if(OLED_6X8_FONT == oled_display_font)
             {
-                // ݲ֧
-            }break;
+                line_buffer[0][x - start + i] = ascii_font_6x8[c][i];
+            }
+            else
+            {
+                line_buffer[0][x - start + i] = ascii_font_8x16[c][i];
+                line_buffer[1][x - start + i] = ascii_font_8x16[c][i + 8];
+            }
         }
+        x += font_width;
+        j ++;
+    }
+    for(i = 0; font_page > i && OLED_PAGE_MAX > y + i && start < x; i ++)
+    {
+        oled_write_page(start, y + i, line_buffer[i], x - start);
     }
-    OLED_CS(1);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -468,18 +539,18 @@ void oled_show_binary_image (uint16 x, uint16 y, const uint8 *image, uint16 widt
     // һʾõĺ ԼһﳬĻʾΧ
     zf_assert(128 > x);
     zf_assert(8 > y);
+    zf_assert(128 >= dis_width);
     zf_assert(NULL != image);
 
+    uint8 page_buffer[OLED_X_MAX];
     uint32 i = 0, j = 0, z = 0;
     uint8 dat = 0;
     uint32 width_index = 0, height_index = 0;
 
-    OLED_CS(0);
     dis_height = dis_height - dis_height % 8;
     dis_width = dis_width - dis_width % 8;
     for(j = 0; j < dis_height; j += 8)
     {
-        oled_set_coordinate(x + 0, (uint16)(y + j / 8));
         height_index = j * height / dis_height;
         for(i = 0; i < dis_width; i += 8)
         {
@@ -519,11 +590,11 @@ void oled_show_binary_image (uint16 x, uint16 y, const uint8 *image, uint16 widt
                 {
                     dat |= 0x80;
                 }
-                oled_write_data(dat);
+                page_buffer[i + z] = dat;
             }
         }
+        oled_write_page(x, (uint16)(y + j / 8), page_buffer, (uint16)dis_width);
     }
-    OLED_CS(1);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -539,6 +610,7 @@ void oled_show_binary_image (uint16 x, uint16 y, const uint8 *image, uint16 widt
 // ز     void
 // ʹʾ     oled_show_gray_image(0, 0, mt9v03x_image[0], width, height, 128, 64, x);
 // עϢ     ʾͼ
+//              Ԥ ÿҳƴúһη Ӳ SPI  DMA ʱ DMA 
 //              Ҫʾֵͼ ֱ޸һΪҪĶֵֵ
 //              Ҫʾֵͼ ֱ޸һΪҪĶֵֵ
 //              Ҫʾֵͼ ֱ޸һΪҪĶֵֵ
@@ -550,58 +622,35 @@ void oled_show_gray_image (uint16 x, uint16 y, const uint8 *image, uint16 width,
     // һʾõĺ ԼһﳬĻʾΧ
     zf_assert(128 > x);
     zf_assert(8 > y);
+    zf_assert(128 >= dis_width);
     zf_assert(NULL != image);
 
-    int16 i = 0, j = 0;
-    uint8 dat = 0;
-    uint32 width_index = 0, height_index = 0;
+    const uint16_t *column = lcd_image_column_table(width, dis_width);
+    const uint8 *row[8];
+    uint8 page_buffer[128];
+    uint16 i = 0, j = 0, k = 0;
 
-    OLED_CS(0);
     dis_height = dis_height - dis_height % 8;
     for(j = 0; j < dis_height; j += 8)
     {
-        oled_set_coordinate(x + 0, y + j / 8);
-        height_index = j * height / dis_height;
+        for(k = 0; 8 > k; k ++)
+        {
+            row[k] = image + (uint32)(j + k) * height / dis_height * width;    // һҳ 8 и԰ȡԭͼ
+        }
         for(i = 0; i < dis_width; i ++)
         {
-            width_index = i * width / dis_width;
-            dat = 0;
-            if(*(image + height_index * width + width_index + width * 0) > threshold)
-            {
-                dat |= 0x01;
-            }
-            if(*(image + height_index * width + width_index + width * 1) > threshold)
-            {
-                dat |= 0x02;
-            }
-            if(*(image + height_index * width + width_index + width * 2) > threshold)
-            {
-                dat |= 0x04;
-            }
-            if(*(image + height_index * width + width_index + width * 3) > threshold)
-            {
-                dat |= 0x08;
-            }
-            if(*(image + height_index * width + width_index + width * 4) > threshold)
-            {
-                dat |= 0x10;
-            }
-            if(*(image + height_index * width + width_index + width * 5) > threshold)
+            uint8 dat = 0;
+            for(k = 0; 8 > k; k ++)
             {
-                dat |= 0x20;
-            }
-            if(*(image + height_index * width + width_index + width * 6) > threshold)
-            {
-                dat |= 0x40;
-            }
-            if(*(image + height_index * width + width_index + width * 7) > threshold)
-            {
-                dat |= 0x80;
+                if(row[k][column[i]] > threshold)
+                {
+                    dat |= (0x01 << k);
+                }
             }
-            oled_write_data(dat);
+            page_buffer[i] = dat;
         }
+        oled_write_page(x, y + j / 8, page_buffer, dis_width);                  // һҳд
     }
-    OLED_CS(1);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -624,35 +673,29 @@ void oled_show_wave (uint16 x, uint16 y, const uint16 *wave, uint16 width, uint1
     // һʾõĺ ԼһﳬĻʾΧ
     zf_assert(128 > x);
     zf_assert(8 > y);
+    zf_assert(128 >= dis_width);
     zf_assert(NULL != wave);
 
+    uint8 point[OLED_X_MAX];                                                    // ÿвε
+    uint8 page_buffer[OLED_X_MAX];
     uint32 i = 0;
     uint32 width_index = 0, value_max_index = 0;
-    uint8 dis_h = 0;
-
-    uint32 x_temp = 0;
     uint32 y_temp = 0;
 
-    OLED_CS(0);
-    for(y_temp = 0; y_temp < dis_value_max; y_temp += 8)
-    {
-        oled_set_coordinate(x + 0, (uint16)(y + y_temp / 8));
-        for(x_temp = 0; x_temp < dis_width; x_temp ++)
-        {
-            oled_write_data(0x00); 
-        }
-    }
     for(i = 0; i < dis_width; i ++)
     {
         width_index = i * width / dis_width;
         value_max_index = *(wave + width_index) * (dis_value_max - 1) / value_max;
-
-        dis_h = (uint8)((dis_value_max - 1) - value_max_index);
-        oled_set_coordinate((uint16)(i + x), dis_h / 8 + y);
-        dis_h = (0x01 << dis_h % 8);
-        oled_write_data(dis_h);
+        point[i] = (uint8)((dis_value_max - 1) - value_max_index);
+    }
+    for(y_temp = 0; y_temp < dis_value_max; y_temp += 8)                        // ҳʾ򲢻ڱҳĵ
+    {
+        for(i = 0; i < dis_width; i ++)
+        {
+            page_buffer[i] = (point[i] / 8 == y_temp / 8) ? (uint8)(0x01 << (point[i] % 8)) : 0x00;
+        }
+        oled_write_page(x, (uint16)(y + y_temp / 8), page_buffer, dis_width);
     }
-    OLED_CS(1);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -675,22 +718,45 @@ void oled_show_chinese (uint16 x, uint16 y, uint8 size, const uint8 *chinese_buf
     zf_assert(8 > y);
     zf_assert(NULL != chinese_buffer);
 
-    int16 i = 0, j = 0, k = 0;
+    int16 i = 0, j = 0;
 
-    OLED_CS(0);
     for(i = 0; i < number; i ++)
     {
         for(j = 0; j < (size / 8); j ++)
         {
-            oled_set_coordinate(x + i * size, y + j);
-            for(k = 0; 16 > k; k ++)
-            {
-                oled_write_data(*chinese_buffer);
-                chinese_buffer ++;
-            }
+            oled_write_page(x + i * size, y + j, chinese_buffer, 16);
+            chinese_buffer += 16;
         }
     }
-    OLED_CS(1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Դ滺б仯Ĳַ͵Ļ
+// ˵     void
+// ز     uint8           η͵ҳ 0-ûб仯
+// ʹʾ     oled_flush();
+// עϢ      OLED_USE_FRAME_BUFFER ʱ ʾֻдԴ滺 ҪԵñŻʾĻ
+//              ÿҳֻһ Ӹҳһıеһı Ӳ SPI  DMA ʱ DMA 
+//              δʱʾֱд ʲôҲ  0
+//-------------------------------------------------------------------------------------------------------------------
+uint8 oled_flush (void)
+{
+    uint8 count = 0;
+#if OLED_USE_FRAME_BUFFER
+    uint8 y = 0;
+
+    for(y = 0; OLED_PAGE_MAX > y; y ++)
+    {
+        if(oled_dirty_start[y] < oled_dirty_end[y])
+        {
+            oled_send_page(oled_dirty_start[y], y, &oled_frame_buffer[y][oled_dirty_start[y]], oled_dirty_end[y] - oled_dirty_start[y]);
+            oled_dirty_start[y] = OLED_X_MAX;
+            oled_dirty_end[y] = 0;
+            count ++;
+        }
+    }
+#endif
+    return count;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -704,6 +770,7 @@ void oled_init (void)
 {
 #if OLED_USE_SOFT_SPI
 	soft_spi_init(&oled_spi, (uint8)0, (uint32)OLED_SOFT_SPI_DELAY, (gpio_pin_enum)OLED_D0_PIN, (gpio_pin_enum)OLED_D1_PIN, (gpio_pin_enum)SOFT_SPI_PIN_NULL, (gpio_pin_enum)SOFT_SPI_PIN_NULL);
+	soft_spi_set_fast(&oled_spi, oled_spi_fast);
 #else
     spi_init(OLED_SPI, SPI_MODE0, OLED_SPI_SPEED, OLED_D0_PIN, OLED_D1_PIN, OLED_D1_PIN_IN, SPI_CS_NULL);
 #endif
@@ -760,7 +827,14 @@ void oled_init (void)
     oled_write_command(0xaf);                                                   // oled
     OLED_CS(1);
 
+#if OLED_USE_FRAME_BUFFER
+    memset(oled_frame_buffer, 0, sizeof(oled_frame_buffer));                    // ϵĻԴݲȷ Ϊͺ
+    memset(oled_dirty_start, 0, sizeof(oled_dirty_start));
+    memset(oled_dirty_end, OLED_X_MAX, sizeof(oled_dirty_end));
+    oled_flush();
+#else
     oled_clear();                                                               // ʼ
+#endif
     oled_set_coordinate(0, 0);                                                  // OLEDʾ
     oled_debug_init();                                                          // OLEDʾDEBUGϢʼ
 }
@@ -79,6 +79,12 @@
 #define OLED_DEFAULT_DISPLAY_FONT       (OLED_6X8_FONT )                        // Ĭϵģʽ
 #define OLED_X_MAX                      (128)                                   // ĻXֵ
 #define OLED_Y_MAX                      (64 )                                   // ĻYֵ
+#define OLED_PAGE_MAX                   (OLED_Y_MAX / 8)                        // Ļҳ ÿҳ 8 
+
+// 1-ʹ 1KB Դ滺 ʾֻд RAM  oled_flush ʱŰѱ仯Ĳַ͵Ļ 0-ʾֱд
+#ifndef OLED_USE_FRAME_BUFFER
+#define OLED_USE_FRAME_BUFFER           (0 )
+#endif
 
 #define OLED_RES(x)                     ((x) ? (gpio_high(OLED_RES_PIN)) : (gpio_low(OLED_RES_PIN)))
 #define OLED_DC(x)                      ((x) ? (gpio_high(OLED_DC_PIN))  : (gpio_low(OLED_DC_PIN)))
@@ -108,6 +114,9 @@ void    oled_full                       (const uint8 color);
 void    oled_set_dir                    (oled_dir_enum dir);                                                // OLED ʾ
 void    oled_set_font                   (oled_font_size_enum font);                                         // OLED ʾ
 void    oled_draw_point                 (uint16 x, uint16 y, const uint8 color);                            // OLED 㺯
+#if OLED_USE_FRAME_BUFFER
+void    oled_draw_pixel                 (uint16 x, uint16 y, const uint8 color);                            // OLED ص ҪԴ滺
+#endif
 
 void    oled_show_string                (uint16 x, uint16 y, const char ch[]);                              // OLED ʾַ
 void    oled_show_int                   (uint16 x, uint16 y, const int32 dat, uint8 num);                   // OLED ʾ32λз (ȥЧ0)
@@ -119,6 +128,7 @@ void    oled_show_gray_image            (uint16 x, uint16 y, const uint8 *image,
 
 void    oled_show_wave                  (uint16 x, uint16 y, const uint16 *image, uint16 width, uint16 value_max, uint16 dis_width, uint16 dis_value_max);              // OLED ʾ
 void    oled_show_chinese               (uint16 x, uint16 y, uint8 size, const uint8 *chinese_buffer, uint8 number);                                                    // OLED ʾ
+uint8   oled_flush                      (void);                                                             // OLED Դ滺б仯Ĳ
 void    oled_init                       (void);                                                             // OLED ʼ
 //=================================================== OLED =================================================
 
@@ -67,6 +67,7 @@ static 	tft180_font_size_enum    tft180_display_font = TFT180_DEFAULT_DISPLAY_FO
 
 #if TFT180_USE_SOFT_SPI
 static soft_spi_info_struct             tft180_spi;
+SOFT_SPI_FAST_DEFINE(tft180_spi_fast, TFT180_SCL_PIN, TFT180_SDA_PIN, SOFT_SPI_PIN_NULL, 0, TFT180_SOFT_SPI_DELAY)
 //-------------------------------------------------------------------------------------------------------------------
 //      TFT180  SPI д 8bit 
 // ˵     data            
@@ -104,6 +105,16 @@ static soft_spi_info_struct             tft180_spi;
 // עϢ     ڲ
 //-------------------------------------------------------------------------------------------------------------------
 #define tft180_write_16bit_data_array(data, len)    (soft_spi_write_16bit_array(&tft180_spi, (data), (len)))
+
+//-------------------------------------------------------------------------------------------------------------------
+//      TFT180  SPI ظдͬһ 16bit 
+// ˵     data            
+// ˵     len             ظ
+// ز     void
+// ʹʾ     tft180_write_16bit_data_repeat(RGB565_WHITE, 128 * 160);
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+#define tft180_write_16bit_data_repeat(data, len)   (soft_spi_write_16bit_repeat(&tft180_spi, (data), (len)))
 #else
 //-------------------------------------------------------------------------------------------------------------------
 //      TFT180 SPI д 8bit 
@@ -142,6 +153,16 @@ static soft_spi_info_struct             tft180_spi;
 // עϢ     ڲ
 //-------------------------------------------------------------------------------------------------------------------
 #define tft180_write_16bit_data_array(data, len)    (spi_write_16bit_array(TFT180_SPI, (data), (len)))
+
+//-------------------------------------------------------------------------------------------------------------------
+//      TFT180 SPI ظдͬһ 16bit 
+// ˵     data            
+// ˵     len             ظ
+// ز     void
+// ʹʾ     tft180_write_16bit_data_repeat(RGB565_WHITE, 128 * 160);
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+#define tft180_write_16bit_data_repeat(data, len)   (spi_write_16bit_repeat(TFT180_SPI, (data), (len)))
 #endif
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -214,6 +235,38 @@ static void tft180_set_region (uint16 x1, uint16 y1, uint16 x2, uint16 y2)
     tft180_write_index(0x2c);
 }
 
+#if TFT180_USE_SOFT_SPI
+//-------------------------------------------------------------------------------------------------------------------
+//      TFT180 дһͼ
+// ˵     *data           
+// ˵     len             ݳ
+// ز     void
+// ʹʾ     tft180_write_image_line(data, len);
+// עϢ     ڲ Ϊ lcd_image_show д뺯
+//-------------------------------------------------------------------------------------------------------------------
+static void tft180_write_image_line (const uint8 *data, uint32 len)
+{
+    tft180_write_8bit_data_array(data, len);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//      TFT180 ͼ
+// ˵     *image          ͼ
+// ز     void
+// ʹʾ     tft180_write_image(&image_info);
+// עϢ     ڲ ǰƬѡúʾ
+//              Ӳ SPI ʱл DMA  תһ뷢һͬʱ
+//-------------------------------------------------------------------------------------------------------------------
+static void tft180_write_image (const lcd_image_struct *image)
+{
+#if TFT180_USE_SOFT_SPI
+    lcd_image_show(image, tft180_write_image_line);
+#else
+    lcd_image_show_spi(image, TFT180_SPI);
+#endif
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      TFT180 ʾDEBUGϢʼ
 // ˵     void
@@ -262,20 +315,7 @@ static void tft180_debug_init (void)
 //-------------------------------------------------------------------------------------------------------------------
 void tft180_clear (void)
 {
-    uint16 color_buffer[tft180_width_max];
-    uint16 i = 0, j = 0;
-
-    TFT180_CS(0);
-    tft180_set_region(0, 0, tft180_width_max - 1, tft180_height_max - 1);
-    for(i = 0; i < tft180_width_max; i ++)
-    {
-        color_buffer[i] = tft180_bgcolor;
-    }
-    for (j = 0; j < tft180_height_max; j ++)
-    {
-        tft180_write_16bit_data_array(color_buffer, tft180_width_max);
-    }
-    TFT180_CS(1);
+    tft180_fill_rect(0, 0, tft180_width_max, tft180_height_max, tft180_bgcolor);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -287,19 +327,36 @@ void tft180_clear (void)
 //-------------------------------------------------------------------------------------------------------------------
 void tft180_full (const uint16 color)
 {
-    uint16 color_buffer[tft180_width_max];
-    uint16 i = 0, j = 0;
+    tft180_fill_rect(0, 0, tft180_width_max, tft180_height_max, color);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      TFT180 
+// ˵     x               x Χ [0, tft180_width_max-1]
+// ˵     y               y Χ [0, tft180_height_max-1]
+// ˵     width           ο x + width  tft180_width_max
+// ˵     height          θ߶ y + height  tft180_height_max
+// ˵     color           ɫʽ RGB565 ߿ʹ zf_common_font.h  rgb565_color_enum öֵд
+// ز     void
+// ʹʾ     tft180_fill_rect(0, 0, 40, 20, RGB565_BLUE);
+// עϢ     ֻһʾ Ӳ SPI  DMA ʱԴַ 16bit DMA ͬһɫ
+//               65535  SPI Զֶ Ҫɫ
+//-------------------------------------------------------------------------------------------------------------------
+void tft180_fill_rect (uint16 x, uint16 y, uint16 width, uint16 height, const uint16 color)
+{
+    // ˶Ϣ ʾλ
+    // ôһĻʾʱ򳬹ĻֱʷΧ
+    zf_assert(x < tft180_width_max);
+    zf_assert(y < tft180_height_max);
 
-    TFT180_CS(0);
-    tft180_set_region(0, 0, tft180_width_max - 1, tft180_height_max - 1);
-    for(i = 0; i < tft180_width_max; i ++)
+    if(0 == width || 0 == height)
     {
-        color_buffer[i] = color;
-    }
-    for (j = 0; j < tft180_height_max; j ++)
-    {
-        tft180_write_16bit_data_array(color_buffer, tft180_width_max);
+        return;
     }
+
+    TFT180_CS(0);
+    tft180_set_region(x, y, x + width - 1, y + height - 1);
+    tft180_write_16bit_data_repeat(color, (uint32)width * height);
     TFT180_CS(1);
 }
 
@@ -460,74 +517,17 @@ void tft180_show_char (uint16 x, uint16 y, const char dat)
     zf_assert(x < tft180_width_max);
     zf_assert(y < tft180_height_max);
 
-    uint8 i = 0, j = 0;
-
-    TFT180_CS(0);
-    switch(tft180_display_font)
+    if(TFT180_16X16_FONT == tft180_display_font)
     {
-        case TFT180_6X8_FONT:
-        {
-            uint16 display_buffer[6*8];
-            tft180_set_region(x, y, x + 5, y + 7);
-            for(i = 0; 6 > i; i ++)
-            {
-                //  32 ΪȡģǴӿոʼȡ ո ascii  32
-                uint8 temp_top = ascii_font_6x8[dat - 32][i];
-                for(j = 0; 8 > j; j ++)
-                {
-                    if(temp_top & 0x01)
-                    {
-                        display_buffer[i + j * 6] = (tft180_pencolor);
-                    }
-                    else
-                    {
-                        display_buffer[i + j * 6] = (tft180_bgcolor);
-                    }
-                    temp_top >>= 1;
-                }
-            }
-            tft180_write_16bit_data_array(display_buffer, 6*8);
-        }break;
-        case TFT180_8X16_FONT:
-        {
-            uint16 display_buffer[8*16];
-            tft180_set_region(x, y, x + 7, y + 15);
-            for(i = 0; 8 > i; i ++)
-            {
-                uint8 temp_top = ascii_font_8x16[dat - 32][i];
-                uint8 temp_bottom = ascii_font_8x16[dat - 32][i + 8];
-                for(j = 0; 8 > j; j ++)
-                {
-                    if(temp_top & 0x01)
-                    {
-                        display_buffer[i + j * 8] = (tft180_pencolor);
-                    }
-                    else
-                    {
-                        display_buffer[i + j * 8] = (tft180_bgcolor);
-                    }
-                    temp_top >>= 1;
-                }
-                for(j = 0; 8 > j; j ++)
-                {
-                    if(temp_bottom & 0x01)
-                    {
-                        display_buffer[i + j * 8 + 4 * 16] = (tft180_pencolor);
-                    }
-                    else
-                    {
-                        display_buffer[i + j * 8 + 4 * 16] = (tft180_bgcolor);
-                    }
-                    temp_bottom >>= 1;
-                }
-            }
-            tft180_write_16bit_data_array(display_buffer, 8 * 16);
-        }break;
-        case TFT180_16X16_FONT:
-        {
-            // ݲ֧
-        }break;
+        return;                                                                 // ݲ֧
     }
+
+    uint8 width = LCD_GLYPH_WIDTH(tft180_display_font);
+    uint8 height = LCD_GLYPH_HEIGHT(tft180_display_font);
+
+    TFT180_CS(0);
+    tft180_set_region(x, y, x + width - 1, y + height - 1);
+    tft180_write_8bit_data_array(lcd_glyph_get(dat, tft180_display_font, tft180_pencolor, tft180_bgcolor), width * height * 2);
     TFT180_CS(1);
 }
 
@@ -538,7 +538,7 @@ void tft180_show_char (uint16 x, uint16 y, const char dat)
 // ˵     dat             Ҫʾַ
 // ز     void
 // ʹʾ     tft180_show_string(0, 0, "seekfree");
-// עϢ
+// עϢ     ַƴӳһ鷢  LCD_GLYPH_RUN_BUFFER_SIZE Ĳֶַη
 //-------------------------------------------------------------------------------------------------------------------
 void tft180_show_string (uint16 x, uint16 y, const char dat[])
 {
@@ -546,18 +546,27 @@ void tft180_show_string (uint16 x, uint16 y, const char dat[])
     // ôһĻʾʱ򳬹ĻֱʷΧ
     zf_assert(x < tft180_width_max);
     zf_assert(y < tft180_height_max);
-    
-    uint16 j = 0;
-    while('\0' != dat[j])
+
+    if(TFT180_16X16_FONT == tft180_display_font)
     {
-        switch(tft180_display_font)
-        {
-            case TFT180_6X8_FONT:   tft180_show_char(x + 6 * j, y, dat[j]); break;
-            case TFT180_8X16_FONT:  tft180_show_char(x + 8 * j, y, dat[j]); break;
-            case TFT180_16X16_FONT: break;                                      // ݲ֧
-        }
-        j ++;
+        return;                                                                 // ݲ֧
     }
+
+    uint8 width = LCD_GLYPH_WIDTH(tft180_display_font);
+    uint8 height = LCD_GLYPH_HEIGHT(tft180_display_font);
+    const uint8 *buffer = NULL;
+    uint16 count = 0;
+
+    TFT180_CS(0);
+    while(0 != (count = lcd_glyph_compose(dat, tft180_display_font, tft180_pencolor, tft180_bgcolor, &buffer)))
+    {
+        // һַֻһʾ ƴõһη
+        tft180_set_region(x, y, x + width * count - 1, y + height - 1);
+        tft180_write_8bit_data_array(buffer, (uint32)width * height * count * 2);
+        x += width * count;
+        dat += count;
+    }
+    TFT180_CS(1);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -702,33 +711,11 @@ void tft180_show_binary_image (uint16 x, uint16 y, const uint8 *image, uint16 wi
     zf_assert(y < tft180_height_max);
     zf_assert(NULL != image);
 
-    uint32 i = 0, j = 0;
-    uint8 temp = 0;
-    uint32 width_index = 0;
-    uint16 data_buffer[dis_width];
-    const uint8 *image_temp;
+    lcd_image_struct image_info = {image, LCD_IMAGE_BINARY, width, height, dis_width, dis_height, 0};
 
     TFT180_CS(0);
     tft180_set_region(x, y, x + dis_width - 1, y + dis_height - 1);             // ʾ
-
-    for(j = 0; j < dis_height; j ++)
-    {
-        image_temp = image + j * height / dis_height * width / 8;               // ֱӶ image  Hardfault ʱ֪Ϊʲô
-        for(i = 0; i < dis_width; i ++)
-        {
-            width_index = i * width / dis_width;
-            temp = *(image_temp + width_index / 8);                             // ȡص
-            if(0x80 & (temp << (width_index % 8)))
-            {
-                data_buffer[i] = (RGB565_WHITE);
-            }
-            else
-            {
-                data_buffer[i] = (RGB565_BLACK);
-            }
-        }
-        tft180_write_16bit_data_array(data_buffer, dis_width);
-    }
+    tft180_write_image(&image_info);
     TFT180_CS(1);
 }
 
@@ -757,38 +744,11 @@ void tft180_show_gray_image (uint16 x, uint16 y, const uint8 *image, uint16 widt
     zf_assert(y < tft180_height_max);
     zf_assert(NULL != image);
 
-    uint32 i = 0, j = 0;
-    uint16 color = 0,temp = 0;
-    uint16 data_buffer[dis_width];
-    const uint8 *image_temp;
+    lcd_image_struct image_info = {image, LCD_IMAGE_GRAY, width, height, dis_width, dis_height, threshold};
 
     TFT180_CS(0);
     tft180_set_region(x, y, x + dis_width - 1, y + dis_height - 1);             // ʾ
-
-    for(j = 0; j < dis_height; j ++)
-    {
-        image_temp = image + j * height / dis_height * width;                   // ֱӶ image  Hardfault ʱ֪Ϊʲô
-        for(i = 0; i < dis_width; i ++)
-        {
-            temp = *(image_temp + i * width / dis_width);               // ȡص
-            if(threshold == 0)
-            {
-                color = (0x001f & ((temp) >> 3)) << 11;
-                color = color | (((0x003f) & ((temp) >> 2)) << 5);
-                color = color | (0x001f & ((temp) >> 3));
-                data_buffer[i] = (color);
-            }
-            else if(temp < threshold)
-            {
-                data_buffer[i] = (RGB565_BLACK);
-            }
-            else
-            {
-                data_buffer[i] = (RGB565_WHITE);
-            }
-        }
-        tft180_write_16bit_data_array(data_buffer, dis_width);
-    }
+    tft180_write_image(&image_info);
     TFT180_CS(1);
 }
 
@@ -817,27 +777,51 @@ void tft180_show_rgb565_image (uint16 x, uint16 y, const uint16 *image, uint16 w
     zf_assert(y < tft180_height_max);
     zf_assert(NULL != image);
 
-    uint32 i = 0, j = 0;
-    uint16 data_buffer[dis_width];
-    const uint16 *image_temp;
+    lcd_image_struct image_info = {image, LCD_IMAGE_RGB565, width, height, dis_width, dis_height, color_mode};
 
     TFT180_CS(0);
     tft180_set_region(x, y, x + dis_width - 1, y + dis_height - 1);             // ʾ
+    tft180_write_image(&image_info);
+    TFT180_CS(1);
+}
 
-    for(j = 0; j < dis_height; j ++)
+//-------------------------------------------------------------------------------------------------------------------
+//      TFT180 һδд
+// ˵     x               x Χ [0, tft180_width_max-1]
+// ˵     y               y Χ [0, tft180_height_max-1]
+// ˵     width           ڿ
+// ˵     height          ڸ߶
+// ˵     *data            ÿ 2 ֽ ֽǰ RGB565
+// ˵     stride          data еֽڼ  width * 2 ʾ
+// ز     void
+// ʹʾ     tft180_write_window(0, 0, 16, 16, buffer, 128 * 2);
+// עϢ     ֻһʾ ʱһη з
+//              ԭ lcd_canvas_window_handler һ ֱΪˢº
+//-------------------------------------------------------------------------------------------------------------------
+void tft180_write_window (uint16 x, uint16 y, uint16 width, uint16 height, const uint8 *data, uint32 stride)
+{
+    // ˶Ϣ ʾλ
+    // ôһĻʾʱ򳬹ĻֱʷΧ
+    zf_assert(x < tft180_width_max);
+    zf_assert(y < tft180_height_max);
+    zf_assert(0 < width && 0 < height);
+    zf_assert(NULL != data);
+
+    uint16 j = 0;
+
+    TFT180_CS(0);
+    tft180_set_region(x, y, x + width - 1, y + height - 1);
+
+    if((uint32)width * 2 == stride)
     {
-        image_temp = image + j * height / dis_height * width;                   // ֱӶ image  Hardfault ʱ֪Ϊʲô
-        for(i = 0; i < dis_width; i ++)
-        {
-            data_buffer[i] = *(image_temp + i * width / dis_width); // ȡص
-        }
-        if(color_mode)
-        {
-            tft180_write_8bit_data_array((uint8 *)data_buffer, dis_width * 2);
-        }
-        else
+        tft180_write_8bit_data_array(data, (uint32)width * height * 2);
+    }
+    else
+    {
+        for(j = 0; j < height; j ++)
         {
-            tft180_write_16bit_data_array(data_buffer, dis_width);
+            tft180_write_8bit_data_array(data, (uint32)width * 2);
+            data += stride;
         }
     }
     TFT180_CS(1);
@@ -956,6 +940,7 @@ void tft180_init (void)
 {
 #if TFT180_USE_SOFT_SPI
     soft_spi_init(&tft180_spi, (uint8)0, (uint32)TFT180_SOFT_SPI_DELAY, (gpio_pin_enum)TFT180_SCL_PIN, (gpio_pin_enum)TFT180_SDA_PIN, (gpio_pin_enum)SOFT_SPI_PIN_NULL, (gpio_pin_enum)SOFT_SPI_PIN_NULL);
+    soft_spi_set_fast(&tft180_spi, tft180_spi_fast);
 #else
     spi_init(TFT180_SPI, SPI_MODE0, TFT180_SPI_SPEED, TFT180_SCL_PIN, TFT180_SDA_PIN, TFT180_SDA_PIN_IN, SPI_CS_NULL);
 #endif
@@ -113,6 +113,7 @@ extern  uint16  tft180_height_max;
 //================================================= TFT180 ================================================
 void    tft180_clear                    (void);                                                                               // TFT180 
 void    tft180_full                     (const uint16 color);                                                                 // TFT180 Ļ亯
+void    tft180_fill_rect                (uint16 x, uint16 y, uint16 width, uint16 height, const uint16 color);                // TFT180 亯
 void    tft180_set_dir                  (tft180_dir_enum dir);                                                                // TFT180 ʾ
 void    tft180_set_font                 (tft180_font_size_enum font);                                                         // TFT180 ʾ
 void    tft180_set_color                (const uint16 pen, const  uint16 bgcolor);                                            // TFT180 ʾɫ
@@ -128,6 +129,7 @@ void    tft180_show_float               (uint16 x, uint16 y, const double dat, u
 void    tft180_show_binary_image        (uint16 x, uint16 y, const uint8 *image, uint16 width, uint16 height, uint16 dis_width, uint16 dis_height);                    // TFT180 ʾֵͼ ÿ˸һֽ
 void    tft180_show_gray_image          (uint16 x, uint16 y, const uint8 *image, uint16 width, uint16 height, uint16 dis_width, uint16 dis_height, uint8 threshold);   // TFT180 ʾ 8bit Ҷͼ ֵֵ
 void    tft180_show_rgb565_image        (uint16 x, uint16 y, const uint16 *image, uint16 width, uint16 height, uint16 dis_width, uint16 dis_height, uint8 color_mode); // TFT180 ʾ RGB565 ɫͼ
+void    tft180_write_window             (uint16 x, uint16 y, uint16 width, uint16 height, const uint8 *data, uint32 stride);                                           // TFT180 δд RGB565 
 
 void    tft180_show_wave                (uint16 x, uint16 y, const uint16 *wave, uint16 width, uint16 value_max, uint16 dis_width, uint16 dis_value_max);              // TFT180 ʾ
 void    tft180_show_chinese             (uint16 x, uint16 y, uint8 size, const uint8 *chinese_buffer, uint8 number, const uint16 color);                               // TFT180 ʾ
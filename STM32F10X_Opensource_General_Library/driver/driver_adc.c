@@ -139,6 +139,7 @@ RCC_ADCCLKConfig(RCC_PCLK2_Div6);   // 
     ADC_DMACmd(ADC1, ENABLE);    /* ʹ ADC1  DMA  */
 		
     /* 3. DMA ʼ */
+    zf_assert(dma1_claim(dma1_CH1, DMA_OWNER_ADC1));                      // ͨ 1 ѱռ
     dma1_init(dma1_CH1,(uint32)&ADC1->DR,(uint32)adc_dma_buf,DMA_HalfWord,ADC_NUMBER,DMA_Priority_High, DMA_DIR_PeripheralSRC);
     DMA1_Channel1->CCR |= (1 << 5);   /* CIRC = 1ѭģʽ */
     dma1_enable(dma1_CH1);
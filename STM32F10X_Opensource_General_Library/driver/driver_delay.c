@@ -34,12 +34,16 @@ void system_delay_init(void)
 //-------------------------------------------------------------------------------------------------------------------
 void system_delay_us(uint32_t xus)
 {
-    uint32_t tick0 = SysTick->VAL;
+    uint32_t load  = SysTick->LOAD + 1;
+    uint32_t last  = SysTick->VAL;
     uint32_t ticks = xus * 72;                 /* 72 MHz */
-    uint32_t delta;
-    do{
-        delta = (tick0 - SysTick->VAL) & 0xFFFFFFUL; /* 24 bit ¼ */
-    }while(delta < ticks);
+    uint32_t elapsed = 0;
+    uint32_t now;
+    while(elapsed < ticks){
+        now = SysTick->VAL;                    /* ¼ ÿ load ʱװһ */
+        elapsed += (last >= now) ? (last - now) : (last + load - now);
+        last = now;
+    }
 }
 //-------------------------------------------------------------------------------------------------------------------
 //        system  ʱ
@@ -23,6 +23,38 @@ static DMA_Channel_TypeDef* const DMA1_ChannelTable[] = {
 		DMA1_Channel6,
 		DMA1_Channel7
 };
+
+/* ͨжϻص ͬһͨ踴 жϷͳһַ */
+static dma_irq_callback g_dma1_irq_callback[7];
+static void            *g_dma1_irq_arg[7];
+
+/* ͨǰʹ ʼ׶εǼ */
+static dma_owner_enum   g_dma1_owner[7];
+static const char *const g_dma1_owner_name[] =
+{
+    "NONE", "ADC1", "UART1_TX", "UART1_RX", "UART2_TX", "UART2_RX", "UART3_TX", "UART3_RX",
+    "SPI1_TX", "SPI1_RX", "SPI2_TX", "SPI2_RX", "IIC1_RX", "IIC2_RX", "MEMORY", "USER"
+};
+
+/* 洢洢 queue[tail] Ϊڴһ head/tail  */
+typedef struct
+{
+    uint8               *dst;
+    const uint8         *src;                                       /* ʱʹ */
+    uint32              len;                                        /* ʣֽ */
+    uint32              fill;                                       /* ֵ ʱظ 32 λ */
+    uint8               elem;                                       /* Ԫֽ 0 ʾ */
+    dma_copy_callback   callback;
+    void                *arg;
+}dma_copy_job_struct;
+
+static dma_copy_job_struct  g_dma_copy_queue[DMA_COPY_QUEUE_SIZE];
+static volatile uint32      g_dma_copy_head;
+static volatile uint32      g_dma_copy_tail;
+static volatile uint8       g_dma_copy_busy;                        /* ڴ queue[tail] */
+static uint32               g_dma_copy_chunk;                       /* ǰһεֽ */
+static dma_channel_enum     g_dma_copy_channel = DMA1_CH_NONE;
+
 //-------------------------------------------------------------------------------------------------------------------
 //       dma1ʼ					洢洢
 // ˵      dma1_ch             ѡDMA1ͨ
@@ -82,7 +114,7 @@ void dma1_disable(dma_channel_enum dma1_ch)
     if(dma1_ch > dma1_CH7) return;
     DMA_Cmd(DMA1_ChannelTable[dma1_ch], DISABLE);
     /* һжϱ־ֹԺ󿪴жʱ IRQ */
-    DMA_ClearITPendingBit(DMA1_IT_GL1 << dma1_ch);
+    DMA_ClearITPendingBit(DMA1_IT_GL1 << (dma1_ch * 4));
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      dma1 ʹ
@@ -153,3 +185,347 @@ void dma_wait_done(DMA_Channel_TypeDef* ch)
     while(ch->CNDTR);
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//       ע DMA1 ͨжϻص
+// ˵      dma1_ch             ѡDMA1ͨ
+// ˵      callback            жϻص NULL ʾȡע
+// ˵      arg                 ص
+// ز      void
+// ʹʾ      dma1_irq_register(dma1_CH4, spi_dma_irq_handler, &bus);
+// עϢ      صжִ жȡͨжϱ־
+//               δעصͨжʱȫ־ ֹж
+//-------------------------------------------------------------------------------------------------------------------
+void dma1_irq_register(dma_channel_enum dma1_ch, dma_irq_callback callback, void *arg)
+{
+    if (dma1_ch > dma1_CH7) return;
+    g_dma1_irq_callback[dma1_ch] = NULL;                    /* ص жõ»صɲ */
+    g_dma1_irq_arg[dma1_ch]      = arg;
+    g_dma1_irq_callback[dma1_ch] = callback;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       Ǽռ DMA1 ͨ
+// ˵      dma1_ch             ѡDMA1ͨ
+// ˵      owner               ʹ
+// ز      uint8               1-ռóɹ owner ռ 0-ѱʹռ
+// ʹʾ      if(!dma1_claim(dma1_CH5, DMA_OWNER_IIC2_RX)) { /* жϽ */ }
+// עϢ      ͻʱ zf_log  "DMA1 CHx ԭʹ / ʹ" ԭʹֲ߱
+//               ͬһʹظʼʱٴεǼǲͻ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 dma1_claim(dma_channel_enum dma1_ch, dma_owner_enum owner)
+{
+    static char message[32];
+    uint8 result = 1;
+
+    if (dma1_ch > dma1_CH7 || owner == DMA_OWNER_NONE) return 0;
+
+    {
+        CRIT_ENTER();
+        if (g_dma1_owner[dma1_ch] == DMA_OWNER_NONE) g_dma1_owner[dma1_ch] = owner;
+        else if (g_dma1_owner[dma1_ch] != owner) result = 0;
+        CRIT_EXIT();
+    }
+
+    if (!result)
+    {
+        char *p = message;
+        const char *name;
+        for (name = "DMA1 CH"; *name; ) *p++ = *name++;
+        *p++ = '1' + dma1_ch;
+        *p++ = ' ';
+        for (name = g_dma1_owner_name[g_dma1_owner[dma1_ch]]; *name; ) *p++ = *name++;
+        *p++ = ' '; *p++ = '/'; *p++ = ' ';
+        for (name = g_dma1_owner_name[owner]; *name; ) *p++ = *name++;
+        *p = '\0';
+        zf_log(0, message);
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       һе DMA1 ͨ
+// ˵      owner               ʹ һΪ DMA_OWNER_MEMORY
+// ز      dma_channel_enum    ֵͨ DMA1_CH_NONE ʾȫռ
+// ʹʾ      dma_channel_enum ch = dma1_alloc(DMA_OWNER_MEMORY);
+// עϢ      ͨ 7 ² Ӧڱʼ Ǽʱᱨͻ
+//-------------------------------------------------------------------------------------------------------------------
+dma_channel_enum dma1_alloc(dma_owner_enum owner)
+{
+    dma_channel_enum result = DMA1_CH_NONE;
+
+    if (owner == DMA_OWNER_NONE) return DMA1_CH_NONE;
+
+    {
+        CRIT_ENTER();
+        for (int8 ch = dma1_CH7; ch >= dma1_CH1; ch --)
+        {
+            if (g_dma1_owner[ch] == DMA_OWNER_NONE)
+            {
+                g_dma1_owner[ch] = owner;
+                result = (dma_channel_enum)ch;
+                break;
+            }
+        }
+        CRIT_EXIT();
+    }
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ͷ DMA1 ͨ
+// ˵      dma1_ch             ѡDMA1ͨ
+// ˵      owner               ʹ Ǽʱһ²ͷ
+// ز      void
+// ʹʾ      dma1_release(ch, DMA_OWNER_MEMORY);
+// עϢ      ͬʱȡͨжϻص ĶͨĴ ǰйرͨ
+//-------------------------------------------------------------------------------------------------------------------
+void dma1_release(dma_channel_enum dma1_ch, dma_owner_enum owner)
+{
+    if (dma1_ch > dma1_CH7 || g_dma1_owner[dma1_ch] != owner) return;
+    dma1_irq_register(dma1_ch, NULL, NULL);
+    g_dma1_owner[dma1_ch] = DMA_OWNER_NONE;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯ DMA1 ͨʹ
+// ˵      dma1_ch             ѡDMA1ͨ
+// ز      dma_owner_enum      DMA_OWNER_NONE ʾ
+// ʹʾ      if(dma1_get_owner(dma1_CH4) == DMA_OWNER_UART1_TX) ...
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+dma_owner_enum dma1_get_owner(dma_channel_enum dma1_ch)
+{
+    if (dma1_ch > dma1_CH7) return DMA_OWNER_NONE;
+    return g_dma1_owner[dma1_ch];
+}
+
+/*  CPU ɿ DMA ʱҲʣಿ */
+static void dma_copy_cpu(const dma_copy_job_struct *job)
+{
+    if (job->elem == 0)
+    {
+        memcpy(job->dst, job->src, job->len);
+    }
+    else
+    {
+        uint16 *p = (uint16 *)job->dst;
+        for (uint32 n = job->len / sizeof(uint16); n; n --) *p++ = (uint16)job->fill;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       װصǰһβ
+// ˵      *job                ǰ
+// ز      void
+// ʹʾ      dma_copy_chunk(job);
+// עϢ      ڲ ǰжͨѹر ַʣ೤ȵĶѡ//ֽڿ
+//-------------------------------------------------------------------------------------------------------------------
+static void dma_copy_chunk(dma_copy_job_struct *job)
+{
+    DMA_Channel_TypeDef *ch = DMA1_ChannelTable[g_dma_copy_channel];
+    uint32 align = (uint32)job->dst | (job->elem ? 0 : (uint32)job->src);
+    uint32 width, size, count;
+
+    if (!(align & 3) && job->len >= 4)          { width = 4; size = DMA_CCR1_PSIZE_1 | DMA_CCR1_MSIZE_1; }
+    else if (!(align & 1) && job->len >= 2)     { width = 2; size = DMA_CCR1_PSIZE_0 | DMA_CCR1_MSIZE_0; }
+    else                                        { width = 1; size = 0; }
+
+    count = job->len / width;
+    if (count > 0xFFFF) count = 0xFFFF;
+    g_dma_copy_chunk = count * width;
+
+    DMA1->IFCR = DMA_IFCR_CGIF1 << (g_dma_copy_channel * 4);
+    ch->CPAR  = job->elem ? (uint32)&job->fill : (uint32)job->src;     /* ʱȡе fill */
+    ch->CMAR  = (uint32)job->dst;
+    ch->CNDTR = count;
+    ch->CCR   = DMA_CCR1_MEM2MEM | size | DMA_CCR1_MINC | (job->elem ? 0 : DMA_CCR1_PINC) | DMA_CCR1_TEIE | DMA_CCR1_TCIE | DMA_CCR1_EN;
+}
+
+/* еһ ǰжͨ */
+static void dma_copy_start(void)
+{
+    if (g_dma_copy_head == g_dma_copy_tail) return;
+    g_dma_copy_busy = 1;
+    dma_copy_chunk(&g_dma_copy_queue[g_dma_copy_tail & (DMA_COPY_QUEUE_SIZE - 1)]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ǰһδ װһλɱοص
+// ˵      void
+// ز      void
+// ʹʾ      dma_copy_complete();
+// עϢ      ڲ  DMA жϻȴ TC/TE δλʱκβ
+//               ʱʣಿָ CPU  صڿж״ִ̬ صٴύ
+//-------------------------------------------------------------------------------------------------------------------
+static void dma_copy_complete(void)
+{
+    dma_copy_callback callback;
+    void *arg;
+
+    {
+        CRIT_ENTER();
+        uint32 shift = g_dma_copy_channel * 4;
+        uint32 isr = DMA1->ISR;
+        if (!g_dma_copy_busy || !(isr & ((DMA_ISR_TCIF1 | DMA_ISR_TEIF1) << shift)))
+        {
+            CRIT_EXIT();
+            return;
+        }
+        dma_copy_job_struct *job = &g_dma_copy_queue[g_dma_copy_tail & (DMA_COPY_QUEUE_SIZE - 1)];
+        DMA1->IFCR = DMA_IFCR_CGIF1 << shift;
+        DMA1_ChannelTable[g_dma_copy_channel]->CCR = 0;
+        if (isr & (DMA_ISR_TEIF1 << shift))
+        {
+            dma_copy_cpu(job);
+            job->len = 0;
+        }
+        else
+        {
+            job->dst += g_dma_copy_chunk;
+            if (job->elem == 0) job->src += g_dma_copy_chunk;
+            job->len -= g_dma_copy_chunk;
+        }
+        if (job->len)
+        {
+            dma_copy_chunk(job);
+            CRIT_EXIT();
+            return;
+        }
+        callback = job->callback;
+        arg = job->arg;
+        g_dma_copy_tail ++;
+        g_dma_copy_busy = 0;
+        CRIT_EXIT();
+    }
+
+    if (callback != NULL) callback(arg);
+
+    {
+        CRIT_ENTER();
+        if (!g_dma_copy_busy) dma_copy_start();                     /* صѾύ */
+        CRIT_EXIT();
+    }
+}
+
+static void dma_copy_irq_handler(void *arg)
+{
+    (void)arg;
+    dma_copy_complete();
+}
+
+/* ȡÿõͨ ״ʹûͨͷź· ûпͨʱ 0 */
+static uint8 dma_copy_channel_get(void)
+{
+    NVIC_InitTypeDef nv;
+
+    if (g_dma_copy_channel != DMA1_CH_NONE && dma1_get_owner(g_dma_copy_channel) == DMA_OWNER_MEMORY) return 1;
+    g_dma_copy_channel = dma1_alloc(DMA_OWNER_MEMORY);
+    if (g_dma_copy_channel == DMA1_CH_NONE) return 0;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    DMA1_ChannelTable[g_dma_copy_channel]->CCR = 0;
+    dma1_irq_register(g_dma_copy_channel, dma_copy_irq_handler, NULL);
+    nv.NVIC_IRQChannel                   = DMA1_Channel1_IRQn + g_dma_copy_channel;
+    nv.NVIC_IRQChannelPreemptionPriority = DMA_COPY_NVIC_PREEMPT_PRIORITY;
+    nv.NVIC_IRQChannelSubPriority        = 0;
+    nv.NVIC_IRQChannelCmd                = ENABLE;
+    NVIC_Init(&nv);
+    return 1;
+}
+
+/* 뿽 ΪյСûͨʱ CPU  */
+static uint8 dma_copy_submit(const dma_copy_job_struct *job)
+{
+    if (g_dma_copy_head == g_dma_copy_tail && (job->len < DMA_COPY_CPU_THRESHOLD || !dma_copy_channel_get()))
+    {
+        dma_copy_cpu(job);
+        if (job->callback != NULL) job->callback(job->arg);
+        return 0;
+    }
+    while (g_dma_copy_head - g_dma_copy_tail >= DMA_COPY_QUEUE_SIZE) dma_copy_complete();   /* ʱƽڳλ */
+
+    {
+        CRIT_ENTER();
+        g_dma_copy_queue[g_dma_copy_head & (DMA_COPY_QUEUE_SIZE - 1)] = *job;
+        g_dma_copy_head ++;
+        if (!g_dma_copy_busy) dma_copy_start();
+        CRIT_EXIT();
+    }
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       첽һڴ
+// ˵      *dst                Ŀĵַ
+// ˵      *src                Դַ  FLASH
+// ˵      len                 ֽ
+// ˵      callback            ɻص Ϊ NULL
+// ˵      arg                 ص
+// ز      uint8               1-ѽ DMA ʱص 0- CPU  صڷǰִ
+// ʹʾ      dma_memcpy_async(line_buffer, &image[y][0], 188, line_ready, NULL);
+// עϢ       1 ʱڻص dma_copy_wait ֮ǰܸĶԴĿĻ
+//               ύ˳ ص DMA жϻ dma_copy_wait ִ
+//               ԴĿص
+//-------------------------------------------------------------------------------------------------------------------
+uint8 dma_memcpy_async(void *dst, const void *src, uint32 len, dma_copy_callback callback, void *arg)
+{
+    dma_copy_job_struct job = {(uint8 *)dst, (const uint8 *)src, len, 0, 0, callback, arg};
+    return dma_copy_submit(&job);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       첽ͬһֵһ uint16 
+// ˵      *dst                Ŀ
+// ˵      value               ֵ
+// ˵      count               Ԫظ
+// ˵      callback            ɻص Ϊ NULL
+// ˵      arg                 ص
+// ز      uint8               1-ѽ DMA ʱص 0- CPU  صڷǰִ
+// ʹʾ      dma_memset16_async(line_buffer, RGB565_BLACK, 160, NULL, NULL);
+// עϢ      DMA Դַ Ҫ׼仺 ͬ dma_memcpy_async
+//-------------------------------------------------------------------------------------------------------------------
+uint8 dma_memset16_async(uint16 *dst, uint16 value, uint32 count, dma_copy_callback callback, void *arg)
+{
+    uint32 fill = (sizeof(uint16) == 2) ? (((uint32)value << 16) | (value & 0xFFFF)) : (uint32)value;
+    dma_copy_job_struct job = {(uint8 *)dst, NULL, count * sizeof(uint16), fill, sizeof(uint16), callback, arg};
+    return dma_copy_submit(&job);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯδɵĿ
+// ˵      void
+// ز      uint32              ŶڴĿ
+// ʹʾ      while(dma_copy_pending()) { /*  */ }
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 dma_copy_pending(void)
+{
+    return g_dma_copy_head - g_dma_copy_tail;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȴȫ
+// ˵      void
+// ز      void
+// ʹʾ      dma_copy_wait();
+// עϢ      жϱʱҲƽ
+//-------------------------------------------------------------------------------------------------------------------
+void dma_copy_wait(void)
+{
+    while (g_dma_copy_head != g_dma_copy_tail) dma_copy_complete();
+}
+
+static void dma1_irq_dispatch(dma_channel_enum dma1_ch)
+{
+    dma_irq_callback callback = g_dma1_irq_callback[dma1_ch];
+    if (callback != NULL) callback(g_dma1_irq_arg[dma1_ch]);
+    else DMA_ClearITPendingBit(DMA1_IT_GL1 << (dma1_ch * 4));
+}
+
+void DMA1_Channel1_IRQHandler(void){ PROFILE_BEGIN(dma1_ch1); dma1_irq_dispatch(dma1_CH1); PROFILE_END(dma1_ch1); }
+void DMA1_Channel2_IRQHandler(void){ PROFILE_BEGIN(dma1_ch2); dma1_irq_dispatch(dma1_CH2); PROFILE_END(dma1_ch2); }
+void DMA1_Channel3_IRQHandler(void){ PROFILE_BEGIN(dma1_ch3); dma1_irq_dispatch(dma1_CH3); PROFILE_END(dma1_ch3); }
+void DMA1_Channel4_IRQHandler(void){ PROFILE_BEGIN(dma1_ch4); dma1_irq_dispatch(dma1_CH4); PROFILE_END(dma1_ch4); }
+void DMA1_Channel5_IRQHandler(void){ PROFILE_BEGIN(dma1_ch5); dma1_irq_dispatch(dma1_CH5); PROFILE_END(dma1_ch5); }
+void DMA1_Channel6_IRQHandler(void){ PROFILE_BEGIN(dma1_ch6); dma1_irq_dispatch(dma1_CH6); PROFILE_END(dma1_ch6); }
+void DMA1_Channel7_IRQHandler(void){ PROFILE_BEGIN(dma1_ch7); dma1_irq_dispatch(dma1_CH7); PROFILE_END(dma1_ch7); }
@@ -17,6 +17,42 @@
 #define _driver_dma_h_
 #include "common_headfile.h"
 
+typedef void (*dma_irq_callback)(void *arg);                                    // DMA жϻص arg ΪעʱĲ
+
+// DMA1 ÿ̶ĳһͨ 蹲ͬһͨ ͬʱ DMA ụдͨĴ
+// ʼʱ dma1_claim Ǽռõͨ ѱռʱ zf_log ͻ 0
+// 洢洢Ĵ䲻ӳ  dma1_alloc ͨ Ӧʼ֮
+#define DMA1_CH_NONE        ((dma_channel_enum)0xFF)                            // dma1_alloc ûпͨ
+
+typedef enum
+{
+    DMA_OWNER_NONE,                                                             // ͨ
+    DMA_OWNER_ADC1,                                                             // ͨ 1
+    DMA_OWNER_UART1_TX,                                                         // ͨ 4
+    DMA_OWNER_UART1_RX,                                                         // ͨ 5
+    DMA_OWNER_UART2_TX,                                                         // ͨ 7
+    DMA_OWNER_UART2_RX,                                                         // ͨ 6
+    DMA_OWNER_UART3_TX,                                                         // ͨ 2
+    DMA_OWNER_UART3_RX,                                                         // ͨ 3
+    DMA_OWNER_SPI1_TX,                                                          // ͨ 3
+    DMA_OWNER_SPI1_RX,                                                          // ͨ 2
+    DMA_OWNER_SPI2_TX,                                                          // ͨ 5
+    DMA_OWNER_SPI2_RX,                                                          // ͨ 4
+    DMA_OWNER_IIC1_RX,                                                          // ͨ 7
+    DMA_OWNER_IIC2_RX,                                                          // ͨ 5
+    DMA_OWNER_MEMORY,                                                           // 洢洢 ͨ
+    DMA_OWNER_USER,                                                             // ûʹ
+}dma_owner_enum;
+
+// 洢洢Ŀ ״ʹʱ dma1_alloc ռһͨ жϽеһ
+// ΪҳС DMA_COPY_CPU_THRESHOLD ֽʱֱ CPU  ûпͨʱȫ CPU 
+// ԴĿĵַ볤ȶ 4 ֽڶʱְ 򰴰ֻֽ  65535 εĴԶֶ
+#define DMA_COPY_QUEUE_SIZE             (8)                                     // ŶӵĿ Ϊ 2 
+#define DMA_COPY_CPU_THRESHOLD          (64)                                    // Сڸֽʱ CPU 
+#define DMA_COPY_NVIC_PREEMPT_PRIORITY  (10)                                    // жռȼ
+
+typedef void (*dma_copy_callback)(void *arg);                                   // ɻص arg ΪύʱĲ
+
 void dma1_init(dma_channel_enum dma1_ch, uint32 source_addr, uint32 destination_addr, 
 	uint32 datasize, uint16 dma_count, uint32 priority, uint32 dir);
 void dma1_disable(dma_channel_enum dma1_ch);
@@ -26,4 +62,16 @@ void dma1_transfer(dma_channel_enum dma1_ch, uint16_t dma_count);
 void dma_start(DMA_Channel_TypeDef* ch, uint16 len);
 void dma_wait_done(DMA_Channel_TypeDef* ch);
 
+void dma1_irq_register(dma_channel_enum dma1_ch, dma_irq_callback callback, void *arg);
+
+uint8            dma1_claim          (dma_channel_enum dma1_ch, dma_owner_enum owner);
+dma_channel_enum dma1_alloc          (dma_owner_enum owner);
+void             dma1_release        (dma_channel_enum dma1_ch, dma_owner_enum owner);
+dma_owner_enum   dma1_get_owner      (dma_channel_enum dma1_ch);
+
+uint8            dma_memcpy_async    (void *dst, const void *src, uint32 len, dma_copy_callback callback, void *arg);
+uint8            dma_memset16_async  (uint16 *dst, uint16 value, uint32 count, dma_copy_callback callback, void *arg);
+uint32           dma_copy_pending    (void);
+void             dma_copy_wait       (void);
+
 #endif
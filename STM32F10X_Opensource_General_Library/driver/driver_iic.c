@@ -14,491 +14,911 @@
 * 2026-01-01        Lihua      first version
 ********************************************************************************************************************/
 #include "driver_iic.h"
-/* ========================= ڲ/ ========================= */
-#define I2C_TIMEOUT  ((uint32_t)0x0000FFFF)   /* 㹻ĳʱֵ */
 
-static I2C_TypeDef *I2C_NUM[2] = {I2C1, I2C2}; /* õ I2C1 Ҳ */
+#if (IIC_QUEUE_SIZE & (IIC_QUEUE_SIZE - 1)) || !IIC_QUEUE_SIZE
+#error "IIC_QUEUE_SIZE  2 "
+#endif
 
-static uint32_t I2C_WaitEvent(I2C_TypeDef *I2Cx, uint32_t event)
+#define IIC_PHASE_WRITE         (0)                                 /* ͼĴַ */
+#define IIC_PHASE_READ          (1)                                 /* ظ START ȡ */
+
+#define IIC_SR1_ERROR           (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR)
+
+/*  queue[tail] Ϊڴһ head/tail  */
+typedef struct
+{
+    I2C_TypeDef             *i2cx;
+    DMA_Channel_TypeDef     *rx_dma;
+    dma_channel_enum        rx_channel;
+    uint32                  rx_tc_flag;
+    uint32                  rx_gl_flag;
+    IRQn_Type               ev_irq;
+    IRQn_Type               er_irq;
+    uint8                   addr;                                   /* iic_init ָĴӻַ ʹ */
+    GPIO_TypeDef            *port;                                  /* SCL/SDA ڶ˿ λʱͷ */
+    uint16                  scl_pin;
+    uint16                  sda_pin;
+    iic_error_enum          error;                                  /* һĽ */
+    iic_xfer_struct         *queue[IIC_QUEUE_SIZE];
+    volatile uint32         head;
+    volatile uint32         tail;
+    volatile uint8          busy;                                   /* ڴ queue[tail] */
+    volatile uint8          stop_wait;                              /* queue[tail]  START Ҫһ STOP   iic_bus_kick  */
+    volatile uint8          resetting;                              /* ڸλ ڼ䲻´ */
+    uint32                  poll_progress;                          /* iic_poll ϴοĽ */
+    uint32                  poll_count;                             /* iic_poll ûнչĴ */
+    uint8                   phase;                                  /* IIC_PHASE_WRITE / IIC_PHASE_READ */
+    uint8                   dma;                                    /* ζȡ DMA  */
+    uint8                   dma_owned;                              /* ͨǼǳɹ жֽڶȡ */
+    uint32                  index;                                  /* ׶շֽ */
+    uint32                  tx_total;                               /* д׶ֽ Ĵַ */
+    uint32                  rx_total;                               /* ׶ֽ */
+}iic_bus_struct;
+
+static iic_bus_struct g_iic_bus[2] =
+{
+    {I2C1, DMA1_Channel7, dma1_CH7, DMA1_FLAG_TC7, DMA1_FLAG_GL7, I2C1_EV_IRQn, I2C1_ER_IRQn},
+    {I2C2, DMA1_Channel5, dma1_CH5, DMA1_FLAG_TC5, DMA1_FLAG_GL5, I2C2_EV_IRQn, I2C2_ER_IRQn},
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡд׶εһֽ
+// ˵     *bus            IIC 
+// ˵     *xfer           ǰ
+// ز     uint8           ȼĴַ ֽǰ 
+// ʹʾ     i2cx->DR = iic_tx_byte(bus, xfer);
+// עϢ     ڲ 16 λݸֽǰ
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 iic_tx_byte(iic_bus_struct *bus, iic_xfer_struct *xfer)
+{
+    uint32 i = bus->index;
+
+    if (i < xfer->reg_len) return (uint8)(xfer->reg >> ((xfer->reg_len - 1 - i) * 8));
+    i -= xfer->reg_len;
+    if (xfer->flags & IIC_XFER_16BIT)
+        return (uint8)(((const uint16 *)xfer->tx)[i >> 1] >> ((i & 1) ? 0 : 8));
+    return ((const uint8 *)xfer->tx)[i];
+}
+
+/* 16 λȡʱֽȰ˳յͷ βǰƴ uint16 Ḳδֽ */
+static void iic_rx_unpack(iic_xfer_struct *xfer)
+{
+    uint8  *raw = (uint8 *)xfer->rx;
+    uint16 *dat = (uint16 *)xfer->rx;
+
+    for (uint32 i = xfer->rx_len; i > 0; i--)
+        dat[i - 1] = (uint16)((uint16)raw[2 * i - 2] << 8 | raw[2 * i - 1]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      λ IIC 貢ͷ
+// ˵     *bus            IIC 
+// ز     void
+// ʹʾ     iic_bus_reset(bus);
+// עϢ     ڲ ڿж״̬µ ǰ resetting ֹλڼ´
+//              SWRST ס BUSY/START/STOP ״̬ ָ֮ iic_init 
+//              λڼе© ӻס SDA ʱ 9  SCL ʱ굱ǰֽ ٷ STOP
+//-------------------------------------------------------------------------------------------------------------------
+static void iic_bus_reset(iic_bus_struct *bus)
 {
-    uint32_t timeout = I2C_TIMEOUT;
-    while (!I2C_CheckEvent(I2Cx, event))
+    I2C_TypeDef *i2cx = bus->i2cx;
+    GPIO_InitTypeDef gpio;
+    uint16 cr2   = i2cx->CR2 & ~(I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+    uint16 oar1  = i2cx->OAR1;
+    uint16 ccr   = i2cx->CCR;
+    uint16 trise = i2cx->TRISE;
+
+    i2cx->CR1 = I2C_CR1_SWRST;
+
+    gpio.GPIO_Pin   = bus->scl_pin | bus->sda_pin;
+    gpio.GPIO_Speed = GPIO_Speed_50MHz;
+    gpio.GPIO_Mode  = GPIO_Mode_Out_OD;
+    GPIO_SetBits(bus->port, bus->scl_pin | bus->sda_pin);
     {
-        if (--timeout == 0) return 1; /* ʱط 0 */
+        CRIT_ENTER();                                               /* GPIO_Init д CRL/CRH жͬһ˿ڵĲ */
+        GPIO_Init(bus->port, &gpio);
+        CRIT_EXIT();
     }
-    return 0;
+    for (uint8 i = 0; i < 9 && GPIO_ReadInputDataBit(bus->port, bus->sda_pin) == Bit_RESET; i++)
+    {
+        GPIO_ResetBits(bus->port, bus->scl_pin);
+        system_delay_us(5);
+        GPIO_SetBits(bus->port, bus->scl_pin);
+        system_delay_us(5);
+    }
+    GPIO_ResetBits(bus->port, bus->scl_pin);                        /* SCL Ϊʱ SDA ɵͱ  STOP */
+    GPIO_ResetBits(bus->port, bus->sda_pin);
+    system_delay_us(5);
+    GPIO_SetBits(bus->port, bus->scl_pin);
+    system_delay_us(5);
+    GPIO_SetBits(bus->port, bus->sda_pin);
+    gpio.GPIO_Mode  = GPIO_Mode_AF_OD;
+    {
+        CRIT_ENTER();
+        GPIO_Init(bus->port, &gpio);
+        CRIT_EXIT();
+    }
+
+    i2cx->CR1   = 0;
+    i2cx->CR2   = cr2;
+    i2cx->OAR1  = oar1;
+    i2cx->CCR   = ccr;
+    i2cx->TRISE = trise;
+    i2cx->CR1   = I2C_CR1_PE | I2C_CR1_ACK;
 }
+
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC START ź
-// ˵     iic_n           IIC ָ
+//      еһ
+// ˵     *bus            IIC 
 // ز     void
-// ʹʾ     iic_start(IIC_1);
-// עϢ     ڲ
+// ʹʾ     iic_bus_start(bus);
+// עϢ     ڲ ǰж߿ ڸλʱ
+//              һ STOP ûʱ START ᱻ ʱֻ stop_wait ɵ߿жϺ iic_bus_kick 
 //-------------------------------------------------------------------------------------------------------------------
-void iic_start(iic_index_enum iic_n)
+static void iic_bus_start(iic_bus_struct *bus)
 {
-    I2C_GenerateSTART(I2C_NUM[iic_n], ENABLE);
-    I2C_WaitEvent(I2C_NUM[iic_n], I2C_EVENT_MASTER_MODE_SELECT);
+    I2C_TypeDef *i2cx = bus->i2cx;
+    iic_xfer_struct *xfer;
+    uint8 width;
+
+    if (bus->head == bus->tail || bus->resetting) return;
+    xfer = bus->queue[bus->tail & (IIC_QUEUE_SIZE - 1)];
+    width = (xfer->flags & IIC_XFER_16BIT) ? 2 : 1;
+    xfer->state   = IIC_XFER_ACTIVE;
+    xfer->error   = IIC_ERROR_NONE;
+    bus->busy     = 1;
+    bus->dma      = 0;
+    bus->index    = 0;
+    bus->tx_total = xfer->reg_len + xfer->tx_len * width;
+    bus->rx_total = xfer->rx_len * width;
+    bus->phase    = (bus->tx_total || !bus->rx_total) ? IIC_PHASE_WRITE : IIC_PHASE_READ;
+
+    if (i2cx->CR1 & I2C_CR1_STOP)
+    {
+        bus->stop_wait = 1;
+        return;
+    }
+    i2cx->CR1 = (i2cx->CR1 & ~I2C_CR1_POS) | I2C_CR1_ACK | I2C_CR1_START;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC STOP ź
-// ˵     iic_n           IIC ָ
+//      һ STOP 󷢳Ƴٵ START
+// ˵     *bus            IIC 
 // ز     void
-// ʹʾ     iic_stop(IIC_1);
-// עϢ     ڲ
+// ʹʾ     iic_bus_kick(bus);
+// עϢ     ڲ ڿж״̬µ ûбƳٵ START ʱֱӷ
+//              STOP λԼ SCL  ȴ IIC_TIMEOUT δ˵߱ס λٷ START
 //-------------------------------------------------------------------------------------------------------------------
-void iic_stop(iic_index_enum iic_n)
+static void iic_bus_kick(iic_bus_struct *bus)
 {
-    I2C_GenerateSTOP(I2C_NUM[iic_n], ENABLE);
+    I2C_TypeDef *i2cx = bus->i2cx;
+    uint32 timeout = IIC_TIMEOUT;
+
+    if (!bus->stop_wait) return;
+    while ((i2cx->CR1 & I2C_CR1_STOP) && timeout) timeout --;
+    if (timeout == 0)
+    {
+        bus->resetting = 1;
+        iic_bus_reset(bus);
+        bus->resetting = 0;
+    }
+
+    {
+        CRIT_ENTER();
+        if (bus->stop_wait)                                         /* ȴڼѱ߷ֹ */
+        {
+            bus->stop_wait = 0;
+            i2cx->CR1 = (i2cx->CR1 & ~I2C_CR1_POS) | I2C_CR1_ACK | I2C_CR1_START;
+        }
+        CRIT_EXIT();
+    }
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC  ACK/NAKC ź ڲ
-// ˵     iic_n           IIC ָ
-// ˵     ack             ACK ƽ
+//      ǰ
+// ˵     *bus            IIC 
+// ˵     error           
+// ز     iic_xfer_struct* Ĵ ɵڿжϺִлص
+// ʹʾ     return iic_bus_finish(bus, IIC_ERROR_NONE);
+// עϢ     ڲ ǰж STOP ɵ߰跢
+//-------------------------------------------------------------------------------------------------------------------
+static iic_xfer_struct *iic_bus_finish(iic_bus_struct *bus, iic_error_enum error)
+{
+    iic_xfer_struct *xfer = bus->queue[bus->tail & (IIC_QUEUE_SIZE - 1)];
+
+    bus->i2cx->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+    if (bus->dma)
+    {
+        bus->rx_dma->CCR &= ~(DMA_CCR1_EN | DMA_CCR1_TCIE);
+        DMA_ClearFlag(bus->rx_gl_flag);
+        bus->dma = 0;
+    }
+    if (error == IIC_ERROR_NONE && (xfer->flags & IIC_XFER_16BIT) && xfer->rx_len) iic_rx_unpack(xfer);
+    xfer->error = error;
+    bus->tail ++;
+    bus->busy = 0;
+    bus->stop_wait = 0;
+    xfer->state = IIC_XFER_DONE;
+    return xfer;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ǰ״̬־ƽһ
+// ˵     *bus            IIC 
+// ز     iic_xfer_struct* Ĵ ûнʱ NULL
+// ʹʾ     xfer = iic_bus_step(bus);
+// עϢ     ڲ ǰж busy Ϊ 1 ûҪı־ʱֻһ SR1
+//              ADDR λڼ SCL   1/2 ֽʱ ADDR ǰĲڹж 㿱ֲʱҪ
+//               3 ֽϲ DMA ʱ ֽڵ BTF ٴ ʱ SCL  жӳӰ
+//-------------------------------------------------------------------------------------------------------------------
+static iic_xfer_struct *iic_bus_step(iic_bus_struct *bus)
+{
+    I2C_TypeDef *i2cx = bus->i2cx;
+    iic_xfer_struct *xfer = bus->queue[bus->tail & (IIC_QUEUE_SIZE - 1)];
+    uint8 *rx = (uint8 *)xfer->rx;
+    uint16 sr1 = i2cx->SR1;
+
+    if (sr1 & IIC_SR1_ERROR)
+    {
+        i2cx->SR1 = (uint16_t)~IIC_SR1_ERROR;
+        if (sr1 & I2C_SR1_ARLO) return iic_bus_finish(bus, IIC_ERROR_ARBITRATION);     /* ٲöʧӲ˳ģʽ */
+        i2cx->CR1 = (i2cx->CR1 & ~I2C_CR1_POS) | I2C_CR1_STOP;
+        return iic_bus_finish(bus, (sr1 & I2C_SR1_AF) ? IIC_ERROR_NACK : (sr1 & I2C_SR1_BERR) ? IIC_ERROR_BUS : IIC_ERROR_OVERRUN);
+    }
+    if (bus->dma)
+    {
+        /* һֽ LAST  NACK DMA ȡߺ STOP */
+        if (DMA_GetFlagStatus(bus->rx_tc_flag) == RESET) return NULL;
+        i2cx->CR1 |= I2C_CR1_STOP;
+        return iic_bus_finish(bus, IIC_ERROR_NONE);
+    }
+    if (sr1 & I2C_SR1_SB)
+    {
+        i2cx->DR = (uint8)(xfer->addr << 1) | ((bus->phase == IIC_PHASE_READ) ? 1 : 0);
+        return NULL;
+    }
+    if (sr1 & I2C_SR1_ADDR)
+    {
+        if (bus->phase == IIC_PHASE_WRITE)
+        {
+            (void)i2cx->SR2;
+            if (bus->tx_total == 0)                                 /* ַֻ ̽ */
+            {
+                i2cx->CR1 |= I2C_CR1_STOP;
+                return iic_bus_finish(bus, IIC_ERROR_NONE);
+            }
+            i2cx->CR2 |= I2C_CR2_ITBUFEN;
+        }
+        else if (bus->rx_total == 1)
+        {
+            /* ֽ  ADDR ǰ ACK  ADDR  STOP */
+            i2cx->CR1 &= ~I2C_CR1_ACK;
+            (void)i2cx->SR2;
+            i2cx->CR1 |= I2C_CR1_STOP;
+            i2cx->CR2 |= I2C_CR2_ITBUFEN;
+        }
+        else if (bus->rx_total == 2)
+        {
+            /* ֽ POS=1 ACK=0 ڶֽڻ NACK ֽڶյBTF STOP */
+            i2cx->CR1 = (i2cx->CR1 & ~I2C_CR1_ACK) | I2C_CR1_POS;
+            (void)i2cx->SR2;
+        }
+        else
+        {
+            if (bus->dma_owned)
+            {
+                bus->dma = 1;
+                DMA_ClearFlag(bus->rx_gl_flag);
+                bus->rx_dma->CMAR  = (uint32)rx;
+                bus->rx_dma->CNDTR = bus->rx_total;
+                bus->rx_dma->CCR  |= DMA_CCR1_TCIE | DMA_CCR1_EN;
+                i2cx->CR2 |= I2C_CR2_DMAEN | I2C_CR2_LAST;
+            }
+            else
+            {
+                i2cx->CR2 |= I2C_CR2_ITBUFEN;
+            }
+            (void)i2cx->SR2;
+        }
+        return NULL;
+    }
+
+    if (bus->phase == IIC_PHASE_WRITE)
+    {
+        if ((sr1 & I2C_SR1_TXE) && bus->index < bus->tx_total)
+        {
+            i2cx->DR = iic_tx_byte(bus, xfer);
+            bus->index ++;
+            if (bus->index == bus->tx_total) i2cx->CR2 &= ~I2C_CR2_ITBUFEN;    /* һֽ ĵ BTF */
+        }
+        else if ((sr1 & I2C_SR1_BTF) && bus->index == bus->tx_total)
+        {
+            if (!bus->rx_total)
+            {
+                i2cx->CR1 |= I2C_CR1_STOP;
+                return iic_bus_finish(bus, IIC_ERROR_NONE);
+            }
+            bus->phase = IIC_PHASE_READ;
+            bus->index = 0;
+            i2cx->CR1 |= I2C_CR1_START;                             /* ظ START ͬʱ BTF */
+        }
+        return NULL;
+    }
+
+    if (bus->rx_total == 2)
+    {
+        if (!(sr1 & I2C_SR1_BTF)) return NULL;
+        i2cx->CR1 |= I2C_CR1_STOP;
+        rx[0] = (uint8)i2cx->DR;
+        rx[1] = (uint8)i2cx->DR;
+        i2cx->CR1 &= ~I2C_CR1_POS;
+        return iic_bus_finish(bus, IIC_ERROR_NONE);
+    }
+    switch (bus->rx_total - bus->index)
+    {
+        case 1:                                                     /* ֽ STOP  ADDR 󷢳 */
+            if (!(sr1 & I2C_SR1_RXNE)) return NULL;
+            rx[bus->index ++] = (uint8)i2cx->DR;
+            return iic_bus_finish(bus, IIC_ERROR_NONE);
+        case 2:                                                     /* ֽڷֱ DR λĴ */
+            if (!(sr1 & I2C_SR1_BTF)) return NULL;
+            i2cx->CR1 |= I2C_CR1_STOP;
+            rx[bus->index ++] = (uint8)i2cx->DR;
+            rx[bus->index ++] = (uint8)i2cx->DR;
+            return iic_bus_finish(bus, IIC_ERROR_NONE);
+        case 3:                                                     /*  DR ڶλĴ  ACK һ NACK */
+            if (!(sr1 & I2C_SR1_BTF)) return NULL;
+            i2cx->CR1 &= ~I2C_CR1_ACK;
+            rx[bus->index ++] = (uint8)i2cx->DR;
+            return NULL;
+        default:
+            if (!(sr1 & I2C_SR1_RXNE)) return NULL;
+            rx[bus->index ++] = (uint8)i2cx->DR;
+            if (bus->rx_total - bus->index == 3) i2cx->CR2 &= ~I2C_CR2_ITBUFEN;
+            return NULL;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ¼ ʱصһ
+// ˵     *bus            IIC 
+// ز     void
+// ʹʾ     iic_bus_service(bus);
+// עϢ     ڲ ¼//DMA жϻȴ
+//              صڿж״ִ̬ صٴ iic_submit
+//-------------------------------------------------------------------------------------------------------------------
+static void iic_bus_service(iic_bus_struct *bus)
+{
+    iic_xfer_struct *xfer = NULL;
+
+    {
+        CRIT_ENTER();
+        if (bus->busy)
+        {
+            if (!bus->stop_wait) xfer = iic_bus_step(bus);
+        }
+        else
+        {
+            bus->i2cx->SR1 = (uint16_t)~IIC_SR1_ERROR;               /* ʱߴ ٽж */
+            iic_bus_start(bus);
+        }
+        CRIT_EXIT();
+    }
+    if (xfer != NULL)
+    {
+        if (xfer->callback != NULL) xfer->callback(xfer);
+
+        {
+            CRIT_ENTER();
+            if (!bus->busy) iic_bus_start(bus);                     /* صѾύ */
+            CRIT_EXIT();
+        }
+    }
+    iic_bus_kick(bus);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ָڽеĴ λһ
+// ˵     *bus            IIC 
+// ˵     error           
 // ز     void
-// ʹʾ     iic_send_ack(IIC_1, 1);
-// עϢ     ڲ
+// ʹʾ     iic_bus_abort(bus, IIC_ERROR_TIMEOUT);
+// עϢ     ڲ ȴʱʱ λصڿж״ִ̬
 //-------------------------------------------------------------------------------------------------------------------
-void iic_send_ack(iic_index_enum iic_n, uint8 ack)
+static void iic_bus_abort(iic_bus_struct *bus, iic_error_enum error)
+{
+    iic_xfer_struct *xfer = NULL;
+
+    {
+        CRIT_ENTER();
+        if (bus->busy)
+        {
+            xfer = iic_bus_finish(bus, error);
+            bus->resetting = 1;
+        }
+        CRIT_EXIT();
+    }
+    if (xfer != NULL)
+    {
+        iic_bus_reset(bus);
+        bus->resetting = 0;
+        if (xfer->callback != NULL) xfer->callback(xfer);
+    }
+
+    {
+        CRIT_ENTER();
+        if (!bus->busy) iic_bus_start(bus);
+        CRIT_EXIT();
+    }
+    iic_bus_kick(bus);
+}
+
+/*  С׶Ρշֽ DMA ʣ仯ʱֵ֮ı */
+static uint32 iic_bus_progress(iic_bus_struct *bus)
 {
-    /* ģʽ£CPU Ҫ ACK/NACK ʱ */
-    if (ack)
-        I2C_AcknowledgeConfig(I2C_NUM[iic_n], ENABLE);
-    else
-        I2C_AcknowledgeConfig(I2C_NUM[iic_n], DISABLE);
+    uint32 progress = bus->tail + bus->phase + bus->index;
+
+    if (bus->dma) progress -= bus->rx_dma->CNDTR;
+    return progress;
 }
+
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC ȡ ACK/NAKC ź
-// ˵     iic_n           IIC ָ
-// ز     uint8           ACK ״̬
-// ʹʾ     iic_wait_ack(IIC_1);
-// עϢ     ڲ
+//      ƽֱָ
+// ˵     *bus            IIC 
+// ˵     *xfer           ȴĴ NULL ʾȶ
+// ز     void
+// ʹʾ     iic_bus_wait(bus, &xfer);
+// עϢ     ڲ  IIC_TIMEOUT βѯȲʱ ǰ IIC_ERROR_TIMEOUT λ
+//              ȡ DMA ʱʣжϽ Ϊʱ䳤
 //-------------------------------------------------------------------------------------------------------------------
-uint8 iic_wait_ack(iic_index_enum iic_n)
+static void iic_bus_wait(iic_bus_struct *bus, iic_xfer_struct *xfer)
 {
-    /* һֽں󣬵ȴӻ ACK */
-    uint32_t timeout = I2C_TIMEOUT;
-    I2C_ClearFlag(I2C_NUM[iic_n], I2C_FLAG_AF);
-    while (I2C_GetFlagStatus(I2C_NUM[iic_n], I2C_FLAG_AF) == RESET)
+    uint32 progress = iic_bus_progress(bus);
+    uint32 timeout  = IIC_TIMEOUT;
+    uint32 now;
+
+    while ((xfer != NULL) ? (xfer->state != IIC_XFER_DONE) : (bus->head != bus->tail))
     {
-        if (--timeout == 0) return 1; /* Ӧ𷵻 1 */
+        iic_bus_service(bus);
+        now = iic_bus_progress(bus);
+        if (now != progress)
+        {
+            progress = now;
+            timeout  = IIC_TIMEOUT;
+        }
+        else if (-- timeout == 0)
+        {
+            iic_bus_abort(bus, IIC_ERROR_TIMEOUT);
+            timeout  = IIC_TIMEOUT;
+        }
     }
-    return 0; /* յ ACK  0 */
 }
+
+#if IIC_RX_USE_DMA
+static void iic_dma_irq_handler(void *arg)
+{
+    iic_bus_service((iic_bus_struct *)arg);
+}
+#endif
+
+void I2C1_EV_IRQHandler(void){ PROFILE_BEGIN(iic1_ev); iic_bus_service(&g_iic_bus[IIC_1]); PROFILE_END(iic1_ev); }
+void I2C1_ER_IRQHandler(void){ PROFILE_BEGIN(iic1_er); iic_bus_service(&g_iic_bus[IIC_1]); PROFILE_END(iic1_er); }
+void I2C2_EV_IRQHandler(void){ PROFILE_BEGIN(iic2_ev); iic_bus_service(&g_iic_bus[IIC_2]); PROFILE_END(iic2_ev); }
+void I2C2_ER_IRQHandler(void){ PROFILE_BEGIN(iic2_er); iic_bus_service(&g_iic_bus[IIC_2]); PROFILE_END(iic2_er); }
+
+/*  ύ첽֮ ȱδٷ жϱʱҲƽ ͬʱ iic_get_error */
+static iic_error_enum iic_xfer_run(iic_index_enum iic_n, uint16 reg, uint8 reg_len, const void *tx, uint32 tx_len, void *rx, uint32 rx_len, uint8 flags)
+{
+    iic_bus_struct *bus = &g_iic_bus[iic_n];
+    iic_xfer_struct xfer = {bus->addr, reg_len, reg, tx, tx_len, rx, rx_len, flags, NULL, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+
+    while (iic_submit(iic_n, &xfer))
+    {
+        if (iic_pending(iic_n) == 0)                                /* Ϊύʧ  */
+        {
+            bus->error = IIC_ERROR_BUS;
+            return bus->error;
+        }
+        iic_bus_wait(bus, bus->queue[bus->tail & (IIC_QUEUE_SIZE - 1)]);    /* ʱһڳλ */
+    }
+    iic_bus_wait(bus, &xfer);
+    bus->error = xfer.error;
+    return bus->error;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC  8bit 
+//      ύһ첽
 // ˵     iic_n           IIC ָ
-// ˵     dat            
-// ز     uint8           ACK ״̬
-// עϢ     ڲ
-//-------------------------------------------------------------------------------------------------------------------
-uint8 iic_send_data(iic_index_enum iic_n, const uint8 dat)
+// ˵     *xfer            ֮ǰ뱣Ч ܷڻǰصĺջ
+// ز     uint8           0-Ѽ 1-
+// ʹʾ     static uint8 dat[12];
+//              static iic_xfer_struct x = {0x69, 1, 0x0C, NULL, 0, dat, 12, 0, on_done, NULL};
+//              iic_submit(IIC_1, &x);
+// עϢ     ύ˳δ ߿ʱ START 漴 ֮жƽ
+//              ɺ state Ϊ IIC_XFER_DONE д error ûص
+//              һζȡ 65535 ֽ ĴַдݶΪ 0 Ҳȡʱֻ͵ַ ̽
+//-------------------------------------------------------------------------------------------------------------------
+uint8 iic_submit(iic_index_enum iic_n, iic_xfer_struct *xfer)
 {
-    I2C_SendData(I2C_NUM[iic_n], dat);
-    if (I2C_WaitEvent(I2C_NUM[iic_n], I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED))
-        return 1;
-    if (I2C_WaitEvent(I2C_NUM[iic_n], I2C_EVENT_MASTER_BYTE_TRANSMITTED))
+    iic_bus_struct *bus = &g_iic_bus[iic_n];
+
+    if (xfer == NULL || xfer->reg_len > 2) return 1;
+    if ((xfer->tx == NULL && xfer->tx_len) || (xfer->rx == NULL && xfer->rx_len)) return 1;
+    if (xfer->rx_len * ((xfer->flags & IIC_XFER_16BIT) ? 2 : 1) > 65535) return 1;
+
+    CRIT_ENTER();
+    if (bus->head - bus->tail >= IIC_QUEUE_SIZE)
+    {
+        CRIT_EXIT();
         return 1;
+    }
+    xfer->state = IIC_XFER_QUEUED;
+    bus->queue[bus->head & (IIC_QUEUE_SIZE - 1)] = xfer;
+    bus->head ++;
+    if (!bus->busy) iic_bus_start(bus);
+    CRIT_EXIT();
+    iic_bus_kick(bus);
     return 0;
 }
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯδɵĴ
+// ˵     iic_n           IIC ָ
+// ز     uint32          Ŷڴĸ
+// ʹʾ     if (iic_pending(IIC_1) == 0) { ... }
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 iic_pending(iic_index_enum iic_n)
+{
+    iic_bus_struct *bus = &g_iic_bus[iic_n];
+    return bus->head - bus->tail;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC ȡ 8bit 
+//      ȴύĴȫ
 // ˵     iic_n           IIC ָ
-// ˵     ack             ACK  NACK
-// ز     uint8           
-// עϢ     ڲ
+// ز     void
+// ʹʾ     iic_flush(IIC_1);
+// עϢ     жصжʱҲƽ ߿Ĵ IIC_ERROR_TIMEOUT 
 //-------------------------------------------------------------------------------------------------------------------
-uint8 iic_read_data(iic_index_enum iic_n, uint8 ack)
+void iic_flush(iic_index_enum iic_n)
 {
-    iic_send_ack(iic_n, ack);
-    while (!I2C_CheckEvent(I2C_NUM[iic_n], I2C_EVENT_MASTER_BYTE_RECEIVED));
-    return I2C_ReceiveData(I2C_NUM[iic_n]);
+    iic_bus_wait(&g_iic_bus[iic_n], NULL);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      첽Ƿס
+// ˵     iic_n           IIC ָ
+// ز     void
+// ʹʾ     iic_poll(IIC_1); iic_submit(IIC_1, &x);                     //  PIT жÿڵ
+// עϢ     ʹ iic_submit ʱ̶ڵ ύ PIT ж
+//              ڽеĴ IIC_POLL_TIMEOUT εûнչʱ  IIC_ERROR_TIMEOUT  λ貢һ
+//              ӦһֽڵĴʱ Ҫѭ
+//-------------------------------------------------------------------------------------------------------------------
+void iic_poll(iic_index_enum iic_n)
+{
+    iic_bus_struct *bus = &g_iic_bus[iic_n];
+    uint32 progress = iic_bus_progress(bus);
+
+    if (!bus->busy || progress != bus->poll_progress)
+    {
+        bus->poll_progress = progress;
+        bus->poll_count    = 0;
+    }
+    else if (++ bus->poll_count >= IIC_POLL_TIMEOUT)
+    {
+        bus->poll_count = 0;
+        iic_bus_abort(bus, IIC_ERROR_TIMEOUT);
+    }
 }
+
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿд 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     dat            Ҫд
-// ز     void            
+// ˵     dat             Ҫд
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_8bit(IIC_1, 0x01);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_8bit(iic_index_enum iic_n, const uint8 dat)
+iic_error_enum iic_write_8bit(iic_index_enum iic_n, const uint8 dat)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, dat);
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, 0, 0, &dat, 1, NULL, 0, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿд 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     *dat           ݴŻ
+// ˵     *dat            ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_8bit_array(IIC_1, dat, 6);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_8bit_array(iic_index_enum iic_n, const uint8 *dat, uint32 len)
+iic_error_enum iic_write_8bit_array(iic_index_enum iic_n, const uint8 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    for(uint32 i = 0; i < len; i++)
-        iic_send_data(iic_n, dat[i]);
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, 0, 0, dat, len, NULL, 0, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿд 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     dat            Ҫд
-// ز     void            
+// ˵     dat             Ҫд
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_16bit(IIC_1, 0x0101);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_16bit(iic_index_enum iic_n, const uint16 dat)
+iic_error_enum iic_write_16bit(iic_index_enum iic_n, const uint16 dat)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, (uint8)(dat >> 8));
-    iic_send_data(iic_n, (uint8)(dat & 0xFF));
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, 0, 0, &dat, 1, NULL, 0, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿд 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     *dat           ݴŻ
+// ˵     *dat            ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_16bit_array(IIC_1, dat, 6);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_16bit_array(iic_index_enum iic_n, const uint16 *dat, uint32 len)
+iic_error_enum iic_write_16bit_array(iic_index_enum iic_n, const uint16 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    for(uint32 i = 0; i < len; i++)
-    {
-        iic_send_data(iic_n, (uint8)(dat[i] >> 8));
-        iic_send_data(iic_n, (uint8)(dat[i] & 0xFF));
-    }
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, 0, 0, dat, len, NULL, 0, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿ򴫸Ĵд 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     dat            Ҫд
-// ز     void            
+// ˵     reg             ļĴַ
+// ˵     dat             Ҫд
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_8bit_register(IIC_1, 0x01, 0x01);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_8bit_register(iic_index_enum iic_n, const uint8 reg, const uint8 dat)
+iic_error_enum iic_write_8bit_register(iic_index_enum iic_n, const uint8 reg, const uint8 dat)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, reg);
-    iic_send_data(iic_n, dat);
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, reg, 1, &dat, 1, NULL, 0, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿ򴫸Ĵд 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     *dat           ݴŻ
+// ˵     reg             ļĴַ
+// ˵     *dat            ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_8bit_registers(IIC_1, 0x01, dat, 6);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_8bit_registers(iic_index_enum iic_n, const uint8 reg, const uint8 *dat, uint32 len)
+iic_error_enum iic_write_8bit_registers(iic_index_enum iic_n, const uint8 reg, const uint8 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, reg);
-    for(uint32 i = 0; i < len; i++)
-        iic_send_data(iic_n, dat[i]);
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, reg, 1, dat, len, NULL, 0, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿ򴫸Ĵд 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     dat            Ҫд
-// ز     void            
+// ˵     reg             ļĴַ
+// ˵     dat             Ҫд
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_16bit_register(IIC_1, 0x0101, 0x0101);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_16bit_register(iic_index_enum iic_n, const uint16 reg, const uint16 dat)
+iic_error_enum iic_write_16bit_register(iic_index_enum iic_n, const uint16 reg, const uint16 dat)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, (uint8)(reg >> 8));
-    iic_send_data(iic_n, (uint8)(reg & 0xFF));
-    iic_send_data(iic_n, (uint8)(dat >> 8));
-    iic_send_data(iic_n, (uint8)(dat & 0xFF));
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, reg, 2, &dat, 1, NULL, 0, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿ򴫸Ĵд 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     *dat           ݴŻ
+// ˵     reg             ļĴַ
+// ˵     *dat            ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_write_16bit_registers(IIC_1, 0x0101, dat, 6);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_write_16bit_registers(iic_index_enum iic_n, const uint16 reg, const uint16 *dat, uint32 len)
+iic_error_enum iic_write_16bit_registers(iic_index_enum iic_n, const uint16 reg, const uint16 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, (uint8)(reg >> 8));
-    iic_send_data(iic_n, (uint8)(reg & 0xFF));
-    for(uint32 i = 0; i < len; i++)
-    {
-        iic_send_data(iic_n, (uint8)(dat[i] >> 8));
-        iic_send_data(iic_n, (uint8)(dat[i] & 0xFF));
-    }
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, reg, 2, dat, len, NULL, 0, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڶȡ 8bit 
 // ˵     iic_n           IIC ָ
 // ز     uint8           ضȡ 8bit 
 // ʹʾ     iic_read_8bit(IIC_1);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
 uint8 iic_read_8bit(iic_index_enum iic_n)
 {
-    uint8 dat;
-    iic_start(iic_n);
-    dat = iic_read_data(iic_n, 0); /* NACK  */
-    iic_stop(iic_n);
+    uint8 dat = 0;
+    if (iic_xfer_run(iic_n, 0, 0, NULL, 0, &dat, 1, 0) != IIC_ERROR_NONE) return 0;
     return dat;
 }
 //-------------------------------------------------------------------------------------------------------------------
-//      Ӳ IIC ӿڴӴĴȡ 8bit 
+//      Ӳ IIC ӿڶȡ 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     *dat           ҪȡݵĻָ
+// ˵     *dat            ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_read_8bit_array(IIC_1, dat, 8);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_read_8bit_array(iic_index_enum iic_n, uint8 *dat, uint32 len)
+iic_error_enum iic_read_8bit_array(iic_index_enum iic_n, uint8 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    for(uint32 i = 0; i < len; i++)
-        dat[i] = iic_read_data(iic_n, (i == len - 1) ? 0 : 1);
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, 0, 0, NULL, 0, dat, len, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڶȡ 16bit 
 // ˵     iic_n           IIC ָ
 // ز     uint16          ضȡ 16bit 
 // ʹʾ     iic_read_16bit(IIC_1);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
 uint16 iic_read_16bit(iic_index_enum iic_n)
 {
-    uint16 dat;
-    iic_start(iic_n);
-    dat  = (uint16)iic_read_data(iic_n, 1) << 8;
-    dat |= iic_read_data(iic_n, 0);
-    iic_stop(iic_n);
+    uint16 dat = 0;
+    if (iic_xfer_run(iic_n, 0, 0, NULL, 0, &dat, 1, IIC_XFER_16BIT) != IIC_ERROR_NONE) return 0;
     return dat;
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڶȡ 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     *dat           ҪȡݵĻָ
+// ˵     *dat            ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_read_16bit_array(IIC_1, dat, 8);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_read_16bit_array(iic_index_enum iic_n, uint16 *dat, uint32 len)
+iic_error_enum iic_read_16bit_array(iic_index_enum iic_n, uint16 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    for(uint32 i = 0; i < len; i++)
-    {
-        dat[i]  = (uint16)iic_read_data(iic_n, (i == len - 1) ? 0 : 1) << 8;
-        dat[i] |= iic_read_data(iic_n, (i == len - 1) ? 0 : 1);
-    }
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, 0, 0, NULL, 0, dat, len, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڴӴĴȡ 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
+// ˵     reg             ļĴַ
 // ز     uint8           ضȡ 8bit 
 // ʹʾ     iic_read_8bit_register(IIC_1, 0x01);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
 uint8 iic_read_8bit_register(iic_index_enum iic_n, const uint8 reg)
 {
-    uint8 dat;
-    iic_start(iic_n);
-    iic_send_data(iic_n, reg);
-    /* ߽ģʽ */
-    iic_start(iic_n);
-    dat = iic_read_data(iic_n, 0);
-    iic_stop(iic_n);
+    uint8 dat = 0;
+    if (iic_xfer_run(iic_n, reg, 1, NULL, 0, &dat, 1, 0) != IIC_ERROR_NONE) return 0;
     return dat;
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڴӴĴȡ 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     *dat           ҪȡݵĻָ
+// ˵     reg             ļĴַ
+// ˵     *dat            ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_read_8bit_registers(IIC_1, 0x01, dat, 8);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_read_8bit_registers(iic_index_enum iic_n, const uint8 reg, uint8 *dat, uint32 len)
+iic_error_enum iic_read_8bit_registers(iic_index_enum iic_n, const uint8 reg, uint8 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, reg);
-    /* ߽ģʽ */
-    iic_start(iic_n);
-    for(uint32 i = 0; i < len; i++)
-        dat[i] = iic_read_data(iic_n, (i == len - 1) ? 0 : 1);
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, reg, 1, NULL, 0, dat, len, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڴӴĴȡ 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
+// ˵     reg             ļĴַ
 // ز     uint16          ضȡ 16bit 
 // ʹʾ     iic_read_16bit_register(IIC_1, 0x0101);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
 uint16 iic_read_16bit_register(iic_index_enum iic_n, const uint16 reg)
 {
-    uint16 dat;
-    iic_start(iic_n);
-    iic_send_data(iic_n, (uint8)(reg >> 8));
-    iic_send_data(iic_n, (uint8)(reg & 0xFF));
-    /* ߽ģʽ */
-    iic_start(iic_n);
-    dat  = (uint16)iic_read_data(iic_n, 1) << 8;
-    dat |= iic_read_data(iic_n, 0);
-    iic_stop(iic_n);
+    uint16 dat = 0;
+    if (iic_xfer_run(iic_n, reg, 2, NULL, 0, &dat, 1, IIC_XFER_16BIT) != IIC_ERROR_NONE) return 0;
     return dat;
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڴӴĴȡ 16bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
-// ˵     *dat           ҪȡݵĻָ
+// ˵     reg             ļĴַ
+// ˵     *dat            ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_read_16bit_registers(IIC_1, 0x0101, dat, 8);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_read_16bit_registers(iic_index_enum iic_n, const uint16 reg, uint16 *dat, uint32 len)
+iic_error_enum iic_read_16bit_registers(iic_index_enum iic_n, const uint16 reg, uint16 *dat, uint32 len)
 {
-    iic_start(iic_n);
-    iic_send_data(iic_n, (uint8)(reg >> 8));
-    iic_send_data(iic_n, (uint8)(reg & 0xFF));
-    /* ߽ģʽ */
-    iic_start(iic_n);
-    for(uint32 i = 0; i < len; i++)
-    {
-        dat[i]  = (uint16)iic_read_data(iic_n, (i == len - 1) ? 0 : 1) << 8;
-        dat[i] |= iic_read_data(iic_n, (i == len - 1) ? 0 : 1);
-    }
-    iic_stop(iic_n);
+    return iic_xfer_run(iic_n, reg, 2, NULL, 0, dat, len, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڴ 8bit  дȡ
 // ˵     iic_n           IIC ָ
-// ˵     *write_data     ݴŻ
-// ˵     write_len       ͻ
-// ˵     *read_data      ȡݴŻ
-// ˵     read_len        ȡ
-// ز     void            
-// ʹʾ     iic_transfer_8bit_array(IIC_1, addr, dat, 64, dat, 64);
-// עϢ     
-//-------------------------------------------------------------------------------------------------------------------
-void iic_transfer_8bit_array(iic_index_enum iic_n, const uint8 *wdat, uint32 wlen, uint8 *rdat, uint32 rlen)
-{
-    iic_start(iic_n);
-    for(uint32 i = 0; i < wlen; i++)
-        iic_send_data(iic_n, wdat[i]);
-    /* ߽ģʽ */
-    iic_start(iic_n);
-    for(uint32 i = 0; i < rlen; i++)
-        rdat[i] = iic_read_data(iic_n, (i == rlen - 1) ? 0 : 1);
-    iic_stop(iic_n);
+// ˵     *wdat           ݴŻ
+// ˵     wlen            ͻ
+// ˵     *rdat           ȡݴŻ
+// ˵     rlen            ȡ
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
+// ʹʾ     iic_transfer_8bit_array(IIC_1, dat, 64, dat, 64);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+iic_error_enum iic_transfer_8bit_array(iic_index_enum iic_n, const uint8 *wdat, uint32 wlen, uint8 *rdat, uint32 rlen)
+{
+    return iic_xfer_run(iic_n, 0, 0, wdat, wlen, rdat, rlen, 0);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڴ 16bit  дȡ
-// ˵     iic_n   			  IIC ָ
-// ˵     *write_data     ݴŻ
-// ˵     write_len       ͻ
-// ˵     *read_data      ȡݴŻ
-// ˵     read_len        ȡ
-// ز     void            
-// ʹʾ     iic_transfer_16bit_array(IIC_1, addr, dat, 64, dat, 64);
-// עϢ     
-//-------------------------------------------------------------------------------------------------------------------
-void iic_transfer_16bit_array(iic_index_enum iic_n, const uint16 *wdat, uint32 wlen, uint16 *rdat, uint32 rlen)
-{
-    iic_start(iic_n);
-    for(uint32 i = 0; i < wlen; i++)
-    {
-        iic_send_data(iic_n, (uint8)(wdat[i] >> 8));
-        iic_send_data(iic_n, (uint8)(wdat[i] & 0xFF));
-    }
-    /* ߽ģʽ */
-    iic_start(iic_n);
-    for(uint32 i = 0; i < rlen; i++)
-    {
-        rdat[i]  = (uint16)iic_read_data(iic_n, (i == rlen - 1) ? 0 : 1) << 8;
-        rdat[i] |= iic_read_data(iic_n, (i == rlen - 1) ? 0 : 1);
-    }
-    iic_stop(iic_n);
+// ˵     iic_n           IIC ָ
+// ˵     *wdat           ݴŻ
+// ˵     wlen            ͻ
+// ˵     *rdat           ȡݴŻ
+// ˵     rlen            ȡ
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
+// ʹʾ     iic_transfer_16bit_array(IIC_1, dat, 64, dat, 64);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+iic_error_enum iic_transfer_16bit_array(iic_index_enum iic_n, const uint16 *wdat, uint32 wlen, uint16 *rdat, uint32 rlen)
+{
+    return iic_xfer_run(iic_n, 0, 0, wdat, wlen, rdat, rlen, IIC_XFER_16BIT);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿ SCCB ģʽ򴫸Ĵд 8bit 
-// ˵     *soft_iic_obj    IIC ָϢ 
-// ˵     register_name   ļĴַ
-// ˵     dat            Ҫд
-// ز     void            
+// ˵     iic_n           IIC ָ
+// ˵     reg             ļĴַ
+// ˵     dat             Ҫд
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_sccb_write_register(IIC_1, 0x01, 0x01);
-// עϢ     
+// עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void iic_sccb_write_register(iic_index_enum iic_n, const uint8 reg, uint8 dat)
+iic_error_enum iic_sccb_write_register(iic_index_enum iic_n, const uint8 reg, uint8 dat)
 {
-    iic_write_8bit_register(iic_n, reg, dat);
+    return iic_write_8bit_register(iic_n, reg, dat);
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿ SCCB ģʽӴĴȡ 8bit 
 // ˵     iic_n           IIC ָ
-// ˵     register_name   ļĴַ
+// ˵     reg             ļĴַ
 // ز     uint8           ضȡ 8bit 
 // ʹʾ     iic_sccb_read_register(IIC_1, 0x01);
-// עϢ     
+// עϢ     SCCB ֧ظ START дĴַ STOP ٵȡ ʱ 0  iic_get_error
 //-------------------------------------------------------------------------------------------------------------------
 uint8 iic_sccb_read_register(iic_index_enum iic_n, const uint8 reg)
 {
-    return iic_read_8bit_register(iic_n, reg);
+    uint8 dat = 0;
+    if (iic_xfer_run(iic_n, reg, 1, NULL, 0, NULL, 0, 0) != IIC_ERROR_NONE) return 0;
+    if (iic_xfer_run(iic_n, 0, 0, NULL, 0, &dat, 1, 0) != IIC_ERROR_NONE) return 0;
+    return dat;
+}
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯһĽ
+// ˵     iic_n           IIC ָ
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
+// ʹʾ     dat = iic_read_8bit_register(IIC_1, 0x75); if (iic_get_error(IIC_1) != IIC_ERROR_NONE) { ... }
+// עϢ     ݵĶȡʱ 0 ֶ 0 봫ʧ
+//-------------------------------------------------------------------------------------------------------------------
+iic_error_enum iic_get_error(iic_index_enum iic_n)
+{
+    return g_iic_bus[iic_n].error;
 }
 //-------------------------------------------------------------------------------------------------------------------
 //      Ӳ IIC ӿڳʼ Ĭ MASTER ģʽ ṩ SLAVE ģʽ
-// ˵     iic_n   			  IIC ָ
-// ˵     addr            IIC ַ Ҫע ׼λַ λ дʱȷ
-// ˵     speed_khz       SCLʱƵʣֵԽSCLƵԽߣݴԽ
-// ˵     scl_pin         IIC ʱ 
-// ˵     sda_pin         IIC  
-// ز     void            
-// ʹʾ     iic_init(IIC_1, addr, 100, PB6, PB7);
-// עϢ     
+// ˵     iic_n           IIC ָ
+// ˵     addr            ӻַ ׼λַ λ  iic_* ַ
+// ˵     speed_khz       SCLʱƵʣֵԽSCLƵԽߣݴԽ  400
+// ˵     scl_pin         IIC ʱ
+// ˵     sda_pin         IIC 
+// ز     void
+// ʹʾ     iic_init(IIC_1, 0x68, 400, IIC1_SCL_PB6, IIC1_SDA_PB7);
+// עϢ     ͬʱ¼ж IIC_RX_USE_DMA Ϊ 1 ʱý DMA ͨ
+//              ͨѱռʱͻ · IIC Ϊ¼жֽڶȡ
 //-------------------------------------------------------------------------------------------------------------------
 void iic_init(iic_index_enum iic_n, uint8 addr, uint32 speed_khz, iic_pin_enum scl_pin, iic_pin_enum sda_pin)
 {
+    iic_bus_struct   *bus = &g_iic_bus[iic_n];
     I2C_InitTypeDef  iic;
     GPIO_InitTypeDef gpio;
+    NVIC_InitTypeDef nv;
     GPIO_TypeDef*    gpio_port;
     uint16_t         gpio_pin_scl;
     uint16_t         gpio_pin_sda;
-    I2C_TypeDef*     i2c_x;
+    I2C_TypeDef*     i2c_x = bus->i2cx;
+    uint8            priority = (iic_n == IIC_1) ? IIC1_NVIC_PREEMPT_PRIORITY : IIC2_NVIC_PREEMPT_PRIORITY;
+
+    iic_flush(iic_n);                                               /* ³ʼǰύĴ */
+    bus->addr = addr & 0x7F;
 
     if (iic_n == IIC_1)
     {
@@ -520,7 +940,6 @@ void iic_init(iic_index_enum iic_n, uint8 addr, uint32 speed_khz, iic_pin_enum s
             gpio_pin_scl = GPIO_Pin_6;
             gpio_pin_sda = GPIO_Pin_7;
         }
-        i2c_x = I2C1;
     }
     else /* IIC_2 */
     {
@@ -529,9 +948,13 @@ void iic_init(iic_index_enum iic_n, uint8 addr, uint32 speed_khz, iic_pin_enum s
         gpio_port    = GPIOB;
         gpio_pin_scl = GPIO_Pin_10;
         gpio_pin_sda = GPIO_Pin_11;
-        i2c_x = I2C2;
     }
 
+    bus->port    = gpio_port;
+    bus->scl_pin = gpio_pin_scl;
+    bus->sda_pin = gpio_pin_sda;
+    bus->error   = IIC_ERROR_NONE;
+
     gpio.GPIO_Pin   = gpio_pin_scl | gpio_pin_sda;
     gpio.GPIO_Speed = GPIO_Speed_50MHz;
     gpio.GPIO_Mode  = GPIO_Mode_AF_OD;
@@ -540,11 +963,51 @@ void iic_init(iic_index_enum iic_n, uint8 addr, uint32 speed_khz, iic_pin_enum s
     I2C_DeInit(i2c_x);
     iic.I2C_Mode                = I2C_Mode_I2C;
     iic.I2C_DutyCycle           = I2C_DutyCycle_2;
-    iic.I2C_OwnAddress1         = addr << 1;
+    iic.I2C_OwnAddress1         = 0;                                /* ֻ ַʹ */
     iic.I2C_Ack                 = I2C_Ack_Enable;
     iic.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
     iic.I2C_ClockSpeed          = speed_khz * 1000;
     I2C_Init(i2c_x, &iic);
     I2C_Cmd(i2c_x, ENABLE);
-}
+    i2c_x->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
 
+#if IIC_RX_USE_DMA
+    bus->dma_owned = dma1_claim(bus->rx_channel, (iic_n == IIC_1) ? DMA_OWNER_IIC1_RX : DMA_OWNER_IIC2_RX);
+    if (bus->dma_owned)
+    {
+        DMA_InitTypeDef dmaInit;
+
+        RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+        DMA_Cmd(bus->rx_dma, DISABLE);
+        DMA_StructInit(&dmaInit);
+        dmaInit.DMA_PeripheralBaseAddr = (uint32)&i2c_x->DR;
+        dmaInit.DMA_DIR                = DMA_DIR_PeripheralSRC;
+        dmaInit.DMA_BufferSize         = 1;
+        dmaInit.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+        dmaInit.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+        dmaInit.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+        dmaInit.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+        dmaInit.DMA_Mode               = DMA_Mode_Normal;
+        dmaInit.DMA_Priority           = DMA_Priority_High;
+        dmaInit.DMA_M2M                = DMA_M2M_Disable;
+        DMA_Init(bus->rx_dma, &dmaInit);
+
+        dma1_irq_register(bus->rx_channel, iic_dma_irq_handler, bus);
+        NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
+        nv.NVIC_IRQChannel                   = DMA1_Channel1_IRQn + bus->rx_channel;
+        nv.NVIC_IRQChannelPreemptionPriority = priority;
+        nv.NVIC_IRQChannelSubPriority        = 0;
+        nv.NVIC_IRQChannelCmd                = ENABLE;
+        NVIC_Init(&nv);
+    }
+#endif
+
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
+    nv.NVIC_IRQChannelPreemptionPriority = priority;
+    nv.NVIC_IRQChannelSubPriority        = 0;
+    nv.NVIC_IRQChannelCmd                = ENABLE;
+    nv.NVIC_IRQChannel                   = bus->ev_irq;
+    NVIC_Init(&nv);
+    nv.NVIC_IRQChannel                   = bus->er_irq;
+    NVIC_Init(&nv);
+}
@@ -17,38 +17,81 @@
 #ifndef _driver_iic_h_
 #define _driver_iic_h_
 
-#include "driver_gpio.h"
+#include "common_headfile.h"
 
-// 1ʾʹDMA0ʾʹͨݲ֧֣
+// 1ʾֽڶȡʹ DMA գ0ʾ¼жֽڶȡ
 // ĶҪȱ벢س򣬵ƬģҪϵͨѶ
-#define IIC_TX_USE_DMA         (1)                                       // Ĭʹ DMA ʽ	
-#define IIC_RX_USE_DMA         (0)                                       // Ĭʹ DMA ʽ	
-
-
-void iic_write_8bit(iic_index_enum iic_n, const uint8 dat);
-void iic_write_8bit_array(iic_index_enum iic_n, const uint8 *dat, uint32 len);
-void iic_write_16bit(iic_index_enum iic_n, const uint16 dat);
-void iic_write_16bit_array(iic_index_enum iic_n, const uint16 *dat, uint32 len);
-void iic_write_8bit_register(iic_index_enum iic_n, const uint8 reg, const uint8 dat);
-void iic_write_8bit_registers(iic_index_enum iic_n, const uint8 reg, const uint8 *dat, uint32 len);
-void iic_write_16bit_register(iic_index_enum iic_n, const uint16 reg, const uint16 dat);
-void iic_write_16bit_registers(iic_index_enum iic_n, const uint16 reg, const uint16 *dat, uint32 len);
-uint8 iic_read_8bit(iic_index_enum iic_n);
-void iic_read_8bit_array(iic_index_enum iic_n, uint8 *dat, uint32 len);
-uint16 iic_read_16bit(iic_index_enum iic_n);
-void iic_read_16bit_array(iic_index_enum iic_n, uint16 *dat, uint32 len);
-uint8 iic_read_8bit_register(iic_index_enum iic_n, const uint8 reg);
-void iic_read_8bit_registers(iic_index_enum iic_n, const uint8 reg, uint8 *dat, uint32 len);
-uint16 iic_read_16bit_register(iic_index_enum iic_n, const uint16 reg);
-void iic_read_16bit_registers(iic_index_enum iic_n, const uint16 reg, uint16 *dat, uint32 len);
-void iic_transfer_8bit_array(iic_index_enum iic_n, const uint8 *wdat, uint32 wlen, uint8 *rdat, uint32 rlen);
-void iic_transfer_16bit_array(iic_index_enum iic_n, const uint16 *wdat, uint32 wlen, uint16 *rdat, uint32 rlen);
-void iic_sccb_write_register(iic_index_enum iic_n, const uint8 reg, uint8 dat);
-uint8 iic_sccb_read_register(iic_index_enum iic_n, const uint8 reg);
-void iic_init(iic_index_enum iic_n, uint8 addr, uint32 speed_khz, iic_pin_enum scl_pin, iic_pin_enum sda_pin);
+#define IIC_RX_USE_DMA         (1)                                       // Ĭʹ DMA ʽ
 
+// жĴ
+// ÿΪ д START ַ+д Ĵַ ظ START ַ+ ȡ STOP дʡ
+// ¼жƽ״̬ ȡ 1/2 ֽʱֲ˳ ACK/POS/STOP 3 ֽ DMA գIIC_RX_USE_DMA Ϊ 1 ʱ
+//  iic_* ͬɶ ύ첽ִ֮ ش
+//  iic_flush ȴڼ IIC_TIMEOUT βѯûнչʱ ǰ IIC_ERROR_TIMEOUT  踴λͷ
+// ֻ iic_submit ʱڵõ iic_poll жϳʱ λȴ STOP ڿж״̬½
+// IIC1 ռ DMA1 ͨ 7 봮 2  DMA ͻ IIC2 ռ DMA1 ͨ 5  SPI2 ͡ 1  DMA ͻ
+// ͨѱǼռʱ · IIC Ϊ¼жֽڶȡ
+#define IIC_QUEUE_SIZE                  (8)                                     // ÿ· IIC ŶӵĴ Ϊ 2 
+#define IIC1_NVIC_PREEMPT_PRIORITY      (8)                                     // IIC1 ¼//DMA жռȼ
+#define IIC2_NVIC_PREEMPT_PRIORITY      (9)                                     // IIC2 ¼//DMA жռȼ
+#define IIC_TIMEOUT                     (0x0000FFFF)                            // ȴʱٴβѯûнչж߿ λ貢ͷ
+#define IIC_POLL_TIMEOUT                (10)                                    // iic_poll ٴεûнչж߿  1ms ڵԼΪ 10ms
 
+#define IIC_XFER_16BIT                  (0x01)                                  // tx/rx ָ uint16  Ȱ ֽǰ
 
+typedef enum
+{
+    IIC_XFER_IDLE,                                                              // δύȡ߽
+    IIC_XFER_QUEUED,                                                            // Ŷ
+    IIC_XFER_ACTIVE,                                                            // ڴ
+    IIC_XFER_DONE,                                                              //   error
+}iic_xfer_state_enum;
 
-#endif
+typedef struct iic_xfer_struct
+{
+    uint8                           addr;                                       // λӻַ
+    uint8                           reg_len;                                    // Ĵַֽ 0-2 ֽȷ
+    uint16                          reg;                                        // Ĵַ
+    const void                      *tx;                                        // Ĵַ֮д Ϊ NULL
+    uint32                          tx_len;                                     // д
+    void                            *rx;                                        // ȡ rx_len Ϊ 0 ʱֻд
+    uint32                          rx_len;                                     // ȡ
+    uint8                           flags;                                      // IIC_XFER_16BIT 0 Ϊ 8 λ
+    void                            (*callback)(struct iic_xfer_struct *xfer);  // ɻص жִ Ϊ NULL
+    void                            *user_data;                                 // صʹõû
+    volatile iic_xfer_state_enum    state;                                      // ״̬ ά
+    volatile iic_error_enum         error;                                      //  state Ϊ IIC_XFER_DONE ʱЧ
+}iic_xfer_struct;
+
+//====================================================IIC ====================================================
+iic_error_enum  iic_write_8bit              (iic_index_enum iic_n, const uint8 dat);
+iic_error_enum  iic_write_8bit_array        (iic_index_enum iic_n, const uint8 *dat, uint32 len);
+iic_error_enum  iic_write_16bit             (iic_index_enum iic_n, const uint16 dat);
+iic_error_enum  iic_write_16bit_array       (iic_index_enum iic_n, const uint16 *dat, uint32 len);
+iic_error_enum  iic_write_8bit_register     (iic_index_enum iic_n, const uint8 reg, const uint8 dat);
+iic_error_enum  iic_write_8bit_registers    (iic_index_enum iic_n, const uint8 reg, const uint8 *dat, uint32 len);
+iic_error_enum  iic_write_16bit_register    (iic_index_enum iic_n, const uint16 reg, const uint16 dat);
+iic_error_enum  iic_write_16bit_registers   (iic_index_enum iic_n, const uint16 reg, const uint16 *dat, uint32 len);
+uint8           iic_read_8bit               (iic_index_enum iic_n);
+iic_error_enum  iic_read_8bit_array         (iic_index_enum iic_n, uint8 *dat, uint32 len);
+uint16          iic_read_16bit              (iic_index_enum iic_n);
+iic_error_enum  iic_read_16bit_array        (iic_index_enum iic_n, uint16 *dat, uint32 len);
+uint8           iic_read_8bit_register      (iic_index_enum iic_n, const uint8 reg);
+iic_error_enum  iic_read_8bit_registers     (iic_index_enum iic_n, const uint8 reg, uint8 *dat, uint32 len);
+uint16          iic_read_16bit_register     (iic_index_enum iic_n, const uint16 reg);
+iic_error_enum  iic_read_16bit_registers    (iic_index_enum iic_n, const uint16 reg, uint16 *dat, uint32 len);
+iic_error_enum  iic_transfer_8bit_array     (iic_index_enum iic_n, const uint8 *wdat, uint32 wlen, uint8 *rdat, uint32 rlen);
+iic_error_enum  iic_transfer_16bit_array    (iic_index_enum iic_n, const uint16 *wdat, uint32 wlen, uint16 *rdat, uint32 rlen);
+iic_error_enum  iic_sccb_write_register     (iic_index_enum iic_n, const uint8 reg, uint8 dat);
+uint8           iic_sccb_read_register      (iic_index_enum iic_n, const uint8 reg);
+iic_error_enum  iic_get_error               (iic_index_enum iic_n);
+
+uint8           iic_submit                  (iic_index_enum iic_n, iic_xfer_struct *xfer);
+uint32          iic_pending                 (iic_index_enum iic_n);
+void            iic_flush                   (iic_index_enum iic_n);
+void            iic_poll                    (iic_index_enum iic_n);
 
+void            iic_init                    (iic_index_enum iic_n, uint8 addr, uint32 speed_khz, iic_pin_enum scl_pin, iic_pin_enum sda_pin);
+//====================================================IIC ====================================================
+
+#endif
@@ -14,6 +14,7 @@
 * 2026-01-01        Lihua      first version
 ********************************************************************************************************************/
 
+
 #include "driver_soft_iic.h"
 
 //#pragma warning disable = 183
@@ -22,6 +23,15 @@
 
 #define SOFT_IIC_SDA_IO_SWITCH          (0)                                     // ǷҪ SDA  I/O л 0-Ҫ 1-Ҫ
 
+// Ϊ© д BSRR ͷΪߵƽ д BRR   IDR õϵʵʵƽ
+#define SOFT_IIC_SCL_LOW(obj)           ((obj)->scl_port->BRR  = (obj)->scl_mask)
+#define SOFT_IIC_SDA_HIGH(obj)          ((obj)->sda_port->BSRR = (obj)->sda_mask)
+#define SOFT_IIC_SDA_LOW(obj)           ((obj)->sda_port->BRR  = (obj)->sda_mask)
+#define SOFT_IIC_SDA_SET(obj, level)    ((level) ? SOFT_IIC_SDA_HIGH(obj) : SOFT_IIC_SDA_LOW(obj))
+#define SOFT_IIC_SCL_GET(obj)           (((obj)->scl_port->IDR & (obj)->scl_mask) ? 1 : 0)
+#define SOFT_IIC_SDA_GET(obj)           (((obj)->sda_port->IDR & (obj)->sda_mask) ? 1 : 0)
+#define SOFT_IIC_DELAY(obj)             do { if((obj)->delay) soft_iic_delay((obj)->delay); } while(0)
+
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC ʱ
 // ˵     delay           ʱ
@@ -36,186 +46,285 @@ void soft_iic_delay (vuint32 delay)
 }
 //#define soft_iic_delay(x)  for(uint32 i = x; i--; )
 
+//-------------------------------------------------------------------------------------------------------------------
+//       IIC ͷ SCL
+// ˵     *soft_iic_obj    IIC ָϢ
+// ز     uint8           0-SCL Ϊߵƽ 1-ȴʱչʱ
+// ʹʾ     soft_iic_scl_high(soft_iic_obj);
+// עϢ     ڲ stretch Ϊ 0 ʱȴӻɿ SCL ʱΪ IIC_ERROR_TIMEOUT
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 soft_iic_scl_high (soft_iic_info_struct *soft_iic_obj)
+{
+    uint32 wait = soft_iic_obj->stretch;
+
+    soft_iic_obj->scl_port->BSRR = soft_iic_obj->scl_mask;
+    if(wait)
+    {
+        while(!SOFT_IIC_SCL_GET(soft_iic_obj))
+        {
+            if(0 == -- wait)
+            {
+                if(IIC_ERROR_NONE == soft_iic_obj->error)
+                {
+                    soft_iic_obj->error = IIC_ERROR_TIMEOUT;
+                }
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC START ź
-// ˵     *soft_iic_obj    IIC ָϢ 
+// ˵     *soft_iic_obj    IIC ָϢ
 // ز     void
 // ʹʾ     soft_iic_start(soft_iic_obj);
-// עϢ     ڲ
+// עϢ     ڲ Ҳظ START ʱ SCL Ϊ͵ƽ ͷ SDA ͷ SCL
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_start (soft_iic_info_struct *soft_iic_obj)
+static void soft_iic_start (soft_iic_info_struct *soft_iic_obj)
 {
-    zf_assert(soft_iic_obj != NULL);
-    gpio_high(soft_iic_obj->scl_pin);                                           // SCL ߵƽ
-    gpio_high(soft_iic_obj->sda_pin);                                           // SDA ߵƽ
+    SOFT_IIC_SDA_HIGH(soft_iic_obj);                                            // SDA ߵƽ
+    if(soft_iic_scl_high(soft_iic_obj))                                         // SCL ߵƽ
+    {
+        return;
+    }
 
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_low(soft_iic_obj->sda_pin);                                            // SDA 
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL 
+    SOFT_IIC_DELAY(soft_iic_obj);
+    SOFT_IIC_SDA_LOW(soft_iic_obj);                                             // SDA 
+    SOFT_IIC_DELAY(soft_iic_obj);
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL 
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC STOP ź
-// ˵     *soft_iic_obj    IIC ָϢ 
-// ز     void
-// ʹʾ     soft_iic_stop(soft_iic_obj);
-// עϢ     ڲ
+// ˵     *soft_iic_obj    IIC ָϢ
+// ز     iic_error_enum  δĽ
+// ʹʾ     return soft_iic_stop(soft_iic_obj);
+// עϢ     ڲ ʱͬ STOP ͷ
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_stop (soft_iic_info_struct *soft_iic_obj)
+static iic_error_enum soft_iic_stop (soft_iic_info_struct *soft_iic_obj)
 {
-    zf_assert(soft_iic_obj != NULL);
-    gpio_low(soft_iic_obj->sda_pin);                                            // SDA ͵ƽ
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL ͵ƽ
-
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_high(soft_iic_obj->scl_pin);                                           // SCL 
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_high(soft_iic_obj->sda_pin);                                           // SDA 
-    soft_iic_delay(soft_iic_obj->delay);
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL ͵ƽ
+    SOFT_IIC_SDA_LOW(soft_iic_obj);                                             // SDA ͵ƽ
+
+    SOFT_IIC_DELAY(soft_iic_obj);
+    soft_iic_scl_high(soft_iic_obj);                                            // SCL 
+    SOFT_IIC_DELAY(soft_iic_obj);
+    SOFT_IIC_SDA_HIGH(soft_iic_obj);                                            // SDA 
+    SOFT_IIC_DELAY(soft_iic_obj);
+    return soft_iic_obj->error;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC  ACK/NAKC ź ڲ
-// ˵     *soft_iic_obj    IIC ָϢ 
+// ˵     *soft_iic_obj    IIC ָϢ
 // ˵     ack             ACK ƽ
 // ز     void
 // ʹʾ     soft_iic_send_ack(soft_iic_obj, 1);
 // עϢ     ڲ
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_send_ack (soft_iic_info_struct *soft_iic_obj, uint8 ack)
+static void soft_iic_send_ack (soft_iic_info_struct *soft_iic_obj, uint8 ack)
 {
-    zf_assert(soft_iic_obj != NULL);
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL ͵ƽ
-
-    if(ack)
-    {
-        gpio_high(soft_iic_obj->sda_pin);                                       // SDA 
-    }
-    else
-    {
-        gpio_low(soft_iic_obj->sda_pin);                                        // SDA 
-    }
-
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_high(soft_iic_obj->scl_pin);                                           // SCL 
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL 
-    gpio_high(soft_iic_obj->sda_pin);                                           // SDA 
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL ͵ƽ
+    SOFT_IIC_SDA_SET(soft_iic_obj, ack);                                        // 1-SDA  NACK 0-SDA  ACK
+
+    SOFT_IIC_DELAY(soft_iic_obj);
+    soft_iic_scl_high(soft_iic_obj);                                            // SCL 
+    SOFT_IIC_DELAY(soft_iic_obj);
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL 
+    SOFT_IIC_SDA_HIGH(soft_iic_obj);                                            // SDA 
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC ȡ ACK/NAKC ź
-// ˵     *soft_iic_obj    IIC ָϢ 
-// ز     uint8           ACK ״̬
+// ˵     *soft_iic_obj    IIC ָϢ
+// ز     uint8           1-NACK 0-ACK
 // ʹʾ     soft_iic_wait_ack(soft_iic_obj);
-// עϢ     ڲ
+// עϢ     ڲ ֮һֽڵݽʱ ﲻ׷ʱ
 //-------------------------------------------------------------------------------------------------------------------
-uint8 soft_iic_wait_ack (soft_iic_info_struct *soft_iic_obj)
+static uint8 soft_iic_wait_ack (soft_iic_info_struct *soft_iic_obj)
 {
-	uint8 temp = 0;
-    zf_assert(soft_iic_obj != NULL);
-  
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL ͵ƽ
-    gpio_high(soft_iic_obj->sda_pin);                                           // SDA ߵƽ ͷ SDA
+    uint8 temp = 0;
+
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL ͵ƽ
+    SOFT_IIC_SDA_HIGH(soft_iic_obj);                                            // SDA ߵƽ ͷ SDA
 #if SOFT_IIC_SDA_IO_SWITCH
     gpio_set_dir(soft_iic_obj->sda_pin, GPI, GPI_FLOATING_IN);
 #endif
-    soft_iic_delay(soft_iic_obj->delay);
-
-    gpio_high(soft_iic_obj->scl_pin);                                           // SCL ߵƽ
-    soft_iic_delay(soft_iic_obj->delay);
+    SOFT_IIC_DELAY(soft_iic_obj);
 
-    if(gpio_get_level((gpio_pin_enum)soft_iic_obj->sda_pin))
+    if(!soft_iic_scl_high(soft_iic_obj))                                        // SCL ߵƽ
     {
-        temp = 1;
+        SOFT_IIC_DELAY(soft_iic_obj);
+        temp = SOFT_IIC_SDA_GET(soft_iic_obj);
     }
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL ͵ƽ
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL ͵ƽ
 #if SOFT_IIC_SDA_IO_SWITCH
     gpio_set_dir(soft_iic_obj->sda_pin, GPO, GPO_OPEN_DTAIN);
 #endif
-    soft_iic_delay(soft_iic_obj->delay);
 
     return temp;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC  8bit 
-// ˵     *soft_iic_obj    IIC ָϢ 
+// ˵     *soft_iic_obj    IIC ָϢ
 // ˵     dat            
-// ز     uint8           ACK ״̬
-// עϢ     ڲ
+// ز     void
+// עϢ     ڲ δѳʱٲ ӦΪ IIC_ERROR_NACK
 //-------------------------------------------------------------------------------------------------------------------
-uint8 soft_iic_send_data (soft_iic_info_struct *soft_iic_obj, const uint8 dat)
+static void soft_iic_send_data (soft_iic_info_struct *soft_iic_obj, const uint8 dat)
 {
-	uint8 temp = 0x80;
-	
-   zf_assert(soft_iic_obj != NULL);
-
-    while(temp)
+    if(IIC_ERROR_NONE != soft_iic_obj->error)
     {
-        ((dat & temp) ? (gpio_high(soft_iic_obj->sda_pin)) : (gpio_low(soft_iic_obj->sda_pin)));
-        temp >>= 1;
+        return;
+    }
 
-        soft_iic_delay(soft_iic_obj->delay);
-        gpio_high(soft_iic_obj->scl_pin);                                       // SCL 
-        soft_iic_delay(soft_iic_obj->delay);
-        gpio_low(soft_iic_obj->scl_pin);                                        // SCL 
+    for(uint8 temp = 0x80; temp; temp >>= 1)
+    {
+        SOFT_IIC_SDA_SET(soft_iic_obj, dat & temp);
+        SOFT_IIC_DELAY(soft_iic_obj);
+        if(soft_iic_scl_high(soft_iic_obj))                                     // SCL 
+        {
+            return;
+        }
+        SOFT_IIC_DELAY(soft_iic_obj);
+        SOFT_IIC_SCL_LOW(soft_iic_obj);                                         // SCL 
+    }
+    if(soft_iic_wait_ack(soft_iic_obj) && IIC_ERROR_NONE == soft_iic_obj->error)
+    {
+        soft_iic_obj->error = IIC_ERROR_NACK;
     }
-    return ((soft_iic_wait_ack(soft_iic_obj) == 1) ? 0 : 1 );
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC ȡ 8bit 
-// ˵     *soft_iic_obj    IIC ָϢ 
+// ˵     *soft_iic_obj    IIC ָϢ
 // ˵     ack             ACK  NACK
-// ز     uint8           
-// עϢ     ڲ
+// ز     uint8            δѳʱ 0
+// עϢ     ڲ ʱ SCL Ϊ͵ƽ
 //-------------------------------------------------------------------------------------------------------------------
-uint8 soft_iic_read_data (soft_iic_info_struct *soft_iic_obj, uint8 ack)
+static uint8 soft_iic_read_data (soft_iic_info_struct *soft_iic_obj, uint8 ack)
 {
     uint8 dat = 0x00;
-    uint8 temp = 8;
-		zf_assert(soft_iic_obj != NULL);
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL ͵ƽ
-    soft_iic_delay(soft_iic_obj->delay);
-    gpio_high(soft_iic_obj->sda_pin);                                           // SDA ߵƽ ͷ SDA
+
+    if(IIC_ERROR_NONE != soft_iic_obj->error)
+    {
+        return 0;
+    }
+
+    SOFT_IIC_SDA_HIGH(soft_iic_obj);                                            // SDA ߵƽ ͷ SDA
 #if SOFT_IIC_SDA_IO_SWITCH
     gpio_set_dir(soft_iic_obj->sda_pin, GPI, GPI_FLOATING_IN);
 #endif
 
-    while(temp --)
+    for(uint8 temp = 8; temp --; )
     {
-        gpio_low(soft_iic_obj->scl_pin);                                        // SCL 
-        soft_iic_delay(soft_iic_obj->delay);
-        gpio_high(soft_iic_obj->scl_pin);                                       // SCL 
-        soft_iic_delay(soft_iic_obj->delay);
-        dat = ((dat << 1) | gpio_get_level((gpio_pin_enum)soft_iic_obj->sda_pin));
+        SOFT_IIC_SCL_LOW(soft_iic_obj);                                         // SCL 
+        SOFT_IIC_DELAY(soft_iic_obj);
+        if(soft_iic_scl_high(soft_iic_obj))                                     // SCL 
+        {
+            return 0;
+        }
+        SOFT_IIC_DELAY(soft_iic_obj);
+        dat = (uint8)((dat << 1) | SOFT_IIC_SDA_GET(soft_iic_obj));
     }
-    gpio_low(soft_iic_obj->scl_pin);                                            // SCL ͵ƽ
 #if SOFT_IIC_SDA_IO_SWITCH
+    SOFT_IIC_SCL_LOW(soft_iic_obj);                                             // SCL ͵ƽ
     gpio_set_dir(soft_iic_obj->sda_pin, GPO, GPO_OPEN_DTAIN);
 #endif
-    soft_iic_delay(soft_iic_obj->delay);
     soft_iic_send_ack(soft_iic_obj, ack);
     return dat;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//       IIC ߻ָ
+// ˵     *soft_iic_obj    IIC ָϢ
+// ز     iic_error_enum  IIC_ERROR_NONE-ѿ IIC_ERROR_BUS-SDA/SCL Ա IIC_ERROR_TIMEOUT-ʱչʱ
+// ʹʾ     soft_iic_bus_recover(&mpu6050_iic_struct);
+// עϢ     Ƭڴ;λʱ ӻ 0 һֱ SDA
+//              ͷ SDA  9  SCL ʱ ôӻֽڷ SDA ߺٷ STOP
+//              soft_iic_init ÿδ俪ʼʱ SDA/SCL Ϊ͵ƽԶ
+//-------------------------------------------------------------------------------------------------------------------
+iic_error_enum soft_iic_bus_recover (soft_iic_info_struct *soft_iic_obj)
+{
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_obj->error = IIC_ERROR_NONE;
+
+    SOFT_IIC_SDA_HIGH(soft_iic_obj);                                            // ͷ SDA
+    for(uint8 i = 0; 9 > i && !SOFT_IIC_SDA_GET(soft_iic_obj); i ++)
+    {
+        SOFT_IIC_SCL_LOW(soft_iic_obj);
+        SOFT_IIC_DELAY(soft_iic_obj);
+        if(soft_iic_scl_high(soft_iic_obj))
+        {
+            break;
+        }
+        SOFT_IIC_DELAY(soft_iic_obj);
+    }
+    soft_iic_stop(soft_iic_obj);
+
+    if(IIC_ERROR_NONE == soft_iic_obj->error && (!SOFT_IIC_SDA_GET(soft_iic_obj) || !SOFT_IIC_SCL_GET(soft_iic_obj)))
+    {
+        soft_iic_obj->error = IIC_ERROR_BUS;
+    }
+    return soft_iic_obj->error;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       IIC ʼһδ START ַ
+// ˵     *soft_iic_obj    IIC ָϢ
+// ˵     read            0-д 1-
+// ز     void
+// ʹʾ     soft_iic_begin(soft_iic_obj, 0);
+// עϢ     ڲ ϴεĴ ûпʱ߻ָ
+//-------------------------------------------------------------------------------------------------------------------
+static void soft_iic_begin (soft_iic_info_struct *soft_iic_obj, uint8 read)
+{
+    soft_iic_obj->error = IIC_ERROR_NONE;
+    if(!SOFT_IIC_SDA_GET(soft_iic_obj) || !SOFT_IIC_SCL_GET(soft_iic_obj))
+    {
+        if(IIC_ERROR_NONE != soft_iic_bus_recover(soft_iic_obj))
+        {
+            return;
+        }
+    }
+    soft_iic_start(soft_iic_obj);
+    soft_iic_send_data(soft_iic_obj, (uint8)((soft_iic_obj->addr << 1) | read));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       IIC ظ START ԶʽѰַ
+// ˵     *soft_iic_obj    IIC ָϢ
+// ز     void
+// ʹʾ     soft_iic_restart(soft_iic_obj);
+// עϢ     ڲ д׶ѳʱٲ
+//-------------------------------------------------------------------------------------------------------------------
+static void soft_iic_restart (soft_iic_info_struct *soft_iic_obj)
+{
+    if(IIC_ERROR_NONE != soft_iic_obj->error)
+    {
+        return;
+    }
+    soft_iic_start(soft_iic_obj);
+    soft_iic_send_data(soft_iic_obj, (uint8)((soft_iic_obj->addr << 1) | 0x01));
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC ӿд 8bit 
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ˵     dat            Ҫд
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_8bit_register(soft_iic_obj, 0x01);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_8bit (soft_iic_info_struct *soft_iic_obj, const uint8 dat)
+iic_error_enum soft_iic_write_8bit (soft_iic_info_struct *soft_iic_obj, const uint8 dat)
 {
     zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, dat);
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -223,39 +332,37 @@ void soft_iic_write_8bit (soft_iic_info_struct *soft_iic_obj, const uint8 dat)
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ˵     *dat           ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_8bit_array(soft_iic_obj, dat, 6);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_8bit_array (soft_iic_info_struct *soft_iic_obj, const uint8 *dat, uint32 len)
+iic_error_enum soft_iic_write_8bit_array (soft_iic_info_struct *soft_iic_obj, const uint8 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     while(len --)
     {
         soft_iic_send_data(soft_iic_obj, *dat ++);
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC ӿд 16bit 
 // ˵     *soft_iic_obj    IIC ָϢ
 // ˵     dat            Ҫд
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_16bit(soft_iic_obj, 0x0101);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_16bit (soft_iic_info_struct *soft_iic_obj, const uint16 dat)
+iic_error_enum soft_iic_write_16bit (soft_iic_info_struct *soft_iic_obj, const uint16 dat)
 {
     zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, (uint8)((dat & 0xFF00) >> 8));
     soft_iic_send_data(soft_iic_obj, (uint8)(dat & 0x00FF));
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -263,22 +370,21 @@ void soft_iic_write_16bit (soft_iic_info_struct *soft_iic_obj, const uint16 dat)
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ˵     *dat           ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_16bit_array(soft_iic_obj, dat, 6);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_16bit_array (soft_iic_info_struct *soft_iic_obj, const uint16 *dat, uint32 len)
+iic_error_enum soft_iic_write_16bit_array (soft_iic_info_struct *soft_iic_obj, const uint16 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     while(len --)
     {
         soft_iic_send_data(soft_iic_obj, (uint8)((*dat & 0xFF00) >> 8));
         soft_iic_send_data(soft_iic_obj, (uint8)(*dat ++ & 0x00FF));
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -286,18 +392,17 @@ void soft_iic_write_16bit_array (soft_iic_info_struct *soft_iic_obj, const uint1
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ˵     register_name   ļĴַ
 // ˵     dat            Ҫд
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_8bit_register(soft_iic_obj, 0x01, 0x01);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_8bit_register (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 dat)
+iic_error_enum soft_iic_write_8bit_register (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 dat)
 {
     zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, register_name);
     soft_iic_send_data(soft_iic_obj, dat);
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -306,22 +411,21 @@ void soft_iic_write_8bit_register (soft_iic_info_struct *soft_iic_obj, const uin
 // ˵     register_name   ļĴַ
 // ˵     *dat           ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_8bit_registers(soft_iic_obj, 0x01, dat, 6);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_8bit_registers (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 *dat, uint32 len)
+iic_error_enum soft_iic_write_8bit_registers (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, register_name);
     while(len --)
     {
         soft_iic_send_data(soft_iic_obj, *dat ++);
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -329,20 +433,19 @@ void soft_iic_write_8bit_registers (soft_iic_info_struct *soft_iic_obj, const ui
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ˵     register_name   ļĴַ
 // ˵     dat            Ҫд
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_16bit_register(soft_iic_obj, 0x0101, 0x0101);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_16bit_register (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 dat)
+iic_error_enum soft_iic_write_16bit_register (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 dat)
 {
     zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, (uint8)((register_name & 0xFF00) >> 8));
     soft_iic_send_data(soft_iic_obj, (uint8)(register_name & 0x00FF));
     soft_iic_send_data(soft_iic_obj, (uint8)((dat & 0xFF00) >> 8));
     soft_iic_send_data(soft_iic_obj, (uint8)(dat & 0x00FF));
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -351,16 +454,15 @@ void soft_iic_write_16bit_register (soft_iic_info_struct *soft_iic_obj, const ui
 // ˵     register_name   ļĴַ
 // ˵     *dat           ݴŻ
 // ˵     len             
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_write_16bit_registers(soft_iic_obj, 0x0101, dat, 6);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_write_16bit_registers (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 *dat, uint32 len)
+iic_error_enum soft_iic_write_16bit_registers (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, (uint8)((register_name & 0xFF00) >> 8));
     soft_iic_send_data(soft_iic_obj, (uint8)(register_name & 0x00FF));
     while(len--)
@@ -368,7 +470,7 @@ void soft_iic_write_16bit_registers (soft_iic_info_struct *soft_iic_obj, const u
         soft_iic_send_data(soft_iic_obj, (uint8)((*dat & 0xFF00) >> 8));
         soft_iic_send_data(soft_iic_obj, (uint8)(*dat ++ & 0x00FF));
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -376,14 +478,13 @@ void soft_iic_write_16bit_registers (soft_iic_info_struct *soft_iic_obj, const u
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ز     uint8           ضȡ 8bit 
 // ʹʾ     soft_iic_read_8bit(soft_iic_obj);
-// עϢ     
+// עϢ     ʱ 0  soft_iic_obj->error
 //-------------------------------------------------------------------------------------------------------------------
 uint8 soft_iic_read_8bit (soft_iic_info_struct *soft_iic_obj)
 {
     uint8 temp = 0;
-		zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_begin(soft_iic_obj, 1);
     temp = soft_iic_read_data(soft_iic_obj, 1);
     soft_iic_stop(soft_iic_obj);
     return temp;
@@ -395,21 +496,20 @@ uint8 soft_iic_read_8bit (soft_iic_info_struct *soft_iic_obj)
 // ˵     register_name   ļĴַ
 // ˵     *dat           ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_read_8bit_array(soft_iic_obj, dat, 8);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_read_8bit_array (soft_iic_info_struct *soft_iic_obj, uint8 *dat, uint32 len)
+iic_error_enum soft_iic_read_8bit_array (soft_iic_info_struct *soft_iic_obj, uint8 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    soft_iic_begin(soft_iic_obj, 1);
     while(len --)
     {
         *dat ++ = soft_iic_read_data(soft_iic_obj, len == 0);
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -418,14 +518,13 @@ void soft_iic_read_8bit_array (soft_iic_info_struct *soft_iic_obj, uint8 *dat, u
 // ˵     register_name   ļĴַ
 // ز     uint16          ضȡ 16bit 
 // ʹʾ     soft_iic_read_16bit(soft_iic_obj);
-// עϢ     
+// עϢ     ʱ 0  soft_iic_obj->error
 //-------------------------------------------------------------------------------------------------------------------
 uint16 soft_iic_read_16bit (soft_iic_info_struct *soft_iic_obj)
 {
     uint16 temp = 0;
-		zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_begin(soft_iic_obj, 1);
     temp = soft_iic_read_data(soft_iic_obj, 0);
     temp = ((temp << 8)| soft_iic_read_data(soft_iic_obj, 1));
     soft_iic_stop(soft_iic_obj);
@@ -437,23 +536,22 @@ uint16 soft_iic_read_16bit (soft_iic_info_struct *soft_iic_obj)
 // ˵     *soft_iic_obj    IIC ָϢ Բ 
 // ˵     *dat           ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_read_16bit_array(soft_iic_obj, dat, 8);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_read_16bit_array (soft_iic_info_struct *soft_iic_obj, uint16 *dat, uint32 len)
+iic_error_enum soft_iic_read_16bit_array (soft_iic_info_struct *soft_iic_obj, uint16 *dat, uint32 len)
 {
-		zf_assert(soft_iic_obj != NULL);
-		zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    zf_assert(soft_iic_obj != NULL);
+    zf_assert(dat != NULL);
+    soft_iic_begin(soft_iic_obj, 1);
     while(len --)
     {
         *dat = soft_iic_read_data(soft_iic_obj, 0);
         *dat = ((*dat << 8)| soft_iic_read_data(soft_iic_obj, len == 0));
         dat ++;
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -462,17 +560,15 @@ void soft_iic_read_16bit_array (soft_iic_info_struct *soft_iic_obj, uint16 *dat,
 // ˵     register_name   ļĴַ
 // ز     uint8           ضȡ 8bit 
 // ʹʾ     soft_iic_read_8bit_register(soft_iic_obj, 0x01);
-// עϢ     
+// עϢ     ʱ 0  soft_iic_obj->error
 //-------------------------------------------------------------------------------------------------------------------
 uint8 soft_iic_read_8bit_register (soft_iic_info_struct *soft_iic_obj, const uint8 register_name)
 {
     uint8 temp = 0;
-		zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, register_name);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    soft_iic_restart(soft_iic_obj);
     temp = soft_iic_read_data(soft_iic_obj, 1);
     soft_iic_stop(soft_iic_obj);
     return temp;
@@ -484,24 +580,22 @@ uint8 soft_iic_read_8bit_register (soft_iic_info_struct *soft_iic_obj, const uin
 // ˵     register_name   ļĴַ
 // ˵     *dat           ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_read_8bit_registers(soft_iic_obj, 0x01, dat, 8);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_read_8bit_registers (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 *dat, uint32 len)
+iic_error_enum soft_iic_read_8bit_registers (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, register_name);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    soft_iic_restart(soft_iic_obj);
     while(len --)
     {
         *dat ++ = soft_iic_read_data(soft_iic_obj, len == 0);
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -510,18 +604,16 @@ void soft_iic_read_8bit_registers (soft_iic_info_struct *soft_iic_obj, const uin
 // ˵     register_name   ļĴַ
 // ز     uint16          ضȡ 16bit 
 // ʹʾ     soft_iic_read_16bit_register(soft_iic_obj, 0x0101);
-// עϢ     
+// עϢ     ʱ 0  soft_iic_obj->error
 //-------------------------------------------------------------------------------------------------------------------
 uint16 soft_iic_read_16bit_register (soft_iic_info_struct *soft_iic_obj, const uint16 register_name)
 {
     uint16 temp = 0;
-		zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, (uint8)((register_name & 0xFF00) >> 8));
     soft_iic_send_data(soft_iic_obj, (uint8)(register_name & 0x00FF));
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    soft_iic_restart(soft_iic_obj);
     temp = soft_iic_read_data(soft_iic_obj, 0);
     temp = ((temp << 8)| soft_iic_read_data(soft_iic_obj, 1));
     soft_iic_stop(soft_iic_obj);
@@ -534,27 +626,25 @@ uint16 soft_iic_read_16bit_register (soft_iic_info_struct *soft_iic_obj, const u
 // ˵     register_name   ļĴַ
 // ˵     *dat           ҪȡݵĻָ
 // ˵     len             Ҫȡݳ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_read_16bit_registers(soft_iic_obj, 0x0101, dat, 8);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_read_16bit_registers (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, uint16 *dat, uint32 len)
+iic_error_enum soft_iic_read_16bit_registers (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, uint16 *dat, uint32 len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(dat != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, (uint8)((register_name & 0xFF00) >> 8));
     soft_iic_send_data(soft_iic_obj, (uint8)(register_name & 0x00FF));
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    soft_iic_restart(soft_iic_obj);
     while(len --)
     {
         *dat = soft_iic_read_data(soft_iic_obj, 0);
         *dat = ((*dat << 8)| soft_iic_read_data(soft_iic_obj, len == 0));
         dat ++;
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -564,17 +654,16 @@ void soft_iic_read_16bit_registers (soft_iic_info_struct *soft_iic_obj, const ui
 // ˵     write_len       ͻ
 // ˵     *read_data      ȡݴŻ
 // ˵     read_len        ȡ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_transfer_8bit_array(IIC_1, addr, dat, 64, dat, 64);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_transfer_8bit_array (soft_iic_info_struct *soft_iic_obj, const uint8 *write_data, uint32 write_len, uint8 *read_data, uint32 read_len)
+iic_error_enum soft_iic_transfer_8bit_array (soft_iic_info_struct *soft_iic_obj, const uint8 *write_data, uint32 write_len, uint8 *read_data, uint32 read_len)
 {
     zf_assert(soft_iic_obj != NULL);
     zf_assert(write_data != NULL);
     zf_assert(read_data != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     while(write_len --)
     {
         soft_iic_send_data(soft_iic_obj, *write_data ++);
@@ -582,14 +671,13 @@ void soft_iic_transfer_8bit_array (soft_iic_info_struct *soft_iic_obj, const uin
 
     if(read_len)
     {
-        soft_iic_start(soft_iic_obj);
-        soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+        soft_iic_restart(soft_iic_obj);
         while(read_len --)
         {
             *read_data ++ = soft_iic_read_data(soft_iic_obj, read_len == 0);
         }
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -599,17 +687,16 @@ void soft_iic_transfer_8bit_array (soft_iic_info_struct *soft_iic_obj, const uin
 // ˵     write_len       ͻ
 // ˵     *read_data      ȡݴŻ
 // ˵     read_len        ȡ
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     iic_transfer_16bit_array(IIC_1, addr, dat, 64, dat, 64);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_transfer_16bit_array (soft_iic_info_struct *soft_iic_obj, const uint16 *write_data, uint32 write_len, uint16 *read_data, uint32 read_len)
+iic_error_enum soft_iic_transfer_16bit_array (soft_iic_info_struct *soft_iic_obj, const uint16 *write_data, uint32 write_len, uint16 *read_data, uint32 read_len)
 {
-		zf_assert(soft_iic_obj != NULL);
-		zf_assert(write_data != NULL);
-		zf_assert(read_data != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    zf_assert(soft_iic_obj != NULL);
+    zf_assert(write_data != NULL);
+    zf_assert(read_data != NULL);
+    soft_iic_begin(soft_iic_obj, 0);
     while(write_len--)
     {
         soft_iic_send_data(soft_iic_obj, (uint8)((*write_data & 0xFF00) >> 8));
@@ -617,8 +704,7 @@ void soft_iic_transfer_16bit_array (soft_iic_info_struct *soft_iic_obj, const ui
     }
     if(read_len)
     {
-        soft_iic_start(soft_iic_obj);
-        soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+        soft_iic_restart(soft_iic_obj);
         while(read_len --)
         {
             *read_data = soft_iic_read_data(soft_iic_obj, 0);
@@ -626,7 +712,7 @@ void soft_iic_transfer_16bit_array (soft_iic_info_struct *soft_iic_obj, const ui
             read_data ++;
         }
     }
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -634,18 +720,17 @@ void soft_iic_transfer_16bit_array (soft_iic_info_struct *soft_iic_obj, const ui
 // ˵     *soft_iic_obj    IIC ָϢ 
 // ˵     register_name   ļĴַ
 // ˵     dat            Ҫд
-// ز     void            
+// ز     iic_error_enum   IIC_ERROR_NONE-ɹ
 // ʹʾ     soft_iic_sccb_write_register(soft_iic_obj, 0x01, 0x01);
 // עϢ     
 //-------------------------------------------------------------------------------------------------------------------
-void soft_iic_sccb_write_register (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 dat)
+iic_error_enum soft_iic_sccb_write_register (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 dat)
 {
     zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, register_name);
     soft_iic_send_data(soft_iic_obj, dat);
-    soft_iic_stop(soft_iic_obj);
+    return soft_iic_stop(soft_iic_obj);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -654,24 +739,35 @@ void soft_iic_sccb_write_register (soft_iic_info_struct *soft_iic_obj, const uin
 // ˵     register_name   ļĴַ
 // ز     uint8           ضȡ 8bit 
 // ʹʾ     soft_iic_sccb_read_register(soft_iic_obj, 0x01);
-// עϢ     
+// עϢ     ʱ 0  soft_iic_obj->error
 //-------------------------------------------------------------------------------------------------------------------
 uint8 soft_iic_sccb_read_register (soft_iic_info_struct *soft_iic_obj, const uint8 register_name)
 {
     uint8 temp = 0;
-		zf_assert(soft_iic_obj != NULL);
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1);
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_begin(soft_iic_obj, 0);
     soft_iic_send_data(soft_iic_obj, register_name);
     soft_iic_stop(soft_iic_obj);
 
-    soft_iic_start(soft_iic_obj);
-    soft_iic_send_data(soft_iic_obj, soft_iic_obj->addr << 1 | 0x01);
+    soft_iic_restart(soft_iic_obj);                                             // SCCB  STOP ֮ START ȡ д׶γʱ
     temp = soft_iic_read_data(soft_iic_obj, 1);
     soft_iic_stop(soft_iic_obj);
     return temp;
 }
 
+// űŻΪ˿  gpio_init 㷨ͬ
+static GPIO_TypeDef *soft_iic_port (gpio_pin_enum pin)
+{
+    return (GPIO_TypeDef *)(GPIOA_BASE + (((pin <= PA15) ? 0 : ((pin <= PB15) ? 1 : 2)) << 10));
+}
+
+static uint16 soft_iic_mask (gpio_pin_enum pin)
+{
+    if(pin <= PA15)         return (uint16)(1 << (pin - PA0));
+    else if(pin <= PB15)    return (uint16)(1 << (pin - PB0));
+    else                    return (uint16)(1 << (pin - PC13 + 13));
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //       IIC ӿڳʼ Ĭ MASTER ģʽ ṩ SLAVE ģʽ
 // ˵     *soft_iic_obj    IIC ָϢŽṹָ
@@ -680,8 +776,8 @@ uint8 soft_iic_sccb_read_register (soft_iic_info_struct *soft_iic_obj, const uin
 // ˵     scl_pin          IIC ʱ 
 // ˵     sda_pin          IIC  
 // ز     void            
-// ʹʾ     soft_iic_init(&soft_iic_obj, addr, 100, PB6, PB7);
-// עϢ     
+// ʹʾ     soft_iic_init(&soft_iic_obj, addr, SOFT_IIC_DELAY_400KHZ, PB6, PB7);
+// עϢ     Ŷ˿ ֱ֮ӶдĴ SDA/SCL ʱ߻ָ
 //-------------------------------------------------------------------------------------------------------------------
 void soft_iic_init (soft_iic_info_struct *soft_iic_obj, uint8 addr, uint32 delay, gpio_pin_enum scl_pin, gpio_pin_enum sda_pin)
 {
@@ -691,7 +787,32 @@ void soft_iic_init (soft_iic_info_struct *soft_iic_obj, uint8 addr, uint32 delay
     soft_iic_obj->sda_pin = sda_pin;
     soft_iic_obj->addr = addr;
     soft_iic_obj->delay = delay;
+    soft_iic_obj->scl_port = soft_iic_port(scl_pin);
+    soft_iic_obj->scl_mask = soft_iic_mask(scl_pin);
+    soft_iic_obj->sda_port = soft_iic_port(sda_pin);
+    soft_iic_obj->sda_mask = soft_iic_mask(sda_pin);
+    soft_iic_obj->stretch = 0;
+    soft_iic_obj->error = IIC_ERROR_NONE;
     gpio_init(scl_pin, GPO_OPEN_DTAIN, 1);                          	// ȡӦIO AFܱ
     gpio_init(sda_pin, GPO_OPEN_DTAIN, 1);                         	// ȡӦIO AFܱ
+
+    if(!SOFT_IIC_SDA_GET(soft_iic_obj) || !SOFT_IIC_SCL_GET(soft_iic_obj))     // λǰ䱻 ӻ
+    {
+        soft_iic_bus_recover(soft_iic_obj);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       IIC ʱչȴ
+// ˵     *soft_iic_obj    IIC ָϢŽṹָ
+// ˵     wait            ÿͷ SCL ѯ SCL Ĵ 0- ӻ֧ʱչʱ 0 
+// ز     void
+// ʹʾ     soft_iic_set_stretch(&soft_iic_obj, SOFT_IIC_STRETCH_WAIT);
+// עϢ      soft_iic_init ֮ ʱ󱾴δ䷵ IIC_ERROR_TIMEOUT
+//-------------------------------------------------------------------------------------------------------------------
+void soft_iic_set_stretch (soft_iic_info_struct *soft_iic_obj, uint32 wait)
+{
+    zf_assert(soft_iic_obj != NULL);
+    soft_iic_obj->stretch = wait;
 }
 
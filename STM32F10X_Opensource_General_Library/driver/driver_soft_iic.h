@@ -19,38 +19,54 @@
 
 #include "common_headfile.h"
 
+// ʱ  72MHz ںʱӹ soft_iic_delay ÿѭԼ 6 ʱ  SCL Լ 16 ʱӵŲ
+// delay Ϊ 0 ʱʱ SCL ᳬ 1MHz ֵֻ֧ ȷʾΪ׼
+#define SOFT_IIC_DELAY_LOOP_CYCLES      (6)                                     // soft_iic_delay ÿѭںʱ
+#define SOFT_IIC_EDGE_CYCLES            (16)                                    //  SCL ڳʱĿ
+#define SOFT_IIC_DELAY_KHZ(khz)         ((72000 / 2 / (khz) > SOFT_IIC_EDGE_CYCLES) ? ((72000 / 2 / (khz) - SOFT_IIC_EDGE_CYCLES) / SOFT_IIC_DELAY_LOOP_CYCLES) : 1)
+#define SOFT_IIC_DELAY_400KHZ           (SOFT_IIC_DELAY_KHZ(400))               // ģʽ
+#define SOFT_IIC_DELAY_1MHZ             (SOFT_IIC_DELAY_KHZ(1000))              // ģʽǿ Fm+
 
-void        soft_iic_write_8bit             (soft_iic_info_struct *soft_iic_obj, const uint8 dat);
-void        soft_iic_write_8bit_array       (soft_iic_info_struct *soft_iic_obj, const uint8 *dat, uint32 len);
+#define SOFT_IIC_STRETCH_WAIT           (1000)                                  // soft_iic_set_stretch õĲѯ 72MHz Լ 100us
 
-void        soft_iic_write_16bit            (soft_iic_info_struct *soft_iic_obj, const uint16 dat);
-void        soft_iic_write_16bit_array      (soft_iic_info_struct *soft_iic_obj, const uint16 *dat, uint32 len);
+// Ӧʱչʱ߱ͣʱ STOP ټշ
+// д iic_error_enum ʱ 0  0  soft_iic_obj->error
 
-void        soft_iic_write_8bit_register    (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 dat);
-void        soft_iic_write_8bit_registers   (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 *dat, uint32 len);
+iic_error_enum soft_iic_write_8bit             (soft_iic_info_struct *soft_iic_obj, const uint8 dat);
+iic_error_enum soft_iic_write_8bit_array       (soft_iic_info_struct *soft_iic_obj, const uint8 *dat, uint32 len);
 
-void        soft_iic_write_16bit_register   (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 dat);
-void        soft_iic_write_16bit_registers  (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 *dat, uint32 len);
+iic_error_enum soft_iic_write_16bit            (soft_iic_info_struct *soft_iic_obj, const uint16 dat);
+iic_error_enum soft_iic_write_16bit_array      (soft_iic_info_struct *soft_iic_obj, const uint16 *dat, uint32 len);
 
-uint8       soft_iic_read_8bit              (soft_iic_info_struct *soft_iic_obj);
-void        soft_iic_read_8bit_array        (soft_iic_info_struct *soft_iic_obj, uint8 *dat, uint32 len);
+iic_error_enum soft_iic_write_8bit_register    (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 dat);
+iic_error_enum soft_iic_write_8bit_registers   (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, const uint8 *dat, uint32 len);
 
-uint16      soft_iic_read_16bit             (soft_iic_info_struct *soft_iic_obj);
-void        soft_iic_read_16bit_array       (soft_iic_info_struct *soft_iic_obj, uint16 *dat, uint32 len);
+iic_error_enum soft_iic_write_16bit_register   (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 dat);
+iic_error_enum soft_iic_write_16bit_registers  (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, const uint16 *dat, uint32 len);
 
-uint8       soft_iic_read_8bit_register     (soft_iic_info_struct *soft_iic_obj, const uint8 register_name);
-void        soft_iic_read_8bit_registers    (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 *dat, uint32 len);
+uint8          soft_iic_read_8bit              (soft_iic_info_struct *soft_iic_obj);
+iic_error_enum soft_iic_read_8bit_array        (soft_iic_info_struct *soft_iic_obj, uint8 *dat, uint32 len);
 
-uint16      soft_iic_read_16bit_register    (soft_iic_info_struct *soft_iic_obj, const uint16 register_name);
-void        soft_iic_read_16bit_registers   (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, uint16 *dat, uint32 len);
+uint16         soft_iic_read_16bit             (soft_iic_info_struct *soft_iic_obj);
+iic_error_enum soft_iic_read_16bit_array       (soft_iic_info_struct *soft_iic_obj, uint16 *dat, uint32 len);
 
-void        soft_iic_transfer_8bit_array    (soft_iic_info_struct *soft_iic_obj, const uint8 *write_data, uint32 write_len, uint8 *read_data, uint32 read_len);
-void        soft_iic_transfer_16bit_array   (soft_iic_info_struct *soft_iic_obj, const uint16 *write_data, uint32 write_len, uint16 *read_data, uint32 read_len);
+uint8          soft_iic_read_8bit_register     (soft_iic_info_struct *soft_iic_obj, const uint8 register_name);
+iic_error_enum soft_iic_read_8bit_registers    (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 *dat, uint32 len);
 
-void        soft_iic_sccb_write_register    (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 dat);
-uint8       soft_iic_sccb_read_register     (soft_iic_info_struct *soft_iic_obj, const uint8 register_name);
+uint16         soft_iic_read_16bit_register    (soft_iic_info_struct *soft_iic_obj, const uint16 register_name);
+iic_error_enum soft_iic_read_16bit_registers   (soft_iic_info_struct *soft_iic_obj, const uint16 register_name, uint16 *dat, uint32 len);
 
-void        soft_iic_init                   (soft_iic_info_struct *soft_iic_obj, uint8 addr, uint32 delay, gpio_pin_enum scl_pin, gpio_pin_enum sda_pin);
+iic_error_enum soft_iic_transfer_8bit_array    (soft_iic_info_struct *soft_iic_obj, const uint8 *write_data, uint32 write_len, uint8 *read_data, uint32 read_len);
+iic_error_enum soft_iic_transfer_16bit_array   (soft_iic_info_struct *soft_iic_obj, const uint16 *write_data, uint32 write_len, uint16 *read_data, uint32 read_len);
+
+iic_error_enum soft_iic_sccb_write_register    (soft_iic_info_struct *soft_iic_obj, const uint8 register_name, uint8 dat);
+uint8          soft_iic_sccb_read_register     (soft_iic_info_struct *soft_iic_obj, const uint8 register_name);
+
+void           soft_iic_delay                  (vuint32 delay);
+iic_error_enum soft_iic_bus_recover            (soft_iic_info_struct *soft_iic_obj);
+
+void           soft_iic_init                   (soft_iic_info_struct *soft_iic_obj, uint8 addr, uint32 delay, gpio_pin_enum scl_pin, gpio_pin_enum sda_pin);
+void           soft_iic_set_stretch            (soft_iic_info_struct *soft_iic_obj, uint32 wait);
 
 #endif
 
@@ -63,6 +63,11 @@ static uint8 soft_spi_8bit_data_handler (soft_spi_info_struct *soft_spi_obj, con
     uint8 write_data = dat;
     uint8 read_data = 0;
 
+    if(NULL != soft_spi_obj->fast)
+    {
+        return soft_spi_obj->fast(dat);
+    }
+
 //    if(soft_spi_obj->config.use_cs)
 //    {
 //        gpio_low(soft_spi_obj->cs_pin);
@@ -144,6 +149,12 @@ static uint16 soft_spi_16bit_data_handler (soft_spi_info_struct *soft_spi_obj, c
     uint16 write_data = dat;
     uint16 read_data = 0;
 
+    if(NULL != soft_spi_obj->fast)                                              // 高字节在前 与 16bit 逐位移出的时序相同
+    {
+        read_data = (uint16)soft_spi_obj->fast((uint8)(dat >> 8)) << 8;
+        return read_data | soft_spi_obj->fast((uint8)dat);
+    }
+
 //    if(soft_spi_obj->config.use_cs)
 //    {
 //        gpio_low(soft_spi_obj->cs_pin);
@@ -320,6 +331,34 @@ void soft_spi_write_16bit_array (soft_spi_info_struct *soft_spi_obj, const uint1
     }
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     软件 SPI 接口重复写同一个 16bit 数据
+// 参数说明     *soft_spi_obj   软件 SPI 指定信息存放结构体的指针
+// 参数说明     dat             发送的数据
+// 参数说明     len             发送次数
+// 返回参数     void
+// 使用示例     soft_spi_write_16bit_repeat(&soft_spi_obj, RGB565_BLACK, 128 * 160);
+// 备注信息     与 spi_write_16bit_repeat 对应 用于屏幕填充 不需要准备填充缓冲区
+//-------------------------------------------------------------------------------------------------------------------
+void soft_spi_write_16bit_repeat (soft_spi_info_struct *soft_spi_obj, const uint16 dat, uint32 len)
+{
+    zf_assert(soft_spi_obj != NULL);
+	if(soft_spi_obj->config.use_cs)
+    {
+        gpio_low(soft_spi_obj->cs_pin);
+    }
+	
+    while(len --)
+    {
+        soft_spi_16bit_data_handler(soft_spi_obj, dat);
+    }
+	
+	if(soft_spi_obj->config.use_cs)
+    {
+        gpio_high(soft_spi_obj->cs_pin);
+    }
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // 函数简介     软件 SPI 接口向传感器的寄存器写 8bit 数据
 // 参数说明     *soft_spi_obj   软件 SPI 指定信息存放结构体的指针
@@ -771,6 +810,7 @@ void soft_spi_init (soft_spi_info_struct *soft_spi_obj, uint8 mode, uint32 delay
 
     soft_spi_obj->config.mode = mode;
     soft_spi_obj->delay = delay;
+    soft_spi_obj->fast = NULL;
 
     soft_spi_obj->sck_pin = sck_pin;
     soft_spi_obj->mosi_pin = mosi_pin;
@@ -805,3 +845,17 @@ void soft_spi_init (soft_spi_info_struct *soft_spi_obj, uint8 mode, uint32 delay
         gpio_init(soft_spi_obj->cs_pin, GPO_PUSH_PULL, 1);         // IO 初始化
     }
 }
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介     软件 SPI 挂上编译期绑定引脚的快速通道
+// 参数说明     *soft_spi_obj   软件 SPI 指定信息存放结构体的指针
+// 参数说明     handler         SOFT_SPI_FAST_DEFINE 生成的函数 NULL 时恢复按引脚编号逐位操作
+// 返回参数     void
+// 使用示例     soft_spi_set_fast(&tft180_spi, tft180_spi_fast);
+// 备注信息     在 soft_spi_init 之后调用 生成函数时的引脚与模式必须和初始化时一致
+//-------------------------------------------------------------------------------------------------------------------
+void soft_spi_set_fast (soft_spi_info_struct *soft_spi_obj, soft_spi_fast_handler handler)
+{
+    zf_assert(soft_spi_obj != NULL);
+    soft_spi_obj->fast = handler;
+}
@@ -40,12 +40,70 @@
 
 #define SOFT_SPI_PIN_NULL       (0xFFFF)                                        // 用于区分是否分配引脚
 
+//====================================================快速通道====================================================
+// 引脚在编译期确定时 用 SOFT_SPI_FAST_DEFINE 生成专用的 8bit 读写函数 再用 soft_spi_set_fast 挂到对象上
+// 端口与掩码在编译期算好 每个边沿直接写 BSRR/BRR 8 个 bit 全部展开 delay 为 0 时不插入任何延时
+// 挂上之后 soft_spi_* 接口不变 每个字节都走快速通道 16bit 数据按高字节在前拆成两次
+//
+// 使用示例
+//      SOFT_SPI_FAST_DEFINE(tft180_spi_fast, TFT180_SCL_PIN, TFT180_SDA_PIN, SOFT_SPI_PIN_NULL, 0, TFT180_SOFT_SPI_DELAY)
+//      soft_spi_init(&tft180_spi, 0, TFT180_SOFT_SPI_DELAY, TFT180_SCL_PIN, TFT180_SDA_PIN, SOFT_SPI_PIN_NULL, SOFT_SPI_PIN_NULL);
+//      soft_spi_set_fast(&tft180_spi, tft180_spi_fast);
+#define SOFT_SPI_PORT(pin)      ((GPIO_TypeDef *)(GPIOA_BASE + (((pin) <= PA15) ? 0x000 : (((pin) <= PB15) ? 0x400 : 0x800))))
+#define SOFT_SPI_MASK(pin)      ((uint16)(1U << ((((pin) <= PB15) ? (pin) : ((pin) - PC13 + 13)) & 0x0F)))
+#define SOFT_SPI_PIN_SET(pin, level)                                                                                \
+    do { if(level) SOFT_SPI_PORT(pin)->BSRR = SOFT_SPI_MASK(pin); else SOFT_SPI_PORT(pin)->BRR = SOFT_SPI_MASK(pin); } while(0)
+#define SOFT_SPI_PIN_GET(pin)   ((SOFT_SPI_PORT(pin)->IDR & SOFT_SPI_MASK(pin)) ? 1 : 0)
+#define SOFT_SPI_FAST_DELAY(delay)                                                                                  \
+    do { if(delay) soft_spi_delay(delay); } while(0)
+
+// 一个 bit CPHA = 0 先出数据 第一个边沿采样 CPHA = 1 第一个边沿出数据 第二个边沿采样 MISO 为 SOFT_SPI_PIN_NULL 时不采样
+#define SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, bit)                                                        \
+    do {                                                                                                            \
+        if(!((mode) & 0x01))                                                                                        \
+        {                                                                                                           \
+            SOFT_SPI_PIN_SET(mosi, dat & (0x80 >> (bit)));                                                          \
+            SOFT_SPI_FAST_DELAY(delay);                                                                             \
+            SOFT_SPI_PIN_SET(sck, !((mode) & 0x02));                                                                \
+            if(SOFT_SPI_PIN_NULL != (miso)) read_data |= (uint8)(SOFT_SPI_PIN_GET(miso) << (7 - (bit)));            \
+            SOFT_SPI_FAST_DELAY(delay);                                                                             \
+            SOFT_SPI_PIN_SET(sck, (mode) & 0x02);                                                                   \
+        }                                                                                                           \
+        else                                                                                                        \
+        {                                                                                                           \
+            SOFT_SPI_PIN_SET(sck, !((mode) & 0x02));                                                                \
+            SOFT_SPI_PIN_SET(mosi, dat & (0x80 >> (bit)));                                                          \
+            SOFT_SPI_FAST_DELAY(delay);                                                                             \
+            SOFT_SPI_PIN_SET(sck, (mode) & 0x02);                                                                   \
+            if(SOFT_SPI_PIN_NULL != (miso)) read_data |= (uint8)(SOFT_SPI_PIN_GET(miso) << (7 - (bit)));            \
+            SOFT_SPI_FAST_DELAY(delay);                                                                             \
+        }                                                                                                           \
+    } while(0)
+
+// 生成 static uint8 name (uint8 dat) 引脚、模式、延时都必须是常量 SCK 空闲电平由 soft_spi_init 设置
+#define SOFT_SPI_FAST_DEFINE(name, sck, mosi, miso, mode, delay)                                                    \
+static uint8 name (uint8 dat)                                                                                       \
+{                                                                                                                   \
+    uint8 read_data = 0;                                                                                            \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 0);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 1);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 2);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 3);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 4);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 5);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 6);                                                             \
+    SOFT_SPI_FAST_BIT(sck, mosi, miso, mode, delay, 7);                                                             \
+    return read_data;                                                                                               \
+}
+
+void        soft_spi_delay                      (uint32 x);
 
 void        soft_spi_write_8bit                 (soft_spi_info_struct *soft_spi_obj, const uint8 dat);
 void        soft_spi_write_8bit_array           (soft_spi_info_struct *soft_spi_obj, const uint8 *dat, uint32 len);
 
 void        soft_spi_write_16bit                (soft_spi_info_struct *soft_spi_obj, const uint16 dat);
 void        soft_spi_write_16bit_array          (soft_spi_info_struct *soft_spi_obj, const uint16 *dat, uint32 len);
+void        soft_spi_write_16bit_repeat         (soft_spi_info_struct *soft_spi_obj, const uint16 dat, uint32 len);
 
 void        soft_spi_write_8bit_register        (soft_spi_info_struct *soft_spi_obj, const uint8 register_name, const uint8 dat);
 void        soft_spi_write_8bit_registers       (soft_spi_info_struct *soft_spi_obj, const uint8 register_name, const uint8 *dat, uint32 len);
@@ -69,5 +127,6 @@ void        soft_spi_transfer_8bit              (soft_spi_info_struct *soft_spi_
 void        soft_spi_transfer_16bit             (soft_spi_info_struct *soft_spi_obj, const uint16 *write_buffer, uint16 *read_buffer, uint32 len);
 
 void        soft_spi_init                       (soft_spi_info_struct *soft_spi_obj, uint8 mode, uint32 delay, gpio_pin_enum sck_pin, gpio_pin_enum mosi_pin, gpio_pin_enum miso_pin, gpio_pin_enum cs_pin);
+void        soft_spi_set_fast                   (soft_spi_info_struct *soft_spi_obj, soft_spi_fast_handler handler);
 
 #endif
@@ -21,10 +21,66 @@
 
 /* ֻеһDMAʹʱҪdummy */
 #if SPI_TX_USE_DMA
-static uint8 spi_tx_dummy = 0xFF;   /* ʱ͵ */
+static const uint16 spi_tx_dummy = 0xFFFF; /* ʱ͵ 16 λ֡ʱҲ */
 #endif
-#if SPI_RX_USE_DMA
-static uint8 spi_rx_dummy;          /* ʱյ */
+#if SPI_RX_USE_DMA || SPI_TX_USE_DMA
+static uint16 spi_rx_dummy;         /* ʱյ */
+static uint8 g_spi_dma[2];          /* DMA ͨǼǳɹ Ϊ 0 ʱ· SPI ˻زѯ */
+#endif
+
+#if SPI_TX_USE_DMA
+#if (SPI_QUEUE_SIZE & (SPI_QUEUE_SIZE - 1)) || !SPI_QUEUE_SIZE
+#error "SPI_QUEUE_SIZE  2 "
+#endif
+
+/* 첽 queue[tail] Ϊڴһ head/tail  */
+typedef struct
+{
+    SPI_TypeDef             *spix;
+    DMA_Channel_TypeDef     *tx_dma;
+    DMA_Channel_TypeDef     *rx_dma;
+    dma_channel_enum        rx_channel;                             /* ͨ ж */
+    uint32                  rx_tc_flag;
+    uint32                  dma_gl_flag;                            /* շͨȫ־ */
+    spi_xfer_struct         *queue[SPI_QUEUE_SIZE];
+    volatile uint32         head;
+    volatile uint32         tail;
+    volatile uint8          busy;                                   /* DMA ڴ queue[tail] */
+    uint32                  done;                                   /* queue[tail] ɵ֡ */
+    uint32                  chunk;                                  /* ֡ һ 65535 */
+}spi_bus_struct;
+
+static spi_bus_struct g_spi_bus[2] =
+{
+    {SPI1, DMA1_Channel3, DMA1_Channel2, dma1_CH2, DMA1_FLAG_TC2, DMA1_FLAG_GL2 | DMA1_FLAG_GL3},
+    {SPI2, DMA1_Channel5, DMA1_Channel4, dma1_CH4, DMA1_FLAG_TC4, DMA1_FLAG_GL4 | DMA1_FLAG_GL5},
+};
+#endif
+
+/* ߹ owner Ϊǰռߵ active Ϊ CR1 ǰӦ */
+static spi_device_struct *volatile g_spi_owner[2];
+static spi_device_struct *g_spi_active[2];
+
+#if SPI_TX_USE_DMA
+/* 16 λ֡ʱ DMA Ϊ 洢ఴ uint16 ʵʿ uint16 Ϊ 32 λʱ DMA Զȡ/ */
+#define SPI_DMA_SIZE_16BIT      (DMA_CCR1_PSIZE_0 | ((sizeof(uint16) == 4) ? DMA_CCR1_MSIZE_1 : DMA_CCR1_MSIZE_0))
+
+/* л 8/16 λ֡ DMA ݿ DFF ֻ SPE رʱ޸ ʱ */
+static void spi_bus_frame(spi_bus_struct *bus, uint8 frame16)
+{
+    uint16 dff  = frame16 ? SPI_CR1_DFF : 0;
+    uint32 size = frame16 ? SPI_DMA_SIZE_16BIT : 0;
+
+    if ((bus->spix->CR1 & SPI_CR1_DFF) != dff)
+    {
+        bus->spix->CR1 &= ~SPI_CR1_SPE;
+        bus->spix->CR1  = (bus->spix->CR1 & ~SPI_CR1_DFF) | dff;
+        bus->spix->CR1 |= SPI_CR1_SPE;
+    }
+    if (!g_spi_dma[bus - g_spi_bus]) return;                       /* ͨ */
+    bus->rx_dma->CCR = (bus->rx_dma->CCR & ~(DMA_CCR1_PSIZE | DMA_CCR1_MSIZE)) | size;
+    bus->tx_dma->CCR = (bus->tx_dma->CCR & ~(DMA_CCR1_PSIZE | DMA_CCR1_MSIZE)) | size;
+}
 #endif
 //-------------------------------------------------------------------------------------------------------------------
 //           SPI д 1Byteڲ,ֻеһDMAʱҪ
@@ -38,12 +94,39 @@ static uint8 spi_rx_dummy;          /* 
 static uint8 spi_rw_byte(spi_index_enum spi_n, uint8 tx)
 {
 		SPI_TypeDef *spix = (spi_n == SPI_1) ? SPI1 : SPI2;
+#if SPI_TX_USE_DMA
+    spi_flush(spi_n);                                               /* ȶе DMA  */
+    spi_bus_frame(&g_spi_bus[spi_n - SPI_1], 0);                   /* һ 16 λ֡ */
+#endif
     while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_TXE) == RESET);
     SPI_I2S_SendData(spix, tx);
     while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_RXNE) == RESET);
     return (uint8)SPI_I2S_ReceiveData(spix);
 }
 #endif
+//-------------------------------------------------------------------------------------------------------------------
+//           ĿѡƵ
+// ˵          spi_n        SPIģ
+// ˵          baud         ĿʣHz
+//           uint16       SPI_BaudRatePrescaler_x Ŀʵһ
+// ʹʾ          spi.SPI_BaudRatePrescaler = spi_baud_prescaler(SPI_1, 10000000);
+// עϢ          ڲߺ
+//-------------------------------------------------------------------------------------------------------------------
+static uint16 spi_baud_prescaler(spi_index_enum spi_n, uint32 baud)
+{
+    /*  APB ʱӼƵSPI1-72MSPI2-36M */
+    const uint32 apbclk = (spi_n == SPI_1) ? 72000000 : 36000000;
+    return
+        (baud >= apbclk / 2)   ? SPI_BaudRatePrescaler_2 :
+        (baud >= apbclk / 4)   ? SPI_BaudRatePrescaler_4 :
+        (baud >= apbclk / 8)   ? SPI_BaudRatePrescaler_8 :
+        (baud >= apbclk / 16)  ? SPI_BaudRatePrescaler_16 :
+        (baud >= apbclk / 32)  ? SPI_BaudRatePrescaler_32 :
+        (baud >= apbclk / 64)  ? SPI_BaudRatePrescaler_64 :
+        (baud >= apbclk / 128) ? SPI_BaudRatePrescaler_128 :
+                                 SPI_BaudRatePrescaler_256;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //           źŽΪGPIO˿Pin
 // ˵          packed       ֵport*102+pin
@@ -76,13 +159,382 @@ static bool is_spi1_remap_pin(uint32 packed)
            (packed == SPI1_CS_PA15);
 }
 /* ȴSPI */
-#if SPI_TX_USE_DMA || SPI_RX_USE_DMA 
+#if !SPI_TX_USE_DMA && SPI_RX_USE_DMA
 static void spi_wait_idle(spi_index_enum spi_n)
 {
     SPI_TypeDef *spix = (spi_n == SPI_1) ? SPI1 : SPI2;
     while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_BSY) == SET);
 }
 #endif
+
+#if SPI_TX_USE_DMA
+//-------------------------------------------------------------------------------------------------------------------
+//           װصǰһ
+// ˵          *bus         SPI 
+// ˵          *xfer        ǰ
+//           void
+// ʹʾ          spi_bus_chunk(bus, xfer);
+// עϢ          ڲ ǰж DMA ͨѹر
+//                   CNDTR ֻ 16 λ һ 65535 ֡  done Ű
+//                   շͨͬʱ ȿٿ  NULL ʱ̶ 0xFF TX_FIXED ʱԴַ
+//-------------------------------------------------------------------------------------------------------------------
+static void spi_bus_chunk(spi_bus_struct *bus, spi_xfer_struct *xfer)
+{
+    uint32 offset = bus->done * ((xfer->flags & SPI_XFER_16BIT) ? sizeof(uint16) : 1);
+    uint8  tx_inc = (xfer->tx != NULL && !(xfer->flags & SPI_XFER_TX_FIXED));
+
+    bus->chunk = xfer->length - bus->done;
+    if (bus->chunk > 65535) bus->chunk = 65535;
+    DMA_ClearFlag(bus->dma_gl_flag);
+
+    bus->rx_dma->CMAR  = xfer->rx ? (uint32)(xfer->rx + offset) : (uint32)&spi_rx_dummy;
+    bus->rx_dma->CNDTR = bus->chunk;
+    bus->rx_dma->CCR   = (bus->rx_dma->CCR & ~DMA_CCR1_MINC) | (xfer->rx ? DMA_CCR1_MINC : 0) | DMA_CCR1_TCIE | DMA_CCR1_EN;
+
+    bus->tx_dma->CMAR  = xfer->tx ? (uint32)(xfer->tx + (tx_inc ? offset : 0)) : (uint32)&spi_tx_dummy;
+    bus->tx_dma->CNDTR = bus->chunk;
+    bus->tx_dma->CCR   = (bus->tx_dma->CCR & ~DMA_CCR1_MINC) | (tx_inc ? DMA_CCR1_MINC : 0) | DMA_CCR1_EN;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           еһ
+// ˵          *bus         SPI 
+//           void
+// ʹʾ          spi_bus_start(bus);
+// עϢ          ڲ ǰж DMA   flags л֡
+//-------------------------------------------------------------------------------------------------------------------
+static void spi_bus_start(spi_bus_struct *bus)
+{
+    spi_xfer_struct *xfer;
+
+    if (bus->head == bus->tail) return;
+    xfer = bus->queue[bus->tail & (SPI_QUEUE_SIZE - 1)];
+    xfer->state = SPI_XFER_ACTIVE;
+    bus->busy = 1;
+    bus->done = 0;
+    spi_bus_frame(bus, xfer->flags & SPI_XFER_16BIT);
+    if (xfer->cs_pin != SPI_XFER_CS_NONE) gpio_low(xfer->cs_pin);
+
+    (void)bus->spix->DR;                                            /* ݲ OVR */
+    (void)bus->spix->SR;
+    spi_bus_chunk(bus, xfer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ǰ ͷƬѡ صһ
+// ˵          *bus         SPI 
+//           void
+// ʹʾ          spi_bus_complete(bus);
+// עϢ          ڲ  DMA жϻȴ ͨ TC δλʱκβ
+//                    65535 ֡Ĵװһ ͷƬѡص
+//                   صڿж״ִ̬ صٴ spi_submit
+//-------------------------------------------------------------------------------------------------------------------
+static void spi_bus_complete(spi_bus_struct *bus)
+{
+    spi_xfer_struct *xfer;
+
+    {
+        CRIT_ENTER();
+        if (!bus->busy) spi_bus_start(bus);                         /* صȴʱ һܻû */
+        if (!bus->busy || DMA_GetFlagStatus(bus->rx_tc_flag) == RESET)
+        {
+            CRIT_EXIT();
+            return;
+        }
+        DMA_ClearFlag(bus->dma_gl_flag);
+        bus->rx_dma->CCR &= ~(DMA_CCR1_EN | DMA_CCR1_TCIE);
+        bus->tx_dma->CCR &= ~DMA_CCR1_EN;
+        xfer = bus->queue[bus->tail & (SPI_QUEUE_SIZE - 1)];
+        bus->done += bus->chunk;
+        if (bus->done < xfer->length)
+        {
+            spi_bus_chunk(bus, xfer);
+            CRIT_EXIT();
+            return;
+        }
+        if (xfer->cs_pin != SPI_XFER_CS_NONE && !xfer->cs_hold) gpio_high(xfer->cs_pin);
+        bus->tail ++;
+        bus->busy = 0;
+        xfer->state = SPI_XFER_DONE;
+        CRIT_EXIT();
+    }
+
+    if (xfer->callback != NULL) xfer->callback(xfer);
+
+    {
+        CRIT_ENTER();
+        if (!bus->busy) spi_bus_start(bus);                         /* صѾύ */
+        CRIT_EXIT();
+    }
+}
+
+static void spi_dma_irq_handler(void *arg)
+{
+    spi_bus_complete((spi_bus_struct *)arg);
+}
+
+/* ȴĳ жϱʱҲƽ */
+static void spi_xfer_wait(spi_bus_struct *bus, spi_xfer_struct *xfer)
+{
+    while (xfer->state != SPI_XFER_DONE) spi_bus_complete(bus);
+}
+
+/*  DMA  ύ첽֮ ȱδٷ */
+static void spi_xfer_run(spi_index_enum spi_n, const void *tx, void *rx, uint32 length, uint8 flags)
+{
+    spi_xfer_struct xfer = {SPI_XFER_CS_NONE, 0, (const uint8 *)tx, (uint8 *)rx, length, flags, NULL, NULL, SPI_XFER_IDLE};
+    spi_bus_struct *bus = &g_spi_bus[spi_n - SPI_1];
+
+    while (spi_submit(spi_n, &xfer)) spi_bus_complete(bus);        /* ʱƽڳλ */
+    spi_xfer_wait(bus, &xfer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           Բѯʽһ
+// ˵          *bus         SPI 
+// ˵          *xfer        
+//           void
+// ʹʾ          spi_bus_poll(bus, xfer);
+// עϢ          ڲ DMA ͨǼʧʱ spi_submit  Ƭѡɵ߿
+//                    8 λ֡ 16 λݲɸֽǰֽ ʱͬ
+//-------------------------------------------------------------------------------------------------------------------
+static void spi_bus_poll(spi_bus_struct *bus, spi_xfer_struct *xfer)
+{
+    SPI_TypeDef *spix = bus->spix;
+    uint8  width = (xfer->flags & SPI_XFER_16BIT) ? 2 : 1;
+    uint8  tx_inc = (xfer->tx != NULL && !(xfer->flags & SPI_XFER_TX_FIXED));
+    uint16 tx, rx;
+    uint32 i;
+    uint8  b;
+
+    for (i = 0; i < xfer->length; i ++)
+    {
+        if (xfer->tx == NULL)   tx = 0xFFFF;
+        else if (width == 2)    tx = ((const uint16 *)xfer->tx)[tx_inc ? i : 0];
+        else                    tx = xfer->tx[tx_inc ? i : 0];
+        rx = 0;
+        for (b = width; b --; )
+        {
+            while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_TXE) == RESET);
+            SPI_I2S_SendData(spix, (uint8)(tx >> (8 * b)));
+            while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_RXNE) == RESET);
+            rx = (uint16)((rx << 8) | (uint8)SPI_I2S_ReceiveData(spix));
+        }
+        if (xfer->rx == NULL) continue;
+        if (width == 2) ((uint16 *)xfer->rx)[i] = rx;
+        else            xfer->rx[i] = (uint8)rx;
+    }
+}
+#endif
+
+#if SPI_TX_USE_DMA || SPI_RX_USE_DMA
+//-------------------------------------------------------------------------------------------------------------------
+//           Ǽ SPI ʹõ DMA ͨ
+// ˵          spi_n        SPIģ
+//           uint8        1-ȫǼǳɹ 0-ͨռ
+// ʹʾ          g_spi_dma[spi_n - SPI_1] = spi_dma_claim(spi_n);
+// עϢ          ڲ ͻ dma1_claim  zf_log  շͨҪôҪô
+//-------------------------------------------------------------------------------------------------------------------
+static uint8 spi_dma_claim(spi_index_enum spi_n)
+{
+    dma_channel_enum rx_channel = (spi_n == SPI_1) ? dma1_CH2 : dma1_CH4;
+    dma_owner_enum   rx_owner   = (spi_n == SPI_1) ? DMA_OWNER_SPI1_RX : DMA_OWNER_SPI2_RX;
+#if SPI_TX_USE_DMA
+    dma_channel_enum tx_channel = (spi_n == SPI_1) ? dma1_CH3 : dma1_CH5;
+    dma_owner_enum   tx_owner   = (spi_n == SPI_1) ? DMA_OWNER_SPI1_TX : DMA_OWNER_SPI2_TX;
+
+    if (!dma1_claim(tx_channel, tx_owner)) return 0;
+    if (!dma1_claim(rx_channel, rx_owner))
+    {
+        dma1_release(tx_channel, tx_owner);
+        return 0;
+    }
+    return 1;
+#else
+    return dma1_claim(rx_channel, rx_owner);
+#endif
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ύһ첽
+// ˵          spi_n        SPIģ
+// ˵          *xfer         ֮ǰ뱣Ч ܷڻǰصĺջ
+//           uint8        0-Ѽ 1-
+// ʹʾ          static spi_xfer_struct x = {PA4, 0, cmd, NULL, 4, 0, on_done, NULL};
+//                   spi_submit(SPI_1, &x);
+// עϢ          ύ˳δ ߿ʱ 漴
+//                   ɺ state Ϊ SPI_XFER_DONE ûص
+//                   ʹ DMA  DMA ͨռʱ ڱԲѯʽٷ
+//                   ֶƬѡٵ spi_* ǰ  spi_flush 첽 ƬѡͬʱЧ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 spi_submit(spi_index_enum spi_n, spi_xfer_struct *xfer)
+{
+    if (xfer == NULL || xfer->length == 0) return 1;
+#if SPI_TX_USE_DMA
+    spi_bus_struct *bus = &g_spi_bus[spi_n - SPI_1];
+    if (g_spi_dma[spi_n - SPI_1])
+    {
+        CRIT_ENTER();
+        if (bus->head - bus->tail >= SPI_QUEUE_SIZE)
+        {
+            CRIT_EXIT();
+            return 1;
+        }
+        xfer->state = SPI_XFER_QUEUED;
+        bus->queue[bus->head & (SPI_QUEUE_SIZE - 1)] = xfer;
+        bus->head ++;
+        if (!bus->busy) spi_bus_start(bus);
+        CRIT_EXIT();
+        return 0;
+    }
+#endif
+    xfer->state = SPI_XFER_ACTIVE;
+    if (xfer->cs_pin != SPI_XFER_CS_NONE) gpio_low(xfer->cs_pin);
+#if SPI_TX_USE_DMA
+    spi_bus_poll(bus, xfer);
+#else
+    if (xfer->tx != NULL && (xfer->flags & SPI_XFER_TX_FIXED))
+    {
+        for (uint32 i = 0; i < xfer->length; i++)
+        {
+            if (xfer->flags & SPI_XFER_16BIT)
+                spi_transfer_16bit(spi_n, (const uint16 *)xfer->tx, xfer->rx ? (uint16 *)xfer->rx + i : NULL, 1);
+            else
+                spi_transfer_8bit(spi_n, xfer->tx, xfer->rx ? xfer->rx + i : NULL, 1);
+        }
+    }
+    else if (xfer->flags & SPI_XFER_16BIT)
+        spi_transfer_16bit(spi_n, (const uint16 *)xfer->tx, (uint16 *)xfer->rx, xfer->length);
+    else
+        spi_transfer_8bit(spi_n, xfer->tx, xfer->rx, xfer->length);
+#endif
+    if (xfer->cs_pin != SPI_XFER_CS_NONE && !xfer->cs_hold) gpio_high(xfer->cs_pin);
+    xfer->state = SPI_XFER_DONE;
+    if (xfer->callback != NULL) xfer->callback(xfer);
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ѯδɵĴ
+// ˵          spi_n        SPIģ
+//           uint32       Ŷڴĸ
+// ʹʾ          if (spi_pending(SPI_2) == 0) { ... }
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 spi_pending(spi_index_enum spi_n)
+{
+#if SPI_TX_USE_DMA
+    spi_bus_struct *bus = &g_spi_bus[spi_n - SPI_1];
+    return bus->head - bus->tail;
+#else
+    (void)spi_n;
+    return 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ȴύĴȫ
+// ˵          spi_n        SPIģ
+//           void
+// ʹʾ          spi_flush(SPI_2);
+// עϢ          жصжʱҲƽ
+//-------------------------------------------------------------------------------------------------------------------
+void spi_flush(spi_index_enum spi_n)
+{
+#if SPI_TX_USE_DMA
+    spi_bus_struct *bus = &g_spi_bus[spi_n - SPI_1];
+    while (bus->head != bus->tail) spi_bus_complete(bus);
+#else
+    (void)spi_n;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ʼһϵ
+// ˵          *device       賤Ч
+// ˵          spi_n        SPIģ
+// ˵          mode         ģʽ0-3
+// ˵          baud         ʣHz
+// ˵          cs_pin       Ƭѡ ʼΪ SPI_XFER_CS_NONE ʱ
+//           void
+// ʹʾ          spi_device_init(&w25q64_dev, SPI_1, SPI_MODE0, 10000000, PA4);
+// עϢ          ֻ CR1  SPI   DMA  spi_init 
+//                   CR1  8 λ֡ 16 λ֡ɴ SPI_XFER_16BIT л DMA ݿ֮л
+//-------------------------------------------------------------------------------------------------------------------
+void spi_device_init(spi_device_struct *device, spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, gpio_pin_enum cs_pin)
+{
+    device->spi_n  = spi_n;
+    device->cs_pin = cs_pin;
+    device->cr1    = SPI_Direction_2Lines_FullDuplex | SPI_Mode_Master | SPI_NSS_Soft | SPI_FirstBit_MSB |
+                     ((mode & 0x02) ? SPI_CPOL_High : SPI_CPOL_Low) |
+                     ((mode & 0x01) ? SPI_CPHA_2Edge : SPI_CPHA_1Edge) |
+                     SPI_DataSize_8b | spi_baud_prescaler(spi_n, baud) | SPI_CR1_SPE;
+    if (cs_pin != SPI_XFER_CS_NONE) gpio_init(cs_pin, GPO_PUSH_PULL, 1);
+}
+
+/*  CR1 л device ռҶѿ ֡ص 8 λ  DMA ֽڿһ */
+static void spi_bus_switch(spi_device_struct *device)
+{
+    SPI_TypeDef *spix = (device->spi_n == SPI_1) ? SPI1 : SPI2;
+
+    while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_TXE) == RESET);
+    while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_BSY) == SET);
+    spix->CR1 = device->cr1 & ~SPI_CR1_SPE;                         /*  SPE ܸ֡ */
+    spix->CR1 = device->cr1;
+#if SPI_TX_USE_DMA
+    spi_bus_frame(&g_spi_bus[device->spi_n - SPI_1], 0);
+#endif
+    g_spi_active[device->spi_n - SPI_1] = device;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ռ
+// ˵          *device      
+//           uint8        0-ɹ 1-ռ Ҫллд
+// ʹʾ          if (spi_device_acquire(&imu_dev)) return;          // ж ζȡ
+//                   while (spi_device_acquire(&w25q64_dev));           // ѭ ж
+// עϢ          ȴ һռߵĲǱʱл CR1
+//                   лʱлĴ( Flash ҳд롢Ļˢ)ռ ƽһк󷵻 1
+//                   ͬһظռ ռڼƬѡɵ߿
+//-------------------------------------------------------------------------------------------------------------------
+uint8 spi_device_acquire(spi_device_struct *device)
+{
+    uint8 index = device->spi_n - SPI_1;
+    uint8 result = 0;
+
+    {
+        CRIT_ENTER();
+        if (g_spi_owner[index] != NULL) result = 1;
+#if SPI_TX_USE_DMA
+        else if (g_spi_active[index] != device && g_spi_bus[index].head != g_spi_bus[index].tail) result = 1;
+#endif
+        else g_spi_owner[index] = device;
+        CRIT_EXIT();
+    }
+    if (result)
+    {
+#if SPI_TX_USE_DMA
+        spi_bus_complete(&g_spi_bus[index]);                        /* жϱʱҲܰѶ */
+#endif
+        return 1;
+    }
+    if (g_spi_active[index] != device) spi_bus_switch(device);
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           ͷ
+// ˵          *device      
+//           void
+// ʹʾ          spi_device_release(&imu_dev);
+// עϢ          ȴ첽 ֮ǰռ
+//-------------------------------------------------------------------------------------------------------------------
+void spi_device_release(spi_device_struct *device)
+{
+    uint8 index = device->spi_n - SPI_1;
+    if (g_spi_owner[index] == device) g_spi_owner[index] = NULL;
+}
 //-------------------------------------------------------------------------------------------------------------------
 //           SPIд8λ
 // ˵          spi_n        SPIģ
@@ -128,8 +580,12 @@ void spi_write_8bit_array(spi_index_enum spi_n, const uint8 *data, uint32 len)
 //-------------------------------------------------------------------------------------------------------------------
 void spi_write_16bit(spi_index_enum spi_n, const uint16 data)
 {
+#if SPI_TX_USE_DMA
+    spi_xfer_run(spi_n, &data, NULL, 1, SPI_XFER_16BIT);
+#else
     spi_write_8bit(spi_n, (uint8)(data >> 8));//
     spi_write_8bit(spi_n, (uint8)(data & 0xFF));// 
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -139,11 +595,54 @@ void spi_write_16bit(spi_index_enum spi_n, const uint16 data)
 // ˵          len          
 //           void
 // ʹʾ          spi_write_16bit_array(SPI_1, buf, 5);
-// עϢ          
+// עϢ          ʹ DMA ʱ 16 λ֡鴫 ֲֽ
 //-------------------------------------------------------------------------------------------------------------------
 void spi_write_16bit_array(spi_index_enum spi_n, const uint16 *data, uint32 len)
 {
+#if SPI_TX_USE_DMA
+    if (len == 0) return;
+    spi_xfer_run(spi_n, data, NULL, len, SPI_XFER_16BIT);
+#else
     while (len--) spi_write_16bit(spi_n, *data++);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           SPIظͬһ8λ
+// ˵          spi_n        SPIģ
+// ˵          data         ֽ
+// ˵          len          
+//           void
+// ʹʾ          spi_write_8bit_repeat(SPI_1, 0x00, 1024);
+// עϢ          ʹ DMA ʱԴַ Ҫ׼仺 Ȳ 65535 
+//-------------------------------------------------------------------------------------------------------------------
+void spi_write_8bit_repeat(spi_index_enum spi_n, const uint8 data, uint32 len)
+{
+#if SPI_TX_USE_DMA
+    if (len == 0) return;
+    spi_xfer_run(spi_n, &data, NULL, len, SPI_XFER_TX_FIXED);
+#else
+    while (len--) spi_write_8bit(spi_n, data);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//           SPIظͬһ16λ
+// ˵          spi_n        SPIģ
+// ˵          data         
+// ˵          len          
+//           void
+// ʹʾ          spi_write_16bit_repeat(SPI_2, RGB565_BLACK, 128 * 160);   // 
+// עϢ          ʹ DMA ʱ 16 λ֡Դַ Ȳ 65535 
+//-------------------------------------------------------------------------------------------------------------------
+void spi_write_16bit_repeat(spi_index_enum spi_n, const uint16 data, uint32 len)
+{
+#if SPI_TX_USE_DMA
+    if (len == 0) return;
+    spi_xfer_run(spi_n, &data, NULL, len, SPI_XFER_16BIT | SPI_XFER_TX_FIXED);
+#else
+    while (len--) spi_write_16bit(spi_n, data);
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -239,7 +738,7 @@ uint8 spi_read_8bit(spi_index_enum spi_n)
 void spi_read_8bit_array(spi_index_enum spi_n, uint8 *data, uint32 len)
 {
 	  if (len == 0) return;
-#if SPI_RX_USE_DMA
+#if SPI_TX_USE_DMA || SPI_RX_USE_DMA
     spi_transfer_8bit(spi_n, NULL, data, len);
 #else
     while (len--) *data++ = spi_rw_byte(spi_n, 0xFF);
@@ -255,9 +754,15 @@ void spi_read_8bit_array(spi_index_enum spi_n, uint8 *data, uint32 len)
 //-------------------------------------------------------------------------------------------------------------------
 uint16 spi_read_16bit(spi_index_enum spi_n)
 {
+#if SPI_TX_USE_DMA
+    uint16 rx;
+    spi_xfer_run(spi_n, NULL, &rx, 1, SPI_XFER_16BIT);
+    return rx;
+#else
     uint16 h = spi_read_8bit(spi_n);
     uint16 l = spi_read_8bit(spi_n);
     return (h << 8) | l;
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -271,7 +776,12 @@ uint16 spi_read_16bit(spi_index_enum spi_n)
 //-------------------------------------------------------------------------------------------------------------------
 void spi_read_16bit_array(spi_index_enum spi_n, uint16 *data, uint32 len)
 {
+#if SPI_TX_USE_DMA
+    if (len == 0) return;
+    spi_xfer_run(spi_n, NULL, data, len, SPI_XFER_16BIT);
+#else
     while (len--) *data++ = spi_read_16bit(spi_n);
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -342,116 +852,36 @@ void spi_read_16bit_registers(spi_index_enum spi_n, const uint16 register_name,
 // ˵          len          
 //           void
 // ʹʾ          spi_transfer_8bit(SPI_1, txbuf, rxbuf, 8);
-// עϢ          
+// עϢ           65535 ֽʱԶֶ Ƭѡڼ䱣
 //-------------------------------------------------------------------------------------------------------------------
 void spi_transfer_8bit(spi_index_enum spi_n, const uint8 *write_buffer, uint8 *read_buffer, uint32 len)
 {
-    if (len == 0 || len > 65535) return;
-#if SPI_TX_USE_DMA || SPI_RX_USE_DMA    
+    if (len == 0) return;
+#if !SPI_TX_USE_DMA && SPI_RX_USE_DMA
     SPI_TypeDef *spix = (spi_n == SPI_1) ? SPI1 : SPI2;
 #endif    
     // ˫ΪNULL
     if (write_buffer == NULL && read_buffer == NULL) return;
     
     // DMAѡ
-#if SPI_TX_USE_DMA && SPI_RX_USE_DMA
-    // ==================== ģʽ1: ȫDMAģʽ====================
-    {
-        DMA_Channel_TypeDef *tx_dma = SPI_TX_DMA_CH(spi_n);
-        DMA_Channel_TypeDef *rx_dma = SPI_RX_DMA_CH(spi_n);
-        
-        SPI_Cmd(spix, DISABLE);
-        spi_wait_idle(spi_n);
-        
-        // TX DMAԴַ
-        tx_dma->CMAR = (uint32)(write_buffer ? write_buffer : &spi_tx_dummy);
-        // RX DMAĿַ
-        rx_dma->CMAR = (uint32)(read_buffer ? read_buffer : &spi_rx_dummy);
-        
-        // RX DMATX DMA
-        dma_start(rx_dma, (uint16)len);
-        dma_start(tx_dma, (uint16)len);
-        
-        SPI_Cmd(spix, ENABLE);
-        
-        // ȴ
-        spi_wait_idle(spi_n);
-        dma_wait_done(rx_dma);
-        dma_wait_done(tx_dma);
-        
-        DMA_Cmd(rx_dma, DISABLE);
-        DMA_Cmd(tx_dma, DISABLE);
-    }
-#elif SPI_TX_USE_DMA && !SPI_RX_USE_DMA
-    // ==================== ģʽ2: TXDMARXѯ ====================
-    // ԣDMA + ж/ѯգΪͳһʹѯ
-    {
-        // սջ
-        while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_RXNE) == SET) {
-            (void)SPI_I2S_ReceiveData(spix);
-        }
-        
-        if (read_buffer == NULL) {
-            // ֻͣʹDMAԽ
-            DMA_Channel_TypeDef *tx_dma = SPI_TX_DMA_CH(spi_n);
-            
-            SPI_Cmd(spix, DISABLE);
-            spi_wait_idle(spi_n);
-            
-            tx_dma->CMAR = (uint32)write_buffer;
-            dma_start(tx_dma, (uint16)len);
-            
-            SPI_Cmd(spix, ENABLE);
-            
-            // ѯսգֹ
-            for (uint32 i = 0; i < len; i++) {
-                while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_RXNE) == RESET);
-                (void)SPI_I2S_ReceiveData(spix);
-            }
-            
-            spi_wait_idle(spi_n);
-            dma_wait_done(tx_dma);
-            DMA_Cmd(tx_dma, DISABLE);
-        } else if (write_buffer == NULL) {
-            // ֻգʹѯRXDMA
-            for (uint32 i = 0; i < len; i++) {
-                read_buffer[i] = spi_rw_byte(spi_n, 0xFF);
-            }
-        } else {
-            // ȫ˫DMA + ѯ
-            DMA_Channel_TypeDef *tx_dma = SPI_TX_DMA_CH(spi_n);
-            
-            SPI_Cmd(spix, DISABLE);
-            spi_wait_idle(spi_n);
-            
-            // սջ
-            while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_RXNE) == SET) {
-                (void)SPI_I2S_ReceiveData(spix);
-            }
-            
-            tx_dma->CMAR = (uint32)write_buffer;
-            dma_start(tx_dma, (uint16)len);
-            
-            SPI_Cmd(spix, ENABLE);
-            
-            // ѯ
-            for (uint32 i = 0; i < len; i++) {
-                while (SPI_I2S_GetFlagStatus(spix, SPI_I2S_FLAG_RXNE) == RESET);
-                read_buffer[i] = (uint8)SPI_I2S_ReceiveData(spix);
-            }
-            
-            spi_wait_idle(spi_n);
-            dma_wait_done(tx_dma);
-            DMA_Cmd(tx_dma, DISABLE);
-        }
-    }
+#if SPI_TX_USE_DMA
+    // ==================== ģʽ1: DMA  ====================
+    // ύ첽֮ շ DMA  ȴδٷ
+    spi_xfer_run(spi_n, write_buffer, read_buffer, len, 0);
 #elif !SPI_TX_USE_DMA && SPI_RX_USE_DMA
-    // ==================== ģʽ3: RXDMATXѯ ====================
+    // ==================== ģʽ2: RXDMATXѯ ====================
     // ԣѯ + DMA
     {
-        if (write_buffer == NULL && read_buffer != NULL) {
+        if (write_buffer == NULL && read_buffer != NULL && g_spi_dma[spi_n - SPI_1]) {
             // ֻգѯ0xFF + DMA
             DMA_Channel_TypeDef *rx_dma = SPI_RX_DMA_CH(spi_n);
+
+            while (len > 65535) {
+                // CNDTR ֻ 16 λ ʱֶν
+                spi_transfer_8bit(spi_n, NULL, read_buffer, 65535);
+                read_buffer += 65535;
+                len -= 65535;
+            }
             
             SPI_Cmd(spix, DISABLE);
             spi_wait_idle(spi_n);
@@ -485,7 +915,7 @@ void spi_transfer_8bit(spi_index_enum spi_n, const uint8 *write_buffer, uint8 *r
         }
     }
 #else
-    // ==================== ģʽ4: ȫѯģʽ ====================
+    // ==================== ģʽ3: ȫѯģʽ ====================
     {
         const uint8 *tx_ptr = write_buffer;
         uint8 *rx_ptr = read_buffer;
@@ -507,11 +937,15 @@ void spi_transfer_8bit(spi_index_enum spi_n, const uint8 *write_buffer, uint8 *r
 // ˵          len          
 //           void
 // ʹʾ          spi_transfer_16bit(SPI_1, txbuf, rxbuf, 4);
-// עϢ          
+// עϢ          ʹ DMA ʱе 16 λ֡鴫 ɸֽǰֽ ʱͬ
 //-------------------------------------------------------------------------------------------------------------------
 void spi_transfer_16bit(spi_index_enum spi_n, const uint16 *write_buffer, uint16 *read_buffer, uint32 len)
 {
-    if (len == 0 || len > 32767) return;  // 65534ֽ
+    if (len == 0) return;
+    if (write_buffer == NULL && read_buffer == NULL) return;
+#if SPI_TX_USE_DMA
+    spi_xfer_run(spi_n, write_buffer, read_buffer, len, SPI_XFER_16BIT);
+#else
     
     // ʹʱֽת
     uint8 temp_tx[64];  // ջʱƵδ32֣64ֽڣ
@@ -547,6 +981,7 @@ void spi_transfer_16bit(spi_index_enum spi_n, const uint16 *write_buffer, uint16
         
         offset += chunk_len;
     }
+#endif
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -568,6 +1003,9 @@ void spi_init(spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_sck_pin
     GPIO_TypeDef *sck_port, *mosi_port, *miso_port, *cs_port;
     uint16 sck_pin_, mosi_pin_, miso_pin_, cs_pin_;
 
+#if SPI_TX_USE_DMA
+    spi_flush(spi_n);                                               /* ͬһĴ */
+#endif
     /* 1. ʱ */
     if (spi_n == SPI_1)
     {
@@ -632,24 +1070,18 @@ void spi_init(spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_sck_pin
     spi.SPI_CPHA      = (mode & 0x01) ? SPI_CPHA_2Edge : SPI_CPHA_1Edge;
     spi.SPI_NSS       = SPI_NSS_Soft;
 
-    /*  APB ʱӼƵSPI1-72MSPI2-36M */
-    const uint32 apbclk = (spi_n == SPI_1) ? 72000000 : 36000000;
-    spi.SPI_BaudRatePrescaler =
-        (baud >= apbclk / 2)   ? SPI_BaudRatePrescaler_2 :
-        (baud >= apbclk / 4)   ? SPI_BaudRatePrescaler_4 :
-        (baud >= apbclk / 8)   ? SPI_BaudRatePrescaler_8 :
-        (baud >= apbclk / 16)  ? SPI_BaudRatePrescaler_16 :
-        (baud >= apbclk / 32)  ? SPI_BaudRatePrescaler_32 :
-        (baud >= apbclk / 64)  ? SPI_BaudRatePrescaler_64 :
-        (baud >= apbclk / 128) ? SPI_BaudRatePrescaler_128 :
-                                 SPI_BaudRatePrescaler_256;
+    spi.SPI_BaudRatePrescaler = spi_baud_prescaler(spi_n, baud);
 
     spi.SPI_FirstBit = SPI_FirstBit_MSB;
     SPI_Init(spix, &spi);
     SPI_Cmd(spix, ENABLE);          /* һ */
 		
-    /* 5. ʼDMA */
+    /* 5. ʼDMA ͨѱռʱ dma1_claim  zf_log ͻ · SPI ˻زѯ */
+#if SPI_TX_USE_DMA || SPI_RX_USE_DMA
+    g_spi_dma[spi_n - SPI_1] = spi_dma_claim(spi_n);
+#endif
 #if SPI_TX_USE_DMA
+if (g_spi_dma[spi_n - SPI_1])
 {
         DMA_Channel_TypeDef *dma_ch = SPI_TX_DMA_CH(spi_n);
         
@@ -677,7 +1109,8 @@ void spi_init(spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_sck_pin
 }
 #endif
 
-#if SPI_RX_USE_DMA
+#if SPI_TX_USE_DMA || SPI_RX_USE_DMA
+if (g_spi_dma[spi_n - SPI_1])
 {
         DMA_Channel_TypeDef *dma_ch = SPI_RX_DMA_CH(spi_n);
         
@@ -704,5 +1137,23 @@ void spi_init(spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_sck_pin
         SPI_I2S_DMACmd(spix, SPI_I2S_DMAReq_Rx, ENABLE);
 }
 #endif
+
+#if SPI_TX_USE_DMA
+if (g_spi_dma[spi_n - SPI_1])
+{
+        /* 6. 첽 ͨжƽ */
+        spi_bus_struct *bus = &g_spi_bus[spi_n - SPI_1];
+        NVIC_InitTypeDef nv;
+
+        dma1_irq_register(bus->rx_channel, spi_dma_irq_handler, bus);
+        NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
+        nv.NVIC_IRQChannel                   = DMA1_Channel1_IRQn + bus->rx_channel;
+        nv.NVIC_IRQChannelPreemptionPriority = (spi_n == SPI_1) ? SPI1_DMA_NVIC_PREEMPT_PRIORITY : SPI2_DMA_NVIC_PREEMPT_PRIORITY;
+        nv.NVIC_IRQChannelSubPriority        = 0;
+        nv.NVIC_IRQChannelCmd                = ENABLE;
+        NVIC_Init(&nv);
+}
+#endif
+    g_spi_active[spi_n - SPI_1] = NULL;                             /* CR1 ѱд ´ռʱл */
 }
 
@@ -23,9 +23,53 @@
 // ĶҪȱ벢س򣬵ƬģҪϵͨѶ
 #define SPI_TX_USE_DMA         (1)                                       // Ĭʹ DMA ʽ	
 #define SPI_RX_USE_DMA         (0)                                       // Ĭʹ DMA ʽ	
-
-
-
+// DMA ͨѱռʱ spi_init  zf_log ͻ · SPI ˻زѯ spi_submit ֮ںڴٷ
+
+// SPI_TX_USE_DMA Ϊ 1 ʱ첽
+// ÿ DMA  շͨͬʱ ͨжϱʾһλƳ 漴ͷƬѡһ
+//  spi_* ͬɶ ύ첽ִ֮
+#define SPI_QUEUE_SIZE                  (8)                                     // ÿ· SPI ŶӵĴ Ϊ 2 
+#define SPI1_DMA_NVIC_PREEMPT_PRIORITY  (6)                                     // SPI1 DMA жռȼ
+#define SPI2_DMA_NVIC_PREEMPT_PRIORITY  (7)                                     // SPI2 DMA жռȼ
+
+#define SPI_XFER_CS_NONE                ((gpio_pin_enum)0xFF)                   // 䲻Ƭѡ ɵ߿
+
+#define SPI_XFER_16BIT                  (0x01)                                  // 16 λ֡ tx/rx ָ uint16  length ֡ ֽȷ
+#define SPI_XFER_TX_FIXED               (0x02)                                  // ͵ַ ظ tx ָͬһ 
+
+typedef enum
+{
+    SPI_XFER_IDLE,                                                              // δύȡ߽
+    SPI_XFER_QUEUED,                                                            // Ŷ
+    SPI_XFER_ACTIVE,                                                            // ڴ
+    SPI_XFER_DONE,                                                              // 
+}spi_xfer_state_enum;
+
+typedef struct spi_xfer_struct
+{
+    gpio_pin_enum                   cs_pin;                                     // Ƭѡ 俪ʼ  SPI_XFER_CS_NONE 
+    uint8                           cs_hold;                                    // 1-󱣳ƬѡΪ һһ֡
+    const uint8                     *tx;                                        //  NULL ʱ 0xFF
+    uint8                           *rx;                                        // ջ NULL ʱ
+    uint32                          length;                                     // ֡  65535 ʱԶֶ
+    uint8                           flags;                                      // SPI_XFER_16BIT / SPI_XFER_TX_FIXED  0 Ϊͨ 8 λ
+    void                            (*callback)(struct spi_xfer_struct *xfer);  // ɻص  DMA жִ Ϊ NULL
+    void                            *user_data;                                 // صʹõû
+    volatile spi_xfer_state_enum    state;                                      // ״̬ ά
+}spi_xfer_struct;
+
+// ߹ ͬһ· SPI ϹҶģʽʲͬʱʹ
+// ÿһ spi_device_struct ¼ģʽƵƬѡ ʼʱ CR1
+// ֡ ÿδ spi_write_16bit*  SPI_XFER_16BIT Ĵ 16 λ֡  8 λ֡
+// ǰ spi_device_acquire ռ һʹõͬʱŸд CR1  spi_device_release ͷ
+// ռòȴ ߱ռ Ҫллдʱֱӷ 1 жѭд Flash ʱζȡ
+// ѭ while (spi_device_acquire(&dev)); ȴ жϷǰһͷ
+typedef struct
+{
+    spi_index_enum                  spi_n;                                      //  SPI ģ
+    gpio_pin_enum                   cs_pin;                                     // Ƭѡ SPI_XFER_CS_NONE ʾʼ
+    uint16                          cr1;                                        // Ԥõ CR1 ģʽ Ƶ
+}spi_device_struct;
 
 //====================================================SPI ====================================================
 void        spi_write_8bit                  (spi_index_enum spi_n, const uint8 data);
@@ -34,6 +78,9 @@ void        spi_write_8bit_array            (spi_index_enum spi_n, const uint8 *
 void        spi_write_16bit                 (spi_index_enum spi_n, const uint16 data);
 void        spi_write_16bit_array           (spi_index_enum spi_n, const uint16 *data, uint32 len);
 
+void        spi_write_8bit_repeat           (spi_index_enum spi_n, const uint8 data, uint32 len);
+void        spi_write_16bit_repeat          (spi_index_enum spi_n, const uint16 data, uint32 len);
+
 void        spi_write_8bit_register         (spi_index_enum spi_n, const uint8 register_name, const uint8 data);
 void        spi_write_8bit_registers        (spi_index_enum spi_n, const uint8 register_name, const uint8 *data, uint32 len);
 
@@ -55,6 +102,14 @@ void        spi_read_16bit_registers        (spi_index_enum spi_n, const uint16
 void        spi_transfer_8bit               (spi_index_enum spi_n, const uint8 *write_buffer, uint8 *read_buffer, uint32 len);
 void        spi_transfer_16bit              (spi_index_enum spi_n, const uint16 *write_buffer, uint16 *read_buffer, uint32 len);
 
+uint8       spi_submit                      (spi_index_enum spi_n, spi_xfer_struct *xfer);
+uint32      spi_pending                     (spi_index_enum spi_n);
+void        spi_flush                       (spi_index_enum spi_n);
+
+void        spi_device_init                 (spi_device_struct *device, spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, gpio_pin_enum cs_pin);
+uint8       spi_device_acquire              (spi_device_struct *device);
+void        spi_device_release              (spi_device_struct *device);
+
 void        spi_init                        (spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_sck_pin_enum sck_pin, spi_mosi_pin_enum mosi_pin, spi_miso_pin_enum miso_pin, spi_cs_pin_enum cs_pin);
 //====================================================SPI ====================================================
 
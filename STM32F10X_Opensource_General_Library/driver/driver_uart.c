@@ -21,17 +21,77 @@ typedef struct
     USART_TypeDef       *uartx;
     DMA_Channel_TypeDef *tx_dma_ch;
     DMA_Channel_TypeDef *rx_dma_ch;
-    uint8               rx_buf[UART_RX_BUF_SIZE];
-    volatile uint16     rx_head;
-    volatile uint16     rx_tail;
+    uint8               *rx_buf;                                        /* ջ */
+    uint32              rx_mask;                                        /* ջСһ */
+    uint8               *tx_buf;                                        /* DMA ͻ */
+    uint32              tx_mask;                                        /* DMA ͻСһ */
+    volatile uint32     rx_head;                                        /* жϽдλ DMA ʱ CNDTR  ʹ */
+    volatile uint32     rx_tail;                                        /* ȡλ */
+#if UART_RX_LINE_ENABLE
+    uint32              rx_scan;                                        /* Ѳҹָλ DMA ʱʹ */
+    volatile uint32     rx_lines;                                       /*  */
+#endif
+    uint8               rx_flow;                                        /* Ƿ RTS Ӳ */
+    volatile uint8      rx_throttled;                                   /* ͣ ȴȡָ */
+    uint32              baud;                                           /* ʵʲ */
+    int32               baud_error;                                     /*  λ 0.01% */
+    uart_stats_struct   stats;                                          /* շͳ */
+#if UART_RX_USE_DMA
+    uint8               rx_dma;                                         /* ͨǼǳɹ Ϊ 0 ʱ˻жϽ */
+#endif
+#if UART_TX_USE_DMA
+    uint8               tx_dma;                                         /* ͨǼǳɹ Ϊ 0 ʱ˻زѯ */
+    volatile uint32     tx_head;                                        /* дֽ  */
+    volatile uint32     tx_tail;                                        /* ѷֽ  */
+    volatile uint32     tx_dma_len;                                     /* ǰ DMA ڷ͵ĳ 0 ʾ */
+#endif
 }uart_handle_t;
 
+/* Ĭϻ СΪ 0 ʱ  uart_set_buffer ṩ */
+#if UART1_RX_BUF_SIZE
+static uint8 g_uart1_rx_buf[UART1_RX_BUF_SIZE];
+#define UART1_RX_BUF    (g_uart1_rx_buf)
+#else
+#define UART1_RX_BUF    (NULL)
+#endif
+#if UART2_RX_BUF_SIZE
+static uint8 g_uart2_rx_buf[UART2_RX_BUF_SIZE];
+#define UART2_RX_BUF    (g_uart2_rx_buf)
+#else
+#define UART2_RX_BUF    (NULL)
+#endif
+#if UART3_RX_BUF_SIZE
+static uint8 g_uart3_rx_buf[UART3_RX_BUF_SIZE];
+#define UART3_RX_BUF    (g_uart3_rx_buf)
+#else
+#define UART3_RX_BUF    (NULL)
+#endif
+
+#if UART_TX_USE_DMA && UART1_TX_BUF_SIZE
+static uint8 g_uart1_tx_buf[UART1_TX_BUF_SIZE];
+#define UART1_TX_BUF    (g_uart1_tx_buf)
+#else
+#define UART1_TX_BUF    (NULL)
+#endif
+#if UART_TX_USE_DMA && UART2_TX_BUF_SIZE
+static uint8 g_uart2_tx_buf[UART2_TX_BUF_SIZE];
+#define UART2_TX_BUF    (g_uart2_tx_buf)
+#else
+#define UART2_TX_BUF    (NULL)
+#endif
+#if UART_TX_USE_DMA && UART3_TX_BUF_SIZE
+static uint8 g_uart3_tx_buf[UART3_TX_BUF_SIZE];
+#define UART3_TX_BUF    (g_uart3_tx_buf)
+#else
+#define UART3_TX_BUF    (NULL)
+#endif
+
 /* ̬ */
 static uart_handle_t g_uart[3] =
 {
-    {USART1, DMA1_Channel4, DMA1_Channel5},   /* UART1 */
-    {USART2, DMA1_Channel7, DMA1_Channel6},   /* UART2 */
-    {USART3, DMA1_Channel2, DMA1_Channel3},   /* UART3 */
+    {USART1, DMA1_Channel4, DMA1_Channel5, UART1_RX_BUF, UART1_RX_BUF_SIZE - 1, UART1_TX_BUF, UART1_TX_BUF_SIZE - 1},   /* UART1 */
+    {USART2, DMA1_Channel7, DMA1_Channel6, UART2_RX_BUF, UART2_RX_BUF_SIZE - 1, UART2_TX_BUF, UART2_TX_BUF_SIZE - 1},   /* UART2 */
+    {USART3, DMA1_Channel2, DMA1_Channel3, UART3_RX_BUF, UART3_RX_BUF_SIZE - 1, UART3_TX_BUF, UART3_TX_BUF_SIZE - 1},   /* UART3 */
 };
 
 /* ȡں */
@@ -48,6 +108,37 @@ static inline uint8_t uart_get_irq_channel(USART_TypeDef *u)
     return USART3_IRQn;
 }
 
+/* Ӳ ӳ䲻Ӱ CTS/RTS λ */
+static GPIO_TypeDef * const g_uart_flow_port[3] = {GPIOA, GPIOA, GPIOB};
+static const uint16 g_uart_rts_pin[3] = {GPIO_Pin_12, GPIO_Pin_1, GPIO_Pin_14};   /* PA12 PA1 PB14 */
+static const uint16 g_uart_cts_pin[3] = {GPIO_Pin_11, GPIO_Pin_0, GPIO_Pin_13};   /* PA11 PA0 PB13 */
+
+/* жҪͳƵĴ־ */
+#define UART_SR_ERROR           (USART_FLAG_ORE | USART_FLAG_NE | USART_FLAG_FE | USART_FLAG_PE)
+
+/* DMA ֻͳƷָʱʹͨж */
+#define UART_RX_DMA_IRQ         (UART_RX_USE_DMA && UART_RX_LINE_ENABLE)
+
+#if UART_RX_DMA_IRQ
+  /* RX DMAͨж ȫʱһ ֤ÿһȦͳ */
+  static const uint32 g_dma_rx_it_gl[3] = {
+      DMA1_IT_GL5,     /* UART1 RX - Channel 5 */
+      DMA1_IT_GL6,     /* UART2 RX - Channel 6 */
+      DMA1_IT_GL3      /* UART3 RX - Channel 3 */
+  };
+
+  static void uart_rx_dma_handler(void *arg);
+#endif
+
+#if UART_RX_USE_DMA
+  static const dma_channel_enum g_dma_rx_channel[3] = {
+      dma1_CH5,   /* UART1 RX - Channel 5 */
+      dma1_CH6,   /* UART2 RX - Channel 6 */
+      dma1_CH3    /* UART3 RX - Channel 3 */
+  };
+  static const dma_owner_enum g_dma_rx_owner[3] = {DMA_OWNER_UART1_RX, DMA_OWNER_UART2_RX, DMA_OWNER_UART3_RX};
+#endif
+
 #if UART_TX_USE_DMA
   /* TX DMAͨ־ */
   static const uint32 g_dma_tx_tc_flag[3] = {
@@ -55,25 +146,62 @@ static inline uint8_t uart_get_irq_channel(USART_TypeDef *u)
       DMA1_FLAG_TC7,   /* UART2 TX - Channel 7 */
       DMA1_FLAG_TC2    /* UART3 TX - Channel 2 */
   };
-#endif
 
-#if UART_RX_USE_DMA
-  /* RX DMAͨжϱ־ */
-  static const uint32 g_dma_rx_tc_flag[3] = {
-      DMA1_IT_TC5,   /* UART1 RX - Channel 5 */
-      DMA1_IT_TC6,   /* UART2 RX - Channel 6 */
-      DMA1_IT_TC3    /* UART3 RX - Channel 3 */
+  /* TX DMAͨ */
+  static const dma_channel_enum g_dma_tx_channel[3] = {
+      dma1_CH4,   /* UART1 TX - Channel 4 */
+      dma1_CH7,   /* UART2 TX - Channel 7 */
+      dma1_CH2    /* UART3 TX - Channel 2 */
   };
+  static const dma_owner_enum g_dma_tx_owner[3] = {DMA_OWNER_UART1_TX, DMA_OWNER_UART2_TX, DMA_OWNER_UART3_TX};
+
+  static void uart_tx_dma_handler(void *arg);
 
-// ȡDMAͨӦжͨ
-static inline uint8_t uart_get_dma_irq_channel(uint8 idx)
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ͻһݵ DMA 
+// ˵       *hu             ھ
+// ز       void
+// ʹʾ       uart_tx_dma_start(hu);
+// עϢ       ڲ ǰж DMA 
+//                ڻβʱֻ͵βΪֹ ʣಿɴжϽ
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_tx_dma_start(uart_handle_t *hu)
 {
-    // DMAͨ: UART1=CH5, UART2=CH6, UART3=CH3
-    const uint8_t dma_irq[] = {DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel3_IRQn};
-    return dma_irq[idx];
+    uint32 tail = hu->tx_tail & hu->tx_mask;
+    uint32 len  = hu->tx_head - hu->tx_tail;
+
+    if(len == 0) return;
+    if(len > hu->tx_mask + 1 - tail) len = hu->tx_mask + 1 - tail;
+
+    hu->tx_dma_len       = len;
+    hu->tx_dma_ch->CMAR  = (uint32)&hu->tx_buf[tail];                   /* Դַ */
+    hu->tx_dma_ch->CNDTR = len;                                         /*  */
+    USART_ClearFlag(hu->uartx, USART_FLAG_TC);                          /*  TC  uart_tx_flush жһֽƳ */
+    DMA_Cmd(hu->tx_dma_ch, ENABLE);                                     /*  */
 }
 
-#endif	
+//-------------------------------------------------------------------------------------------------------------------
+//        һ DMA  ͷŻռ䲢һ
+// ˵       idx             
+// ز       void
+// ʹʾ       uart_tx_dma_complete(idx);
+// עϢ       ڲ ǰж TC ־δλʱκβ
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_tx_dma_complete(uint8 idx)
+{
+    uart_handle_t *hu = &g_uart[idx];
+
+    if(DMA_GetFlagStatus(g_dma_tx_tc_flag[idx]) == RESET) return;
+    DMA_ClearFlag(g_dma_tx_tc_flag[idx]);
+    DMA_Cmd(hu->tx_dma_ch, DISABLE);
+    hu->stats.tx_bytes += hu->tx_dma_len;
+    hu->tx_tail   += hu->tx_dma_len;
+    hu->tx_dma_len = 0;
+    uart_tx_dma_start(hu);
+}
+#endif
+
 //-------------------------------------------------------------------------------------------------------------------
 //        ڷд
 // ˵       uart_n          ģ 
@@ -84,14 +212,18 @@ static inline uint8_t uart_get_dma_irq_channel(uint8 idx)
 //-------------------------------------------------------------------------------------------------------------------
 void uart_write_byte(uart_index_enum uartn, const uint8 dat)
 {
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
 #if UART_TX_USE_DMA 
-    uint8 tmp = dat;
-    uart_write_buffer(uartn, &tmp, 1);
-#else
-    USART_TypeDef *u = g_uart[uart_idx(uartn)].uartx;
-    while(USART_GetFlagStatus(u, USART_FLAG_TXE) == RESET);
-    USART_SendData(u, dat);	
+    if(hu->tx_dma)
+    {
+        uint8 tmp = dat;
+        uart_write_buffer(uartn, &tmp, 1);
+        return;
+    }
 #endif	
+    while(USART_GetFlagStatus(hu->uartx, USART_FLAG_TXE) == RESET);
+    USART_SendData(hu->uartx, dat);
+    hu->stats.tx_bytes ++;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -101,7 +233,9 @@ void uart_write_byte(uart_index_enum uartn, const uint8 dat)
 // ˵       len             ͳ
 // ز       void
 // ʹʾ       uart_write_buffer(UART_1, &a[0], 5);
-// עϢ
+// עϢ       DMA ģʽȿ뷢ͻ 漴 buff 
+//                ʱȴ DMA ڳռ Ҫȷȫʱ uart_tx_flush
+//                DMA ͨռʱ˻ֽڲѯ
 //-------------------------------------------------------------------------------------------------------------------
 void uart_write_buffer(uart_index_enum uartn, const uint8 *buff, uint32 len)
 {
@@ -109,20 +243,33 @@ void uart_write_buffer(uart_index_enum uartn, const uint8 *buff, uint32 len)
 #if UART_TX_USE_DMA 
     uint8 idx = uart_idx(uartn);
     uart_handle_t *hu = &g_uart[idx];
+    uint32 chunk, head, first;
 
-    while(hu->tx_dma_ch->CCR & DMA_CCR1_EN);          /* һ */
-    hu->tx_dma_ch->CMAR  = (uint32)buff;              /* Դַ */
-    hu->tx_dma_ch->CNDTR = len;                       /*  */
-		DMA_ClearFlag(g_dma_tx_tc_flag[idx]);             /*  TC־ - ʹòʽ */       /*  TC */
-    DMA_Cmd(hu->tx_dma_ch, ENABLE);                   /*  */
-
-    while(DMA_GetFlagStatus(g_dma_tx_tc_flag[idx]) == RESET); /* ȴ */
-	  DMA_Cmd(hu->tx_dma_ch, DISABLE);
-#else
-    while(len--) uart_write_byte(uartn, *buff++);	
-	
+    while(len && hu->tx_dma)
+    {
+        CRIT_ENTER();
+        chunk = hu->tx_mask + 1 - (hu->tx_head - hu->tx_tail);
+        if(chunk == 0)
+        {
+            /*  ڸȼжʱ DMA жϽ ѯɱ־ */
+            uart_tx_dma_complete(idx);
+            CRIT_EXIT();
+            continue;
+        }
+        if(chunk > len) chunk = len;
+        head  = hu->tx_head & hu->tx_mask;
+        first = hu->tx_mask + 1 - head;
+        if(first > chunk) first = chunk;
+        memcpy(&hu->tx_buf[head], buff, first);                         /* β */
+        memcpy(hu->tx_buf, buff + first, chunk - first);                /* ƵͷĲ */
+        hu->tx_head += chunk;
+        if(hu->tx_dma_len == 0) uart_tx_dma_start(hu);                  /* DMA  */
+        CRIT_EXIT();
+        buff += chunk;
+        len  -= chunk;
+    }
 #endif	
-	
+    while(len--) uart_write_byte(uartn, *buff++);	
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -138,17 +285,165 @@ void uart_write_string(uart_index_enum uartn, const char *str)
     uart_write_buffer(uartn, (uint8*)str, strlen(str));
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//        ѯͻδֽ
+// ˵       uart_n          ģ
+// ز       uint32          δֽ  DMA ģʽºΪ 0
+// ʹʾ       if(uart_tx_pending(UART_1) < 64) { ... }
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_tx_pending(uart_index_enum uartn)
+{
+#if UART_TX_USE_DMA
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+    return hu->tx_head - hu->tx_tail;
+#else
+    (void)uartn;
+    return 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ȴȫ
+// ˵       uart_n          ģ
+// ز       void
+// ʹʾ       uart_tx_flush(UART_1);                            // ͹Ļλǰ
+// עϢ       ȴͻһֽƳλĴ
+//-------------------------------------------------------------------------------------------------------------------
+void uart_tx_flush(uart_index_enum uartn)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+#if UART_TX_USE_DMA
+    while(hu->tx_head != hu->tx_tail)
+    {
+        CRIT_ENTER();
+        uart_tx_dma_complete(uart_idx(uartn));                          /* жϱʱҲܼƽ */
+        CRIT_EXIT();
+    }
+#endif
+    while(USART_GetFlagStatus(hu->uartx, USART_FLAG_TC) == RESET);
+}
+
 /*============================ ղ ============================*/
+#if UART_RX_USE_DMA
+/* DMA ѭд rx_buf ǰдλ CNDTR  ֻάȡλ rx_tail ͨǼʧʱжϽմ */
+static uint32 uart_rx_head(uart_handle_t *hu)
+{
+    return (hu->rx_mask + 1 - hu->rx_dma_ch->CNDTR) & hu->rx_mask;     /* CNDTR װ˲ܶ 0 ͬΪ 0 */
+}
+
+#if UART_RX_LINE_ENABLE
+
+/* ͳ DMA деķָշͳ ÿֻֽһ ǰж */
+/* DMA /ȫжϱ֤ε֮Ȧ ݴждλǷ׷˶ȡλ */
+static void uart_rx_scan(uart_handle_t *hu)
+{
+    uint32 head, scan, fresh, used;
+
+    if(!hu->rx_dma) return;                                             /* жϽʱָ uart_rx_push ֽͳ */
+    head  = uart_rx_head(hu);
+    scan  = hu->rx_scan;
+    fresh = (head - scan) & hu->rx_mask;
+    used  = ((scan - hu->rx_tail) & hu->rx_mask) + fresh;
+
+    hu->stats.rx_bytes += fresh;
+    if(used > hu->rx_mask)
+    {
+        /*  ȡֻܿ used ԻСȡĲ Ϊʧ */
+        hu->stats.rx_dropped += used - (used & hu->rx_mask);
+        used = hu->rx_mask + 1;
+        scan = hu->rx_tail;                                             /* ͳƵпܱ Ӷȡλͳ */
+        hu->rx_lines = 0;
+    }
+    if(used > hu->stats.rx_peak) hu->stats.rx_peak = used;
+
+    while(scan != head)
+    {
+        if(hu->rx_buf[scan] == UART_LINE_DELIMITER) hu->rx_lines ++;
+        scan = (scan + 1) & hu->rx_mask;
+    }
+    hu->rx_scan = scan;
+}
+
+/* ͳдݺ󷵻ضȡõĽλ ȡԽͳƵλ ͳƲŲظ© */
+static uint32 uart_rx_sync(uart_handle_t *hu)
+{
+    uint32 head;
+
+    if(!hu->rx_dma) return hu->rx_head;
+    CRIT_ENTER();
+    uart_rx_scan(hu);
+    head = hu->rx_scan;
+    CRIT_EXIT();
+    return head;
+}
+#else
+/* ͳƷָ ֻǰռø rx_peak Ҫ DMA ж ޷ rx_bytes/rx_dropped ͳ */
+static void uart_rx_scan(uart_handle_t *hu)
+{
+    uint32 used;
+
+    if(!hu->rx_dma) return;
+    used = (uart_rx_head(hu) - hu->rx_tail) & hu->rx_mask;
+    if(used > hu->stats.rx_peak) hu->stats.rx_peak = used;
+}
+
+/* ȡֱʹ DMA дλ */
+static uint32 uart_rx_sync(uart_handle_t *hu)
+{
+    uint32 head, used;
+
+    if(!hu->rx_dma) return hu->rx_head;
+    head = uart_rx_head(hu);
+    used = (head - hu->rx_tail) & hu->rx_mask;
+    if(used > hu->stats.rx_peak) hu->stats.rx_peak = used;
+    return head;
+}
+#endif
+#else
+/* жϽ дλɽжά */
+static uint32 uart_rx_sync(uart_handle_t *hu)
+{
+    return hu->rx_head;
+}
+
+/* жϽʱָ uart_rx_push ֽͳ ¿ */
+static void uart_rx_scan(uart_handle_t *hu)
+{
+    (void)hu;
+}
+#endif
+
 /* յ 1 ֽѹ FIFO */
 static void uart_rx_push(uart_index_enum uartn, uint8 dat)
 {
     uint8 idx = uart_idx(uartn);
     uart_handle_t *hu = &g_uart[idx];
-    uint16 next = (hu->rx_head + 1) % UART_RX_BUF_SIZE;
-    if(next != hu->rx_tail)           /* û */
+    uint32 next = (hu->rx_head + 1) & hu->rx_mask;
+    uint32 used;
+
+    hu->stats.rx_bytes ++;
+    if(next == hu->rx_tail)           /*   */
     {
-        hu->rx_buf[hu->rx_head] = dat;
-        hu->rx_head = next;
+        hu->stats.rx_dropped ++;
+        return;
+    }
+    hu->rx_buf[hu->rx_head] = dat;
+    hu->rx_head = next;
+#if UART_RX_LINE_ENABLE
+    if(dat == UART_LINE_DELIMITER) hu->rx_lines ++;
+#endif
+    used = (next - hu->rx_tail) & hu->rx_mask;
+    if(used > hu->stats.rx_peak) hu->stats.rx_peak = used;
+}
+
+/* ȡڳ˿ռ 򻺳ָͣ жϽտ RTS ʱͣ */
+static void uart_rx_release(uart_handle_t *hu)
+{
+    if(hu->rx_throttled)
+    {
+        hu->rx_throttled = 0;
+        USART_ITConfig(hu->uartx, USART_IT_RXNE, ENABLE);
     }
 }
 
@@ -164,12 +459,151 @@ uint8 uart_query_byte(uart_index_enum uartn, uint8 *dat)
 {
     uint8 idx = uart_idx(uartn);
     uart_handle_t *hu = &g_uart[idx];
-    if(hu->rx_head == hu->rx_tail) return 0;   /*  */
+    if(uart_rx_sync(hu) == hu->rx_tail) return 0;   /*  */
     *dat = hu->rx_buf[hu->rx_tail];
-    hu->rx_tail = (hu->rx_tail + 1) % UART_RX_BUF_SIZE;
+    hu->rx_tail = (hu->rx_tail + 1) & hu->rx_mask;
+#if UART_RX_LINE_ENABLE
+    if(*dat == UART_LINE_DELIMITER && hu->rx_lines)                     /* ֽȡ߷ָ ͬ */
+    {
+        CRIT_ENTER();
+        if(hu->rx_lines) hu->rx_lines --;
+        CRIT_EXIT();
+    }
+#endif
+    uart_rx_release(hu);
     return 1;
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//        ȡڽյݣѯգ
+// ˵       uart_n          ģ
+// ˵       *buff           ݵĵַ
+// ˵       len             ȡֽ
+// ز       uint32          ʵʶȡֽ ûʱΪ 0
+// ʹʾ       uint8 buf[64]; uint32 n = uart_read_buffer(UART_1, buf, sizeof(buf));
+// עϢ       ȴ ջʱο
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_read_buffer(uart_index_enum uartn, uint8 *buff, uint32 len)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+    uint32 head = uart_rx_sync(hu);
+    uint32 tail = hu->rx_tail;
+    uint32 avail = (head - tail) & hu->rx_mask;
+    uint32 first;
+#if UART_RX_LINE_ENABLE
+    uint32 lines = 0, i;
+#endif
+
+    if(len > avail) len = avail;
+    first = hu->rx_mask + 1 - tail;
+    if(first > len) first = len;
+    memcpy(buff, &hu->rx_buf[tail], first);                 /* β */
+    memcpy(buff + first, hu->rx_buf, len - first);          /* ƵͷĲ */
+    hu->rx_tail = (tail + len) & hu->rx_mask;
+#if UART_RX_LINE_ENABLE
+    if(hu->rx_lines)                                        /* δʱ ȡߵķָп۳ */
+    {
+        for(i = 0; i < len; i ++) lines += (buff[i] == UART_LINE_DELIMITER);
+        CRIT_ENTER();
+        hu->rx_lines = (hu->rx_lines > lines) ? (hu->rx_lines - lines) : 0;
+        CRIT_EXIT();
+    }
+#endif
+    uart_rx_release(hu);
+    return len;
+}
+
+#if UART_RX_LINE_ENABLE
+//-------------------------------------------------------------------------------------------------------------------
+//        ѯջе
+// ˵       uart_n          ģ
+// ز       uint32           UART_LINE_DELIMITER β
+// ʹʾ       if(uart_lines_pending(UART_3)) { ... }
+// עϢ       ָڽʱͳ ѯ뻺޹
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_lines_pending(uart_index_enum uartn)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+    uint32 lines;
+
+    CRIT_ENTER();
+    uart_rx_scan(hu);
+    lines = hu->rx_lines;
+    CRIT_EXIT();
+    return lines;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ȡһ
+// ˵       uart_n          ģ
+// ˵       *buff           ַĵַ  '\0' β ָβ '\r'
+// ˵       len             buff ĴС Ϊ 2 С 2 ʱȡֱӷ 0
+// ز       uint32          ַ ûʱ 0
+// ʹʾ       char line[96]; if(uart_read_line(UART_3, line, sizeof(line))) { parse(line); }
+// עϢ       ֱӶ г len - 1 ʱض ʣಿֶ
+//                ջûзָʱ ѻݵһȡ һֱ޷
+//                 uart_query_byte / uart_read_buffer  ȡߵķָͬп۳
+//                ͳ뻺ݲһʱ( DMA ձ) ԻʵΪ׼ Ҳָ
+//                ʱδ 0 ķʽȡ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_read_line(uart_index_enum uartn, char *buff, uint32 len)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+    uint32 count, tail, end, avail;
+    uint8 dat, line_end, found;
+
+    if(buff == NULL || len < 2) return 0;                              /* Ҫһַ '\0' ÿһжж */
+    do
+    {
+        CRIT_ENTER();
+        end      = uart_rx_sync(hu);                                    /* λȡͬһͳ */
+        line_end = (hu->rx_lines != 0);
+        CRIT_EXIT();
+
+        tail  = hu->rx_tail;
+        avail = (end - tail) & hu->rx_mask;
+        if(!line_end && avail != hu->rx_mask) return 0;                 /* ûһδ */
+
+        count = 0;
+        found = 0;
+        while(avail --)                                                 /* ֻȡյ */
+        {
+            dat  = hu->rx_buf[tail];
+            tail = (tail + 1) & hu->rx_mask;
+            if(dat == UART_LINE_DELIMITER)
+            {
+                found = 1;
+                break;
+            }
+            if(count < len - 1) buff[count ++] = (char)dat;
+        }
+        if(!found)
+        {
+            CRIT_ENTER();
+            hu->rx_lines = 0;                                           /* ͳʧЧ */
+            CRIT_EXIT();
+            if(((end - hu->rx_tail) & hu->rx_mask) != hu->rx_mask)
+            {
+                buff[0] = '\0';
+                return 0;                                               /* δ ղȫ */
+            }
+        }
+        else
+        {
+            CRIT_ENTER();
+            if(hu->rx_lines) hu->rx_lines --;
+            CRIT_EXIT();
+        }
+        hu->rx_tail = tail;
+        uart_rx_release(hu);
+
+        if(count && buff[count - 1] == '\r') count --;                 /* \r\n β */
+        buff[count] = '\0';
+    }while(count == 0);
+    return count;
+}
+#endif
+
 //-------------------------------------------------------------------------------------------------------------------
 //        ȡڽյݣwhlieȴ
 // ˵       uart_n          ģ  zf_driver_uart.h  uart_index_enum ö嶨
@@ -186,18 +620,84 @@ uint8 uart_read_byte(uart_index_enum uartn)
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//        ڳʼ
-//  ˵      uartn           ģ(UART_0,UART_1,UART_2,UART_3)
+//        ʹԶ洢ռΪշ
+// ˵       uart_n          ģ
+// ˵       *rx_buff        ջ NULL ʾԭ
+// ˵       rx_size         ջС  2 
+// ˵       *tx_buff        DMA ͻ NULL ʾԭ  DMA ģʽ²ʹ
+// ˵       tx_size         DMA ͻС  2 
+// ز       uint8           0ɹ   1С 2 
+// ʹʾ       static uint8 gnss_rx[1024]; uart_set_buffer(UART_3, gnss_rx, sizeof(gnss_rx), NULL, 0);
+// עϢ       Ҫ uart_init ֮ǰ Ӧ UARTx_RX_BUF_SIZE / UARTx_TX_BUF_SIZE Ϊ 0 ʡȥĬϻ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 uart_set_buffer(uart_index_enum uartn, uint8 *rx_buff, uint32 rx_size, uint8 *tx_buff, uint32 tx_size)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+
+    if(rx_buff != NULL)
+    {
+        if(rx_size == 0 || !UART_BUF_SIZE_CHECK(rx_size)) return 1;
+#if UART_RX_USE_DMA
+        if(rx_size > 32768) return 1;                                   /* CNDTR  65535 */
+#endif
+        hu->rx_buf  = rx_buff;
+        hu->rx_mask = rx_size - 1;
+        hu->rx_head = 0;
+        hu->rx_tail = 0;
+#if UART_RX_LINE_ENABLE
+        hu->rx_scan = 0;
+        hu->rx_lines = 0;
+#endif
+    }
+    if(tx_buff != NULL)
+    {
+        if(tx_size == 0 || !UART_BUF_SIZE_CHECK(tx_size)) return 1;
+        hu->tx_buf  = tx_buff;
+        hu->tx_mask = tx_size - 1;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ڳʼ 8 λ У 1 λֹͣλ 
+//  ˵      uartn           ģ(UART_1,UART_2,UART_3)
 //  ˵      baud            ڲ
 //  ˵      tx_pin          ڷ
 //  ˵      rx_pin          ڽ
 //  ز      uint32          ʵʲ
-//  ʹʾ      uart_init(UART_0,115200,UART0_TX_P14_0,UART0_RX_P14_1);       // ʼ0 115200 ʹP14_0 ʹP14_1
+//  ʹʾ      uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);       // ʼ1 115200 ʹPA9 ʹPA10
 //  עϢ
 //-------------------------------------------------------------------------------------------------------------------
-void uart_init(uart_index_enum uartn, uint32 baud,
+uint32 uart_init(uart_index_enum uartn, uint32 baud,
                uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin)
 {
+    return uart_init_ex(uartn, baud, tx_pin, rx_pin, NULL);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ڳʼ У ֹͣλӲ
+//  ˵      uartn           ģ(UART_1,UART_2,UART_3)
+//  ˵      baud            ڲ USART1  PCLK2/16 USART2/3  PCLK1/16
+//  ˵      tx_pin          ڷ
+//  ˵      rx_pin          ڽ
+//  ˵      *config         ֡ʽ NULL ʾ 8N1 
+//  ز      uint32          ʵʲ
+//  ʹʾ      uart_config_struct cfg = {UART_PARITY_NONE, UART_STOP_1, UART_FLOW_RTS_CTS};
+//                uart_init_ex(UART_2, 2000000, UART2_TX_PA2, UART2_RX_PA3, &cfg);
+//  עϢ      Уʱʹ 9 λֳ Ϊ 8 λ
+//                RTS/CTS Ź̶ USART1 PA12/PA11  USART2 PA1/PA0  USART3 PB14/PB13
+//                жϽʱջͣȡ RTS ֮Ч Էֹͣ ݺԶָ
+//                DMA ʱ RTS ֻ DMA ʱ ֹܷλ
+//                BRR  PCLK / baud   UART_BAUD_ERROR_MAX ʱ  uart_get_baud ѯ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_init_ex(uart_index_enum uartn, uint32 baud,
+               uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin, const uart_config_struct *config)
+{
+    static const uart_config_struct default_config = {UART_PARITY_NONE, UART_STOP_1, UART_FLOW_NONE};
+    static const uint16 parity_table[3]   = {USART_Parity_No, USART_Parity_Even, USART_Parity_Odd};
+    static const uint16 stop_table[4]     = {USART_StopBits_1, USART_StopBits_0_5, USART_StopBits_2, USART_StopBits_1_5};
+    static const uint16 flow_table[4]     = {USART_HardwareFlowControl_None, USART_HardwareFlowControl_RTS,
+                                             USART_HardwareFlowControl_CTS, USART_HardwareFlowControl_RTS_CTS};
     uint8 idx = uart_idx(uartn);
     uart_handle_t *hu = &g_uart[idx];
     USART_TypeDef *u = hu->uartx;
@@ -205,12 +705,24 @@ void uart_init(uart_index_enum uartn, uint32 baud,
     GPIO_InitTypeDef  gpio_init_struct;
     GPIO_TypeDef *tx_port, *rx_port;
     uint16 tx_pin_src, rx_pin_src;
+    RCC_ClocksTypeDef clocks;
+    uint32 pclk, brr;
+
+    if(config == NULL) config = &default_config;
+    zf_assert(0 != baud);
+    zf_assert((uint32)config->parity < sizeof(parity_table) / sizeof(parity_table[0]));   // У鷽ʽ uart_parity_enum Χ
+    zf_assert((uint32)config->stop < sizeof(stop_table) / sizeof(stop_table[0]));         // ֹͣλ uart_stop_enum Χ
+    zf_assert((uint32)config->flow < sizeof(flow_table) / sizeof(flow_table[0]));         // س uart_flow_enum Χ
 
 	  uint8 preempt_pri;
 
-#if UART_RX_USE_DMA
+#if UART_TX_USE_DMA || UART_RX_DMA_IRQ
     uint8_t dma_preempt_pri;  // DMAģʽ¶
 #endif
+#if UART_TX_USE_DMA
+    zf_assert(NULL != hu->tx_buf);                  // UARTx_TX_BUF_SIZE Ϊ 0 ʱȵ uart_set_buffer
+#endif
+    zf_assert(NULL != hu->rx_buf);                  // UARTx_RX_BUF_SIZE Ϊ 0 ʱȵ uart_set_buffer
 	
     /* 1.  uartn ȡ TX/RX ˿ڼԴ */
     if (uartn == UART_1)
@@ -220,7 +732,7 @@ void uart_init(uart_index_enum uartn, uint32 baud,
         tx_pin_src = (tx_pin == UART1_TX_PA9)  ? GPIO_PinSource9  : GPIO_PinSource6;
         rx_pin_src = (rx_pin == UART1_RX_PA10) ? GPIO_PinSource10 : GPIO_PinSource7;
 			  preempt_pri = UART1_NVIC_PREEMPT_PRIORITY;
-#if UART_RX_USE_DMA			
+#if UART_TX_USE_DMA || UART_RX_DMA_IRQ
         dma_preempt_pri = UART1_DMA_NVIC_PREEMPT_PRIORITY;
 #endif			
     }
@@ -229,7 +741,7 @@ void uart_init(uart_index_enum uartn, uint32 baud,
         tx_port = GPIOA; rx_port = GPIOA;
         tx_pin_src = GPIO_PinSource2; rx_pin_src = GPIO_PinSource3;
         preempt_pri = UART2_NVIC_PREEMPT_PRIORITY;
-#if UART_RX_USE_DMA				
+#if UART_TX_USE_DMA || UART_RX_DMA_IRQ
         dma_preempt_pri = UART2_DMA_NVIC_PREEMPT_PRIORITY;
 #endif				
     }
@@ -238,7 +750,7 @@ void uart_init(uart_index_enum uartn, uint32 baud,
         tx_port = GPIOB; rx_port = GPIOB;
         tx_pin_src = GPIO_PinSource10; rx_pin_src = GPIO_PinSource11;
 			  preempt_pri = UART3_NVIC_PREEMPT_PRIORITY;
-#if UART_RX_USE_DMA						
+#if UART_TX_USE_DMA || UART_RX_DMA_IRQ
         dma_preempt_pri = UART3_DMA_NVIC_PREEMPT_PRIORITY;
 #endif			
     }
@@ -260,18 +772,45 @@ void uart_init(uart_index_enum uartn, uint32 baud,
     gpio_init_struct.GPIO_Pin   = (1 << rx_pin_src);
     gpio_init_struct.GPIO_Mode  = GPIO_Mode_IN_FLOATING;
     GPIO_Init(rx_port, &gpio_init_struct);
+    if (config->flow & UART_FLOW_RTS)
+    {
+        gpio_init_struct.GPIO_Pin   = g_uart_rts_pin[idx];
+        gpio_init_struct.GPIO_Mode  = GPIO_Mode_AF_PP;
+        GPIO_Init(g_uart_flow_port[idx], &gpio_init_struct);
+    }
+    if (config->flow & UART_FLOW_CTS)
+    {
+        gpio_init_struct.GPIO_Pin   = g_uart_cts_pin[idx];
+        gpio_init_struct.GPIO_Mode  = GPIO_Mode_IPU;               /* δʱ ΪԷæ */
+        GPIO_Init(g_uart_flow_port[idx], &gpio_init_struct);
+    }
 
     /* 3.  USART  */
     USART_InitTypeDef us;
     USART_StructInit(&us);
     us.USART_BaudRate            = baud;
-    us.USART_WordLength          = USART_WordLength_8b;
-    us.USART_StopBits            = USART_StopBits_1;
-    us.USART_Parity              = USART_Parity_No;
+    us.USART_WordLength          = (config->parity == UART_PARITY_NONE) ? USART_WordLength_8b : USART_WordLength_9b;
+    us.USART_StopBits            = stop_table[config->stop];
+    us.USART_Parity              = parity_table[config->parity];
     us.USART_Mode                = USART_Mode_Rx | USART_Mode_Tx;
-    us.USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+    us.USART_HardwareFlowControl = flow_table[config->flow];
     USART_Init(u, &us);
 
+    /*  16 ʱ BRR  PCLK / baud12.4 㣩 ֱ벢У鷶Χ */
+    RCC_GetClocksFreq(&clocks);
+    pclk = (uartn == UART_1) ? clocks.PCLK2_Frequency : clocks.PCLK1_Frequency;
+    brr  = (pclk + baud / 2) / baud;
+    zf_assert(brr >= 16 && brr <= 0xFFFF);                         // ʳ PCLK/16 ~ PCLK/65535 Χ
+    if (brr < 16)     brr = 16;
+    if (brr > 0xFFFF) brr = 0xFFFF;
+    u->BRR = (uint16)brr;
+    hu->baud       = (pclk + brr / 2) / brr;
+    hu->baud_error = ((int32)hu->baud - (int32)baud) * 10000 / (int32)baud;   // BRR >= 16 ʱֵ baud/32 
+    zf_assert(hu->baud_error <= UART_BAUD_ERROR_MAX && hu->baud_error >= -UART_BAUD_ERROR_MAX);
+    hu->rx_flow      = (config->flow & UART_FLOW_RTS) ? 1 : 0;
+    hu->rx_throttled = 0;
+    memset(&hu->stats, 0, sizeof(hu->stats));
+
 		/* 4.  NVIC */
     NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
 
@@ -284,124 +823,240 @@ void uart_init(uart_index_enum uartn, uint32 baud,
     NVIC_Init(&nv);
 
 #if UART_RX_USE_DMA
-    /* 5. RX-DMA ãѭ˵ rx_buf/ж FIFO */
-    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
-    DMA_DeInit(hu->rx_dma_ch);
-    DMA_InitTypeDef dma;
-    dma.DMA_PeripheralBaseAddr = (uint32)&u->DR;
-    dma.DMA_MemoryBaseAddr     = (uint32)hu->rx_buf;
-    dma.DMA_DIR                = DMA_DIR_PeripheralSRC;
-    dma.DMA_BufferSize         = UART_RX_BUF_SIZE;
-    dma.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
-    dma.DMA_MemoryInc          = DMA_MemoryInc_Enable;
-    dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
-    dma.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
-    dma.DMA_Mode               = DMA_Mode_Circular;
-    dma.DMA_Priority           = DMA_Priority_Medium;
-    dma.DMA_M2M                = DMA_M2M_Disable;
-    DMA_Init(hu->rx_dma_ch, &dma);
-
-    USART_DMACmd(u, USART_DMAReq_Rx, ENABLE);
-    DMA_Cmd(hu->rx_dma_ch, ENABLE);
-
-    /*  DMA жϣ/ȫɶѡݡ FIFO */
-    DMA_ITConfig(hu->rx_dma_ch, DMA_IT_TC | DMA_IT_HT, ENABLE);
-      /* DMAͨж */
-		nv.NVIC_IRQChannel = uart_get_dma_irq_channel(idx);
-    nv.NVIC_IRQChannelPreemptionPriority = dma_preempt_pri;  // DMAȼUSART
-    nv.NVIC_IRQChannelSubPriority = 0;
-    NVIC_Init(&nv);
-#else
-    /* ͨжϽ */
-    USART_ITConfig(u, USART_IT_RXNE, ENABLE);
+    /* 5. RX-DMA ãѭ˵ rx_bufȡʱֱ CNDTR дλ ͳʱð/ȫжͳƷָ */
+    /* ͨѱռʱ dma1_claim  zf_log ͻ ˻жϽ */
+    hu->rx_dma = dma1_claim(g_dma_rx_channel[idx], g_dma_rx_owner[idx]);
+    if(hu->rx_dma)
+    {
+        RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+        DMA_DeInit(hu->rx_dma_ch);
+        DMA_InitTypeDef dma;
+        dma.DMA_PeripheralBaseAddr = (uint32)&u->DR;
+        dma.DMA_MemoryBaseAddr     = (uint32)hu->rx_buf;
+        dma.DMA_DIR                = DMA_DIR_PeripheralSRC;
+        dma.DMA_BufferSize         = hu->rx_mask + 1;
+        dma.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+        dma.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+        dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+        dma.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+        dma.DMA_Mode               = DMA_Mode_Circular;
+        dma.DMA_Priority           = DMA_Priority_Medium;
+        dma.DMA_M2M                = DMA_M2M_Disable;
+        DMA_Init(hu->rx_dma_ch, &dma);
+
+        hu->rx_tail = 0;
+        USART_DMACmd(u, USART_DMAReq_Rx, ENABLE);
+#if UART_RX_LINE_ENABLE
+        hu->rx_scan = 0;
+        hu->rx_lines = 0;
+        DMA_ClearITPendingBit(g_dma_rx_it_gl[idx]);
+        DMA_ITConfig(hu->rx_dma_ch, DMA_IT_HT | DMA_IT_TC, ENABLE);
+        dma1_irq_register(g_dma_rx_channel[idx], uart_rx_dma_handler, hu);
+        nv.NVIC_IRQChannel = DMA1_Channel1_IRQn + g_dma_rx_channel[idx];
+        nv.NVIC_IRQChannelPreemptionPriority = dma_preempt_pri;
+        NVIC_Init(&nv);
+#endif
+        DMA_Cmd(hu->rx_dma_ch, ENABLE);
+
+        /* ߿һַʱж һֻ֡һж FE/NE/ORE  EIE  PE  PEIE  */
+        USART_ITConfig(u, USART_IT_IDLE, ENABLE);
+        USART_ITConfig(u, USART_IT_ERR, ENABLE);
+        if(config->parity != UART_PARITY_NONE) USART_ITConfig(u, USART_IT_PE, ENABLE);
+    }
+    else
 #endif
+    {
+        /* ͨжϽ */
+        USART_ITConfig(u, USART_IT_RXNE, ENABLE);
+    }
 
 #if UART_TX_USE_DMA
-      /* 7. TX-DMA ׼ֻã */
-      RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
-      DMA_DeInit(hu->tx_dma_ch);
-      DMA_InitTypeDef tx_dma;
-      tx_dma.DMA_PeripheralBaseAddr = (uint32)&u->DR;
-      tx_dma.DMA_MemoryBaseAddr     = 0;  /* ʱ */
-      tx_dma.DMA_DIR                = DMA_DIR_PeripheralDST;
-      tx_dma.DMA_BufferSize         = 0;  /* ʱ */
-      tx_dma.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
-      tx_dma.DMA_MemoryInc          = DMA_MemoryInc_Enable;
-      tx_dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
-      tx_dma.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
-      tx_dma.DMA_Mode               = DMA_Mode_Normal;  /* ģʽ */
-      tx_dma.DMA_Priority           = DMA_Priority_Medium;
-      tx_dma.DMA_M2M                = DMA_M2M_Disable;
-      DMA_Init(hu->tx_dma_ch, &tx_dma);
+      /* 7. TX-DMA ׼ֻã ͨѱռʱ dma1_claim  zf_log ͻ ˻زѯ */
+      hu->tx_head = 0;
+      hu->tx_tail = 0;
+      hu->tx_dma_len = 0;
+      hu->tx_dma = dma1_claim(g_dma_tx_channel[idx], g_dma_tx_owner[idx]);
+      if(hu->tx_dma)
+      {
+          RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+          DMA_DeInit(hu->tx_dma_ch);
+          DMA_InitTypeDef tx_dma;
+          tx_dma.DMA_PeripheralBaseAddr = (uint32)&u->DR;
+          tx_dma.DMA_MemoryBaseAddr     = 0;  /* ʱ */
+          tx_dma.DMA_DIR                = DMA_DIR_PeripheralDST;
+          tx_dma.DMA_BufferSize         = 0;  /* ʱ */
+          tx_dma.DMA_PeripheralInc      = DMA_PeripheralInc_Disable;
+          tx_dma.DMA_MemoryInc          = DMA_MemoryInc_Enable;
+          tx_dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+          tx_dma.DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte;
+          tx_dma.DMA_Mode               = DMA_Mode_Normal;  /* ģʽ */
+          tx_dma.DMA_Priority           = DMA_Priority_Medium;
+          tx_dma.DMA_M2M                = DMA_M2M_Disable;
+          DMA_Init(hu->tx_dma_ch, &tx_dma);
       
-      USART_DMACmd(u, USART_DMAReq_Tx, ENABLE);
-      /* TX DMAжϣʹòѯʽȴ */
+          USART_DMACmd(u, USART_DMAReq_Tx, ENABLE);
+
+          /* жͻеһ */
+          DMA_ClearFlag(g_dma_tx_tc_flag[idx]);
+          DMA_ITConfig(hu->tx_dma_ch, DMA_IT_TC, ENABLE);
+          dma1_irq_register(g_dma_tx_channel[idx], uart_tx_dma_handler, hu);
+          nv.NVIC_IRQChannel = DMA1_Channel1_IRQn + g_dma_tx_channel[idx];
+          nv.NVIC_IRQChannelPreemptionPriority = dma_preempt_pri;
+          nv.NVIC_IRQChannelSubPriority = 0;
+          nv.NVIC_IRQChannelCmd = ENABLE;
+          NVIC_Init(&nv);
+      }
 #endif
 
     USART_Cmd(u, ENABLE);
+    return hu->baud;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ѯʵʲ
+//  ˵      uartn           ģ
+//  ˵      *error          趨ֵ λ 0.01% Ҫʱ NULL
+//  ز      uint32          ʵʲ δʼʱΪ 0
+//  ʹʾ      int32 err; uint32 baud = uart_get_baud(UART_2, &err);
+//  עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_get_baud(uart_index_enum uartn, int32 *error)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+    if(error != NULL) *error = hu->baud_error;
+    return hu->baud;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        ȡշͳ
+// ˵       uart_n          ģ
+// ˵       *stats          ͳƽ
+// ز       void
+// ʹʾ       uart_stats_struct st; uart_get_stats(UART_1, &st);
+// עϢ       DMA ʱֽռ÷ֵڿжϡDMA /ȫжϺͱи
+//                DMA δ UART_RX_LINE_ENABLE ʱ rx_bytes/rx_dropped ͳ rx_peak ֻڶȡѯʱ
+//                rx_peak ӽС rx_dropped ˵ƫСȡʱ
+//                overrun ˵ж/DMA ȡ Ӧȼ򽵵Ͳ
+//                framing/noise/parity ͨǲ·Ż˫֡ʽһ
+//-------------------------------------------------------------------------------------------------------------------
+void uart_get_stats(uart_index_enum uartn, uart_stats_struct *stats)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+
+    CRIT_ENTER();
+    uart_rx_scan(hu);
+    *stats = hu->stats;
+    CRIT_EXIT();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        㴮շͳ
+// ˵       uart_n          ģ
+// ز       void
+// ʹʾ       uart_clear_stats(UART_1);
+// עϢ       rx_peak ´ӵǰռÿʼͳ
+//-------------------------------------------------------------------------------------------------------------------
+void uart_clear_stats(uart_index_enum uartn)
+{
+    uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+
+    CRIT_ENTER();
+    uart_rx_scan(hu);
+    memset(&hu->stats, 0, sizeof(hu->stats));
+    CRIT_EXIT();
 }
 
 /*-------------------- жϷ --------------------*/
+
+/* ͳ SR еĴ־ ־ DR ʱ */
+static void uart_rx_error_count(uart_handle_t *hu, uint16 sr)
+{
+    if(sr & USART_FLAG_ORE) hu->stats.overrun ++;
+    if(sr & USART_FLAG_NE)  hu->stats.noise ++;
+    if(sr & USART_FLAG_FE)  hu->stats.framing ++;
+    if(sr & USART_FLAG_PE)  hu->stats.parity ++;
+}
   
-#if !UART_RX_USE_DMA
   /* DMAģʽʹôжϽ */
   static void uart_rx_irq_handler(uart_index_enum uartn)
   {
-      USART_TypeDef *u = g_uart[uart_idx(uartn)].uartx;
+      uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+      USART_TypeDef *u = hu->uartx;
+      uint16 sr = u->SR;
       if(USART_GetITStatus(u, USART_IT_RXNE) != RESET)
       {
-          uint8 dat = USART_ReceiveData(u);
+          if(hu->rx_flow && ((hu->rx_head + 1) & hu->rx_mask) == hu->rx_tail)
+          {
+              /*   DR ʹ RTS Ч Էͣ ȡݺ uart_rx_release ָ */
+              USART_ITConfig(u, USART_IT_RXNE, DISABLE);
+              hu->rx_throttled = 1;
+              return;
+          }
+          uint8 dat = USART_ReceiveData(u);     /* ȶ SR ٶ DR ͬʱ־ */
+          uart_rx_error_count(hu, sr);
           uart_rx_push(uartn, dat);
       }
   }
+
+#if UART_RX_USE_DMA
+  /* DMAģʽ DMA д rx_buf жֻڽ߿лʱ */
+  static void uart_rx_idle_handler(uart_index_enum uartn)
+  {
+      uart_handle_t *hu = &g_uart[uart_idx(uartn)];
+      USART_TypeDef *u = hu->uartx;
+      uint16 sr = u->SR;
+      if(sr & (USART_FLAG_IDLE | UART_SR_ERROR))
+      {
+          USART_ReceiveData(u);     /* ȶ SR ٶ DR  IDLE ־ ֽ DMA ȡ */
+          CRIT_ENTER();
+          uart_rx_error_count(hu, sr);
+          uart_rx_scan(hu);         /* һ֡ʱͳյķָռ÷ֵ */
+          CRIT_EXIT();
+      }
+  }
+#endif
+
+  /* շʽַ DMA ͨǼʧܵĴжϽ */
+  static void uart_irq_handler(uart_index_enum uartn)
+  {
+#if UART_RX_USE_DMA
+      if(g_uart[uart_idx(uartn)].rx_dma)
+      {
+          uart_rx_idle_handler(uartn);
+          return;
+      }
+#endif
+      uart_rx_irq_handler(uartn);
+  }
   void USART1_IRQHandler(void){
-	uart_rx_irq_handler(UART_1); 
+	PROFILE_BEGIN(uart1_irq);
+	uart_irq_handler(UART_1); 
 #if DEBUG_UART_USE_INTERRUPT                        //  debug ж
         debug_interrupr_handler();                  //  debug ڽմ ݻᱻ debug λȡ
 #endif                                              // ޸ DEBUG_UART_INDEX δҪŵӦĴжȥ		
+	PROFILE_END(uart1_irq);
 	}
-  void USART2_IRQHandler(void){ uart_rx_irq_handler(UART_2); }
-  void USART3_IRQHandler(void){ uart_rx_irq_handler(UART_3); }
-#else
-  /* DMAģʽжֻ */
-  void USART1_IRQHandler(void)
-  {
-      if(USART_GetITStatus(USART1, USART_IT_RXNE) != RESET)
-          USART_ReceiveData(USART1); /* жϱ־ */
-  }
-  void USART2_IRQHandler(void)
-  {
-      if(USART_GetITStatus(USART2, USART_IT_RXNE) != RESET)
-          USART_ReceiveData(USART2); /* жϱ־ */
-  }
-  void USART3_IRQHandler(void)
+  void USART2_IRQHandler(void){ PROFILE_BEGIN(uart2_irq); uart_irq_handler(UART_2); PROFILE_END(uart2_irq); }
+  void USART3_IRQHandler(void){ PROFILE_BEGIN(uart3_irq); uart_irq_handler(UART_3); PROFILE_END(uart3_irq); }
+
+  /*============================ DMA жϷ  driver_dma ַͨ ============================*/
+#if UART_RX_DMA_IRQ
+  static void uart_rx_dma_handler(void *arg)
   {
-      if(USART_GetITStatus(USART3, USART_IT_RXNE) != RESET)
-          USART_ReceiveData(USART3); /* жϱ־ */
+      uart_handle_t *hu = (uart_handle_t *)arg;
+      DMA_ClearITPendingBit(g_dma_rx_it_gl[hu - g_uart]);
+      CRIT_ENTER();
+      uart_rx_scan(hu);
+      CRIT_EXIT();
   }
 #endif
 
-  /*============================ DMA жϷ񣨽 RX-DMA ģʽõ ============================*/
-#if UART_RX_USE_DMA
-  static void uart_rx_dma_handler(uint8 idx)
+#if UART_TX_USE_DMA
+  static void uart_tx_dma_handler(void *arg)
   {
-      uart_handle_t *hu = &g_uart[idx];
-      uint16 tail = hu->rx_dma_ch->CNDTR;        /* ʣδ */
-      uint16 pos  = UART_RX_BUF_SIZE - tail;     /* ǰ DMA дָ */
-      uint16 old  = (hu->rx_head) % UART_RX_BUF_SIZE;
-
-      /*  [old, pos) û FIFO */
-      while(old != pos)
-      {
-          uart_rx_push((uart_index_enum)idx, hu->rx_buf[old]);
-          old = (old + 1) % UART_RX_BUF_SIZE;
-      }
-      /* жϱ־ - ʹòʽ */
-      DMA_ClearITPendingBit(g_dma_rx_tc_flag[idx]);
+      uart_handle_t *hu = (uart_handle_t *)arg;
+      CRIT_ENTER();
+      uart_tx_dma_complete((uint8)(hu - g_uart));
+      CRIT_EXIT();
   }
-
-  void DMA1_Channel5_IRQHandler(void){ uart_rx_dma_handler(0); }  /* UART1 RX - Channel 5 */
-  void DMA1_Channel6_IRQHandler(void){ uart_rx_dma_handler(1); }  /* UART2 RX - Channel 6 */
-  void DMA1_Channel3_IRQHandler(void){ uart_rx_dma_handler(2); }  /* UART3 RX - Channel 3 */
 #endif
-	
@@ -20,8 +20,13 @@
 #include "common_headfile.h"
 // 1ʾʹDMA0ʾʹͨ
 // ĶҪȱ벢س򣬵ƬģҪϵͨѶ
+#ifndef UART_TX_USE_DMA
 #define UART_TX_USE_DMA         (0)                                       // Ĭʹ DMA ʽ	
+#endif
+#ifndef UART_RX_USE_DMA
 #define UART_RX_USE_DMA         (0)                                       // Ĭʹ DMA ʽ	
+#endif
+// DMA ͨѱռʱ uart_init  zf_log ͻ ô˻жϽջѯ
 
 
 // USART жȼֵԽСȼԽߣΧ0-15
@@ -29,23 +34,121 @@
 #define UART2_NVIC_PREEMPT_PRIORITY     (4)
 #define UART3_NVIC_PREEMPT_PRIORITY     (5)
 
-// DMA жȼڶӦUSARTֹݸǣ
+// DMA жȼ
+// DMA ղʹ DMA ж ɴڿжϣIDLE֪ͨһ֡
 #define UART1_DMA_NVIC_PREEMPT_PRIORITY (0)
 #define UART2_DMA_NVIC_PREEMPT_PRIORITY (1)
 #define UART3_DMA_NVIC_PREEMPT_PRIORITY (2)
 
 
-/* ڲѭС */
-#define UART_RX_BUF_SIZE  256
+// /ͻλС ÿڵ  2  ±
+// ͻֻ UART_TX_USE_DMA ʱʹ uart_write_buffer ݿ  DMA жν
+// Ϊ 0 ʾ侲̬ Ҫ uart_init ֮ǰ uart_set_buffer ṩ洢ռ
+//  GNSS  115200  1024  debug  64  wifi_uart 2048
+#define UART_RX_BUF_SIZE            (256)                                       // ڽջĬϴС
+#define UART_TX_BUF_SIZE            (256)                                       //  DMA ͻĬϴС
+
+#ifndef UART1_RX_BUF_SIZE
+#define UART1_RX_BUF_SIZE           (UART_RX_BUF_SIZE)
+#endif
+#ifndef UART2_RX_BUF_SIZE
+#define UART2_RX_BUF_SIZE           (UART_RX_BUF_SIZE)
+#endif
+#ifndef UART3_RX_BUF_SIZE
+#define UART3_RX_BUF_SIZE           (UART_RX_BUF_SIZE)
+#endif
+#ifndef UART1_TX_BUF_SIZE
+#define UART1_TX_BUF_SIZE           (UART_TX_BUF_SIZE)
+#endif
+#ifndef UART2_TX_BUF_SIZE
+#define UART2_TX_BUF_SIZE           (UART_TX_BUF_SIZE)
+#endif
+#ifndef UART3_TX_BUF_SIZE
+#define UART3_TX_BUF_SIZE           (UART_TX_BUF_SIZE)
+#endif
+
+#define UART_BAUD_ERROR_MAX         (200)                                       // Ĳ λ 0.01% ʱ uart_init 
+
+typedef enum
+{
+    UART_PARITY_NONE,                                                           // У
+    UART_PARITY_EVEN,                                                           // żУ
+    UART_PARITY_ODD,                                                            // У
+}uart_parity_enum;
+
+typedef enum
+{
+    UART_STOP_1,                                                                // 1 λֹͣλ
+    UART_STOP_0_5,                                                              // 0.5 λֹͣλ
+    UART_STOP_2,                                                                // 2 λֹͣλ
+    UART_STOP_1_5,                                                              // 1.5 λֹͣλ
+}uart_stop_enum;
+
+typedef enum
+{
+    UART_FLOW_NONE      = 0x00,                                                 // 
+    UART_FLOW_RTS       = 0x01,                                                 // ջʱ RTS Ч ֪ͨԷͣ
+    UART_FLOW_CTS       = 0x02,                                                 // CTS Чʱͣ
+    UART_FLOW_RTS_CTS   = 0x03,
+}uart_flow_enum;
+
+typedef struct
+{
+    uart_parity_enum    parity;
+    uart_stop_enum      stop;
+    uart_flow_enum      flow;
+}uart_config_struct;
+
+typedef struct
+{
+    uint32              rx_bytes;                                               // յֽ 򻺳ֽ DMA ʱ迪 UART_RX_LINE_ENABLE
+    uint32              tx_bytes;                                               // ѷֽ
+    uint32              overrun;                                                // Ӳ ORE  ÿٶʧ 1 ֽ
+    uint32              framing;                                                // ֡ FE 
+    uint32              noise;                                                  //  NE 
+    uint32              parity;                                                 // У PE 
+    uint32              rx_dropped;                                             // ջʧֽ DMA ʱ迪 UART_RX_LINE_ENABLE
+    uint32              rx_peak;                                                // ջռֽ
+}uart_stats_struct;
+
+// 1ʾʱͳƷָ ṩ uart_lines_pending/uart_read_line 0ʾͳ DMA ʱֻάȡλ
+// DMA տʹ DMA /ȫж ֤ÿһȦͳ ͳ rx_bytes/rx_dropped
+#ifndef UART_RX_LINE_ENABLE
+#define UART_RX_LINE_ENABLE         (0)
+#endif
+#define UART_LINE_DELIMITER         ('\n')                                      // uart_read_line зָ \r\n βʱ \r ᱻȥ
+
+#define UART_BUF_SIZE_CHECK(size)   (0 == ((size) & ((size) - 1)))             // 0  2 
+#if !UART_BUF_SIZE_CHECK(UART1_RX_BUF_SIZE) || !UART_BUF_SIZE_CHECK(UART2_RX_BUF_SIZE) || !UART_BUF_SIZE_CHECK(UART3_RX_BUF_SIZE)
+#error "UARTx_RX_BUF_SIZE  2 "
+#endif
+#if !UART_BUF_SIZE_CHECK(UART1_TX_BUF_SIZE) || !UART_BUF_SIZE_CHECK(UART2_TX_BUF_SIZE) || !UART_BUF_SIZE_CHECK(UART3_TX_BUF_SIZE)
+#error "UARTx_TX_BUF_SIZE  2 "
+#endif
+#if UART_RX_USE_DMA && (UART1_RX_BUF_SIZE > 32768 || UART2_RX_BUF_SIZE > 32768 || UART3_RX_BUF_SIZE > 32768)
+#error "DMA ʱ UARTx_RX_BUF_SIZE  CNDTR  ܳ 32768"
+#endif
 //==================================================== ====================================================
 void    uart_write_byte                     (uart_index_enum uartn, const uint8 dat);
 void    uart_write_buffer                   (uart_index_enum uartn, const uint8 *buff, uint32 len);
 void    uart_write_string                   (uart_index_enum uartn, const char *str);
+uint32  uart_tx_pending                     (uart_index_enum uartn);
+void    uart_tx_flush                       (uart_index_enum uartn);
 
 uint8   uart_read_byte                      (uart_index_enum uartn);
 uint8   uart_query_byte                     (uart_index_enum uartn, uint8 *dat);
+uint32  uart_read_buffer                    (uart_index_enum uartn, uint8 *buff, uint32 len);
+#if UART_RX_LINE_ENABLE
+uint32  uart_lines_pending                  (uart_index_enum uartn);
+uint32  uart_read_line                      (uart_index_enum uartn, char *buff, uint32 len);
+#endif
 
-void    uart_init                           (uart_index_enum uartn, uint32 baud, uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin);
+uint8   uart_set_buffer                     (uart_index_enum uartn, uint8 *rx_buff, uint32 rx_size, uint8 *tx_buff, uint32 tx_size);
+uint32  uart_init                           (uart_index_enum uartn, uint32 baud, uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin);
+uint32  uart_init_ex                        (uart_index_enum uartn, uint32 baud, uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin, const uart_config_struct *config);
+uint32  uart_get_baud                       (uart_index_enum uartn, int32 *error);
+void    uart_get_stats                      (uart_index_enum uartn, uart_stats_struct *stats);
+void    uart_clear_stats                    (uart_index_enum uartn);
 //==================================================== =====================================================
 
 
@@ -0,0 +1,68 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#ifndef _bench_h_
+#define _bench_h_
+
+#include "common_headfile.h"
+
+typedef struct
+{
+    uint32      iterations;                                                     // ҪִеĴ 궨
+    uint32      bytes_per_op;                                                   // ÿβ ڼ 0 ʾͳ
+    uint64_t    sink;                                                           // ֹŻĽۼ
+}bench_state_struct;
+
+typedef void (*bench_function)(bench_state_struct *b);
+
+typedef struct
+{
+    const char      *name;                                                      //  ģ__ģ
+    bench_function  function;                                                   //  ڲѭ b->iterations 
+}bench_case_struct;
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һ׼
+// ˵     name            
+// ʹʾ     BENCH_CASE(bench_fifo_write_8bit) { for(uint32 i = 0; i < b->iterations; i ++) {...} }
+// עϢ     ڸ bench_xxx.c ʵ  bench_main.c еǼ
+//-------------------------------------------------------------------------------------------------------------------
+#define BENCH_CASE(name)            void name (bench_state_struct *b)
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ͣ/ָʱ
+// ʹʾ     bench_timer_stop(); prepare(); bench_timer_start();
+// עϢ     ųÿҪ׼ ׼ڼڴͬ
+//-------------------------------------------------------------------------------------------------------------------
+void    bench_timer_start           (void);
+void    bench_timer_stop            (void);
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ֹŻ
+// ʹʾ     bench_keep(b, ret);
+//-------------------------------------------------------------------------------------------------------------------
+#define bench_keep(b, x)            ((b)->sink += (uint64_t)(x))
+
+//========================================================================================================
+extern const bench_case_struct bench_fifo_cases[];
+extern const bench_case_struct bench_function_cases[];
+extern const bench_case_struct bench_cjson_cases[];
+extern const bench_case_struct bench_mqttkit_cases[];
+extern const bench_case_struct bench_gnss_cases[];
+extern const bench_case_struct bench_assistant_cases[];
+//========================================================================================================
+
+#endif
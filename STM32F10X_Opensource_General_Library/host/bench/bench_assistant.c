@@ -0,0 +1,76 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "bench.h"
+
+static BENCH_CASE(bench_assistant_oscilloscope_send_8ch)
+{
+    seekfree_assistant_oscilloscope_data.channel_num = 8;
+    for(uint32 i = 0; i < 8; i ++)
+    {
+        seekfree_assistant_oscilloscope_data.data[i] = (float)i * 1.5f;
+    }
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        uint32 before = host_assistant_tx_count();
+        seekfree_assistant_oscilloscope_send(&seekfree_assistant_oscilloscope_data);
+        b->bytes_per_op = host_assistant_tx_count() - before;
+    }
+    bench_keep(b, host_assistant_tx_count());
+}
+
+// λһ· 8 ͨĲ м 3 ֽ
+static BENCH_CASE(bench_assistant_data_analysis_8param)
+{
+    uint8 stream[8 * sizeof(seekfree_assistant_parameter_struct) + 3];
+    uint32 length = 0;
+
+    stream[length ++] = 0x00;
+    stream[length ++] = 0xFF;
+    stream[length ++] = 0x13;
+    for(uint8 ch = 1; ch <= 8; ch ++)
+    {
+        seekfree_assistant_parameter_struct packet;
+        uint8 sum = 0;
+        memset(&packet, 0, sizeof(packet));
+        packet.head     = SEEKFREE_ASSISTANT_RECEIVE_HEAD;
+        packet.function = SEEKFREE_ASSISTANT_RECEIVE_SET_PARAMETER;
+        packet.channel  = ch;
+        packet.data     = ch * 0.25f;
+        for(uint32 k = 0; k < sizeof(packet); k ++)
+        {
+            sum += ((uint8 *)&packet)[k];
+        }
+        packet.check_sum = sum;
+        memcpy(&stream[length], &packet, sizeof(packet));
+        length += sizeof(packet);
+    }
+
+    b->bytes_per_op = length;
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        host_assistant_feed(stream, length);
+        seekfree_assistant_data_analysis();
+        bench_keep(b, seekfree_assistant_parameter_update_flag[7]);
+    }
+}
+
+const bench_case_struct bench_assistant_cases[] =
+{
+    {"assistant_oscilloscope_send_8ch", bench_assistant_oscilloscope_send_8ch},
+    {"assistant_data_analysis_8param",  bench_assistant_data_analysis_8param},
+    {NULL, NULL},
+};
@@ -0,0 +1,62 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "bench.h"
+
+// OneNET ģ·
+static const char bench_cjson_property_set[] =
+    "{\"id\":\"123\",\"version\":\"1.0\",\"params\":{\"led\":true,\"speed\":1500,"
+    "\"target\":{\"x\":12.5,\"y\":-3.25},\"mode\":\"auto\",\"pid\":[1.2,0.05,0.8]}}";
+
+static BENCH_CASE(bench_cjson_parse_property_set)
+{
+    b->bytes_per_op = sizeof(bench_cjson_property_set) - 1;
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        cJSON *root = cJSON_Parse(bench_cjson_property_set);
+        cJSON *params = cJSON_GetObjectItem(root, "params");
+        bench_keep(b, cJSON_GetObjectItem(params, "speed")->valueint);
+        cJSON_Delete(root);
+    }
+}
+
+static BENCH_CASE(bench_cjson_build_print_property_post)
+{
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        cJSON *root = cJSON_CreateObject();
+        cJSON *params = cJSON_CreateObject();
+        cJSON *temp = cJSON_CreateObject();
+        cJSON_AddItemToObject(root, "id", cJSON_CreateString("123"));
+        cJSON_AddItemToObject(root, "version", cJSON_CreateString("1.0"));
+        cJSON_AddItemToObject(temp, "value", cJSON_CreateNumber(25.5));
+        cJSON_AddItemToObject(params, "temperature", temp);
+        cJSON_AddItemToObject(root, "params", params);
+
+        char *out = cJSON_PrintUnformatted(root);
+        b->bytes_per_op = strlen(out);
+        bench_keep(b, out[0]);
+        free(out);
+        cJSON_Delete(root);
+    }
+}
+
+const bench_case_struct bench_cjson_cases[] =
+{
+    {"cjson_parse_property_set",        bench_cjson_parse_property_set},
+    {"cjson_build_print_property_post", bench_cjson_build_print_property_post},
+    {NULL, NULL},
+};
@@ -0,0 +1,254 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "bench.h"
+
+#define BENCH_FIFO_SIZE     (256)
+
+static uint8        bench_fifo_buffer_8bit[BENCH_FIFO_SIZE];
+static uint16       bench_fifo_buffer_16bit[BENCH_FIFO_SIZE];
+static fifo_struct  bench_fifo;
+static spsc_fifo_struct bench_spsc_fifo;
+static message_fifo_struct bench_message_fifo;
+
+// ֽдٶ Ӧڽжֽ ѭֽڳ
+static BENCH_CASE(bench_fifo_element_8bit)
+{
+    uint8 dat = 0;
+    fifo_init(&bench_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = 1;
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        fifo_write_element(&bench_fifo, (uint8)i);
+        fifo_read_element(&bench_fifo, &dat, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dat);
+    }
+}
+
+// дٿ  24  256  ʹдλòϿԽβ
+static BENCH_CASE(bench_fifo_buffer_8bit_24B)
+{
+    uint8 src[24], dst[24];
+    uint32 len;
+    memset(src, 0x5A, sizeof(src));
+    fifo_init(&bench_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        len = sizeof(dst);
+        fifo_write_buffer(&bench_fifo, src, sizeof(src));
+        fifo_read_buffer(&bench_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dst[i % sizeof(dst)]);
+    }
+}
+
+// дһζ Ӧ GNSS ȡ
+static BENCH_CASE(bench_fifo_fill_drain_8bit_128B)
+{
+    uint8 dst[128];
+    uint32 len;
+    fifo_init(&bench_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(dst);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        for(uint32 j = 0; j < sizeof(dst); j ++)
+        {
+            uint8 dat = (uint8)j;
+            fifo_write_buffer(&bench_fifo, &dat, 1);
+        }
+        len = sizeof(dst);
+        fifo_read_buffer(&bench_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dst[len - 1]);
+    }
+}
+
+static BENCH_CASE(bench_fifo_buffer_16bit_24)
+{
+    uint16 src[24], dst[24];
+    uint32 len;
+    memset(src, 0x5A, sizeof(src));
+    fifo_init(&bench_fifo, FIFO_DATA_16BIT, bench_fifo_buffer_16bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        len = 24;
+        fifo_write_buffer(&bench_fifo, src, 24);
+        fifo_read_buffer(&bench_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dst[i % 24]);
+    }
+}
+
+// ֽڴ Ӧȿٽ
+static BENCH_CASE(bench_fifo_copy_parse_8bit_24B)
+{
+    uint8 src[24], dst[24];
+    uint32 len, sum = 0;
+    memset(src, 0x5A, sizeof(src));
+    fifo_init(&bench_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        len = sizeof(dst);
+        fifo_write_buffer(&bench_fifo, src, sizeof(src));
+        fifo_read_buffer(&bench_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        for(uint32 j = 0; j < len; j ++)
+        {
+            sum += dst[j];
+        }
+        bench_keep(b, sum);
+    }
+}
+
+//  fifo_copy_parse_8bit_24B ͬ 㿽ӿ ȡ FIFO ԭش
+//  24 ֽ֡ʱߺʱڲΧ ܾݴ˵ó㿽Ľ
+static BENCH_CASE(bench_fifo_zero_copy_parse_8bit_24B)
+{
+    uint8 src[24];
+    fifo_region_struct region;
+    uint32 sum = 0;
+    memset(src, 0x5A, sizeof(src));
+    fifo_init(&bench_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        fifo_write_buffer(&bench_fifo, src, sizeof(src));
+
+        fifo_read_peek(&bench_fifo, &region);
+        for(uint32 k = 0; k < 2; k ++)
+        {
+            for(uint32 j = 0; j < region.length[k]; j ++)
+            {
+                sum += ((uint8 *)region.buffer[k])[j];
+            }
+        }
+        fifo_read_consume(&bench_fifo, 24);
+        bench_keep(b, sum);
+    }
+}
+
+//====================================================SPSC  FIFO====================================================
+// һӦ ֱӱȽʵ
+
+static BENCH_CASE(bench_spsc_fifo_element_8bit)
+{
+    uint8 dat = 0;
+    spsc_fifo_init(&bench_spsc_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = 1;
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        spsc_fifo_write_element(&bench_spsc_fifo, (uint8)i);
+        spsc_fifo_read_element(&bench_spsc_fifo, &dat, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dat);
+    }
+}
+
+static BENCH_CASE(bench_spsc_fifo_buffer_8bit_24B)
+{
+    uint8 src[24], dst[24];
+    uint32 len;
+    memset(src, 0x5A, sizeof(src));
+    spsc_fifo_init(&bench_spsc_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        len = sizeof(dst);
+        spsc_fifo_write_buffer(&bench_spsc_fifo, src, sizeof(src));
+        spsc_fifo_read_buffer(&bench_spsc_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dst[i % sizeof(dst)]);
+    }
+}
+
+static BENCH_CASE(bench_spsc_fifo_fill_drain_8bit_128B)
+{
+    uint8 dst[128];
+    uint32 len;
+    spsc_fifo_init(&bench_spsc_fifo, FIFO_DATA_8BIT, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(dst);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        for(uint32 j = 0; j < sizeof(dst); j ++)
+        {
+            spsc_fifo_write_element(&bench_spsc_fifo, (uint8)j);
+        }
+        len = sizeof(dst);
+        spsc_fifo_read_buffer(&bench_spsc_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dst[len - 1]);
+    }
+}
+
+static BENCH_CASE(bench_spsc_fifo_buffer_16bit_24)
+{
+    uint16 src[24], dst[24];
+    uint32 len;
+    memset(src, 0x5A, sizeof(src));
+    spsc_fifo_init(&bench_spsc_fifo, FIFO_DATA_16BIT, bench_fifo_buffer_16bit, BENCH_FIFO_SIZE);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        len = 24;
+        spsc_fifo_write_buffer(&bench_spsc_fifo, src, 24);
+        spsc_fifo_read_buffer(&bench_spsc_fifo, dst, &len, FIFO_READ_AND_CLEAN);
+        bench_keep(b, dst[i % 24]);
+    }
+}
+
+// ֡д֡ȡ  fifo_buffer_8bit_24B Աȿɵóǰ׺Ķ⿪
+static BENCH_CASE(bench_message_fifo_push_pop_24B)
+{
+    uint8 src[24], dst[24];
+    uint32 len;
+    memset(src, 0x5A, sizeof(src));
+    message_fifo_init(&bench_message_fifo, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE, MESSAGE_FIFO_REJECT_NEW);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        len = sizeof(dst);
+        message_fifo_push(&bench_message_fifo, src, sizeof(src));
+        message_fifo_pop(&bench_message_fifo, dst, &len);
+        bench_keep(b, dst[i % sizeof(dst)]);
+    }
+}
+
+// ʼ ÿдһ֡Ҫȶɵһ֡
+static BENCH_CASE(bench_message_fifo_drop_oldest_24B)
+{
+    uint8 src[24];
+    memset(src, 0x5A, sizeof(src));
+    message_fifo_init(&bench_message_fifo, bench_fifo_buffer_8bit, BENCH_FIFO_SIZE, MESSAGE_FIFO_DROP_OLDEST);
+    b->bytes_per_op = sizeof(src);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        message_fifo_push(&bench_message_fifo, src, sizeof(src));
+    }
+    bench_keep(b, bench_message_fifo.dropped);
+}
+
+const bench_case_struct bench_fifo_cases[] =
+{
+    {"fifo_element_8bit",               bench_fifo_element_8bit},
+    {"fifo_buffer_8bit_24B",            bench_fifo_buffer_8bit_24B},
+    {"fifo_fill_drain_8bit_128B",       bench_fifo_fill_drain_8bit_128B},
+    {"fifo_buffer_16bit_24",            bench_fifo_buffer_16bit_24},
+    {"fifo_copy_parse_8bit_24B",        bench_fifo_copy_parse_8bit_24B},
+    {"fifo_zero_copy_parse_8bit_24B",   bench_fifo_zero_copy_parse_8bit_24B},
+    {"spsc_fifo_element_8bit",          bench_spsc_fifo_element_8bit},
+    {"spsc_fifo_buffer_8bit_24B",       bench_spsc_fifo_buffer_8bit_24B},
+    {"spsc_fifo_fill_drain_8bit_128B",  bench_spsc_fifo_fill_drain_8bit_128B},
+    {"spsc_fifo_buffer_16bit_24",       bench_spsc_fifo_buffer_16bit_24},
+    {"message_fifo_push_pop_24B",       bench_message_fifo_push_pop_24B},
+    {"message_fifo_drop_oldest_24B",    bench_message_fifo_drop_oldest_24B},
+    {NULL, NULL},
+};
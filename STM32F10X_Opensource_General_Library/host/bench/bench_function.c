@@ -0,0 +1,90 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "bench.h"
+
+static BENCH_CASE(bench_zf_sprintf_int)
+{
+    int8 buff[64];
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        uint32 len = zf_sprintf(buff, (const int8 *)"acc:%d,%d,%d", (int32)i, -1234, 4095);
+        b->bytes_per_op = len;
+        bench_keep(b, len);
+    }
+}
+
+static BENCH_CASE(bench_zf_sprintf_mixed)
+{
+    int8 buff[96];
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        uint32 len = zf_sprintf(buff, (const int8 *)"id=%u hex=%x name=%s c=%c", i, 0xBEEFu, "imu660ra", 'k');
+        b->bytes_per_op = len;
+        bench_keep(b, len);
+    }
+}
+
+static BENCH_CASE(bench_zf_sprintf_float)
+{
+    int8 buff[64];
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        uint32 len = zf_sprintf(buff, (const int8 *)"%f", 3.1415926 + (double)(i & 0xFF));
+        bench_keep(b, len);
+    }
+}
+
+static BENCH_CASE(bench_func_str_to_float)
+{
+    char str[] = "12345.678";
+    b->bytes_per_op = sizeof(str) - 1;
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        float f = func_str_to_float(str);
+        bench_keep(b, (int32)f);
+    }
+}
+
+static BENCH_CASE(bench_func_int_to_str)
+{
+    char str[16];
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        func_int_to_str(str, (int32)(i * 2654435761u));
+        bench_keep(b, str[0]);
+    }
+}
+
+static BENCH_CASE(bench_func_str_to_hex)
+{
+    char str[] = "7E";
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        bench_keep(b, func_str_to_hex(str));
+    }
+}
+
+const bench_case_struct bench_function_cases[] =
+{
+    {"function_zf_sprintf_int",         bench_zf_sprintf_int},
+    {"function_zf_sprintf_mixed",       bench_zf_sprintf_mixed},
+    {"function_zf_sprintf_float",       bench_zf_sprintf_float},
+    {"function_str_to_float",           bench_func_str_to_float},
+    {"function_int_to_str",             bench_func_int_to_str},
+    {"function_str_to_hex",             bench_func_str_to_hex},
+    {NULL, NULL},
+};
@@ -0,0 +1,99 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "bench.h"
+
+static char bench_gnss_rmc[96];
+static char bench_gnss_gga[96];
+
+//-------------------------------------------------------------------------------------------------------------------
+//       NMEA 岹 *У\r\n
+// ˵     *out            
+// ˵     *body           $ ͷ  * 
+// ز     void
+// עϢ     ڲʹ
+//-------------------------------------------------------------------------------------------------------------------
+static void bench_gnss_sentence (char *out, const char *body)
+{
+    uint8 sum = 0;
+    for(const char *p = body + 1; *p; p ++)
+    {
+        sum ^= (uint8)*p;
+    }
+    sprintf(out, "%s*%02X\r\n", body, sum);
+}
+
+static void bench_gnss_prepare (void)
+{
+    bench_gnss_sentence(bench_gnss_rmc, "$GNRMC,083559.00,A,3037.12345,N,10403.54321,E,0.512,77.52,171026,,,A,V");
+    bench_gnss_sentence(bench_gnss_gga, "$GNGGA,083559.00,3037.12345,N,10403.54321,E,1,12,0.78,512.3,M,-31.2,M,,");
+    host_uart_reset();
+    gnss_init(GN43RFA);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ģ⴮ڽж ֽιһ
+// ˵     *sentence       
+// ز     void
+// עϢ     ڲʹ ʵÿյһֽڽһжϵ gnss_uart_callback ķʽһ
+//-------------------------------------------------------------------------------------------------------------------
+static void bench_gnss_receive (const char *sentence)
+{
+    for(const char *p = sentence; *p; p ++)
+    {
+        host_uart_feed(GNSS_UART, (const uint8 *)p, 1);
+        gnss_uart_callback();
+    }
+}
+
+static BENCH_CASE(bench_gnss_uart_callback_rmc)
+{
+    bench_timer_stop();
+    bench_gnss_prepare();
+    bench_timer_start();
+
+    b->bytes_per_op = strlen(bench_gnss_rmc);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        bench_gnss_receive(bench_gnss_rmc);
+        bench_keep(b, gnss_flag);
+    }
+}
+
+static BENCH_CASE(bench_gnss_data_parse_rmc_gga)
+{
+    bench_timer_stop();
+    bench_gnss_prepare();
+    b->bytes_per_op = strlen(bench_gnss_rmc) + strlen(bench_gnss_gga);
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        bench_gnss_receive(bench_gnss_rmc);
+        bench_gnss_receive(bench_gnss_gga);
+        gnss_flag = 0;
+
+        bench_timer_start();
+        bench_keep(b, gnss_data_parse());
+        bench_timer_stop();
+        bench_keep(b, gnss.satellite_used);
+    }
+}
+
+const bench_case_struct bench_gnss_cases[] =
+{
+    {"gnss_uart_callback_rmc_per_byte", bench_gnss_uart_callback_rmc},
+    {"gnss_data_parse_rmc_gga",         bench_gnss_data_parse_rmc_gga},
+    {NULL, NULL},
+};
@@ -0,0 +1,194 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// ׼
+// ÷   host_bench [-f ƹ] [-t ÿк] [--csv]
+//    ns/op      ÿβʱ
+//        B/op       ÿβڴֽͨ --wrap=malloc ͳƣ
+//        allocs/op  ÿβڴ
+//        MB/s        bytes_per_op 
+
+#include <time.h>
+#include "bench.h"
+
+static const bench_case_struct *bench_group_table[] =
+{
+    bench_fifo_cases,
+    bench_function_cases,
+    bench_cjson_cases,
+    bench_mqttkit_cases,
+    bench_gnss_cases,
+    bench_assistant_cases,
+};
+
+static uint64_t bench_elapsed_ns    = 0;                                        // ۼƼʱ
+static uint64_t bench_start_ns      = 0;                                        // μʱ
+static uint8    bench_timer_running = 0;
+static uint64_t bench_alloc_bytes   = 0;                                        // ʱڼֽ
+static uint64_t bench_alloc_count   = 0;                                        // ʱڼĴ
+
+void *__real_malloc (size_t size);
+
+//-------------------------------------------------------------------------------------------------------------------
+//      malloc װ ͳƼʱڼڴ
+// ˵     size            С
+// ز     void *          ڴַ
+// עϢ     Ӳ -Wl,--wrap=malloc 滻ģе malloc 
+//-------------------------------------------------------------------------------------------------------------------
+void *__wrap_malloc (size_t size)
+{
+    if(bench_timer_running)
+    {
+        bench_alloc_bytes += size;
+        bench_alloc_count ++;
+    }
+    return __real_malloc(size);
+}
+
+static uint64_t bench_now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void bench_timer_start (void)
+{
+    if(!bench_timer_running)
+    {
+        bench_start_ns = bench_now_ns();
+        bench_timer_running = 1;
+    }
+}
+
+void bench_timer_stop (void)
+{
+    if(bench_timer_running)
+    {
+        bench_elapsed_ns += bench_now_ns() - bench_start_ns;
+        bench_timer_running = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ִһ
+// ˵     *bench_case     
+// ˵     *b              ״̬ iterations 趨
+// ز     void
+// עϢ     ڲʹ
+//-------------------------------------------------------------------------------------------------------------------
+static void bench_run_once (const bench_case_struct *bench_case, bench_state_struct *b)
+{
+    bench_elapsed_ns    = 0;
+    bench_alloc_bytes   = 0;
+    bench_alloc_count   = 0;
+    b->bytes_per_op     = 0;
+    bench_timer_start();
+    bench_case->function(b);
+    bench_timer_stop();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      궨һ
+// ˵     *bench_case     
+// ˵     min_ns          ʱ
+// ˵     csv             1-CSV ʽ 0-
+// ز     void
+// עϢ     ڲʹ ʵʱ ÿŴ 100 
+//-------------------------------------------------------------------------------------------------------------------
+static void bench_run_case (const bench_case_struct *bench_case, uint64_t min_ns, uint8 csv)
+{
+    bench_state_struct b;
+    uint64_t next = 1;
+
+    memset(&b, 0, sizeof(b));
+    b.iterations = 1;
+    bench_run_once(bench_case, &b);                                             // Ԥ ͬʱõκʱ
+
+    while(bench_elapsed_ns < min_ns && b.iterations < 1000000000U)
+    {
+        next = bench_elapsed_ns ? (min_ns * b.iterations * 6 / 5 / bench_elapsed_ns) : (b.iterations * 100ULL);
+        if(next > b.iterations * 100ULL)    next = b.iterations * 100ULL;
+        if(next <= b.iterations)            next = b.iterations + 1;
+        if(next > 1000000000ULL)            next = 1000000000ULL;
+        b.iterations = (uint32)next;
+        bench_run_once(bench_case, &b);
+    }
+
+    double ns_per_op     = (double)bench_elapsed_ns / b.iterations;
+    double bytes_per_op  = (double)bench_alloc_bytes / b.iterations;
+    double allocs_per_op = (double)bench_alloc_count / b.iterations;
+    double mb_per_s      = (b.bytes_per_op && bench_elapsed_ns) ? ((double)b.bytes_per_op * b.iterations * 1000.0 / bench_elapsed_ns) : 0.0;
+
+    if(csv)
+    {
+        printf("%s,%u,%.2f,%.1f,%.2f,%.2f\n", bench_case->name, b.iterations, ns_per_op, bytes_per_op, allocs_per_op, mb_per_s);
+    }
+    else
+    {
+        printf("%-44s %10u %12.2f %10.1f %10.2f %10.2f\n", bench_case->name, b.iterations, ns_per_op, bytes_per_op, allocs_per_op, mb_per_s);
+    }
+    fflush(stdout);
+}
+
+int main (int argc, char *argv[])
+{
+    const char *filter = NULL;
+    uint64_t min_ns = 200ULL * 1000000ULL;
+    uint8 csv = 0;
+
+    for(int i = 1; i < argc; i ++)
+    {
+        if(0 == strcmp(argv[i], "-f") && (i + 1) < argc)
+        {
+            filter = argv[++ i];
+        }
+        else if(0 == strcmp(argv[i], "-t") && (i + 1) < argc)
+        {
+            min_ns = strtoull(argv[++ i], NULL, 10) * 1000000ULL;
+        }
+        else if(0 == strcmp(argv[i], "--csv"))
+        {
+            csv = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-f filter] [-t min_ms] [--csv]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(csv)
+    {
+        printf("name,iterations,ns_per_op,bytes_per_op,allocs_per_op,mb_per_s\n");
+    }
+    else
+    {
+        printf("%-44s %10s %12s %10s %10s %10s\n", "benchmark", "iters", "ns/op", "B/op", "allocs/op", "MB/s");
+    }
+
+    for(uint32 g = 0; g < sizeof(bench_group_table) / sizeof(bench_group_table[0]); g ++)
+    {
+        for(const bench_case_struct *c = bench_group_table[g]; NULL != c->name; c ++)
+        {
+            if(NULL != filter && NULL == strstr(c->name, filter))
+            {
+                continue;
+            }
+            bench_run_case(c, min_ns, csv);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#include "bench.h"
+
+static const char bench_mqtt_topic[]    = "$sys/product-id/device-name/thing/property/post";
+static const char bench_mqtt_payload[]  = "{\"id\":\"123\",\"params\":{\"temperature\":{\"value\":25.5}}}";
+
+static BENCH_CASE(bench_mqtt_packet_publish)
+{
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        MQTT_PACKET_STRUCTURE packet = {NULL, 0, 0, 0};
+        MQTT_PacketPublish(MQTT_PUBLISH_ID, bench_mqtt_topic, bench_mqtt_payload, sizeof(bench_mqtt_payload) - 1,
+                           MQTT_QOS_LEVEL0, 0, 1, &packet);
+        b->bytes_per_op = packet._len;
+        bench_keep(b, packet._len);
+        MQTT_DeleteBuffer(&packet);
+    }
+}
+
+static BENCH_CASE(bench_mqtt_packet_connect)
+{
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        MQTT_PACKET_STRUCTURE packet = {NULL, 0, 0, 0};
+        MQTT_PacketConnect("product-id", "version=2018-10-31&res=products%2Fid%2Fdevices%2Ftest&et=1782126077&method=md5&sign=pj16A1L5",
+                           "device-name", 256, 1, MQTT_QOS_LEVEL0, NULL, NULL, 0, &packet);
+        b->bytes_per_op = packet._len;
+        bench_keep(b, packet._len);
+        MQTT_DeleteBuffer(&packet);
+    }
+}
+
+static BENCH_CASE(bench_mqtt_unpacket_publish)
+{
+    MQTT_PACKET_STRUCTURE packet = {NULL, 0, 0, 0};
+    char *topic, *payload;
+    uint16 topic_len, payload_len, pkt_id;
+    uint8 qos;
+
+    bench_timer_stop();
+    MQTT_PacketPublish(MQTT_PUBLISH_ID, bench_mqtt_topic, bench_mqtt_payload, sizeof(bench_mqtt_payload) - 1,
+                       MQTT_QOS_LEVEL0, 0, 1, &packet);
+    bench_timer_start();
+
+    b->bytes_per_op = packet._len;
+    for(uint32 i = 0; i < b->iterations; i ++)
+    {
+        if(MQTT_PKT_PUBLISH == MQTT_UnPacketRecv(packet._data) &&
+           0 == MQTT_UnPacketPublish(packet._data, &topic, &topic_len, &payload, &payload_len, &qos, &pkt_id))
+        {
+            bench_keep(b, payload_len);
+            MQTT_FreeBuffer(topic);
+            MQTT_FreeBuffer(payload);
+        }
+    }
+
+    bench_timer_stop();
+    MQTT_DeleteBuffer(&packet);
+}
+
+const bench_case_struct bench_mqttkit_cases[] =
+{
+    {"mqttkit_packet_publish_100B",     bench_mqtt_packet_publish},
+    {"mqttkit_packet_connect",          bench_mqtt_packet_connect},
+    {"mqttkit_unpacket_publish_100B",   bench_mqtt_unpacket_publish},
+    {NULL, NULL},
+};
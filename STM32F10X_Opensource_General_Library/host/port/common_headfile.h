@@ -0,0 +1,121 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// Linux PCõ common_headfile.h 
+//  host/CMakeLists.txt ͨ -include ǿưÿԴļǰ
+// ȶ _common_headfile_h_ ʹ common/common_headfile.h ʧЧ
+//  common/ device/ tools/ µĴ߼ģκ޸ļ PC ϱ
+
+#ifndef _common_headfile_h_
+#define _common_headfile_h_
+
+//===================================================C ===================================================
+#include "math.h"
+#include "stdio.h"
+#include "stdint.h"
+#include "stdbool.h"
+#include "string.h"
+#include "stdarg.h"
+#include "stdlib.h"
+//===================================================C ===================================================
+
+//===================================================Ͷ===================================================
+//  common_typedef.h һ  32 λ͸ unsigned int
+// ֤ LP64  Cortex-M3 ݿһ
+#define __common_typedef_h_
+typedef _Bool           uint1;
+typedef unsigned char   uint8  ;    //  8 bits
+typedef unsigned int    uint16 ;    // 16 bits
+typedef unsigned int    uint32 ;    // 32 bits
+
+typedef signed char     int8   ;    //  8 bits
+typedef signed int      int16  ;    // 16 bits
+typedef signed int      int32  ;    // 32 bits
+
+typedef volatile int8   vint8  ;    //  8 bits
+typedef volatile int16  vint16 ;    // 16 bits
+typedef volatile int32  vint32 ;    // 32 bits
+
+typedef volatile uint8  vuint8 ;    //  8 bits
+typedef volatile uint16 vuint16;    // 16 bits
+typedef volatile uint32 vuint32;    // 32 bits
+
+typedef enum            // öٴ  common_typedef.h һ
+{
+    UART1_TX_PA9,
+    UART1_TX_PB6,
+    UART2_TX_PA2,
+    UART3_TX_PB10,
+}uart_tx_pin_enum;
+typedef enum            // öٴ  common_typedef.h һ
+{
+    UART1_RX_PA10,
+    UART1_RX_PB7,
+    UART2_RX_PA3,
+    UART3_RX_PB11,
+}uart_rx_pin_enum;
+typedef enum            // öٴں  common_typedef.h һ
+{
+    UART_1,
+    UART_2,
+    UART_3,
+}uart_index_enum;
+
+#define ZF_WEAK         __attribute__((weak))
+//===================================================Ͷ===================================================
+
+//===================================================ں˽ӿ===================================================
+// û PRIMASK ߳мɱ֤ٽ
+static inline uint32_t __get_PRIMASK (void)             { return 0; }
+static inline void     __set_PRIMASK (uint32_t pri)     { (void)pri; }
+static inline void     __disable_irq (void)             {}
+static inline void     __enable_irq  (void)             {}
+static inline void     __DMB         (void)             { __asm__ volatile("" ::: "memory"); }
+//===================================================ں˽ӿ===================================================
+
+//===================================================Խӿ===================================================
+#define _common_debug_h_
+#define zf_assert(x)                (debug_assert_handler((x), __FILE__, __LINE__))
+#define zf_log(x, str)              (debug_log_handler((x), (str), __FILE__, __LINE__))
+void    debug_assert_handler        (uint8 pass, char *file, int line);
+void    debug_log_handler           (uint8 pass, char *str, char *file, int line);
+uint32  debug_send_buffer           (const uint8 *buff, uint32 len);
+//===================================================Խӿ===================================================
+
+//===================================================ӿ===================================================
+//  host/port/host_port.c ʵ շڴű ڻ׼ι
+void    uart_write_byte             (uart_index_enum uartn, const uint8 dat);
+void    uart_write_buffer           (uart_index_enum uartn, const uint8 *buff, uint32 len);
+void    uart_write_string           (uart_index_enum uartn, const char *str);
+uint8   uart_query_byte             (uart_index_enum uartn, uint8 *dat);
+void    uart_init                   (uart_index_enum uartn, uint32 baud, uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin);
+void    system_delay_ms             (uint32 time);
+void    system_delay_us             (uint32 time);
+//===================================================ӿ===================================================
+
+//====================================================߼ģ====================================================
+#define PROFILE_ENABLE              (0)                                         // û DWT ̶̽ر
+#include "common_critical.h"
+#include "common_profile.h"
+#include "zf_common_fifo.h"
+#include "zf_common_function.h"
+#include "common_cjson.h"
+#include "common_mqttkit.h"
+#include "zf_device_gnss.h"
+#include "seekfree_assistant.h"
+#include "host_port.h"
+//====================================================߼ģ====================================================
+
+#endif
@@ -0,0 +1,211 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// ˿ Ϊ߼ģṩ ʱ Եӿڵڴʵ
+// ڷֻ ڽմ host_uart_feed ιĽűȡ
+
+#include "host_port.h"
+
+typedef struct
+{
+    uint8   rx_buf[HOST_UART_RX_BUFFER_SIZE];
+    uint32  rx_head;
+    uint32  rx_tail;
+    uint32  tx_count;
+}host_uart_struct;
+
+static host_uart_struct host_uart[3];
+
+static const uint8     *host_assistant_data     = NULL;
+static uint32           host_assistant_length   = 0;
+static uint32           host_assistant_tx       = 0;
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ָڵĽսűι
+// ˵     uartn           ں
+// ˵     *dat            ݵַ
+// ˵     len             ݳ
+// ز     void
+// ʹʾ     host_uart_feed(UART_3, (const uint8 *)nmea, strlen(nmea));
+// עϢ     ʱݶ ӲΪһ
+//-------------------------------------------------------------------------------------------------------------------
+void host_uart_feed (uart_index_enum uartn, const uint8 *dat, uint32 len)
+{
+    host_uart_struct *hu = &host_uart[uartn];
+    while(len --)
+    {
+        uint32 next = (hu->rx_head + 1) % HOST_UART_RX_BUFFER_SIZE;
+        if(next == hu->rx_tail)
+        {
+            break;
+        }
+        hu->rx_buf[hu->rx_head] = *dat ++;
+        hu->rx_head = next;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯָڽսűʣ
+// ˵     uartn           ں
+// ز     uint32          ʣֽ
+// ʹʾ     uint32 n = host_uart_rx_pending(UART_3);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 host_uart_rx_pending (uart_index_enum uartn)
+{
+    host_uart_struct *hu = &host_uart[uartn];
+    return (hu->rx_head + HOST_UART_RX_BUFFER_SIZE - hu->rx_tail) % HOST_UART_RX_BUFFER_SIZE;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯָۼƷֽ
+// ˵     uartn           ں
+// ز     uint32          ۼƷֽ
+// ʹʾ     uint32 n = host_uart_tx_count(UART_1);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 host_uart_tx_count (uart_index_enum uartn)
+{
+    return host_uart[uartn].tx_count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      λȫڽű״̬
+// ˵     void
+// ز     void
+// ʹʾ     host_uart_reset();
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void host_uart_reset (void)
+{
+    memset(host_uart, 0, sizeof(host_uart));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      Ϊֽջصýű
+// ˵     *dat            ݵַ һ seekfree_assistant_data_analysis ǰЧ
+// ˵     len             ݳ
+// ز     void
+// ʹʾ     host_assistant_feed(frame, sizeof(frame));
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void host_assistant_feed (const uint8 *dat, uint32 len)
+{
+    host_assistant_data     = dat;
+    host_assistant_length   = len;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯۼƷֽ
+// ˵     void
+// ز     uint32          ۼƷֽ
+// ʹʾ     uint32 n = host_assistant_tx_count();
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 host_assistant_tx_count (void)
+{
+    return host_assistant_tx;
+}
+
+//=================================================== ӿʵ ===================================================
+void uart_write_byte (uart_index_enum uartn, const uint8 dat)
+{
+    (void)dat;
+    host_uart[uartn].tx_count ++;
+}
+
+void uart_write_buffer (uart_index_enum uartn, const uint8 *buff, uint32 len)
+{
+    (void)buff;
+    host_uart[uartn].tx_count += len;
+}
+
+void uart_write_string (uart_index_enum uartn, const char *str)
+{
+    uart_write_buffer(uartn, (const uint8 *)str, strlen(str));
+}
+
+uint8 uart_query_byte (uart_index_enum uartn, uint8 *dat)
+{
+    host_uart_struct *hu = &host_uart[uartn];
+    if(hu->rx_head == hu->rx_tail)
+    {
+        return 0;
+    }
+    *dat = hu->rx_buf[hu->rx_tail];
+    hu->rx_tail = (hu->rx_tail + 1) % HOST_UART_RX_BUFFER_SIZE;
+    return 1;
+}
+
+void uart_init (uart_index_enum uartn, uint32 baud, uart_tx_pin_enum tx_pin, uart_rx_pin_enum rx_pin)
+{
+    (void)baud;
+    (void)tx_pin;
+    (void)rx_pin;
+    memset(&host_uart[uartn], 0, sizeof(host_uart_struct));
+}
+
+void system_delay_ms (uint32 time)
+{
+    (void)time;
+}
+
+void system_delay_us (uint32 time)
+{
+    (void)time;
+}
+
+uint32 debug_send_buffer (const uint8 *buff, uint32 len)
+{
+    uart_write_buffer(UART_1, buff, len);
+    return 0;
+}
+
+void debug_assert_handler (uint8 pass, char *file, int line)
+{
+    if(!pass)
+    {
+        fprintf(stderr, "Assert error: file %s line %d.\n", file, line);
+        abort();
+    }
+}
+
+void debug_log_handler (uint8 pass, char *str, char *file, int line)
+{
+    if(!pass)
+    {
+        fprintf(stderr, "Log message: file %s line %d: %s.\n", file, line, (NULL == str) ? "" : str);
+    }
+}
+
+//=================================================== ͨѶӿ ===================================================
+uint32 seekfree_assistant_transfer (const uint8 *buff, uint32 length)
+{
+    (void)buff;
+    host_assistant_tx += length;
+    return 0;
+}
+
+uint32 seekfree_assistant_receive (uint8 *buff, uint32 length)
+{
+    if(length > host_assistant_length)
+    {
+        length = host_assistant_length;
+    }
+    memcpy(buff, host_assistant_data, length);
+    host_assistant_data     += length;
+    host_assistant_length   -= length;
+    return length;
+}
@@ -0,0 +1,34 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+
+#ifndef _host_port_h_
+#define _host_port_h_
+
+#include "common_headfile.h"
+
+#define HOST_UART_RX_BUFFER_SIZE    (2048)                                      // ÿڽűջС
+
+//====================================================˿ ====================================================
+void    host_uart_feed              (uart_index_enum uartn, const uint8 *dat, uint32 len);
+uint32  host_uart_rx_pending        (uart_index_enum uartn);
+uint32  host_uart_tx_count          (uart_index_enum uartn);
+void    host_uart_reset             (void);
+
+void    host_assistant_feed         (const uint8 *dat, uint32 len);
+uint32  host_assistant_tx_count     (void);
+//====================================================˿ ====================================================
+
+#endif
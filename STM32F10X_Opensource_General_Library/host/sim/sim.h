@@ -0,0 +1,166 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// Ĵ ӿ
+//
+// ԭ
+//   ַ0x40000000 𣩡ڲ FLASH0x08000000 𣩡SCS0xE000E000DWT0xE0001000
+//    PC аоƬʵַӳ ΪɷʣFLASH Ϊֻ
+//   ̼ԼĴÿһηʶᴥȱҳ źŴмڡִΪģ
+//   Ȼſҳִָ ٱȽҳݵõдֵ ģʹ±
+//
+//   ʱ HCLK ڼƣ72MHz ֻͳ߷ʡȴжϽ ͳָִʱ
+//   ͬһĴķѯᰴָ˱ܿһ¼  while(flag) ȴĿת
+//
+// ѽģ
+//   USART1/2/3   λʱ TXE/TC ն RXNE/ORE/IDLE ж DMA 
+//   SPI1/2       ģʽ  BR  DFF һ֡ʱ TXE/RXNE/BSY/OVR 豸ҽ
+//   I2C1/2       ģʽ  CCR ֽʱ SB/ADDR/BTF/TXE/RXNE/AF ACK/POS/LAST ¼ж DMA  豸ҽ
+//   DMA1         7 ͨ CNDTR ݼ HT/TC/TE ѭģʽ 洢洢 ӳ
+//   FLASH         ֱ/ҳ/Ƭ BSY/EOP ʱ PGERR/WRPRTERR
+//   RCC GPIO     ʱӾλ BSRR/BRR/ODR/IDR Ƭѡ֪ͨ SPI 豸 ⲿţ©룩  IIC 豸
+//   NVIC SysTick DWT   ʹ//ȼռ SysTick  CYCCNT
+//
+// ̼ 4GB µջ ֤ (uint32)ָ д DMA  CMAR ܻԭ
+
+#ifndef _sim_h_
+#define _sim_h_
+
+#include "sim_port.h"
+
+#define SIM_HCLK_HZ                 (72000000UL)                                // ʱ׼  SystemInit һ
+#define SIM_CYCLES_PER_US           (SIM_HCLK_HZ / 1000000UL)
+#define SIM_I2C_STRETCH_FOREVER     (UINT64_MAX)                                // sim_i2c_gpio_attach Ӧһֱ SCL
+
+typedef struct
+{
+    uint64_t    cycles;                                                         // ʱ HCLK 
+    uint64_t    bus_read;                                                       // CPU 
+    uint64_t    bus_write;                                                      // CPU д
+    uint64_t    bus_cycles;                                                     // CPU ĵ
+    uint64_t    wait_cycles;                                                    // ѯ
+    uint64_t    dma_transfer;                                                   // DMA ˴
+    uint64_t    irq;                                                            // жϴ
+    uint64_t    idle_tick;                                                      // ʱʱƽĴ
+}sim_stat_struct;
+
+typedef struct
+{
+    void        (*select)   (void *context, uint8 selected, uint64_t cycles);  // Ƭѡ仯 selected 1-ѡ
+    uint8       (*transfer) (void *context, uint8 mosi, uint64_t cycles);      // һֽ  MISO
+    void        *context;
+}sim_spi_slave_struct;
+
+typedef struct
+{
+    uint8       address;                                                        // λӻַ
+    uint8       (*start)    (void *context, uint8 read, uint64_t cycles);      // ַƥ read 1-  1-Ӧ
+    uint8       (*write)    (void *context, uint8 data, uint64_t cycles);      // дһֽ  1-Ӧ
+    uint8       (*read)     (void *context, uint64_t cycles);                  // һֽ
+    void        (*stop)     (void *context, uint64_t cycles);                  // STOP
+    void        *context;
+}sim_i2c_slave_struct;
+
+typedef struct
+{
+    uint8       memory[8 * 1024 * 1024];
+    uint8       status;                                                         // ״̬Ĵ1 BIT0-BUSY BIT1-WEL
+    uint64_t    busy_end;                                                       // /ʱ
+    uint8       command;
+    uint32      index;                                                          // Ƭѡյֽ
+    uint32      address;
+    uint32      program_count;
+    uint32      erase_count;
+    sim_spi_slave_struct slave;
+}sim_w25q64_struct;
+
+typedef struct
+{
+    uint16      width;
+    uint16      height;
+    uint16_t    *framebuffer;                                                   // RGB565 width * height
+    GPIO_TypeDef *dc_port;
+    uint16      dc_pin;
+    uint8       command;
+    uint32      index;                                                          // ǰյֽ
+    uint16      x_start, x_end, y_start, y_end;
+    uint16      x, y;
+    uint8       pixel_high;                                                     // 1-յظֽ
+    uint8       pixel_byte;
+    uint32      command_count;
+    uint32      pixel_count;
+    sim_spi_slave_struct slave;
+}sim_lcd_struct;
+
+typedef struct
+{
+    uint8       gram[8][128];                                                   // SSD1306 Դ ҳ ÿֽΪһ 8 
+    GPIO_TypeDef *dc_port;
+    uint16      dc_pin;
+    uint8       page;
+    uint8       column;
+    uint8       parameter;                                                      // ǰҪյĲֽ
+    uint32      command_count;
+    uint32      data_count;                                                     // дԴֽ
+    sim_spi_slave_struct slave;
+}sim_oled_struct;
+
+typedef struct
+{
+    uint8       memory[256];                                                    // Ĵ  8 λַ
+    uint8       pointer;                                                        // ǰĴַ ÿдһֽڵ
+    uint8       pointer_set;                                                    // 1-дĵһֽΪĴַ
+    uint8       nack_address;                                                   // 1-Ӧַ ģ
+    uint32      read_count;                                                     // ȡֽ
+    uint32      write_count;                                                    // дĴֽ
+    uint32      transaction_count;                                              // յ STOP 
+    sim_i2c_slave_struct slave;
+}sim_i2c_register_struct;
+
+//========================================================================================================
+void        sim_init                (void);
+int         sim_run                 (void (*entry)(void));
+uint64_t    sim_cycles              (void);
+void        sim_cycles_charge       (uint32 cycles);
+void        sim_stat_get            (sim_stat_struct *stat);
+void        sim_stat_reset          (void);
+void        sim_set_timeout         (uint64_t cycles);
+//========================================================================================================
+
+//====================================================ⲿ====================================================
+void        sim_uart_feed           (USART_TypeDef *uartx, const uint8 *data, uint32 length);
+void        sim_uart_feed_error     (USART_TypeDef *uartx, uint8 data, uint16 error_flag);
+uint32      sim_uart_tx_take        (USART_TypeDef *uartx, uint8 *buffer, uint32 length);
+uint64_t    sim_uart_tx_count       (USART_TypeDef *uartx);
+
+uint8       sim_spi_attach          (SPI_TypeDef *spix, GPIO_TypeDef *cs_port, uint16 cs_pin, const sim_spi_slave_struct *slave);
+uint64_t    sim_spi_frame_count     (SPI_TypeDef *spix);
+
+uint8       sim_i2c_attach          (I2C_TypeDef *i2cx, const sim_i2c_slave_struct *slave);
+uint64_t    sim_i2c_byte_count      (I2C_TypeDef *i2cx);
+void        sim_i2c_hold            (I2C_TypeDef *i2cx, uint64_t bytes);
+uint8       sim_i2c_gpio_attach     (GPIO_TypeDef *scl_port, uint16 scl_pin, GPIO_TypeDef *sda_port, uint16 sda_pin, const sim_i2c_slave_struct *slave, uint64_t stretch);
+void        sim_i2c_gpio_stuck      (const sim_i2c_slave_struct *slave, uint8 clocks);
+
+uint8       sim_gpio_get            (GPIO_TypeDef *port, uint16 pin);
+void        sim_gpio_set_input      (GPIO_TypeDef *port, uint16 pin, uint8 level);
+
+void        sim_w25q64_init         (sim_w25q64_struct *flash);
+void        sim_lcd_init            (sim_lcd_struct *lcd, uint16 width, uint16 height, GPIO_TypeDef *dc_port, uint16 dc_pin);
+void        sim_oled_init           (sim_oled_struct *oled, GPIO_TypeDef *dc_port, uint16 dc_pin);
+void        sim_i2c_register_init   (sim_i2c_register_struct *device, uint8 address);
+//====================================================ⲿ====================================================
+
+#endif
@@ -0,0 +1,1475 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+//  ַӳ ȱҳ/ ¼ʱ NVIC жע SysTick DWT RCC GPIO
+
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim_internal.h"
+
+#define SIM_PAGE_SIZE               (4096)
+#define SIM_OPEN_MAX                (4)                                         // ָͬʱʵܱҳ
+#define SIM_STACK_SIZE              (1024 * 1024)
+#define SIM_ALT_STACK_SIZE          (256 * 1024)
+#define SIM_IDLE_US                 (1000)                                      // м
+#define SIM_IDLE_CYCLES             (SIM_IDLE_US * SIM_CYCLES_PER_US / 10)      // ʱÿƽķʱ
+#define SIM_POLL_SHIFT_MAX          (20)                                        // ѯ 2^20 
+#define SIM_POLL_TIME_MAX           (256)                                       // ʱĴVAL/CYCCNT
+#define SIM_TIMEOUT_DEFAULT         (60ULL * SIM_HCLK_HZ)
+
+typedef struct
+{
+    uint32      base;
+    uint32      size;
+    int         prot;
+    uint8       *alias;                                                         // ɶдӳ ģͨʼĴ
+}sim_region_struct;
+
+typedef struct
+{
+    uint32      base;
+    uint32      size;
+    void        (*read)     (uint32 addr);
+    void        (*write)    (uint32 addr, uint32 old_value, uint32 value);
+}sim_periph_struct;
+
+typedef struct
+{
+    uint64_t    (*next)     (void);
+    void        (*fire)     (uint64_t t);
+}sim_model_struct;
+
+typedef struct
+{
+    sim_region_struct   *region;
+    uint32      page;
+    uint32      fault;
+    uint8       write;
+    uint32      snapshot[SIM_PAGE_SIZE / 4];
+}sim_open_struct;
+
+static void     sim_gpio_write          (uint32 addr, uint32 old_value, uint32 value);
+static void     sim_rcc_write           (uint32 addr, uint32 old_value, uint32 value);
+static void     sim_scs_read            (uint32 addr);
+static void     sim_scs_write           (uint32 addr, uint32 old_value, uint32 value);
+static void     sim_dwt_read            (uint32 addr);
+static void     sim_dwt_write           (uint32 addr, uint32 old_value, uint32 value);
+static uint64_t sim_systick_next        (void);
+static void     sim_systick_fire        (uint64_t t);
+
+uint64_t        sim_now                 = 0;
+uint64_t        sim_cur                 = 0;
+sim_stat_struct sim_stat;
+
+static sim_region_struct sim_region_table[] =
+{
+    {FLASH_BASE,    SIM_FLASH_SIZE, PROT_READ,  NULL},
+    {0x1FFFF000,    0x1000,         PROT_READ,  NULL},                          // ϵͳ洢 Ψһ ID
+    {PERIPH_BASE,   0x24000,        PROT_NONE,  NULL},
+    {SIM_DWT_BASE,  0x1000,         PROT_NONE,  NULL},
+    {SCS_BASE,      0x1000,         PROT_NONE,  NULL},
+};
+
+static const sim_periph_struct sim_periph_table[] =
+{
+    {USART2_BASE,   0x400,          sim_uart_read,  sim_uart_write},
+    {USART3_BASE,   0x400,          sim_uart_read,  sim_uart_write},
+    {USART1_BASE,   0x400,          sim_uart_read,  sim_uart_write},
+    {SPI2_BASE,     0x400,          sim_spi_read,   sim_spi_write},
+    {SPI1_BASE,     0x400,          sim_spi_read,   sim_spi_write},
+    {I2C1_BASE,     0x800,          sim_i2c_read,   sim_i2c_write},
+    {GPIOA_BASE,    0x1C00,         NULL,           sim_gpio_write},
+    {DMA1_BASE,     0x400,          NULL,           sim_dma_write},
+    {RCC_BASE,      0x400,          NULL,           sim_rcc_write},
+    {FLASH_R_BASE,  0x400,          sim_flash_read, sim_flash_write},
+    {SIM_DWT_BASE,  0x1000,         sim_dwt_read,   sim_dwt_write},
+    {SCS_BASE,      0x1000,         sim_scs_read,   sim_scs_write},
+};
+
+static const sim_model_struct sim_model_table[] =
+{
+    {sim_uart_next,     sim_uart_fire},
+    {sim_spi_next,      sim_spi_fire},
+    {sim_i2c_next,      sim_i2c_fire},
+    {sim_dma_next,      sim_dma_fire},
+    {sim_flash_next,    sim_flash_fire},
+    {sim_systick_next,  sim_systick_fire},
+};
+
+// ж  startup_stm32f10x_md.s ˳һ δʵֵĴΪÿָ
+#define SIM_VECTOR_LIST(X)                                                                      \
+    X(WWDG_IRQHandler)          X(PVD_IRQHandler)           X(TAMPER_IRQHandler)                \
+    X(RTC_IRQHandler)           X(FLASH_IRQHandler)         X(RCC_IRQHandler)                   \
+    X(EXTI0_IRQHandler)         X(EXTI1_IRQHandler)         X(EXTI2_IRQHandler)                 \
+    X(EXTI3_IRQHandler)         X(EXTI4_IRQHandler)         X(DMA1_Channel1_IRQHandler)         \
+    X(DMA1_Channel2_IRQHandler) X(DMA1_Channel3_IRQHandler) X(DMA1_Channel4_IRQHandler)         \
+    X(DMA1_Channel5_IRQHandler) X(DMA1_Channel6_IRQHandler) X(DMA1_Channel7_IRQHandler)         \
+    X(ADC1_2_IRQHandler)        X(USB_HP_CAN1_TX_IRQHandler) X(USB_LP_CAN1_RX0_IRQHandler)      \
+    X(CAN1_RX1_IRQHandler)      X(CAN1_SCE_IRQHandler)      X(EXTI9_5_IRQHandler)               \
+    X(TIM1_BRK_IRQHandler)      X(TIM1_UP_IRQHandler)       X(TIM1_TRG_COM_IRQHandler)          \
+    X(TIM1_CC_IRQHandler)       X(TIM2_IRQHandler)          X(TIM3_IRQHandler)                  \
+    X(TIM4_IRQHandler)          X(I2C1_EV_IRQHandler)       X(I2C1_ER_IRQHandler)               \
+    X(I2C2_EV_IRQHandler)       X(I2C2_ER_IRQHandler)       X(SPI1_IRQHandler)                  \
+    X(SPI2_IRQHandler)          X(USART1_IRQHandler)        X(USART2_IRQHandler)                \
+    X(USART3_IRQHandler)        X(EXTI15_10_IRQHandler)     X(RTCAlarm_IRQHandler)              \
+    X(USBWakeUp_IRQHandler)     X(SysTick_Handler)
+
+#define SIM_VECTOR_DECLARE(name)    extern void name (void) __attribute__((weak));
+#define SIM_VECTOR_ENTRY(name)      name,
+#define SIM_VECTOR_NAME(name)       #name,
+SIM_VECTOR_LIST(SIM_VECTOR_DECLARE)
+static void (* const sim_vector_table[SIM_IRQ_COUNT])(void) = {SIM_VECTOR_LIST(SIM_VECTOR_ENTRY)};
+static const char *const sim_vector_name[SIM_IRQ_COUNT] = {SIM_VECTOR_LIST(SIM_VECTOR_NAME)};
+
+extern void SystemInit (void);
+extern char __executable_start[];
+extern char etext[];
+void sim_irq_trampoline (void);
+void sim_irq_dispatch (void);
+
+static uint8            sim_ready           = 0;
+static volatile int     sim_busy            = 0;                                // ʱִ עж
+static sim_open_struct  sim_open[SIM_OPEN_MAX];
+static uint32           sim_page_copy[SIM_PAGE_SIZE / 4];
+static int              sim_open_count      = 0;
+static uint64_t         sim_timeout         = SIM_TIMEOUT_DEFAULT;
+static uint64_t         sim_access_serial   = 0;
+static uint64_t         sim_alarm_serial    = 0;
+
+static uint32           sim_poll_addr       = 0;
+static uint32           sim_poll_value      = 0;
+static uint32           sim_poll_repeat     = 0;
+static const void      *sim_hint_key        = NULL;
+static uint32           sim_hint_repeat     = 0;
+
+static uint64_t         sim_irq_level       = 0;
+static uint64_t         sim_irq_pending     = 0;
+static uint64_t         sim_irq_active      = 0;
+static uint64_t         sim_irq_enable      = 0;
+static uint8            sim_primask         = 0;
+static uint8            sim_prigroup        = 0;
+static uint16           sim_irq_stack[SIM_IRQ_COUNT + 1];                       // Ƕײռȼ
+static int              sim_irq_depth       = 0;
+
+static uint32           sim_systick_v0      = 0;                                // ׼ʱ̵ VAL
+static uint64_t         sim_systick_t0      = 0;
+static uint64_t         sim_systick_fired   = 0;                                // Ѳ SysTick 쳣
+static uint64_t         sim_systick_counted = 0;                                // ϴζ CTRL ʱĹ
+static uint32           sim_dwt_base        = 0;
+static uint64_t         sim_dwt_t0          = 0;
+static uint8            sim_dwt_running     = 0;
+
+static uint32           sim_gpio_input[7];
+static uint32           sim_gpio_hold[7];                                   // ⲿ͵ ƽ
+
+static ucontext_t       sim_host_context;
+static ucontext_t       sim_firmware_context;
+static void             (*sim_entry)(void)  = NULL;
+static uint8            *sim_stack          = NULL;
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ӡʱ̺˳
+// ˵     *format         printf ʽ
+// ز     void
+// עϢ     ̼ȳʱ δʵֵжϵ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_fatal (const char *format, ...)
+{
+    va_list args;
+    fprintf(stderr, "sim: fatal at %llu cycles (%.3f ms): ", (unsigned long long)sim_now, (double)sim_now / (SIM_HCLK_HZ / 1000));
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fprintf(stderr, "\n");
+    fflush(stdout);
+    _exit(2);
+}
+
+static sim_region_struct *sim_region_find (uint64_t addr)
+{
+    for(uint32 i = 0; i < sizeof(sim_region_table) / sizeof(sim_region_table[0]); i ++)
+    {
+        if(addr >= sim_region_table[i].base && addr < (uint64_t)sim_region_table[i].base + sim_region_table[i].size)
+        {
+            return &sim_region_table[i];
+        }
+    }
+    return NULL;
+}
+
+static const sim_periph_struct *sim_periph_find (uint32 addr)
+{
+    for(uint32 i = 0; i < sizeof(sim_periph_table) / sizeof(sim_periph_table[0]); i ++)
+    {
+        if(addr >= sim_periph_table[i].base && addr < sim_periph_table[i].base + sim_periph_table[i].size)
+        {
+            return &sim_periph_table[i];
+        }
+    }
+    return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡüĴĿɶдַ
+// ˵     addr            оƬַ
+// ز     volatile uint32 *   ַ
+// ʹʾ     SIM_REG(USART1_BASE + 0x00) |= USART_SR_TXE;
+// עϢ     ģ޸ļĴᴥ
+//-------------------------------------------------------------------------------------------------------------------
+volatile uint32 *sim_reg (uint32 addr)
+{
+    sim_region_struct *region = sim_region_find(addr);
+    if(NULL == region)
+    {
+        sim_fatal("sim_reg 0x%08X outside simulated regions", addr);
+    }
+    return (volatile uint32 *)(region->alias + ((addr - region->base) & ~3U));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      CPU һθõַĵ
+// ˵     addr            оƬַ
+// ز     uint32          HCLK 
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 sim_bus_cycles (uint32 addr)
+{
+    if(addr >= 0xE0000000)                                  return SIM_CYCLES_PPB;
+    if(addr >= AHBPERIPH_BASE && addr < 0x40030000)         return SIM_CYCLES_AHB;
+    if(addr >= APB2PERIPH_BASE && addr < AHBPERIPH_BASE)    return SIM_CYCLES_APB2;
+    if(addr >= APB1PERIPH_BASE && addr < APB2PERIPH_BASE)   return SIM_CYCLES_APB1;
+    if(addr >= FLASH_BASE && addr < FLASH_BASE + SIM_FLASH_SIZE) return SIM_CYCLES_AHB;
+    return SIM_CYCLES_SRAM;
+}
+
+//====================================================ʱ====================================================
+static uint64_t sim_next_event (void)
+{
+    uint64_t next = SIM_NEVER;
+    for(uint32 i = 0; i < sizeof(sim_model_table) / sizeof(sim_model_table[0]); i ++)
+    {
+        uint64_t t = sim_model_table[i].next();
+        if(t < next)
+        {
+            next = t;
+        }
+    }
+    return next;
+}
+
+static void sim_irq_update (void)
+{
+    sim_uart_irq();
+    sim_spi_irq();
+    sim_i2c_irq();
+    sim_dma_irq();
+    sim_flash_irq();
+    sim_irq_pending |= sim_irq_level & ~sim_irq_active;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʱ˳в sim_now ¼
+// ˵     void
+// ز     void
+// עϢ     ¼ڼ sim_cur Ϊ¼ʱ  sim_now
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_sync (void)
+{
+    for(;;)
+    {
+        uint64_t next = SIM_NEVER;
+        int index = -1;
+        for(uint32 i = 0; i < sizeof(sim_model_table) / sizeof(sim_model_table[0]); i ++)
+        {
+            uint64_t t = sim_model_table[i].next();
+            if(t < next)
+            {
+                next = t;
+                index = (int)i;
+            }
+        }
+        if(index < 0 || next > sim_now)
+        {
+            break;
+        }
+        sim_cur = next;
+        sim_model_table[index].fire(next);
+    }
+    sim_cur = sim_now;
+    if(sim_now > sim_timeout)
+    {
+        sim_fatal("timeout, firmware is probably waiting for a flag that never changes (last polled 0x%08X)", sim_poll_addr);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      豸ģʾ CPU ڷѯͬһæ״̬
+// ˵     *key            ѯ ͬһʾʱָ˱ƽʱ
+// ˵     until           æ״̬ʱ
+// ز     void
+// עϢ      SPI 豸æѯ ѯɶβͬļĴ ޷ɵַѯ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_poll_hint (const void *key, uint64_t until)
+{
+    if(key == sim_hint_key)
+    {
+        if(sim_hint_repeat < SIM_POLL_SHIFT_MAX)
+        {
+            sim_hint_repeat ++;
+        }
+    }
+    else
+    {
+        sim_hint_key = key;
+        sim_hint_repeat = 0;
+    }
+    if(until > sim_now && sim_hint_repeat)
+    {
+        uint64_t wait = 1ULL << sim_hint_repeat;
+        if(sim_now + wait > until)
+        {
+            wait = until - sim_now;
+        }
+        sim_now += wait;
+        sim_stat.wait_cycles += wait;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һ CPU ʵļʱ
+// ˵     addr            оƬַ
+// ˵     write           1-д 0-
+// ز     void
+// עϢ     ִָǰģ͵Ķ ʹָºֵ
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_access (uint32 addr, uint8 write)
+{
+    const sim_periph_struct *periph = sim_periph_find(addr);
+    uint32 word = addr & ~3U;
+    uint8 time_register = (SysTick_BASE + 0x08 == word || SIM_DWT_CYCCNT == word);
+
+    sim_access_serial ++;
+    if(!write && word == sim_poll_addr && sim_poll_repeat)
+    {
+        uint32 shift = sim_poll_repeat < SIM_POLL_SHIFT_MAX ? sim_poll_repeat : SIM_POLL_SHIFT_MAX;
+        uint64_t wait = 1ULL << shift;
+        uint64_t next = sim_next_event();
+        if(time_register && wait > SIM_POLL_TIME_MAX)
+        {
+            wait = SIM_POLL_TIME_MAX;
+        }
+        if(next != SIM_NEVER && next > sim_now && sim_now + wait > next)
+        {
+            wait = next - sim_now;
+        }
+        sim_now += wait;
+        sim_stat.wait_cycles += wait;
+    }
+
+    sim_sync();
+    if(NULL != periph && NULL != periph->read && (!write || addr >= 0xE0000000))
+    {
+        periph->read(word);
+    }
+
+    if(write)
+    {
+        sim_poll_addr = 0;
+        sim_poll_repeat = 0;
+        sim_stat.bus_write ++;
+    }
+    else
+    {
+        uint32 value = SIM_REG(word);
+        if(word == sim_poll_addr && (time_register || value == sim_poll_value))
+        {
+            sim_poll_repeat ++;
+        }
+        else
+        {
+            sim_poll_repeat = 0;
+        }
+        sim_poll_addr = word;
+        sim_poll_value = value;
+        sim_stat.bus_read ++;
+    }
+
+    uint32 cost = sim_bus_cycles(addr);
+    sim_now += cost;
+    sim_stat.bus_cycles += cost;
+}
+
+static void sim_commit_write (sim_region_struct *region, uint32 addr, uint32 old_value, uint32 value, uint32 mask)
+{
+    if(FLASH_BASE == region->base)
+    {
+        sim_flash_memory_write(addr, old_value, value, mask);
+    }
+    else if(PERIPH_BASE == region->base || SCS_BASE == region->base || SIM_DWT_BASE == region->base)
+    {
+        const sim_periph_struct *periph = sim_periph_find(addr);
+        if(NULL != periph && NULL != periph->write)
+        {
+            periph->write(addr, old_value, value);
+        }
+    }
+    else
+    {
+        SIM_REG(addr) = old_value;                                              // ϵͳ洢ֻ
+    }
+}
+
+//====================================================ж====================================================
+static uint8 sim_irq_priority (int irq)
+{
+    volatile uint8 *scs = (volatile uint8 *)sim_reg(SCS_BASE);
+    if(SIM_IRQ_SYSTICK == irq)
+    {
+        return scs[0xD23] & 0xF0;
+    }
+    return scs[0x400 + irq] & 0xF0;
+}
+
+static uint16 sim_irq_group (uint16 priority)
+{
+    return priority & ((0xFF << (sim_prigroup + 1)) & 0xFF);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѡռǰִвȼж
+// ˵     void
+// ز     int             ڲжϺ -1 ʾû
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+static int sim_irq_pick (void)
+{
+    uint64_t candidate = sim_irq_pending & (sim_irq_enable | (1ULL << SIM_IRQ_SYSTICK)) & ~sim_irq_active;
+    uint16 best_priority = 0x100;
+    int best = -1;
+
+    if(0 == candidate || sim_primask)
+    {
+        return -1;
+    }
+    for(int irq = 0; irq < SIM_IRQ_COUNT; irq ++)
+    {
+        if(candidate & (1ULL << irq))
+        {
+            uint16 priority = sim_irq_priority(irq);
+            if(priority < best_priority)
+            {
+                best_priority = priority;
+                best = irq;
+            }
+        }
+    }
+    if(best >= 0 && sim_irq_depth && sim_irq_group(best_priority) >= sim_irq_stack[sim_irq_depth - 1])
+    {
+        best = -1;
+    }
+    return best;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ִпռǰĹж жʱ
+// ˵     void
+// ز     void
+// עϢ     ͬжϰβʽִ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_irq_dispatch (void)
+{
+    for(;;)
+    {
+        int irq;
+
+        sim_busy ++;
+        sim_sync();
+        sim_irq_update();
+        irq = sim_irq_pick();
+        if(irq >= 0)
+        {
+            sim_irq_pending &= ~(1ULL << irq);
+            sim_irq_active |= 1ULL << irq;
+            sim_irq_stack[sim_irq_depth ++] = sim_irq_group(sim_irq_priority(irq));
+            sim_now += SIM_CYCLES_IRQ_ENTRY;
+            sim_stat.irq ++;
+            sim_poll_addr = 0;
+        }
+        sim_busy --;
+        if(irq < 0)
+        {
+            break;
+        }
+        if(NULL == sim_vector_table[irq])
+        {
+            sim_fatal("%s is enabled and pending but not linked", sim_vector_name[irq]);
+        }
+
+        sim_vector_table[irq]();
+
+        sim_busy ++;
+        sim_irq_active &= ~(1ULL << irq);
+        sim_irq_depth --;
+        sim_now += SIM_CYCLES_IRQ_EXIT;
+        sim_busy --;
+    }
+}
+
+// ж ȫ߱Ĵ x87/SSE/AVX ״̬ sim_irq_dispatch
+// ǰźŴѰ rsp  136 ֽڣԽ 128 ֽںѹ뱻ϴ rip
+__asm__(
+    "    .text\n"
+    "    .globl  sim_irq_trampoline\n"
+    "    .type   sim_irq_trampoline, @function\n"
+    "sim_irq_trampoline:\n"
+    "    pushfq\n"
+    "    cld\n"
+    "    push    %rax\n"
+    "    push    %rcx\n"
+    "    push    %rdx\n"
+    "    push    %rsi\n"
+    "    push    %rdi\n"
+    "    push    %r8\n"
+    "    push    %r9\n"
+    "    push    %r10\n"
+    "    push    %r11\n"
+    "    push    %rbp\n"
+    "    mov     %rsp, %rbp\n"
+    "    sub     $1152, %rsp\n"
+    "    and     $-64, %rsp\n"
+    "    xor     %eax, %eax\n"
+    "    mov     %rax, 512(%rsp)\n"
+    "    mov     %rax, 520(%rsp)\n"
+    "    mov     %rax, 528(%rsp)\n"
+    "    mov     %rax, 536(%rsp)\n"
+    "    mov     %rax, 544(%rsp)\n"
+    "    mov     %rax, 552(%rsp)\n"
+    "    mov     %rax, 560(%rsp)\n"
+    "    mov     %rax, 568(%rsp)\n"
+    "    mov     $7, %eax\n"
+    "    xor     %edx, %edx\n"
+    "    xsave64 (%rsp)\n"
+    "    call    sim_irq_dispatch\n"
+    "    mov     $7, %eax\n"
+    "    xor     %edx, %edx\n"
+    "    xrstor64 (%rsp)\n"
+    "    mov     %rbp, %rsp\n"
+    "    pop     %rbp\n"
+    "    pop     %r11\n"
+    "    pop     %r10\n"
+    "    pop     %r9\n"
+    "    pop     %r8\n"
+    "    pop     %rdi\n"
+    "    pop     %rsi\n"
+    "    pop     %rdx\n"
+    "    pop     %rcx\n"
+    "    pop     %rax\n"
+    "    popfq\n"
+    "    ret     $128\n"
+    "    .size   sim_irq_trampoline, .-sim_irq_trampoline\n"
+);
+
+//-------------------------------------------------------------------------------------------------------------------
+//      źŷصעж
+// ˵     *uc             ź
+// ز     void
+// עϢ     ֻڹ̼ڡûδɵʱע ֤ϵָ߽ͨ
+//-------------------------------------------------------------------------------------------------------------------
+static void sim_irq_inject (ucontext_t *uc)
+{
+    greg_t rip = uc->uc_mcontext.gregs[REG_RIP];
+
+    if(sim_busy || sim_open_count || NULL == sim_stack ||
+       rip < (greg_t)(uintptr_t)__executable_start || rip >= (greg_t)(uintptr_t)etext ||
+       sim_irq_pick() < 0)
+    {
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_RSP] -= 136;
+    *(greg_t *)uc->uc_mcontext.gregs[REG_RSP] = rip;
+    uc->uc_mcontext.gregs[REG_RIP] = (greg_t)(uintptr_t)sim_irq_trampoline;
+}
+
+void sim_irq_line (int irq, uint8 level)
+{
+    if(level)
+    {
+        sim_irq_level |= 1ULL << irq;
+    }
+    else
+    {
+        sim_irq_level &= ~(1ULL << irq);
+    }
+}
+
+void sim_enable_irq (void)
+{
+    sim_primask = 0;
+    sim_irq_dispatch();
+}
+
+void sim_disable_irq (void)
+{
+    sim_primask = 1;
+}
+
+uint32_t __get_PRIMASK (void)
+{
+    return sim_primask;
+}
+
+void __set_PRIMASK (uint32_t primask)
+{
+    sim_primask = primask & 1;
+    if(!sim_primask)
+    {
+        sim_irq_dispatch();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      WFI ֱƽһ¼
+// ˵     void
+// ز     void
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_wait_for_interrupt (void)
+{
+    sim_busy ++;
+    uint64_t next = sim_next_event();
+    uint64_t wait = (SIM_NEVER == next || next <= sim_now) ? SIM_IDLE_CYCLES : next - sim_now;
+    sim_now += wait;
+    sim_stat.wait_cycles += wait;
+    sim_busy --;
+    sim_irq_dispatch();
+}
+
+//====================================================SysTick NVIC SCB====================================================
+static uint32 sim_systick_load (void)
+{
+    return SIM_REG(SysTick_BASE + 0x04) & 0x00FFFFFF;
+}
+
+static uint64_t sim_systick_ticks (uint64_t t)
+{
+    uint32 ctrl = SIM_REG(SysTick_BASE + 0x00);
+    return (t - sim_systick_t0) / ((ctrl & SysTick_CTRL_CLKSOURCE) ? 1 : 8);
+}
+
+// ӻ׼ʱ ticks ΪֹĴ
+static uint64_t sim_systick_zero_count (uint64_t ticks)
+{
+    uint64_t period = (uint64_t)sim_systick_load() + 1;
+    if(ticks < sim_systick_v0 || 1 == period)
+    {
+        return 0;
+    }
+    return (ticks - sim_systick_v0) / period + (sim_systick_v0 ? 1 : 0);
+}
+
+static uint32 sim_systick_value (uint64_t t)
+{
+    uint32 ctrl = SIM_REG(SysTick_BASE + 0x00);
+    uint64_t ticks;
+    if(!(ctrl & SysTick_CTRL_ENABLE))
+    {
+        return sim_systick_v0;
+    }
+    ticks = sim_systick_ticks(t);
+    if(ticks <= sim_systick_v0)
+    {
+        return sim_systick_v0 - (uint32)ticks;
+    }
+    return sim_systick_load() - (uint32)((ticks - sim_systick_v0 - 1) % ((uint64_t)sim_systick_load() + 1));
+}
+
+static void sim_systick_rebase (void)
+{
+    sim_systick_v0 = sim_systick_value(sim_cur);
+    sim_systick_t0 = sim_cur;
+    sim_systick_fired = 0;
+    sim_systick_counted = 0;
+}
+
+static uint64_t sim_systick_next (void)
+{
+    uint32 ctrl = SIM_REG(SysTick_BASE + 0x00);
+    uint64_t period = (uint64_t)sim_systick_load() + 1;
+    uint64_t ticks;
+
+    if((ctrl & (SysTick_CTRL_ENABLE | SysTick_CTRL_TICKINT)) != (SysTick_CTRL_ENABLE | SysTick_CTRL_TICKINT) || 1 == period)
+    {
+        return SIM_NEVER;
+    }
+    if(sim_systick_v0)
+    {
+        ticks = sim_systick_v0 + sim_systick_fired * period;
+    }
+    else
+    {
+        ticks = (sim_systick_fired + 1) * period;
+    }
+    return sim_systick_t0 + ticks * ((ctrl & SysTick_CTRL_CLKSOURCE) ? 1 : 8);
+}
+
+static void sim_systick_fire (uint64_t t)
+{
+    sim_systick_fired = sim_systick_zero_count(sim_systick_ticks(t));
+    sim_irq_pending |= 1ULL << SIM_IRQ_SYSTICK;
+}
+
+static void sim_scs_read (uint32 addr)
+{
+    uint32 offset = addr - SCS_BASE;
+
+    if(0x010 == offset)
+    {
+        uint64_t count = 0;
+        uint32 ctrl = SIM_REG(addr) & ~SysTick_CTRL_COUNTFLAG;
+        if(ctrl & SysTick_CTRL_ENABLE)
+        {
+            count = sim_systick_zero_count(sim_systick_ticks(sim_cur));
+        }
+        if(count > sim_systick_counted)
+        {
+            ctrl |= SysTick_CTRL_COUNTFLAG;                                     //  ´ζʱ¼
+        }
+        sim_systick_counted = count;
+        SIM_REG(addr) = ctrl;
+    }
+    else if(0x018 == offset)
+    {
+        SIM_REG(addr) = sim_systick_value(sim_cur);
+    }
+    else if(offset >= 0x200 && offset < 0x220)
+    {
+        SIM_REG(addr) = (uint32)(sim_irq_pending >> ((offset - 0x200) * 8));
+    }
+    else if(offset >= 0x280 && offset < 0x2A0)
+    {
+        SIM_REG(addr) = (uint32)(sim_irq_pending >> ((offset - 0x280) * 8));
+    }
+    else if(offset >= 0x300 && offset < 0x320)
+    {
+        SIM_REG(addr) = (uint32)(sim_irq_active >> ((offset - 0x300) * 8));
+    }
+    else if(offset >= 0x100 && offset < 0x1A0)
+    {
+        SIM_REG(addr) = (uint32)(sim_irq_enable >> (((offset & 0x7F) - 0x00) * 8));
+    }
+}
+
+static void sim_scs_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    uint32 offset = addr - SCS_BASE;
+    uint32 shift = 0;
+
+    switch(offset)
+    {
+        case 0x010:
+        {
+            SIM_REG(addr) = (value & 0x7) | (old_value & SysTick_CTRL_COUNTFLAG);
+            if((old_value ^ value) & (SysTick_CTRL_ENABLE | SysTick_CTRL_CLKSOURCE))
+            {
+                if(value & SysTick_CTRL_ENABLE)
+                {
+                    sim_systick_t0 = sim_cur;
+                    sim_systick_fired = 0;
+                    sim_systick_counted = 0;
+                }
+                else
+                {
+                    SIM_REG(addr) = old_value;                                  // Ȱֹͣʱֵ
+                    sim_systick_v0 = sim_systick_value(sim_cur);
+                    SIM_REG(addr) = value & 0x7;
+                }
+            }
+        }break;
+        case 0x014:
+        {
+            SIM_REG(addr) = old_value & 0x00FFFFFF;                             // װֵǰ ٻֵ
+            sim_systick_rebase();
+            SIM_REG(addr) = value & 0x00FFFFFF;
+        }break;
+        case 0x018:
+        {
+            SIM_REG(addr) = 0;                                                  // дֵ  COUNTFLAG
+            sim_systick_v0 = 0;
+            sim_systick_t0 = sim_cur;
+            sim_systick_fired = 0;
+            sim_systick_counted = 0;
+            SIM_REG(SysTick_BASE) &= ~SysTick_CTRL_COUNTFLAG;
+        }break;
+        case 0xD00:
+        {
+            SIM_REG(addr) = old_value;
+        }break;
+        case 0xD04:
+        {
+            if(value & SCB_ICSR_PENDSTSET)
+            {
+                sim_irq_pending |= 1ULL << SIM_IRQ_SYSTICK;
+            }
+            if(value & SCB_ICSR_PENDSTCLR)
+            {
+                sim_irq_pending &= ~(1ULL << SIM_IRQ_SYSTICK);
+            }
+            SIM_REG(addr) = 0;
+        }break;
+        case 0xD0C:
+        {
+            if(0x05FA == (value >> 16))
+            {
+                sim_prigroup = (value >> 8) & 0x7;
+                if(value & SCB_AIRCR_SYSRESETREQ)
+                {
+                    sim_fatal("firmware requested a system reset");
+                }
+            }
+            SIM_REG(addr) = 0xFA050000 | ((uint32)sim_prigroup << 8);
+        }break;
+        case 0xDFC:
+        {
+            sim_dwt_write(SIM_DWT_CTRL, SIM_REG(SIM_DWT_CTRL), SIM_REG(SIM_DWT_CTRL));
+        }break;
+        case 0xF00:
+        {
+            if((value & 0x1FF) < 43)
+            {
+                sim_irq_pending |= 1ULL << (value & 0x1FF);
+            }
+            SIM_REG(addr) = 0;
+        }break;
+        default:
+        {
+            if(offset >= 0x100 && offset < 0x120)
+            {
+                shift = (offset - 0x100) * 8;
+                sim_irq_enable |= (uint64_t)value << shift;
+            }
+            else if(offset >= 0x180 && offset < 0x1A0)
+            {
+                shift = (offset - 0x180) * 8;
+                sim_irq_enable &= ~((uint64_t)value << shift);
+            }
+            else if(offset >= 0x200 && offset < 0x220)
+            {
+                shift = (offset - 0x200) * 8;
+                sim_irq_pending |= (uint64_t)value << shift;
+            }
+            else if(offset >= 0x280 && offset < 0x2A0)
+            {
+                shift = (offset - 0x280) * 8;
+                sim_irq_pending &= ~((uint64_t)value << shift);
+            }
+            else if((offset >= 0x400 && offset < 0x4F0) || (offset >= 0xD18 && offset < 0xD24))
+            {
+                SIM_REG(addr) = value & 0xF0F0F0F0;                             // F103 ֻʵ 4 λȼ
+            }
+            else
+            {
+                break;
+            }
+            sim_irq_enable &= (1ULL << 43) - 1;
+            sim_irq_pending &= ((1ULL << 43) - 1) | (1ULL << SIM_IRQ_SYSTICK);
+        }break;
+    }
+}
+
+//====================================================DWT====================================================
+static void sim_dwt_read (uint32 addr)
+{
+    if(SIM_DWT_CYCCNT == addr && sim_dwt_running)
+    {
+        SIM_REG(addr) = sim_dwt_base + (uint32)(sim_cur - sim_dwt_t0);
+    }
+}
+
+static void sim_dwt_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    uint8 running;
+
+    if(SIM_DWT_CYCCNT == addr)
+    {
+        sim_dwt_base = value;
+        sim_dwt_t0 = sim_cur;
+        return;
+    }
+    if(SIM_DWT_CTRL != addr)
+    {
+        return;
+    }
+    SIM_REG(addr) = 0x40000000 | (value & 0x0FFFFFFF);                          // NUMCOMP=4
+    running = (value & 1) && (SIM_REG(CoreDebug_BASE + 0x0C) & CoreDebug_DEMCR_TRCENA_Msk);
+    if(running != sim_dwt_running)
+    {
+        if(running)
+        {
+            sim_dwt_t0 = sim_cur;
+        }
+        else
+        {
+            sim_dwt_base += (uint32)(sim_cur - sim_dwt_t0);
+            SIM_REG(SIM_DWT_CYCCNT) = sim_dwt_base;
+        }
+        sim_dwt_running = running;
+    }
+}
+
+//====================================================RCC====================================================
+static void sim_rcc_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    (void)old_value;
+    if(RCC_BASE + 0x00 == addr)
+    {
+        value &= ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY);
+        if(value & RCC_CR_HSION)    value |= RCC_CR_HSIRDY;
+        if(value & RCC_CR_HSEON)    value |= RCC_CR_HSERDY;
+        if(value & RCC_CR_PLLON)    value |= RCC_CR_PLLRDY;
+        SIM_REG(addr) = value;
+    }
+    else if(RCC_BASE + 0x04 == addr)
+    {
+        SIM_REG(addr) = (value & ~RCC_CFGR_SWS) | ((value & RCC_CFGR_SW) << 2);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      APB ʱ HCLK ķƵ
+// ˵     apb             1-APB1 2-APB2
+// ز     uint32          Ƶϵ
+// עϢ      RCC_CFGR ǰü
+//-------------------------------------------------------------------------------------------------------------------
+uint32 sim_apb_divider (uint8 apb)
+{
+    uint32 cfgr = SIM_REG(RCC_BASE + 0x04);
+    uint32 ppre = (1 == apb) ? ((cfgr >> 8) & 0x7) : ((cfgr >> 11) & 0x7);
+    return (ppre & 0x4) ? (2U << (ppre & 0x3)) : 1;
+}
+
+//====================================================GPIO====================================================
+static void sim_gpio_refresh (uint32 base)
+{
+    uint32 crl = SIM_REG(base + 0x00);
+    uint32 crh = SIM_REG(base + 0x04);
+    uint32 output = 0;
+    uint32 index = (base - GPIOA_BASE) / 0x400;
+
+    for(uint32 i = 0; i < 8; i ++)
+    {
+        if((crl >> (i * 4)) & 0x3)  output |= 1U << i;
+        if((crh >> (i * 4)) & 0x3)  output |= 1U << (i + 8);
+    }
+    SIM_REG(base + 0x08) = ((SIM_REG(base + 0x0C) & output) | (sim_gpio_input[index] & ~output & 0xFFFF)) & ~sim_gpio_hold[index];
+}
+
+static void sim_gpio_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    uint32 base = addr & ~0x3FFU;
+    uint32 offset = addr & 0x3FF;
+    uint32 odr = SIM_REG(base + 0x0C);
+    uint32 odr_old = odr;
+
+    switch(offset)
+    {
+        case 0x08:  SIM_REG(addr) = old_value;                                      break;
+        case 0x0C:  odr = value & 0xFFFF;                                           break;
+        case 0x10:  odr = ((odr & ~(value >> 16)) | value) & 0xFFFF;    SIM_REG(addr) = 0;  break;
+        case 0x14:  odr = odr & ~value & 0xFFFF;                        SIM_REG(addr) = 0;  break;
+        default:                                                                    break;
+    }
+    SIM_REG(base + 0x0C) = odr;
+    sim_gpio_refresh(base);
+    if(odr != odr_old)
+    {
+        sim_spi_gpio_changed((GPIO_TypeDef *)(uintptr_t)base);
+        sim_i2c_gpio_changed((GPIO_TypeDef *)(uintptr_t)base);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡŵƽ
+// ˵     *port           GPIOA ~ GPIOG
+// ˵     pin             GPIO_Pin_x
+// ز     uint8           1-ߵƽ 0-͵ƽ
+// ʹʾ     sim_gpio_get(GPIOB, GPIO_Pin_0);
+// עϢ     ŷ ODR ŷⲿ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 sim_gpio_get (GPIO_TypeDef *port, uint16 pin)
+{
+    return (SIM_REG((uint32)(uintptr_t)port + 0x08) & pin) ? 1 : 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ⲿƽ
+// ˵     *port           GPIOA ~ GPIOG
+// ˵     pin             GPIO_Pin_x
+// ˵     level           ƽ
+// ز     void
+// ʹʾ     sim_gpio_set_input(GPIOA, GPIO_Pin_0, 1);                  // ģⰴɿ
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_gpio_set_input (GPIO_TypeDef *port, uint16 pin, uint8 level)
+{
+    uint32 base = (uint32)(uintptr_t)port;
+    uint32 index = (base - GPIOA_BASE) / 0x400;
+
+    sim_busy ++;
+    if(level)
+    {
+        sim_gpio_input[index] |= pin;
+    }
+    else
+    {
+        sim_gpio_input[index] &= ~(uint32)pin;
+    }
+    sim_gpio_refresh(base);
+    sim_busy --;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ⲿͻɿ
+// ˵     *port           GPIOA ~ GPIOG
+// ˵     pin             GPIO_Pin_x
+// ˵     hold            1- 0-ɿ
+// ز     void
+// ʹʾ     sim_gpio_hold_low(GPIOB, GPIO_Pin_9, 1);                   // ӻӦ  SDA
+// עϢ     ģ⿪© ڼʲô IDR ͵ƽ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_gpio_hold_low (GPIO_TypeDef *port, uint16 pin, uint8 hold)
+{
+    uint32 base = (uint32)(uintptr_t)port;
+    uint32 index = (base - GPIOA_BASE) / 0x400;
+
+    if(hold)
+    {
+        sim_gpio_hold[index] |= pin;
+    }
+    else
+    {
+        sim_gpio_hold[index] &= ~(uint32)pin;
+    }
+    sim_gpio_refresh(base);
+}
+
+//====================================================߷ʣDMA ʹã====================================================
+//-------------------------------------------------------------------------------------------------------------------
+//      DMA 
+// ˵     addr            оƬַ
+// ˵     size            1/2/4 ֽ
+// ˵     *error          ʷǷַʱ 1
+// ز     uint32          
+// עϢ     ַģͶ DR  RXNE ַΪڴ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 sim_bus_read (uint32 addr, uint8 size, uint8 *error)
+{
+    sim_region_struct *region = sim_region_find(addr);
+    const uint8 *source;
+    uint32 value = 0;
+
+    if(NULL != region)
+    {
+        const sim_periph_struct *periph = sim_periph_find(addr);
+        if(NULL != periph && NULL != periph->read)
+        {
+            periph->read(addr & ~3U);
+        }
+        source = region->alias + (addr - region->base);
+    }
+    else if(addr < 0x10000)
+    {
+        *error = 1;
+        return 0;
+    }
+    else
+    {
+        source = (const uint8 *)(uintptr_t)addr;
+    }
+    memcpy(&value, source, size);
+    return value;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      DMA д
+// ˵     addr            оƬַ
+// ˵     value           
+// ˵     size            1/2/4 ֽ
+// ˵     *error          ʷǷַʱ 1
+// ز     void
+// עϢ     ַģд
+//-------------------------------------------------------------------------------------------------------------------
+void sim_bus_write (uint32 addr, uint32 value, uint8 size, uint8 *error)
+{
+    sim_region_struct *region = sim_region_find(addr);
+
+    if(NULL != region)
+    {
+        uint32 word = addr & ~3U;
+        uint32 old_value = SIM_REG(word);
+        memcpy(region->alias + (addr - region->base), &value, size);
+        sim_commit_write(region, word, old_value, SIM_REG(word), ((1U << (size * 8)) - 1) << ((addr & 3) * 8));
+    }
+    else if(addr < 0x10000)
+    {
+        *error = 1;
+    }
+    else
+    {
+        memcpy((void *)(uintptr_t)addr, &value, size);
+    }
+}
+
+//====================================================źŴ====================================================
+static void sim_segv_handler (int signal_number, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    uint64_t fault = (uint64_t)(uintptr_t)info->si_addr;
+    sim_region_struct *region = sim_region_find(fault);
+    sim_open_struct *open;
+    uint8 write = (uc->uc_mcontext.gregs[REG_ERR] & 2) ? 1 : 0;
+
+    if(NULL == region || sim_open_count >= SIM_OPEN_MAX)
+    {
+        fprintf(stderr, "sim: invalid access to %p at rip %p\n", info->si_addr, (void *)uc->uc_mcontext.gregs[REG_RIP]);
+        signal(signal_number, SIG_DFL);
+        return;
+    }
+
+    sim_access((uint32)fault, write);
+
+    open = &sim_open[sim_open_count ++];
+    open->region = region;
+    open->page = (uint32)fault & ~(SIM_PAGE_SIZE - 1);
+    open->fault = (uint32)fault;
+    open->write = write;
+    memcpy(open->snapshot, (const void *)sim_reg(open->page), SIM_PAGE_SIZE);
+    mprotect((void *)(uintptr_t)open->page, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= 0x100;                                    // ִָ
+}
+
+static void sim_trap_handler (int signal_number, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    int count = sim_open_count;
+
+    (void)signal_number;
+    (void)info;
+    uc->uc_mcontext.gregs[REG_EFL] &= ~0x100;
+    if(0 == count)
+    {
+        return;
+    }
+
+    sim_open_count = 0;
+    for(int i = 0; i < count; i ++)
+    {
+        mprotect((void *)(uintptr_t)sim_open[i].page, SIM_PAGE_SIZE, sim_open[i].region->prot);
+    }
+    for(int i = 0; i < count; i ++)
+    {
+        sim_open_struct *open = &sim_open[i];
+        uint32 *page = sim_page_copy;
+        uint32 fault_word = open->fault & ~3U;
+
+        // ȸһִָкҳ ģʹдʱͬҳĴ޸Ĳܵ CPU д
+        memcpy(page, (const void *)sim_reg(open->page), SIM_PAGE_SIZE);
+        if(0 == memcmp(page, open->snapshot, SIM_PAGE_SIZE) && !open->write)
+        {
+            continue;
+        }
+        for(uint32 w = 0; w < SIM_PAGE_SIZE / 4; w ++)
+        {
+            uint32 addr = open->page + w * 4;
+            uint32 value = page[w];
+            uint32 old_value = open->snapshot[w];
+            uint32 mask = 0;
+
+            for(uint32 b = 0; b < 4; b ++)
+            {
+                if((value ^ old_value) & (0xFFU << (b * 8)))
+                {
+                    mask |= 0xFFU << (b * 8);
+                }
+            }
+            if(open->write && addr == fault_word)
+            {
+                mask |= ((open->fault & 2) ? 0xFFFF0000U : 0x0000FFFFU);
+            }
+            if(mask)
+            {
+                sim_cur = sim_now;
+                sim_commit_write(open->region, addr, old_value, value, mask);
+            }
+        }
+    }
+
+    sim_sync();
+    sim_irq_update();
+    sim_irq_inject(uc);
+}
+
+static void sim_alarm_handler (int signal_number, siginfo_t *info, void *context)
+{
+    uint64_t next;
+    uint64_t wait;
+
+    (void)signal_number;
+    (void)info;
+    if(sim_busy || sim_open_count || NULL == sim_stack)
+    {
+        return;
+    }
+    if(sim_access_serial != sim_alarm_serial)
+    {
+        sim_alarm_serial = sim_access_serial;
+        return;
+    }
+    next = sim_next_event();
+    wait = SIM_IDLE_CYCLES;
+    if(next > sim_now && next - sim_now < wait)
+    {
+        wait = next - sim_now;                                                  // Խһ¼ ֤жϰʱ
+    }
+    sim_now += wait;
+    sim_stat.idle_tick ++;
+    sim_sync();
+    sim_irq_update();
+    sim_irq_inject((ucontext_t *)context);
+}
+
+//====================================================ʼ====================================================
+static void sim_region_map (void)
+{
+    stack_t alt_stack;
+    struct sigaction action;
+
+    for(uint32 i = 0; i < sizeof(sim_region_table) / sizeof(sim_region_table[0]); i ++)
+    {
+        sim_region_struct *region = &sim_region_table[i];
+        int fd = memfd_create("stm32f10x_sim", 0);
+        void *fixed;
+
+        if(fd < 0 || ftruncate(fd, region->size) < 0)
+        {
+            sim_fatal("memfd_create failed");
+        }
+        fixed = mmap((void *)(uintptr_t)region->base, region->size, region->prot, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+        region->alias = mmap(NULL, region->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(fixed != (void *)(uintptr_t)region->base || MAP_FAILED == region->alias)
+        {
+            sim_fatal("cannot map 0x%08X, link the simulator with -no-pie", region->base);
+        }
+        close(fd);
+    }
+    memset(sim_region_table[0].alias, 0xFF, SIM_FLASH_SIZE);                    // Ϊ״̬
+
+    alt_stack.ss_sp = malloc(SIM_ALT_STACK_SIZE);
+    alt_stack.ss_size = SIM_ALT_STACK_SIZE;
+    alt_stack.ss_flags = 0;
+    sigaltstack(&alt_stack, NULL);
+
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    sigaddset(&action.sa_mask, SIGALRM);
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    action.sa_sigaction = sim_segv_handler;
+    sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = sim_trap_handler;
+    sigaction(SIGTRAP, &action, NULL);
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESTART;
+    action.sa_sigaction = sim_alarm_handler;
+    sigaction(SIGALRM, &action, NULL);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʼ ൱оƬϵ縴λ
+// ˵     void
+// ز     void
+// ʹʾ     sim_init();
+// עϢ     ״εʱַӳ ֮ÿεøλȫĴʱ ڲ FLASH ݱ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_init (void)
+{
+    volatile uint8 *system_memory;
+
+    if(!sim_ready)
+    {
+        sim_region_map();
+        sim_ready = 1;
+    }
+    sim_busy ++;
+    memset(sim_region_table[2].alias, 0, sim_region_table[2].size);
+    memset(sim_region_table[3].alias, 0, sim_region_table[3].size);
+    memset(sim_region_table[4].alias, 0, sim_region_table[4].size);
+
+    system_memory = sim_region_table[1].alias;
+    system_memory[0x7E0] = 64;                                                  // F103C8 64KB
+    system_memory[0x7E1] = 0;
+    for(uint32 i = 0; i < 12; i ++)
+    {
+        system_memory[0x7E8 + i] = (uint8)(0x30 + i);
+    }
+
+    sim_now = 0;
+    sim_cur = 0;
+    sim_timeout = SIM_TIMEOUT_DEFAULT;
+    sim_poll_addr = 0;
+    sim_poll_repeat = 0;
+    sim_hint_key = NULL;
+    sim_irq_level = 0;
+    sim_irq_pending = 0;
+    sim_irq_active = 0;
+    sim_irq_enable = 0;
+    sim_primask = 0;
+    sim_prigroup = 0;
+    sim_irq_depth = 0;
+    sim_systick_v0 = 0;
+    sim_systick_t0 = 0;
+    sim_systick_fired = 0;
+    sim_systick_counted = 0;
+    sim_dwt_base = 0;
+    sim_dwt_t0 = 0;
+    sim_dwt_running = 0;
+    memset(&sim_stat, 0, sizeof(sim_stat));
+    memset(sim_gpio_input, 0, sizeof(sim_gpio_input));
+    memset(sim_gpio_hold, 0, sizeof(sim_gpio_hold));
+
+    SIM_REG(RCC_BASE + 0x00) = 0x00000083;
+    for(uint32 base = GPIOA_BASE; base <= GPIOG_BASE; base += 0x400)
+    {
+        SIM_REG(base + 0x00) = 0x44444444;
+        SIM_REG(base + 0x04) = 0x44444444;
+    }
+    SIM_REG(SCB_BASE + 0x00) = 0x411FC231;
+    SIM_REG(SCB_BASE + 0x0C) = 0xFA050000;
+    SIM_REG(SIM_DWT_CTRL) = 0x40000000;
+
+    sim_uart_reset();
+    sim_spi_reset();
+    sim_i2c_reset();
+    sim_dma_reset();
+    sim_flash_reset();
+    sim_busy --;
+}
+
+static void sim_firmware_main (void)
+{
+    SystemInit();
+    sim_entry();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ڷоƬһι̼
+// ˵     entry           ̼ ൱ main
+// ز     int             0-
+// ʹʾ     sim_init(); sim_run(app_main);
+// עϢ     ȵ SystemInit ʱ ٵ entry
+//              ̼ 4GB µĶջ ڼ¼жɷ
+//-------------------------------------------------------------------------------------------------------------------
+int sim_run (void (*entry)(void))
+{
+    struct itimerval timer;
+
+    if(!sim_ready)
+    {
+        sim_init();
+    }
+    if(NULL == sim_stack)
+    {
+        sim_stack = mmap(NULL, SIM_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT | MAP_STACK, -1, 0);
+        if(MAP_FAILED == sim_stack)
+        {
+            sim_fatal("cannot allocate firmware stack below 4GB");
+        }
+    }
+
+    sim_entry = entry;
+    getcontext(&sim_firmware_context);
+    sim_firmware_context.uc_stack.ss_sp = sim_stack;
+    sim_firmware_context.uc_stack.ss_size = SIM_STACK_SIZE;
+    sim_firmware_context.uc_link = &sim_host_context;
+    makecontext(&sim_firmware_context, sim_firmware_main, 0);
+
+    memset(&timer, 0, sizeof(timer));
+    timer.it_interval.tv_usec = SIM_IDLE_US;
+    timer.it_value.tv_usec = SIM_IDLE_US;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    swapcontext(&sim_host_context, &sim_firmware_context);
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_REAL, &timer, NULL);
+    return 0;
+}
+
+uint64_t sim_cycles (void)
+{
+    return sim_now;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һ CPU ʱ
+// ˵     cycles          HCLK 
+// ز     void
+// ʹʾ     sim_cycles_charge(200);                                     // ݴʱ
+// עϢ     ͳִָʱ ҪʱɲԳй
+//-------------------------------------------------------------------------------------------------------------------
+void sim_cycles_charge (uint32 cycles)
+{
+    sim_busy ++;
+    sim_now += cycles;
+    sim_sync();
+    sim_busy --;
+}
+
+void sim_stat_get (sim_stat_struct *stat)
+{
+    sim_busy ++;
+    *stat = sim_stat;
+    stat->cycles = sim_now;
+    sim_busy --;
+}
+
+void sim_stat_reset (void)
+{
+    sim_busy ++;
+    memset(&sim_stat, 0, sizeof(sim_stat));
+    sim_busy --;
+}
+
+void sim_set_timeout (uint64_t cycles)
+{
+    sim_busy ++;
+    sim_timeout = sim_now + cycles;
+    sim_busy --;
+}
+
+// ӿ޸ģ״̬ڼֹעж ֹ̼жϴӿͬʱĶͬһ״̬
+void sim_lock (void)
+{
+    sim_busy ++;
+}
+
+void sim_unlock (void)
+{
+    sim_busy --;
+}
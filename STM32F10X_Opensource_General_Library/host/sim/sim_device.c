@@ -0,0 +1,453 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// SPI 豸ģ
+//   W25Q64        ID/״̬/ дʹ ҳ //Ƭ ֲʱ BUSY
+//   LCD    ST7789/ST7735 ͨӼ 0x2A/0x2B ô 0x2C д RGB565  DC ͵ƽΪ
+//
+// I2C 豸ģ
+//   Ĵ IMU ȴͨ дĵһֽΪĴַ ֮дַԶ
+
+#include <string.h>
+#include "sim_internal.h"
+
+#define SIM_MS(ms)                  ((uint64_t)(ms) * (SIM_HCLK_HZ / 1000))
+#define SIM_W25Q64_SIZE             (8 * 1024 * 1024)
+#define SIM_W25Q64_PROGRAM_CYCLES   (SIM_MS(4) / 10)                            // tPP 0.4ms
+#define SIM_W25Q64_SE_CYCLES        (SIM_MS(45))
+#define SIM_W25Q64_BE32_CYCLES      (SIM_MS(120))
+#define SIM_W25Q64_BE64_CYCLES      (SIM_MS(150))
+#define SIM_W25Q64_CE_CYCLES        (SIM_MS(20000))
+
+//====================================================W25Q64====================================================
+static void sim_w25q64_update (sim_w25q64_struct *flash, uint64_t cycles)
+{
+    if((flash->status & 0x01) && cycles >= flash->busy_end)
+    {
+        flash->status &= ~0x03;                                                 // ɺ BUSY  WEL
+    }
+}
+
+static void sim_w25q64_busy (sim_w25q64_struct *flash, uint64_t cycles, uint64_t duration)
+{
+    flash->status |= 0x01;
+    flash->busy_end = cycles + duration;
+}
+
+// Ƭѡʱִв ҳ̵Ŀʼ
+static void sim_w25q64_finish (sim_w25q64_struct *flash, uint64_t cycles)
+{
+    uint32 size = 0;
+    uint64_t duration = 0;
+
+    if(!(flash->status & 0x02) || (flash->status & 0x01))
+    {
+        return;
+    }
+    switch(flash->command)
+    {
+        case 0x02:
+        {
+            if(flash->index > 4)
+            {
+                flash->program_count ++;
+                sim_w25q64_busy(flash, cycles, SIM_W25Q64_PROGRAM_CYCLES);
+            }
+            return;
+        }
+        case 0x20:  size = 4 * 1024;            duration = SIM_W25Q64_SE_CYCLES;    break;
+        case 0x52:  size = 32 * 1024;           duration = SIM_W25Q64_BE32_CYCLES;  break;
+        case 0xD8:  size = 64 * 1024;           duration = SIM_W25Q64_BE64_CYCLES;  break;
+        case 0x60:
+        case 0xC7:  size = SIM_W25Q64_SIZE;     duration = SIM_W25Q64_CE_CYCLES;    break;
+        default:    return;
+    }
+    if(SIM_W25Q64_SIZE != size && 4 != flash->index)
+    {
+        return;                                                                 // ַ ָЧ
+    }
+    memset(&flash->memory[(flash->address & (SIM_W25Q64_SIZE - 1)) & ~(size - 1)], 0xFF, size);
+    flash->erase_count ++;
+    sim_w25q64_busy(flash, cycles, duration);
+}
+
+static void sim_w25q64_select (void *context, uint8 selected, uint64_t cycles)
+{
+    sim_w25q64_struct *flash = (sim_w25q64_struct *)context;
+
+    sim_w25q64_update(flash, cycles);
+    if(!selected)
+    {
+        if(flash->index)
+        {
+            sim_w25q64_finish(flash, cycles);
+        }
+    }
+    flash->command = 0;
+    flash->index = 0;
+    flash->address = 0;
+}
+
+static uint8 sim_w25q64_transfer (void *context, uint8 mosi, uint64_t cycles)
+{
+    sim_w25q64_struct *flash = (sim_w25q64_struct *)context;
+    uint32 index = flash->index ++;
+    uint8 miso = 0xFF;
+
+    sim_w25q64_update(flash, cycles);
+    if(0 == index)
+    {
+        flash->command = mosi;
+        if(flash->status & 0x01)
+        {
+            if(0x05 != mosi)
+            {
+                flash->command = 0;                                             // æʱֻӦ״̬
+            }
+            return 0xFF;
+        }
+        if(0x06 == mosi)        flash->status |= 0x02;
+        else if(0x04 == mosi)   flash->status &= ~0x02;
+        return 0xFF;
+    }
+
+    switch(flash->command)
+    {
+        case 0x05:
+        {
+            miso = flash->status;
+            if(flash->status & 0x01)
+            {
+                sim_poll_hint(flash, flash->busy_end);                          // ̼ѯ BUSY
+            }
+        }break;
+        case 0x9F:
+        {
+            static const uint8 id[3] = {0xEF, 0x40, 0x17};
+            miso = (index <= 3) ? id[index - 1] : 0xFF;
+        }break;
+        case 0x90:
+        {
+            miso = (index < 4) ? 0xFF : ((index & 1) ? 0x16 : 0xEF);
+        }break;
+        case 0xAB:
+        {
+            miso = (index < 4) ? 0xFF : 0x16;
+        }break;
+        case 0x03:
+        case 0x0B:
+        {
+            uint32 data_start = (0x0B == flash->command) ? 5 : 4;
+            if(index < 4)
+            {
+                flash->address = (flash->address << 8) | mosi;
+            }
+            else if(index >= data_start)
+            {
+                miso = flash->memory[flash->address & (SIM_W25Q64_SIZE - 1)];
+                flash->address ++;
+            }
+        }break;
+        case 0x02:
+        {
+            if(index < 4)
+            {
+                flash->address = (flash->address << 8) | mosi;
+            }
+            else if(flash->status & 0x02)
+            {
+                uint32 page = flash->address & (SIM_W25Q64_SIZE - 1) & ~0xFFU;
+                uint32 offset = (flash->address + index - 4) & 0xFF;            // ҳβصҳ
+                flash->memory[page + offset] &= mosi;
+            }
+        }break;
+        case 0x20:
+        case 0x52:
+        case 0xD8:
+        {
+            if(index < 4)
+            {
+                flash->address = (flash->address << 8) | mosi;
+            }
+        }break;
+        default:
+        {
+        }break;
+    }
+    return miso;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʼ W25Q64 ģ 洢Ϊȫ 0xFF
+// ˵     *flash          ģͶ 8MB ϴ 鶨Ϊȫֱ
+// ز     void
+// ʹʾ     sim_w25q64_init(&flash); sim_spi_attach(SPI1, GPIOA, GPIO_Pin_4, &flash.slave);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_w25q64_init (sim_w25q64_struct *flash)
+{
+    memset(flash->memory, 0xFF, sizeof(flash->memory));
+    flash->status = 0;
+    flash->busy_end = 0;
+    flash->command = 0;
+    flash->index = 0;
+    flash->address = 0;
+    flash->program_count = 0;
+    flash->erase_count = 0;
+    flash->slave.select = sim_w25q64_select;
+    flash->slave.transfer = sim_w25q64_transfer;
+    flash->slave.context = flash;
+}
+
+//====================================================LCD====================================================
+static void sim_lcd_select (void *context, uint8 selected, uint64_t cycles)
+{
+    sim_lcd_struct *lcd = (sim_lcd_struct *)context;
+    (void)cycles;
+    if(selected)
+    {
+        lcd->pixel_high = 0;                                                    // ƬѡЧʱظֽڿʼ
+    }
+}
+
+static uint8 sim_lcd_transfer (void *context, uint8 mosi, uint64_t cycles)
+{
+    sim_lcd_struct *lcd = (sim_lcd_struct *)context;
+    uint32 index;
+    (void)cycles;
+
+    if(!sim_gpio_get(lcd->dc_port, lcd->dc_pin))
+    {
+        lcd->command = mosi;
+        lcd->index = 0;
+        lcd->pixel_high = 0;
+        lcd->command_count ++;
+        if(0x2C == mosi)
+        {
+            lcd->x = lcd->x_start;
+            lcd->y = lcd->y_start;
+        }
+        return 0xFF;
+    }
+
+    index = lcd->index ++;
+    switch(lcd->command)
+    {
+        case 0x2A:
+        case 0x2B:
+        {
+            uint16 *start = (0x2A == lcd->command) ? &lcd->x_start : &lcd->y_start;
+            uint16 *end = (0x2A == lcd->command) ? &lcd->x_end : &lcd->y_end;
+            switch(index)
+            {
+                case 0: *start = (uint16)((*start & 0x00FF) | (mosi << 8));     break;
+                case 1: *start = (uint16)((*start & 0xFF00) | mosi);            break;
+                case 2: *end   = (uint16)((*end & 0x00FF) | (mosi << 8));       break;
+                case 3: *end   = (uint16)((*end & 0xFF00) | mosi);              break;
+                default:                                                        break;
+            }
+        }break;
+        case 0x2C:
+        {
+            if(!lcd->pixel_high)
+            {
+                lcd->pixel_byte = mosi;
+                lcd->pixel_high = 1;
+                break;
+            }
+            lcd->pixel_high = 0;
+            if(lcd->x < lcd->width && lcd->y < lcd->height)
+            {
+                lcd->framebuffer[lcd->y * lcd->width + lcd->x] = (uint16_t)((lcd->pixel_byte << 8) | mosi);
+            }
+            lcd->pixel_count ++;
+            if(++ lcd->x > lcd->x_end)
+            {
+                lcd->x = lcd->x_start;
+                if(++ lcd->y > lcd->y_end)
+                {
+                    lcd->y = lcd->y_start;
+                }
+            }
+        }break;
+        default:
+        {
+        }break;
+    }
+    return 0xFF;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʼ LCD ģ
+// ˵     *lcd            ģͶ framebuffer ɵṩ width * height  uint16
+// ˵     width           Ļ
+// ˵     height          Ļ߶
+// ˵     *dc_port        DC Ŷ˿
+// ˵     dc_pin          DC  GPIO_Pin_x
+// ز     void
+// ʹʾ     sim_lcd_init(&lcd, 240, 320, GPIOB, GPIO_Pin_0); sim_spi_attach(SPI2, GPIOB, GPIO_Pin_12, &lcd.slave);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_lcd_init (sim_lcd_struct *lcd, uint16 width, uint16 height, GPIO_TypeDef *dc_port, uint16 dc_pin)
+{
+    uint16_t *framebuffer = lcd->framebuffer;
+
+    memset(lcd, 0, sizeof(*lcd));
+    lcd->framebuffer = framebuffer;
+    lcd->width = width;
+    lcd->height = height;
+    lcd->dc_port = dc_port;
+    lcd->dc_pin = dc_pin;
+    lcd->x_end = width - 1;
+    lcd->y_end = height - 1;
+    if(NULL != framebuffer)
+    {
+        memset(framebuffer, 0, (size_t)width * height * sizeof(uint16_t));
+    }
+    lcd->slave.select = sim_lcd_select;
+    lcd->slave.transfer = sim_lcd_transfer;
+    lcd->slave.context = lcd;
+}
+
+//====================================================OLED====================================================
+// SSD1306 ҳѰַģʽ ֻҳַеַ Ĳֽ
+static uint8 sim_oled_transfer (void *context, uint8 mosi, uint64_t cycles)
+{
+    sim_oled_struct *oled = (sim_oled_struct *)context;
+    (void)cycles;
+
+    if(!sim_gpio_get(oled->dc_port, oled->dc_pin))
+    {
+        oled->command_count ++;
+        if(oled->parameter)
+        {
+            oled->parameter --;
+        }
+        else if(0xB0 == (mosi & 0xF8))
+        {
+            oled->page = mosi & 0x07;
+        }
+        else if(0x10 > mosi)
+        {
+            oled->column = (uint8)((oled->column & 0xF0) | mosi);
+        }
+        else if(0x20 > mosi)
+        {
+            oled->column = (uint8)((oled->column & 0x0F) | ((mosi & 0x0F) << 4));
+        }
+        else if(0x20 == mosi || 0x81 == mosi || 0x8D == mosi || 0xA8 == mosi ||
+                0xD3 == mosi || 0xD5 == mosi || 0xD9 == mosi || 0xDA == mosi || 0xDB == mosi)
+        {
+            oled->parameter = 1;
+        }
+        return 0xFF;
+    }
+
+    oled->gram[oled->page][oled->column & 0x7F] = mosi;
+    oled->column = (oled->column + 1) & 0x7F;                                   // ҳѰַģʽеַĩβص 0 ҳ
+    oled->data_count ++;
+    return 0xFF;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʼ OLED ģ
+// ˵     *oled           ģͶ
+// ˵     *dc_port        DC Ŷ˿
+// ˵     dc_pin          DC  GPIO_Pin_x
+// ز     void
+// ʹʾ     sim_oled_init(&oled, GPIOA, GPIO_Pin_1); sim_spi_attach(SPI2, GPIOB, GPIO_Pin_12, &oled.slave);
+// עϢ     Դֵ 0x5A ϵʱ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_oled_init (sim_oled_struct *oled, GPIO_TypeDef *dc_port, uint16 dc_pin)
+{
+    memset(oled, 0, sizeof(*oled));
+    memset(oled->gram, 0x5A, sizeof(oled->gram));
+    oled->dc_port = dc_port;
+    oled->dc_pin = dc_pin;
+    oled->slave.transfer = sim_oled_transfer;
+    oled->slave.context = oled;
+}
+
+//====================================================I2C Ĵ====================================================
+static uint8 sim_i2c_register_start (void *context, uint8 read, uint64_t cycles)
+{
+    sim_i2c_register_struct *device = (sim_i2c_register_struct *)context;
+    (void)cycles;
+
+    if(device->nack_address)
+    {
+        return 0;
+    }
+    if(!read)
+    {
+        device->pointer_set = 0;
+    }
+    return 1;
+}
+
+static uint8 sim_i2c_register_write (void *context, uint8 data, uint64_t cycles)
+{
+    sim_i2c_register_struct *device = (sim_i2c_register_struct *)context;
+    (void)cycles;
+
+    if(!device->pointer_set)
+    {
+        device->pointer = data;
+        device->pointer_set = 1;
+    }
+    else
+    {
+        device->memory[device->pointer ++] = data;
+        device->write_count ++;
+    }
+    return 1;
+}
+
+static uint8 sim_i2c_register_read (void *context, uint64_t cycles)
+{
+    sim_i2c_register_struct *device = (sim_i2c_register_struct *)context;
+    (void)cycles;
+
+    device->read_count ++;
+    return device->memory[device->pointer ++];
+}
+
+static void sim_i2c_register_stop (void *context, uint64_t cycles)
+{
+    sim_i2c_register_struct *device = (sim_i2c_register_struct *)context;
+    (void)cycles;
+
+    device->pointer_set = 0;
+    device->transaction_count ++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ʼĴ I2C 豸ģ ĴȫΪ 0
+// ˵     *device         ģͶ
+// ˵     address         λӻַ
+// ز     void
+// ʹʾ     sim_i2c_register_init(&imu, 0x68); sim_i2c_attach(I2C1, &imu.slave);
+// עϢ     Ĵֵڹҽǰֱд memory
+//-------------------------------------------------------------------------------------------------------------------
+void sim_i2c_register_init (sim_i2c_register_struct *device, uint8 address)
+{
+    memset(device, 0, sizeof(*device));
+    device->slave.address = address;
+    device->slave.start = sim_i2c_register_start;
+    device->slave.write = sim_i2c_register_write;
+    device->slave.read = sim_i2c_register_read;
+    device->slave.stop = sim_i2c_register_stop;
+    device->slave.context = device;
+}
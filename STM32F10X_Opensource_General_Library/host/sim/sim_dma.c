@@ -0,0 +1,268 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// DMA1 Ϊģ
+// EN λʱ CNDTR/CPAR/CMAR ֮Ĵֻ
+// Ч ߿ʱΰ ÿΰ CNDTR  1 һ HT  TC ѭģʽԶװ
+// ӳ䣨F103 
+//   CH2 SPI1_RX USART3_TX   CH3 SPI1_TX USART3_RX   CH4 SPI2_RX USART1_TX
+//   CH5 SPI2_TX USART1_RX   CH6 USART2_RX           CH7 USART2_TX
+
+#include "sim_internal.h"
+
+#define SIM_DMA_CHANNEL_COUNT       (7)
+#define SIM_DMA_CCR(n)              (DMA1_BASE + 0x08 + 20 * ((n) - 1))
+
+typedef struct
+{
+    uint8       active;
+    uint32      count;                                                          // EN λʱ CNDTR
+    uint32      remaining;
+    uint32      peripheral_addr;
+    uint32      memory_addr;
+    uint32      peripheral_now;
+    uint32      memory_now;
+    uint64_t    pending_since;                                                  // Чʼʱ
+}sim_dma_channel_struct;
+
+static sim_dma_channel_struct sim_dma_channel[SIM_DMA_CHANNEL_COUNT + 1];
+static uint64_t sim_dma_bus_free = 0;
+
+static uint8 sim_dma_request (uint8 n)
+{
+    uint32 ccr = SIM_REG(SIM_DMA_CCR(n));
+    if(ccr & DMA_CCR1_MEM2MEM)
+    {
+        return 1;
+    }
+    return sim_spi_dma_request(n) || sim_uart_dma_request(n) || sim_i2c_dma_request(n);
+}
+
+static void sim_dma_flag (uint8 n, uint32 flag)
+{
+    SIM_REG(DMA1_BASE + 0x00) |= (flag | 0x1) << ((n - 1) * 4);                 // ͬʱ GIF
+}
+
+static uint8 sim_dma_size (uint32 ccr, uint8 memory)
+{
+    uint32 size = memory ? ((ccr >> 10) & 0x3) : ((ccr >> 8) & 0x3);
+    return (uint8)(1U << (size > 2 ? 2 : size));
+}
+
+// ͨһΰ˵ʱ Чʱ SIM_NEVER
+static uint64_t sim_dma_channel_next (uint8 n)
+{
+    sim_dma_channel_struct *channel = &sim_dma_channel[n];
+    uint64_t start;
+
+    if(!channel->active || 0 == channel->remaining || !sim_dma_request(n))
+    {
+        channel->pending_since = SIM_NEVER;
+        return SIM_NEVER;
+    }
+    if(SIM_NEVER == channel->pending_since)
+    {
+        channel->pending_since = sim_cur;
+    }
+    start = channel->pending_since > sim_dma_bus_free ? channel->pending_since : sim_dma_bus_free;
+    return start + SIM_CYCLES_DMA + sim_bus_cycles(channel->peripheral_now) + sim_bus_cycles(channel->memory_now);
+}
+
+static void sim_dma_transfer (uint8 n, uint64_t t)
+{
+    sim_dma_channel_struct *channel = &sim_dma_channel[n];
+    uint32 ccr = SIM_REG(SIM_DMA_CCR(n));
+    uint8 peripheral_size = sim_dma_size(ccr, 0);
+    uint8 memory_size = sim_dma_size(ccr, 1);
+    uint8 error = 0;
+    uint32 value;
+
+    sim_cur = t;
+    if(ccr & DMA_CCR1_DIR)
+    {
+        value = sim_bus_read(channel->memory_now, memory_size, &error);
+        if(!error)
+        {
+            sim_bus_write(channel->peripheral_now, value, peripheral_size, &error);
+        }
+    }
+    else
+    {
+        value = sim_bus_read(channel->peripheral_now, peripheral_size, &error);
+        if(!error)
+        {
+            sim_bus_write(channel->memory_now, value, memory_size, &error);
+        }
+    }
+    sim_dma_bus_free = t;
+    channel->pending_since = SIM_NEVER;
+    sim_stat.dma_transfer ++;
+
+    if(error)
+    {
+        channel->active = 0;
+        SIM_REG(SIM_DMA_CCR(n)) &= ~DMA_CCR1_EN;                                // ʱӲ EN
+        sim_dma_flag(n, 0x8);
+        return;
+    }
+
+    if(ccr & DMA_CCR1_PINC)     channel->peripheral_now += peripheral_size;
+    if(ccr & DMA_CCR1_MINC)     channel->memory_now += memory_size;
+    channel->remaining --;
+
+    if(channel->count - channel->remaining == channel->count / 2)
+    {
+        sim_dma_flag(n, 0x4);
+    }
+    if(0 == channel->remaining)
+    {
+        sim_dma_flag(n, 0x2);
+        if(ccr & DMA_CCR1_CIRC)
+        {
+            channel->remaining = channel->count;
+            channel->peripheral_now = channel->peripheral_addr;
+            channel->memory_now = channel->memory_addr;
+        }
+    }
+    SIM_REG(SIM_DMA_CCR(n) + 0x04) = channel->remaining;
+}
+
+void sim_dma_reset (void)
+{
+    for(uint8 n = 1; n <= SIM_DMA_CHANNEL_COUNT; n ++)
+    {
+        sim_dma_channel[n].active = 0;
+        sim_dma_channel[n].remaining = 0;
+        sim_dma_channel[n].pending_since = SIM_NEVER;
+    }
+    sim_dma_bus_free = 0;
+}
+
+uint64_t sim_dma_next (void)
+{
+    uint64_t next = SIM_NEVER;
+    for(uint8 n = 1; n <= SIM_DMA_CHANNEL_COUNT; n ++)
+    {
+        uint64_t t = sim_dma_channel_next(n);
+        if(t < next)
+        {
+            next = t;
+        }
+    }
+    return next;
+}
+
+void sim_dma_fire (uint64_t t)
+{
+    uint8 best = 0;
+    uint8 best_priority = 0;
+
+    // ͬһʱ̶ͨʱ ȱȽ PL ٱȽͨ
+    for(uint8 n = 1; n <= SIM_DMA_CHANNEL_COUNT; n ++)
+    {
+        if(sim_dma_channel_next(n) <= t)
+        {
+            uint8 priority = (uint8)((SIM_REG(SIM_DMA_CCR(n)) >> 12) & 0x3);
+            if(0 == best || priority > best_priority)
+            {
+                best = n;
+                best_priority = priority;
+            }
+        }
+    }
+    if(best)
+    {
+        sim_dma_transfer(best, t);
+    }
+}
+
+void sim_dma_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    uint32 offset = addr - DMA1_BASE;
+    uint8 n;
+    uint32 reg;
+
+    if(0x00 == offset)
+    {
+        SIM_REG(addr) = old_value;                                              // ISR ֻ
+        return;
+    }
+    if(0x04 == offset)
+    {
+        uint32 clear = 0;
+        for(uint8 i = 0; i < SIM_DMA_CHANNEL_COUNT; i ++)
+        {
+            uint32 bits = (value >> (i * 4)) & 0xF;
+            if(bits & 0x1)
+            {
+                bits = 0xF;                                                     //  GIF ͬʱͨȫ־
+            }
+            clear |= bits << (i * 4);
+        }
+        SIM_REG(DMA1_BASE + 0x00) &= ~clear;
+        SIM_REG(addr) = 0;
+        return;
+    }
+    if(offset < 0x08 || offset >= 0x08 + 20 * SIM_DMA_CHANNEL_COUNT)
+    {
+        return;
+    }
+    n = (uint8)((offset - 0x08) / 20 + 1);
+    reg = (offset - 0x08) % 20;
+
+    if(0 == reg)
+    {
+        sim_dma_channel_struct *channel = &sim_dma_channel[n];
+        if((value & DMA_CCR1_EN) && !(old_value & DMA_CCR1_EN))
+        {
+            channel->count = SIM_REG(addr + 0x04) & 0xFFFF;
+            channel->remaining = channel->count;
+            channel->peripheral_addr = SIM_REG(addr + 0x08);
+            channel->memory_addr = SIM_REG(addr + 0x0C);
+            channel->peripheral_now = channel->peripheral_addr;
+            channel->memory_now = channel->memory_addr;
+            channel->pending_since = SIM_NEVER;
+            channel->active = 1;
+        }
+        else if(!(value & DMA_CCR1_EN))
+        {
+            channel->active = 0;
+        }
+        SIM_REG(addr) = value & 0x7FFF;
+    }
+    else if(SIM_REG(SIM_DMA_CCR(n)) & DMA_CCR1_EN)
+    {
+        SIM_REG(addr) = old_value;                                              // ͨʹڼ CNDTR/CPAR/CMAR д
+    }
+    else if(0x04 == reg)
+    {
+        SIM_REG(addr) = value & 0xFFFF;
+    }
+}
+
+void sim_dma_irq (void)
+{
+    uint32 isr = SIM_REG(DMA1_BASE + 0x00);
+    for(uint8 n = 1; n <= SIM_DMA_CHANNEL_COUNT; n ++)
+    {
+        uint32 ccr = SIM_REG(SIM_DMA_CCR(n));
+        uint32 flag = (isr >> ((n - 1) * 4)) & 0xF;
+        uint8 level =
+            ((ccr & DMA_CCR1_TCIE) && (flag & 0x2)) ||
+            ((ccr & DMA_CCR1_HTIE) && (flag & 0x4)) ||
+            ((ccr & DMA_CCR1_TEIE) && (flag & 0x8));
+        sim_irq_line(DMA1_Channel1_IRQn + n - 1, level);
+    }
+}
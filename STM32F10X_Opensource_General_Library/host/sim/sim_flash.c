@@ -0,0 +1,245 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// ڲ FLASH ӿΪģ
+// KEY1/KEY2  λ ʱ CR д
+// ֱ 52.5us ҳ 20ms Ƭ 40msֲֵ ڼ BSY=1  EOP
+// 32 λд߲ ڶҪȵһ̽ CPU ڴڼͣ
+
+#include <stdio.h>
+#include <string.h>
+#include "sim_internal.h"
+
+#define SIM_FLASH_PROGRAM_CYCLES    (3780)                                      // 52.5us
+#define SIM_FLASH_PAGE_ERASE_CYCLES (1440000)                                   // 20ms
+#define SIM_FLASH_MASS_ERASE_CYCLES (2880000)                                   // 40ms
+#define SIM_FLASH_PAGE_SIZE         (1024)
+
+typedef enum
+{
+    SIM_FLASH_IDLE,
+    SIM_FLASH_PROGRAM,
+    SIM_FLASH_PAGE_ERASE,
+    SIM_FLASH_MASS_ERASE,
+}sim_flash_operation_enum;
+
+static sim_flash_operation_enum sim_flash_operation = SIM_FLASH_IDLE;
+static uint64_t sim_flash_done      = SIM_NEVER;
+static uint32   sim_flash_address   = 0;                                        // ַ
+static uint8    sim_flash_key_state = 0;                                        // 0-ȴ KEY1 1-ȴ KEY2 2-
+static uint8    sim_flash_warned    = 0;
+
+#define SIM_FLASH_SR                (SIM_REG(FLASH_R_BASE + 0x0C))
+#define SIM_FLASH_CR                (SIM_REG(FLASH_R_BASE + 0x10))
+
+static uint8 *sim_flash_memory (void)
+{
+    return (uint8 *)sim_reg(FLASH_BASE);
+}
+
+void sim_flash_reset (void)
+{
+    sim_flash_operation = SIM_FLASH_IDLE;
+    sim_flash_done = SIM_NEVER;
+    sim_flash_address = 0;
+    sim_flash_key_state = 0;
+    sim_flash_warned = 0;
+    SIM_REG(FLASH_R_BASE + 0x00) = 0x00000030;
+    SIM_FLASH_CR = FLASH_CR_LOCK;
+    SIM_REG(FLASH_R_BASE + 0x1C) = 0x03FFFFFC;
+    SIM_REG(FLASH_R_BASE + 0x20) = 0xFFFFFFFF;
+}
+
+uint64_t sim_flash_next (void)
+{
+    return sim_flash_done;
+}
+
+void sim_flash_fire (uint64_t t)
+{
+    (void)t;
+    if(SIM_FLASH_PAGE_ERASE == sim_flash_operation)
+    {
+        uint32 offset = (sim_flash_address - FLASH_BASE) & ~(SIM_FLASH_PAGE_SIZE - 1);
+        memset(sim_flash_memory() + offset, 0xFF, SIM_FLASH_PAGE_SIZE);
+    }
+    else if(SIM_FLASH_MASS_ERASE == sim_flash_operation)
+    {
+        memset(sim_flash_memory(), 0xFF, SIM_FLASH_SIZE);
+    }
+    if(SIM_FLASH_IDLE != sim_flash_operation)
+    {
+        SIM_FLASH_SR = (SIM_FLASH_SR & ~FLASH_SR_BSY) | FLASH_SR_EOP;
+    }
+    SIM_FLASH_CR &= ~FLASH_CR_STRT;
+    sim_flash_operation = SIM_FLASH_IDLE;
+    sim_flash_done = SIM_NEVER;
+}
+
+static void sim_flash_start (sim_flash_operation_enum operation, uint64_t t, uint32 cycles)
+{
+    sim_flash_operation = operation;
+    sim_flash_done = t + cycles;
+    SIM_FLASH_SR |= FLASH_SR_BSY;
+}
+
+void sim_flash_read (uint32 addr)
+{
+    (void)addr;
+}
+
+void sim_flash_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    uint32 offset = addr - FLASH_R_BASE;
+
+    switch(offset)
+    {
+        case 0x04:
+        {
+            if(0 == sim_flash_key_state && FLASH_KEY1 == value)
+            {
+                sim_flash_key_state = 1;
+            }
+            else if(1 == sim_flash_key_state && FLASH_KEY2 == value)
+            {
+                sim_flash_key_state = 0;
+                SIM_FLASH_CR &= ~FLASH_CR_LOCK;
+            }
+            else
+            {
+                sim_flash_key_state = 2;                                        //  ֱλ޷
+                SIM_FLASH_CR |= FLASH_CR_LOCK;
+            }
+            SIM_REG(addr) = 0;
+        }break;
+        case 0x08:
+        {
+            SIM_REG(addr) = 0;
+        }break;
+        case 0x0C:
+        {
+            uint32 clear = value & (FLASH_SR_PGERR | FLASH_SR_WRPRTERR | FLASH_SR_EOP);
+            SIM_REG(addr) = old_value & ~clear;
+        }break;
+        case 0x10:
+        {
+            if(old_value & FLASH_CR_LOCK)
+            {
+                SIM_REG(addr) = old_value | (value & FLASH_CR_LOCK);
+                break;
+            }
+            value |= old_value & FLASH_CR_STRT;                                 // STRT ֻӲ
+            SIM_REG(addr) = value & 0x000016F7;
+            if((value & FLASH_CR_STRT) && !(old_value & FLASH_CR_STRT) && SIM_FLASH_IDLE == sim_flash_operation)
+            {
+                if(value & FLASH_CR_MER)
+                {
+                    sim_flash_start(SIM_FLASH_MASS_ERASE, sim_cur, SIM_FLASH_MASS_ERASE_CYCLES);
+                }
+                else if(value & FLASH_CR_PER)
+                {
+                    sim_flash_address = SIM_REG(FLASH_R_BASE + 0x14);
+                    sim_flash_start(SIM_FLASH_PAGE_ERASE, sim_cur, SIM_FLASH_PAGE_ERASE_CYCLES);
+                }
+                else
+                {
+                    SIM_REG(addr) &= ~FLASH_CR_STRT;
+                }
+            }
+        }break;
+        case 0x14:
+        {
+            if(SIM_FLASH_SR & FLASH_SR_BSY)
+            {
+                SIM_REG(addr) = old_value;
+            }
+        }break;
+        case 0x00:
+        {
+            SIM_REG(addr) = value & 0x3F;
+        }break;
+        default:
+        {
+            SIM_REG(addr) = old_value;                                          // OBR WRPR ֻ
+        }break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      CPU  FLASH 洢д
+// ˵     addr            ֵַ
+// ˵     old_value       дǰ
+// ˵     value           д
+// ˵     written_mask    д漰ֽ
+// ز     void
+// עϢ     ÿֵ ֻܰ 1  0 ԭֵ 0xFFFF дֵΪ 0 ʱ PGERR 
+//-------------------------------------------------------------------------------------------------------------------
+void sim_flash_memory_write (uint32 addr, uint32 old_value, uint32 value, uint32 written_mask)
+{
+    uint32 result = old_value;
+    uint64_t t = sim_now;
+
+    SIM_REG(addr) = old_value;
+    if((SIM_FLASH_CR & (FLASH_CR_LOCK | FLASH_CR_PG)) != FLASH_CR_PG)
+    {
+        if(!sim_flash_warned)
+        {
+            sim_flash_warned = 1;
+            fprintf(stderr, "sim: flash write 0x%08X ignored, controller locked or PG not set\n", addr);
+        }
+        return;
+    }
+
+    for(uint32 half = 0; half < 2; half ++)
+    {
+        uint32 shift = half * 16;
+        uint16_t before = (uint16_t)(old_value >> shift);
+        uint16_t data = (uint16_t)(value >> shift);
+
+        if(!(written_mask & (0xFFFFU << shift)))
+        {
+            continue;
+        }
+        if(SIM_FLASH_IDLE != sim_flash_operation)
+        {
+            t = sim_flash_done;                                                 // ֱͣһα̽
+            sim_cur = t;
+            sim_flash_fire(t);
+        }
+        if(0xFFFF != before && 0 != data)
+        {
+            SIM_FLASH_SR |= FLASH_SR_PGERR;
+            continue;
+        }
+        result = (result & ~(0xFFFFU << shift)) | ((uint32)(before & data) << shift);
+        sim_flash_start(SIM_FLASH_PROGRAM, t, SIM_FLASH_PROGRAM_CYCLES);
+    }
+    SIM_REG(addr) = result;
+    if(t > sim_now)
+    {
+        sim_stat.wait_cycles += t - sim_now;
+        sim_now = t;
+    }
+}
+
+void sim_flash_irq (void)
+{
+    uint32 sr = SIM_FLASH_SR;
+    uint32 cr = SIM_FLASH_CR;
+    uint8 level =
+        ((cr & FLASH_CR_EOPIE) && (sr & FLASH_SR_EOP)) ||
+        ((cr & FLASH_CR_ERRIE) && (sr & (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)));
+    sim_irq_line(FLASH_IRQn, level);
+}
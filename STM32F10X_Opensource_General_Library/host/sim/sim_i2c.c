@@ -0,0 +1,874 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// I2C Ϊģ
+// START/STOP ռһ SCL  ַֽڸռ 9  SCL  SCL ڰ CCR  F/SDUTY 
+//  DR λĴ λɶ DR Ϊʱ BTF  SCL ȴ
+//  DR δʱһֽͣλĴ BTF  ACK ֽ֮Զһ  NACK ֹͣ
+// ACK ֽڽʱȡֵ POS=1 ʱȡһֽڽʱ ACK λ DMAEN  LAST ͬʱλʱ DMA һֽڻ NACK
+// д STOP/START ڵǰֽڽִ ַӦӦ AF
+//  GPIO ƽĴӻģ  IIC ʹ ֧ʱչ SDA 
+
+#include <string.h>
+#include "sim_internal.h"
+
+#define SIM_I2C_SLAVE_MAX           (4)
+
+#define SIM_I2C_CR1                 (0x00)
+#define SIM_I2C_CR2                 (0x04)
+#define SIM_I2C_DR                  (0x10)
+#define SIM_I2C_SR1                 (0x14)
+#define SIM_I2C_SR2                 (0x18)
+#define SIM_I2C_CCR                 (0x1C)
+
+#define SIM_I2C_SR1_EVENT           (I2C_SR1_SB | I2C_SR1_ADDR | I2C_SR1_BTF | I2C_SR1_ADD10 | I2C_SR1_STOPF)
+#define SIM_I2C_SR1_ERROR           (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR | I2C_SR1_PECERR | I2C_SR1_TIMEOUT | I2C_SR1_SMBALERT)
+
+typedef enum
+{
+    SIM_I2C_IDLE,                                                               // ߿  SCL ȴ
+    SIM_I2C_START,                                                              // ڲ START
+    SIM_I2C_ADDRESS,                                                            // ڷ͵ַ
+    SIM_I2C_TX,                                                                 // ڷֽ
+    SIM_I2C_RX,                                                                 // ڽֽ
+    SIM_I2C_STOP,                                                               // ڲ STOP
+}sim_i2c_state_enum;
+
+typedef struct
+{
+    uint32      base;
+    int         ev_irq;
+    int         er_irq;
+    uint8       tx_dma_channel;
+    uint8       rx_dma_channel;
+
+    sim_i2c_state_enum state;
+    uint64_t    event_end;
+    uint8       address;                                                        // Ѱַĵַֽ дλ
+    uint8       sr1_read;                                                       // ADDR  Ѷ SR1
+    uint8       dr_full;                                                        //  DR дδƳ /  DR 
+    uint8       dr;
+    uint8       shift_full;                                                     // λĴֽ  BTF Ӧ
+    uint8       shift;
+    uint8       ack_latch;                                                      // POS=1 ʱһֽʹõ ACK
+    uint8       nacked;                                                         // ѻ NACK
+    uint8       stop_pending;                                                   // ֽڽ STOP
+    uint8       start_pending;                                                  // ֽڽ START
+    uint64_t    byte_count;
+    uint64_t    hold;                                                           // byte_count ﵽֵӻס SCL ֽڲٽ 0-ס SWRST ͷ
+
+    const sim_i2c_slave_struct *target;                                         // ӦַĴ豸
+    sim_i2c_slave_struct slave[SIM_I2C_SLAVE_MAX];
+    uint8       slave_count;
+}sim_i2c_struct;
+
+static sim_i2c_struct sim_i2c[2] =
+{
+    {I2C1_BASE, I2C1_EV_IRQn, I2C1_ER_IRQn, 6, 7},
+    {I2C2_BASE, I2C2_EV_IRQn, I2C2_ER_IRQn, 4, 5},
+};
+
+static sim_i2c_struct *sim_i2c_find (uint32 addr)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        if((addr & ~0x3FFU) == sim_i2c[i].base)
+        {
+            return &sim_i2c[i];
+        }
+    }
+    return NULL;
+}
+
+static void sim_i2c_sr1 (sim_i2c_struct *i2c, uint32 set, uint32 clear)
+{
+    SIM_REG(i2c->base + SIM_I2C_SR1) = (SIM_REG(i2c->base + SIM_I2C_SR1) & ~clear) | set;
+}
+
+static void sim_i2c_sr2 (sim_i2c_struct *i2c, uint32 set, uint32 clear)
+{
+    SIM_REG(i2c->base + SIM_I2C_SR2) = (SIM_REG(i2c->base + SIM_I2C_SR2) & ~clear) | set;
+}
+
+// SCL  HCLK  ׼ģʽ 2xCCR ģʽ DUTY=0 Ϊ 3xCCR DUTY=1 Ϊ 25xCCR
+static uint64_t sim_i2c_period (sim_i2c_struct *i2c)
+{
+    uint32 ccr = SIM_REG(i2c->base + SIM_I2C_CCR);
+    uint32 count = ccr & I2C_CCR_CCR;
+    uint32 multiple = (ccr & I2C_CCR_FS) ? ((ccr & I2C_CCR_DUTY) ? 25 : 3) : 2;
+
+    if(count < 4)
+    {
+        count = 4;
+    }
+    return (uint64_t)count * multiple * sim_apb_divider(1);
+}
+
+static void sim_i2c_begin (sim_i2c_struct *i2c, sim_i2c_state_enum state, uint64_t t)
+{
+    i2c->state = state;
+    i2c->event_end = t + sim_i2c_period(i2c) * ((SIM_I2C_START == state || SIM_I2C_STOP == state) ? 1 : 9);
+    if(i2c->hold && i2c->byte_count >= i2c->hold && SIM_I2C_START != state && SIM_I2C_STOP != state)
+    {
+        i2c->event_end = SIM_NEVER;
+    }
+}
+
+//  SCL ȴʱ ȼִй STOP/START
+static uint8 sim_i2c_pending (sim_i2c_struct *i2c, uint64_t t)
+{
+    if(i2c->stop_pending)
+    {
+        i2c->stop_pending = 0;
+        i2c->start_pending = 0;
+        sim_i2c_begin(i2c, SIM_I2C_STOP, t);
+        return 1;
+    }
+    if(i2c->start_pending)
+    {
+        i2c->start_pending = 0;
+        sim_i2c_begin(i2c, SIM_I2C_START, t);
+        return 1;
+    }
+    return 0;
+}
+
+static void sim_i2c_rx_done (sim_i2c_struct *i2c, uint64_t t)
+{
+    uint32 cr1 = SIM_REG(i2c->base + SIM_I2C_CR1);
+    uint32 cr2 = SIM_REG(i2c->base + SIM_I2C_CR2);
+    uint8 data = (NULL != i2c->target && NULL != i2c->target->read) ? i2c->target->read(i2c->target->context, t) : 0xFF;
+    uint8 ack;
+
+    if(cr1 & I2C_CR1_POS)
+    {
+        ack = i2c->ack_latch;
+    }
+    else
+    {
+        ack = (cr1 & I2C_CR1_ACK) ? 1 : 0;
+    }
+    i2c->ack_latch = (cr1 & I2C_CR1_ACK) ? 1 : 0;
+    if((cr2 & I2C_CR2_DMAEN) && (cr2 & I2C_CR2_LAST))
+    {
+        uint32 remaining = SIM_REG((uint32)(uintptr_t)DMA1_Channel1 + (i2c->rx_dma_channel - 1) * 0x14 + 0x04);
+        if(remaining == 1U + i2c->dr_full)
+        {
+            ack = 0;
+        }
+    }
+    i2c->nacked = !ack;
+    i2c->byte_count ++;
+
+    if(i2c->dr_full)
+    {
+        i2c->shift = data;
+        i2c->shift_full = 1;
+        sim_i2c_sr1(i2c, I2C_SR1_BTF, 0);
+    }
+    else
+    {
+        i2c->dr = data;
+        i2c->dr_full = 1;
+        SIM_REG(i2c->base + SIM_I2C_DR) = data;
+        sim_i2c_sr1(i2c, I2C_SR1_RXNE, 0);
+    }
+    i2c->state = SIM_I2C_IDLE;
+    i2c->event_end = SIM_NEVER;
+    if(!sim_i2c_pending(i2c, t) && ack && !i2c->shift_full)
+    {
+        sim_i2c_begin(i2c, SIM_I2C_RX, t);
+    }
+}
+
+static void sim_i2c_tx_done (sim_i2c_struct *i2c, uint64_t t)
+{
+    uint8 ack = (NULL != i2c->target && NULL != i2c->target->write) ? i2c->target->write(i2c->target->context, i2c->shift, t) : 0;
+
+    i2c->byte_count ++;
+    i2c->state = SIM_I2C_IDLE;
+    i2c->event_end = SIM_NEVER;
+    if(!ack)
+    {
+        sim_i2c_sr1(i2c, I2C_SR1_AF, 0);
+        sim_i2c_pending(i2c, t);
+        return;
+    }
+    if(sim_i2c_pending(i2c, t))
+    {
+        return;
+    }
+    if(i2c->dr_full)
+    {
+        i2c->shift = i2c->dr;
+        i2c->dr_full = 0;
+        sim_i2c_sr1(i2c, I2C_SR1_TXE, 0);
+        sim_i2c_begin(i2c, SIM_I2C_TX, t);
+    }
+    else
+    {
+        sim_i2c_sr1(i2c, I2C_SR1_BTF, 0);
+    }
+}
+
+static void sim_i2c_address_done (sim_i2c_struct *i2c, uint64_t t)
+{
+    uint8 read = i2c->address & 0x01;
+
+    i2c->target = NULL;
+    for(uint32 i = 0; i < i2c->slave_count; i ++)
+    {
+        if(i2c->slave[i].address == (i2c->address >> 1))
+        {
+            i2c->target = &i2c->slave[i];
+            break;
+        }
+    }
+    i2c->state = SIM_I2C_IDLE;
+    i2c->event_end = SIM_NEVER;
+    i2c->byte_count ++;
+    if(NULL == i2c->target || (NULL != i2c->target->start && !i2c->target->start(i2c->target->context, read, t)))
+    {
+        i2c->target = NULL;
+        sim_i2c_sr1(i2c, I2C_SR1_AF, 0);
+        sim_i2c_pending(i2c, t);
+        return;
+    }
+    i2c->ack_latch = (SIM_REG(i2c->base + SIM_I2C_CR1) & I2C_CR1_ACK) ? 1 : 0;
+    i2c->nacked = 0;
+    i2c->dr_full = 0;
+    i2c->shift_full = 0;
+    i2c->sr1_read = 0;
+    sim_i2c_sr1(i2c, I2C_SR1_ADDR, 0);
+    sim_i2c_sr2(i2c, read ? 0 : I2C_SR2_TRA, read ? I2C_SR2_TRA : 0);
+}
+
+static void sim_i2c_event_done (sim_i2c_struct *i2c, uint64_t t)
+{
+    switch(i2c->state)
+    {
+        case SIM_I2C_START:
+        {
+            i2c->state = SIM_I2C_IDLE;
+            i2c->event_end = SIM_NEVER;
+            SIM_REG(i2c->base + SIM_I2C_CR1) &= ~I2C_CR1_START;
+            sim_i2c_sr1(i2c, I2C_SR1_SB, I2C_SR1_BTF | I2C_SR1_ADDR | I2C_SR1_TXE);
+            sim_i2c_sr2(i2c, I2C_SR2_MSL | I2C_SR2_BUSY, 0);
+            i2c->dr_full = 0;
+            i2c->shift_full = 0;
+        }break;
+        case SIM_I2C_STOP:
+        {
+            i2c->state = SIM_I2C_IDLE;
+            i2c->event_end = SIM_NEVER;
+            SIM_REG(i2c->base + SIM_I2C_CR1) &= ~I2C_CR1_STOP;
+            sim_i2c_sr1(i2c, 0, I2C_SR1_TXE | I2C_SR1_SB | I2C_SR1_ADDR);          // ʱ DR λĴеֽԿɶ
+            sim_i2c_sr2(i2c, 0, I2C_SR2_MSL | I2C_SR2_BUSY | I2C_SR2_TRA);
+            if(NULL != i2c->target && NULL != i2c->target->stop)
+            {
+                i2c->target->stop(i2c->target->context, t);
+            }
+            i2c->target = NULL;
+            if(i2c->start_pending)
+            {
+                i2c->start_pending = 0;
+                sim_i2c_begin(i2c, SIM_I2C_START, t);
+            }
+        }break;
+        case SIM_I2C_ADDRESS:   sim_i2c_address_done(i2c, t);   break;
+        case SIM_I2C_TX:        sim_i2c_tx_done(i2c, t);        break;
+        case SIM_I2C_RX:        sim_i2c_rx_done(i2c, t);        break;
+        default:                                                break;
+    }
+}
+
+//====================================================GPIO ģ IIC ӻ====================================================
+//  IIC ʹ SCL/SDA © ӻ GPIO 仯ʱƽ START/STOPַ
+// SCL ز ½ظı SDA ӻӦʱ SDA Ӧ֮ SCL һʱģʱչ
+#define SIM_I2C_GPIO_MAX            (4)
+
+typedef enum
+{
+    SIM_I2C_GPIO_IDLE,                                                          // ȴ START
+    SIM_I2C_GPIO_ADDRESS,                                                       // յַֽ
+    SIM_I2C_GPIO_WRITE,                                                         // д
+    SIM_I2C_GPIO_READ,                                                          // 
+    SIM_I2C_GPIO_IGNORE,                                                        // δѰַѻ NACK ȴ START/STOP
+}sim_i2c_gpio_state_enum;
+
+typedef struct
+{
+    GPIO_TypeDef *scl_port;
+    uint16      scl_pin;
+    GPIO_TypeDef *sda_port;
+    uint16      sda_pin;
+    sim_i2c_slave_struct slave;
+    uint64_t    stretch;                                                        // ÿӦ SCL ʱ 0-չ SIM_I2C_STRETCH_FOREVER-һֱ
+    uint64_t    stretch_end;
+
+    sim_i2c_gpio_state_enum state;
+    uint8       scl;                                                            // ϴοߵƽ
+    uint8       sda;
+    uint8       bit;                                                            // ֽѽ SCL ʱ  9 ΪӦ
+    uint8       shift;
+    uint8       read;                                                           // ַֽڵĶдλ
+    uint8       ack;                                                            // дΪӦ ΪӦ
+    uint8       active;                                                         // ѱѰַ STOP ʱ֪ͨ豸
+    uint8       driving;                                                        //  SDA
+    uint8       clocked;                                                        // ʱ START ֮ SCL ĵһ½زʱ
+}sim_i2c_gpio_struct;
+
+static sim_i2c_gpio_struct sim_i2c_gpio[SIM_I2C_GPIO_MAX];
+static uint8 sim_i2c_gpio_count;
+
+static void sim_i2c_gpio_drive (sim_i2c_gpio_struct *dev, uint8 low)
+{
+    if(low != dev->driving)                                                     // ͬһ SDA ϿܹŶӻ ֻɿԼ͵
+    {
+        dev->driving = low;
+        sim_gpio_hold_low(dev->sda_port, dev->sda_pin, low);
+    }
+}
+
+static void sim_i2c_gpio_load (sim_i2c_gpio_struct *dev, uint64_t t)
+{
+    dev->shift = (NULL == dev->slave.read) ? 0xFF : dev->slave.read(dev->slave.context, t);
+    dev->bit = 0;
+    sim_i2c_gpio_drive(dev, !(dev->shift & 0x80));
+}
+
+static void sim_i2c_gpio_rising (sim_i2c_gpio_struct *dev, uint8 sda)
+{
+    dev->clocked = 1;
+    if((SIM_I2C_GPIO_ADDRESS == dev->state || SIM_I2C_GPIO_WRITE == dev->state) && 8 > dev->bit)
+    {
+        dev->shift = (uint8)((dev->shift << 1) | sda);
+    }
+    else if(SIM_I2C_GPIO_READ == dev->state && 8 == dev->bit)
+    {
+        dev->ack = !sda;
+    }
+}
+
+static void sim_i2c_gpio_falling (sim_i2c_gpio_struct *dev, uint64_t t)
+{
+    if(!dev->clocked)
+    {
+        return;
+    }
+    dev->clocked = 0;
+    switch(dev->state)
+    {
+        case SIM_I2C_GPIO_ADDRESS:
+        case SIM_I2C_GPIO_WRITE:
+        {
+            dev->bit ++;
+            if(8 == dev->bit)                                                   //  8 ʱӽ Ӧʱ ACK
+            {
+                if(SIM_I2C_GPIO_ADDRESS == dev->state)
+                {
+                    dev->read = dev->shift & 0x01;
+                    dev->ack = ((dev->shift >> 1) == dev->slave.address);
+                    if(dev->ack)
+                    {
+                        dev->active = 1;
+                        dev->ack = (NULL == dev->slave.start) ? 1 : dev->slave.start(dev->slave.context, dev->read, t);
+                    }
+                }
+                else
+                {
+                    dev->ack = (NULL == dev->slave.write) ? 1 : dev->slave.write(dev->slave.context, dev->shift, t);
+                }
+                sim_i2c_gpio_drive(dev, dev->ack);
+            }
+            else if(9 == dev->bit)                                              // Ӧʱӽ
+            {
+                sim_i2c_gpio_drive(dev, 0);
+                dev->bit = 0;
+                dev->shift = 0;
+                if(!dev->ack)
+                {
+                    dev->state = SIM_I2C_GPIO_IGNORE;
+                    break;
+                }
+                if(SIM_I2C_GPIO_ADDRESS == dev->state)
+                {
+                    dev->state = dev->read ? SIM_I2C_GPIO_READ : SIM_I2C_GPIO_WRITE;
+                    if(dev->read)
+                    {
+                        sim_i2c_gpio_load(dev, t);
+                    }
+                }
+                if(dev->stretch)
+                {
+                    sim_gpio_hold_low(dev->scl_port, dev->scl_pin, 1);
+                    dev->stretch_end = (SIM_I2C_STRETCH_FOREVER == dev->stretch) ? SIM_NEVER : t + dev->stretch;
+                }
+            }
+        }break;
+        case SIM_I2C_GPIO_READ:
+        {
+            dev->bit ++;
+            if(8 > dev->bit)
+            {
+                sim_i2c_gpio_drive(dev, !(dev->shift & (0x80 >> dev->bit)));
+            }
+            else if(8 == dev->bit)                                              // ɿ SDA Ӧ
+            {
+                sim_i2c_gpio_drive(dev, 0);
+            }
+            else if(dev->ack)
+            {
+                sim_i2c_gpio_load(dev, t);
+            }
+            else
+            {
+                dev->state = SIM_I2C_GPIO_IGNORE;
+            }
+        }break;
+        default:
+        {
+        }break;
+    }
+}
+
+static void sim_i2c_gpio_update (sim_i2c_gpio_struct *dev, uint64_t t)
+{
+    uint8 scl = sim_gpio_get(dev->scl_port, dev->scl_pin);
+    uint8 sda = sim_gpio_get(dev->sda_port, dev->sda_pin);
+
+    if(scl && dev->scl && sda != dev->sda)                                      // SCL ߵƽڼ SDA 仯Ϊ START/STOP
+    {
+        if(sda)
+        {
+            if(dev->active && NULL != dev->slave.stop)
+            {
+                dev->slave.stop(dev->slave.context, t);
+            }
+            dev->active = 0;
+            dev->state = SIM_I2C_GPIO_IDLE;
+        }
+        else
+        {
+            dev->state = SIM_I2C_GPIO_ADDRESS;
+            dev->bit = 0;
+            dev->shift = 0;
+            dev->clocked = 0;
+        }
+        sim_i2c_gpio_drive(dev, 0);
+    }
+    else if(scl && !dev->scl)
+    {
+        sim_i2c_gpio_rising(dev, sda);
+    }
+    else if(!scl && dev->scl)
+    {
+        sim_i2c_gpio_falling(dev, t);
+    }
+    dev->scl = scl;
+    dev->sda = sim_gpio_get(dev->sda_port, dev->sda_pin);
+}
+
+void sim_i2c_gpio_changed (GPIO_TypeDef *port)
+{
+    for(uint32 i = 0; i < sim_i2c_gpio_count; i ++)
+    {
+        if(sim_i2c_gpio[i].scl_port == port || sim_i2c_gpio[i].sda_port == port)
+        {
+            sim_i2c_gpio_update(&sim_i2c_gpio[i], sim_cur);
+        }
+    }
+}
+
+static uint64_t sim_i2c_gpio_next (void)
+{
+    uint64_t next = SIM_NEVER;
+    for(uint32 i = 0; i < sim_i2c_gpio_count; i ++)
+    {
+        if(sim_i2c_gpio[i].stretch_end < next)
+        {
+            next = sim_i2c_gpio[i].stretch_end;
+        }
+    }
+    return next;
+}
+
+static void sim_i2c_gpio_fire (uint64_t t)
+{
+    for(uint32 i = 0; i < sim_i2c_gpio_count; i ++)
+    {
+        sim_i2c_gpio_struct *dev = &sim_i2c_gpio[i];
+        if(dev->stretch_end <= t)
+        {
+            dev->stretch_end = SIM_NEVER;
+            sim_gpio_hold_low(dev->scl_port, dev->scl_pin, 0);                  // ɿ SCL ͬһϵĴӻῴ
+            for(uint32 j = 0; j < sim_i2c_gpio_count; j ++)
+            {
+                if(sim_i2c_gpio[j].scl_port == dev->scl_port && sim_i2c_gpio[j].scl_pin == dev->scl_pin)
+                {
+                    sim_i2c_gpio_update(&sim_i2c_gpio[j], t);
+                }
+            }
+        }
+    }
+}
+
+//====================================================ģ͵====================================================
+void sim_i2c_reset (void)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        sim_i2c_struct *i2c = &sim_i2c[i];
+        i2c->state = SIM_I2C_IDLE;
+        i2c->event_end = SIM_NEVER;
+        i2c->address = 0;
+        i2c->sr1_read = 0;
+        i2c->dr_full = 0;
+        i2c->shift_full = 0;
+        i2c->nacked = 0;
+        i2c->stop_pending = 0;
+        i2c->start_pending = 0;
+        i2c->byte_count = 0;
+        i2c->hold = 0;
+        i2c->target = NULL;
+        i2c->slave_count = 0;
+    }
+    sim_i2c_gpio_count = 0;
+}
+
+uint64_t sim_i2c_next (void)
+{
+    uint64_t next = sim_i2c_gpio_next();
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        if(sim_i2c[i].event_end < next)
+        {
+            next = sim_i2c[i].event_end;
+        }
+    }
+    return next;
+}
+
+void sim_i2c_fire (uint64_t t)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        if(sim_i2c[i].event_end <= t)
+        {
+            sim_i2c_event_done(&sim_i2c[i], sim_i2c[i].event_end);
+        }
+    }
+    sim_i2c_gpio_fire(t);
+}
+
+void sim_i2c_read (uint32 addr)
+{
+    sim_i2c_struct *i2c = sim_i2c_find(addr);
+    uint32 offset = addr & 0x3FF;
+
+    switch(offset)
+    {
+        case SIM_I2C_SR1:
+        {
+            i2c->sr1_read = 1;
+        }break;
+        case SIM_I2C_SR2:
+        {
+            uint32 sr1 = SIM_REG(i2c->base + SIM_I2C_SR1);
+            if((sr1 & I2C_SR1_ADDR) && i2c->sr1_read)
+            {
+                sim_i2c_sr1(i2c, 0, I2C_SR1_ADDR);
+                if(SIM_REG(i2c->base + SIM_I2C_SR2) & I2C_SR2_TRA)
+                {
+                    sim_i2c_sr1(i2c, I2C_SR1_TXE, 0);
+                }
+                else
+                {
+                    sim_i2c_begin(i2c, SIM_I2C_RX, sim_cur);
+                }
+            }
+            i2c->sr1_read = 0;
+        }break;
+        case SIM_I2C_DR:
+        {
+            SIM_REG(addr) = i2c->dr;
+            if(i2c->dr_full && !(SIM_REG(i2c->base + SIM_I2C_SR2) & I2C_SR2_TRA))
+            {
+                i2c->dr_full = 0;
+                sim_i2c_sr1(i2c, 0, I2C_SR1_RXNE);
+                if(i2c->shift_full)
+                {
+                    i2c->dr = i2c->shift;
+                    i2c->dr_full = 1;
+                    i2c->shift_full = 0;
+                    sim_i2c_sr1(i2c, I2C_SR1_RXNE, I2C_SR1_BTF);
+                    if(SIM_I2C_IDLE == i2c->state && !i2c->nacked && !sim_i2c_pending(i2c, sim_cur))
+                    {
+                        sim_i2c_begin(i2c, SIM_I2C_RX, sim_cur);
+                    }
+                }
+            }
+            i2c->sr1_read = 0;
+        }break;
+        default:
+        {
+        }break;
+    }
+}
+
+void sim_i2c_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    sim_i2c_struct *i2c = sim_i2c_find(addr);
+    uint32 offset = addr & 0x3FF;
+
+    switch(offset)
+    {
+        case SIM_I2C_CR1:
+        {
+            if(value & I2C_CR1_SWRST)
+            {
+                SIM_REG(i2c->base + SIM_I2C_SR1) = 0;
+                SIM_REG(i2c->base + SIM_I2C_SR2) = 0;
+                i2c->state = SIM_I2C_IDLE;
+                i2c->event_end = SIM_NEVER;
+                i2c->target = NULL;
+                i2c->stop_pending = 0;
+                i2c->start_pending = 0;
+                i2c->hold = 0;                                                  // λʱ SCL ʱ ӻſ
+                break;
+            }
+            if(!(value & I2C_CR1_PE))
+            {
+                break;
+            }
+            uint32 transmit = SIM_REG(i2c->base + SIM_I2C_SR2) & I2C_SR2_TRA;
+            if((value & I2C_CR1_STOP) && !(old_value & I2C_CR1_STOP))
+            {
+                sim_i2c_sr1(i2c, 0, transmit ? I2C_SR1_BTF : 0);                 // ʱ START/STOP  BTF
+                if(SIM_I2C_IDLE == i2c->state && (SIM_REG(i2c->base + SIM_I2C_SR2) & I2C_SR2_MSL))
+                {
+                    sim_i2c_begin(i2c, SIM_I2C_STOP, sim_cur);
+                }
+                else
+                {
+                    i2c->stop_pending = 1;
+                }
+            }
+            if((value & I2C_CR1_START) && !(old_value & I2C_CR1_START))
+            {
+                sim_i2c_sr1(i2c, 0, transmit ? I2C_SR1_BTF : 0);
+                if(SIM_I2C_IDLE == i2c->state)
+                {
+                    sim_i2c_begin(i2c, SIM_I2C_START, sim_cur);
+                }
+                else
+                {
+                    i2c->start_pending = 1;
+                }
+            }
+        }break;
+        case SIM_I2C_SR1:
+        {
+            SIM_REG(addr) = old_value & (value | ~SIM_I2C_SR1_ERROR);            // ־д 0  ֻ
+        }break;
+        case SIM_I2C_SR2:
+        {
+            SIM_REG(addr) = old_value;
+        }break;
+        case SIM_I2C_DR:
+        {
+            uint32 sr1 = SIM_REG(i2c->base + SIM_I2C_SR1);
+            value &= 0xFF;
+            i2c->sr1_read = 0;
+            if(sr1 & I2C_SR1_SB)
+            {
+                sim_i2c_sr1(i2c, 0, I2C_SR1_SB);
+                i2c->address = (uint8)value;
+                sim_i2c_begin(i2c, SIM_I2C_ADDRESS, sim_cur);
+            }
+            else if((SIM_REG(i2c->base + SIM_I2C_SR2) & I2C_SR2_TRA) && !(sr1 & I2C_SR1_ADDR))
+            {
+                sim_i2c_sr1(i2c, 0, I2C_SR1_BTF);
+                if(SIM_I2C_IDLE == i2c->state)
+                {
+                    i2c->shift = (uint8)value;
+                    sim_i2c_sr1(i2c, I2C_SR1_TXE, 0);
+                    sim_i2c_begin(i2c, SIM_I2C_TX, sim_cur);
+                }
+                else
+                {
+                    i2c->dr = (uint8)value;
+                    i2c->dr_full = 1;
+                    sim_i2c_sr1(i2c, 0, I2C_SR1_TXE);
+                }
+            }
+        }break;
+        default:
+        {
+        }break;
+    }
+}
+
+void sim_i2c_irq (void)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        uint32 sr1 = SIM_REG(sim_i2c[i].base + SIM_I2C_SR1);
+        uint32 cr2 = SIM_REG(sim_i2c[i].base + SIM_I2C_CR2);
+        uint8 event =
+            ((cr2 & I2C_CR2_ITEVTEN) && (sr1 & SIM_I2C_SR1_EVENT)) ||
+            ((cr2 & I2C_CR2_ITEVTEN) && (cr2 & I2C_CR2_ITBUFEN) && (sr1 & (I2C_SR1_TXE | I2C_SR1_RXNE)));
+        uint8 error = (cr2 & I2C_CR2_ITERREN) && (sr1 & SIM_I2C_SR1_ERROR);
+        sim_irq_line(sim_i2c[i].ev_irq, event);
+        sim_irq_line(sim_i2c[i].er_irq, error);
+    }
+}
+
+uint8 sim_i2c_dma_request (uint8 channel)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        uint32 sr1 = SIM_REG(sim_i2c[i].base + SIM_I2C_SR1);
+        uint32 cr2 = SIM_REG(sim_i2c[i].base + SIM_I2C_CR2);
+        if(!(cr2 & I2C_CR2_DMAEN))
+        {
+            continue;
+        }
+        if(channel == sim_i2c[i].tx_dma_channel && (sr1 & I2C_SR1_TXE))
+        {
+            return 1;
+        }
+        if(channel == sim_i2c[i].rx_dma_channel && (sr1 & I2C_SR1_RXNE))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       I2C Ϲҽһ豸
+// ˵     *i2cx           I2C1/I2C2
+// ˵     *slave          豸ַص
+// ز     uint8           0-ɹ 1-ҽ
+// ʹʾ     sim_i2c_attach(I2C1, &imu.slave);
+// עϢ      sim_init ֮ sim_init չҽ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 sim_i2c_attach (I2C_TypeDef *i2cx, const sim_i2c_slave_struct *slave)
+{
+    sim_i2c_struct *i2c = sim_i2c_find((uint32)(uintptr_t)i2cx);
+
+    if(NULL == i2c || i2c->slave_count >= SIM_I2C_SLAVE_MAX)
+    {
+        return 1;
+    }
+    sim_lock();
+    i2c->slave[i2c->slave_count] = *slave;
+    i2c->slave_count ++;
+    sim_unlock();
+    return 0;
+}
+
+uint64_t sim_i2c_byte_count (I2C_TypeDef *i2cx)
+{
+    sim_i2c_struct *i2c = sim_i2c_find((uint32)(uintptr_t)i2cx);
+    return (NULL == i2c) ? 0 : i2c->byte_count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       I2C ֽ֮
+// ˵     *i2cx           I2C1/I2C2
+// ˵     bytes           ٴٸֽڣַӻס SCL ֽ֮ڲٽ
+// ز     void
+// ʹʾ     sim_i2c_hold(I2C1, 2);
+// עϢ     ģӻ д CR1  SWRST ͷ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_i2c_hold (I2C_TypeDef *i2cx, uint64_t bytes)
+{
+    sim_i2c_struct *i2c = sim_i2c_find((uint32)(uintptr_t)i2cx);
+
+    if(NULL == i2c)
+    {
+        return;
+    }
+    sim_lock();
+    i2c->hold = i2c->byte_count + bytes;
+    sim_unlock();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO  IIC Ϲҽһ豸
+// ˵     *scl_port       SCL ˿
+// ˵     scl_pin         SCL  GPIO_Pin_x
+// ˵     *sda_port       SDA ˿
+// ˵     sda_pin         SDA  GPIO_Pin_x
+// ˵     *slave          豸ַص
+// ˵     stretch         ÿӦ SCL  HCLK  0-չ SIM_I2C_STRETCH_FOREVER-һֱ
+// ز     uint8           0-ɹ 1-ҽ
+// ʹʾ     sim_i2c_gpio_attach(GPIOB, GPIO_Pin_8, GPIOB, GPIO_Pin_9, &imu.slave, 0);
+// עϢ      sim_init ֮ ͬһϿɹҶַͬĴ豸
+//-------------------------------------------------------------------------------------------------------------------
+uint8 sim_i2c_gpio_attach (GPIO_TypeDef *scl_port, uint16 scl_pin, GPIO_TypeDef *sda_port, uint16 sda_pin, const sim_i2c_slave_struct *slave, uint64_t stretch)
+{
+    sim_i2c_gpio_struct *dev;
+
+    if(sim_i2c_gpio_count >= SIM_I2C_GPIO_MAX)
+    {
+        return 1;
+    }
+    sim_lock();
+    dev = &sim_i2c_gpio[sim_i2c_gpio_count ++];
+    memset(dev, 0, sizeof(*dev));
+    dev->scl_port = scl_port;
+    dev->scl_pin = scl_pin;
+    dev->sda_port = sda_port;
+    dev->sda_pin = sda_pin;
+    dev->slave = *slave;
+    dev->stretch = stretch;
+    dev->stretch_end = SIM_NEVER;
+    dev->state = SIM_I2C_GPIO_IDLE;
+    dev->scl = sim_gpio_get(scl_port, scl_pin);
+    dev->sda = sim_gpio_get(sda_port, sda_pin);
+    sim_unlock();
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO  IIC 豸ͣڷֽڵ;
+// ˵     *slave          sim_i2c_gpio_attach ʱĴ豸
+// ˵     clocks          Ҫ SCL ʱ 1-8 ֮ǰһֱ SDA
+// ز     void
+// ʹʾ     sim_i2c_gpio_stuck(&imu.slave, 5);
+// עϢ     ģڶȡ;λ 豸 0 
+//-------------------------------------------------------------------------------------------------------------------
+void sim_i2c_gpio_stuck (const sim_i2c_slave_struct *slave, uint8 clocks)
+{
+    sim_lock();
+    for(uint32 i = 0; i < sim_i2c_gpio_count; i ++)
+    {
+        sim_i2c_gpio_struct *dev = &sim_i2c_gpio[i];
+        if(dev->slave.context == slave->context && dev->slave.address == slave->address)
+        {
+            dev->state = SIM_I2C_GPIO_READ;
+            dev->shift = 0x00;
+            dev->bit = (uint8)(8 - clocks);
+            dev->ack = 0;
+            dev->clocked = 0;
+            sim_i2c_gpio_drive(dev, 1);
+            dev->sda = sim_gpio_get(dev->sda_port, dev->sda_pin);
+        }
+    }
+    sim_unlock();
+}
@@ -0,0 +1,105 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// ڲӿ ֻ host/sim µԴļ֮ʹ
+
+#ifndef _sim_internal_h_
+#define _sim_internal_h_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sim.h"
+
+#define SIM_NEVER                   (UINT64_MAX)
+
+// ߷ʿHCLK ڣ  F103 ߽ṹ
+// APB1 36MHz ÿηԼ 2  PCLK1  ӳ
+#define SIM_CYCLES_PPB              (1)                                         // SCS/DWT ˽
+#define SIM_CYCLES_AHB              (2)                                         // DMA RCC FLASH ӿ
+#define SIM_CYCLES_APB2             (3)                                         // GPIO USART1 SPI1
+#define SIM_CYCLES_APB1             (5)                                         // USART2/3 SPI2 I2C1/2
+#define SIM_CYCLES_SRAM             (1)
+#define SIM_CYCLES_DMA              (4)                                         // DMA ٲַ 
+#define SIM_CYCLES_IRQ_ENTRY        (12)                                        // Cortex-M3 ѹջж
+#define SIM_CYCLES_IRQ_EXIT         (10)
+
+#define SIM_FLASH_SIZE              (128 * 1024)
+#define SIM_DWT_BASE                (0xE0001000UL)                              // core_cm3.h δ DWT 
+#define SIM_DWT_CTRL                (SIM_DWT_BASE + 0x000)
+#define SIM_DWT_CYCCNT              (SIM_DWT_BASE + 0x004)
+
+#define SIM_IRQ_SYSTICK             (43)                                        // ڲ 0~42 Ϊж
+#define SIM_IRQ_COUNT               (44)
+
+#define SIM_REG(addr)               (*sim_reg(addr))
+
+extern uint64_t sim_now;                                                        // CPU ǰʱ
+extern uint64_t sim_cur;                                                        // ģ͵ǰʱ̣¼ʱ̻ CPU ʱ̣
+extern sim_stat_struct sim_stat;
+
+volatile uint32    *sim_reg                 (uint32 addr);
+uint32      sim_bus_read            (uint32 addr, uint8 size, uint8 *error);
+void        sim_bus_write           (uint32 addr, uint32 value, uint8 size, uint8 *error);
+uint32      sim_bus_cycles          (uint32 addr);
+uint32      sim_apb_divider         (uint8 apb);
+void        sim_gpio_hold_low       (GPIO_TypeDef *port, uint16 pin, uint8 hold);
+void        sim_irq_line            (int irq, uint8 level);
+void        sim_poll_hint           (const void *key, uint64_t until);
+void        sim_fatal               (const char *format, ...);
+void        sim_lock                (void);
+void        sim_unlock              (void);
+
+// ģ  sim_core.c ͳһ
+void        sim_uart_reset          (void);
+uint64_t    sim_uart_next           (void);
+void        sim_uart_fire           (uint64_t t);
+void        sim_uart_read           (uint32 addr);
+void        sim_uart_write          (uint32 addr, uint32 old_value, uint32 value);
+void        sim_uart_irq            (void);
+uint8       sim_uart_dma_request    (uint8 channel);
+
+void        sim_spi_reset           (void);
+uint64_t    sim_spi_next            (void);
+void        sim_spi_fire            (uint64_t t);
+void        sim_spi_read            (uint32 addr);
+void        sim_spi_write           (uint32 addr, uint32 old_value, uint32 value);
+void        sim_spi_irq             (void);
+uint8       sim_spi_dma_request     (uint8 channel);
+void        sim_spi_gpio_changed    (GPIO_TypeDef *port);
+
+void        sim_i2c_reset           (void);
+uint64_t    sim_i2c_next            (void);
+void        sim_i2c_fire            (uint64_t t);
+void        sim_i2c_read            (uint32 addr);
+void        sim_i2c_write           (uint32 addr, uint32 old_value, uint32 value);
+void        sim_i2c_irq             (void);
+uint8       sim_i2c_dma_request     (uint8 channel);
+void        sim_i2c_gpio_changed    (GPIO_TypeDef *port);
+
+void        sim_dma_reset           (void);
+uint64_t    sim_dma_next            (void);
+void        sim_dma_fire            (uint64_t t);
+void        sim_dma_write           (uint32 addr, uint32 old_value, uint32 value);
+void        sim_dma_irq             (void);
+
+void        sim_flash_reset         (void);
+uint64_t    sim_flash_next          (void);
+void        sim_flash_fire          (uint64_t t);
+void        sim_flash_read          (uint32 addr);
+void        sim_flash_write         (uint32 addr, uint32 old_value, uint32 value);
+void        sim_flash_memory_write  (uint32 addr, uint32 old_value, uint32 value, uint32 written_mask);
+void        sim_flash_irq           (void);
+
+#endif
@@ -0,0 +1,1333 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// 泡
+// ÷   host_sim [-f ƹ] [--csv]
+// ÿȸλоƬҽⲿ Թ̼ ˶Խ
+//    cycles     ʱ䣨HCLK ڣ        us         㵽 72MHz ʱ
+//        rd/wr      CPU дĴ        bus        Ĵĵ
+//        dma        DMA ˴                  irq        жϴ
+
+#include "common_headfile.h"
+#include "sim.h"
+
+typedef struct
+{
+    const char  *name;
+    void        (*setup)    (void);                                             //  ҽ Ϊ NULL
+    void        (*firmware) (void);                                             // ̼ ڷоƬ
+    uint8       (*check)    (void);                                             //  0-ͨ
+}sim_case_struct;
+
+#define SIM_TEST_LENGTH             (64)
+#define SIM_FLASH_TEST_PAGE         (63)
+#define SIM_W25Q64_TEST_ADDRESS     (0x001000)
+#define SIM_TFT180_GRAM_WIDTH       (132)                                       // ST7735 Դ ʱλ (2, 1)  128x160
+#define SIM_TFT180_GRAM_HEIGHT      (162)
+#define SIM_TFT180_PIXEL(x, y)      (sim_test_framebuffer[((y) + 1) * SIM_TFT180_GRAM_WIDTH + (x) + 2])
+
+static sim_w25q64_struct    sim_test_w25q64;
+static uint16_t             sim_test_framebuffer[SIM_TFT180_GRAM_WIDTH * SIM_TFT180_GRAM_HEIGHT];
+static sim_lcd_struct       sim_test_lcd;
+static sim_oled_struct      sim_test_oled;
+
+static uint8                sim_test_tx[256];
+static uint8                sim_test_rx[256];
+static uint8                sim_test_result;
+
+static void sim_test_pattern (uint8 *buffer, uint32 length, uint8 seed)
+{
+    for(uint32 i = 0; i < length; i ++)
+    {
+        buffer[i] = (uint8)(seed + i * 7);
+    }
+}
+
+//====================================================UART====================================================
+static void sim_case_uart_tx_firmware (void)
+{
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    sim_test_pattern(sim_test_tx, SIM_TEST_LENGTH, 0x30);
+    uart_write_buffer(UART_1, sim_test_tx, SIM_TEST_LENGTH);
+    uart_tx_flush(UART_1);                                                      // һֽƳ
+}
+
+static uint8 sim_case_uart_tx_check (void)
+{
+    uint32 length = sim_uart_tx_take(USART1, sim_test_rx, sizeof(sim_test_rx));
+    return (SIM_TEST_LENGTH != length || memcmp(sim_test_tx, sim_test_rx, SIM_TEST_LENGTH));
+}
+
+static void sim_case_uart_rx_firmware (void)
+{
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    sim_test_pattern(sim_test_tx, SIM_TEST_LENGTH, 0x41);
+    sim_uart_feed(USART1, sim_test_tx, SIM_TEST_LENGTH);
+    for(uint32 i = 0; i < SIM_TEST_LENGTH; i ++)
+    {
+        sim_test_rx[i] = uart_read_byte(UART_1);
+    }
+}
+
+static uint8 sim_case_uart_rx_check (void)
+{
+    return memcmp(sim_test_tx, sim_test_rx, SIM_TEST_LENGTH) ? 1 : 0;
+}
+
+static void sim_case_uart_rx_buffer_firmware (void)
+{
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    sim_test_pattern(sim_test_tx, SIM_TEST_LENGTH, 0x52);
+    sim_uart_feed(USART1, sim_test_tx, SIM_TEST_LENGTH);
+    for(uint32 length = 0; length < SIM_TEST_LENGTH; )
+    {
+        length += uart_read_buffer(UART_1, &sim_test_rx[length], SIM_TEST_LENGTH - length);
+    }
+    sim_test_result = (uint8)uart_read_buffer(UART_1, sim_test_rx, 1);         // Ѷ Ӧ 0
+}
+
+static uint8 sim_case_uart_rx_buffer_check (void)
+{
+    return (sim_test_result || memcmp(sim_test_tx, sim_test_rx, SIM_TEST_LENGTH));
+}
+
+#define SIM_TX_STREAM_LENGTH        (600)                                       // ڷͻ ǻ뻺ȴ
+#define SIM_TX_STREAM_CHUNK         (67)
+
+static uint8                sim_test_stream[SIM_TX_STREAM_LENGTH];
+static uint8                sim_test_stream_rx[SIM_TX_STREAM_LENGTH];
+
+static void sim_case_uart_tx_dma_firmware (void)
+{
+    uint32 length;
+
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    sim_test_pattern(sim_test_stream, SIM_TX_STREAM_LENGTH, 0x11);
+    uart_write_buffer(UART_1, sim_test_stream, SIM_TEST_LENGTH);
+    sim_test_result = (uart_tx_pending(UART_1) < SIM_TEST_LENGTH - 2);         // ʱӦڻŶ
+    for(uint32 i = SIM_TEST_LENGTH; i < SIM_TX_STREAM_LENGTH; i += length)
+    {
+        length = SIM_TX_STREAM_LENGTH - i;
+        length = length > SIM_TX_STREAM_CHUNK ? SIM_TX_STREAM_CHUNK : length;
+        uart_write_buffer(UART_1, &sim_test_stream[i], length);
+    }
+    uart_tx_flush(UART_1);
+}
+
+static uint8 sim_case_uart_tx_dma_check (void)
+{
+    uint32 length = sim_uart_tx_take(USART1, sim_test_stream_rx, sizeof(sim_test_stream_rx));
+    return (sim_test_result || SIM_TX_STREAM_LENGTH != length ||
+            memcmp(sim_test_stream, sim_test_stream_rx, SIM_TX_STREAM_LENGTH));
+}
+
+static uint8                sim_test_user_rx[64];
+static uint8                sim_test_user_tx[32];
+
+static void sim_case_uart_user_buffer_firmware (void)
+{
+    system_delay_init();
+    sim_test_result  = (1 != uart_set_buffer(UART_2, sim_test_user_rx, 48, NULL, 0));   //  2  Ӧܾ
+    sim_test_result |= uart_set_buffer(UART_2, sim_test_user_rx, sizeof(sim_test_user_rx), sim_test_user_tx, sizeof(sim_test_user_tx));
+    uart_init(UART_2, 115200, UART2_TX_PA2, UART2_RX_PA3);
+
+    sim_test_pattern(sim_test_stream, SIM_TX_STREAM_LENGTH, 0x23);
+    uart_write_buffer(UART_2, sim_test_stream, SIM_TX_STREAM_LENGTH);           // Զ 32 ֽڷͻ
+    uart_tx_flush(UART_2);
+
+    sim_test_pattern(sim_test_tx, 48, 0x67);
+    sim_uart_feed(USART2, sim_test_tx, 48);
+    for(uint32 length = 0; length < 48; )
+    {
+        length += uart_read_buffer(UART_2, &sim_test_rx[length], 48 - length);
+    }
+}
+
+static uint8 sim_case_uart_user_buffer_check (void)
+{
+    uint32 length = sim_uart_tx_take(USART2, sim_test_stream_rx, sizeof(sim_test_stream_rx));
+    return (sim_test_result || SIM_TX_STREAM_LENGTH != length ||
+            memcmp(sim_test_stream, sim_test_stream_rx, SIM_TX_STREAM_LENGTH) ||
+            memcmp(sim_test_tx, sim_test_rx, 48));
+}
+
+static uint32               sim_test_baud[2];
+static int32                sim_test_baud_error[2];
+
+static void sim_case_uart_config_firmware (void)
+{
+    uart_config_struct config = {UART_PARITY_EVEN, UART_STOP_2, UART_FLOW_NONE};
+    system_delay_init();
+    sim_test_baud[0] = uart_init_ex(UART_1, 2000000, UART1_TX_PA9, UART1_RX_PA10, &config);   // PCLK2 72MHz BRR = 36 
+    uart_get_baud(UART_1, &sim_test_baud_error[0]);
+    sim_test_baud[1] = uart_init(UART_3, 115200, UART3_TX_PB10, UART3_RX_PB11); // PCLK1 36MHz BRR = 313  -0.15%
+    uart_get_baud(UART_3, &sim_test_baud_error[1]);
+
+    sim_test_pattern(sim_test_tx, SIM_TEST_LENGTH, 0x52);
+    uart_write_buffer(UART_1, sim_test_tx, SIM_TEST_LENGTH);
+    uart_tx_flush(UART_1);
+    sim_uart_feed(USART1, sim_test_tx, SIM_TEST_LENGTH);
+    for(uint32 length = 0; length < SIM_TEST_LENGTH; )
+    {
+        length += uart_read_buffer(UART_1, &sim_test_rx[length], SIM_TEST_LENGTH - length);
+    }
+}
+
+static uint8 sim_case_uart_config_check (void)
+{
+    uint32 length = sim_uart_tx_take(USART1, sim_test_stream_rx, sizeof(sim_test_stream_rx));
+    return (2000000 != sim_test_baud[0] || 0 != sim_test_baud_error[0] ||
+            115016 != sim_test_baud[1] || -15 != sim_test_baud_error[1] ||
+            SIM_TEST_LENGTH != length || memcmp(sim_test_tx, sim_test_stream_rx, SIM_TEST_LENGTH) ||
+            memcmp(sim_test_tx, sim_test_rx, SIM_TEST_LENGTH));
+}
+
+static uart_stats_struct    sim_test_stats[2];
+
+static void sim_case_uart_stats_firmware (void)
+{
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    profile_init();
+    uart_write_string(UART_1, "stats");
+    uart_tx_flush(UART_1);
+
+    sim_test_pattern(sim_test_tx, 16, 0x10);
+    sim_uart_feed(USART1, sim_test_tx, 16);
+    sim_uart_feed_error(USART1, 0x55, USART_SR_FE);
+    sim_uart_feed_error(USART1, 0xAA, USART_SR_NE);
+    for(uint32 length = 0; length < 18; )
+    {
+        length += uart_read_buffer(UART_1, &sim_test_rx[length], 18 - length);
+    }
+    for(uint32 start = PROFILE_CYCLE(); PROFILE_CYCLE() - start < 200 * 72; ); // ȿж
+    uart_get_stats(UART_1, &sim_test_stats[0]);
+
+    uart_clear_stats(UART_1);
+    sim_test_pattern(sim_test_stream, 300, 0x20);
+    sim_uart_feed(USART1, sim_test_stream, 300);                                // ȡ  256 ֽڽջ
+    for(uint32 start = PROFILE_CYCLE(); PROFILE_CYCLE() - start < 30000 * 72; );
+    uart_get_stats(UART_1, &sim_test_stats[1]);
+}
+
+static uint8 sim_case_uart_stats_check (void)
+{
+    const uart_stats_struct *st = sim_test_stats;
+    return (5 != st[0].tx_bytes || 18 != st[0].rx_bytes || 1 != st[0].framing || 1 != st[0].noise ||
+            0 != st[0].overrun || 0 != st[0].rx_dropped || 0 == st[0].rx_peak ||
+            0 != st[1].tx_bytes || 300 != st[1].rx_bytes || 0 != st[1].framing ||
+            256 != st[1].rx_dropped || 256 != st[1].rx_peak);
+}
+
+static const char           sim_test_lines[] = "$GNRMC,023044.00,A,3150.78,N,11711.93,E\r\n\r\nOK\r\nTRUNCATED_LINE_ABCDEFGH\nPARTIAL";
+static char                 sim_test_line[4][16];
+static uint32               sim_test_line_pending[2];
+
+static void sim_case_uart_line_firmware (void)
+{
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    profile_init();                                                             //  CYCCNT ڵȴ
+    sim_uart_feed(USART1, (const uint8 *)sim_test_lines, sizeof(sim_test_lines) - 1);
+    while(uart_lines_pending(UART_1) < 4);                                      // Ҳ ȡʱ
+    sim_test_line_pending[0] = uart_lines_pending(UART_1);
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        uart_read_line(UART_1, sim_test_line[i], sizeof(sim_test_line[i]));
+    }
+    for(uint32 start = PROFILE_CYCLE(); PROFILE_CYCLE() - start < 2000 * 72; ); //  PARTIAL ȫ
+    sim_test_line_pending[1] = uart_lines_pending(UART_1);
+    sim_test_result = (uint8)uart_read_line(UART_1, sim_test_line[3], sizeof(sim_test_line[3]));
+}
+
+static uint8 sim_case_uart_line_check (void)
+{
+    return (4 != sim_test_line_pending[0] || 0 != sim_test_line_pending[1] || sim_test_result ||
+            strcmp(sim_test_line[0], "$GNRMC,023044.0") ||                      // ضΪ 15 ֽ
+            strcmp(sim_test_line[1], "OK") ||
+            strcmp(sim_test_line[2], "TRUNCATED_LINE_"));
+}
+
+static uint32               sim_test_line_mixed[8];
+
+static void sim_case_uart_line_mixed_firmware (void)
+{
+    uint8 dat = 0, buffer[3];
+    uint32 count = 0;
+
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    profile_init();
+    sim_uart_feed(USART1, (const uint8 *)"AB\nCD\nEF\n", 9);
+    while(uart_lines_pending(UART_1) < 3);
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        uart_query_byte(UART_1, &dat);                                          // ֽȡߵһ
+    }
+    sim_test_line_mixed[0] = uart_lines_pending(UART_1);
+    uart_read_buffer(UART_1, buffer, 3);                                        // ȡߵڶ
+    sim_test_line_mixed[1] = uart_lines_pending(UART_1);
+    sim_test_line_mixed[6] = uart_read_line(UART_1, sim_test_line[0], 1);       // Ųַ ܰһеж
+    sim_test_line_mixed[7] = uart_lines_pending(UART_1);
+    sim_test_line_mixed[2] = uart_read_line(UART_1, sim_test_line[0], sizeof(sim_test_line[0]));
+
+    for(uint32 i = 0; i < 242; i ++)
+    {
+        sim_test_tx[i] = (10 == i % 11) ? '\n' : (uint8)('0' + i % 11);
+    }
+    sim_uart_feed(USART1, sim_test_tx, 242);                                    //  27  297 ֽ  256 ֽڽջ ǰб
+    sim_uart_feed(USART1, sim_test_tx, 55);
+    for(uint32 start = PROFILE_CYCLE(); PROFILE_CYCLE() - start < 30000 * 72; );
+    while(uart_read_line(UART_1, sim_test_line[1], sizeof(sim_test_line[1])))
+    {
+        count ++;
+    }
+    sim_test_line_mixed[3] = count;
+    sim_test_line_mixed[4] = uart_lines_pending(UART_1);
+    sim_uart_feed(USART1, (const uint8 *)"OK\n", 3);                           // ֮
+    while(0 == uart_lines_pending(UART_1));
+    sim_test_line_mixed[5] = uart_read_line(UART_1, sim_test_line[2], sizeof(sim_test_line[2]));
+}
+
+static uint8 sim_case_uart_line_mixed_check (void)
+{
+    return (2 != sim_test_line_mixed[0] || 1 != sim_test_line_mixed[1] || 2 != sim_test_line_mixed[2] ||
+            0 != sim_test_line_mixed[6] || 1 != sim_test_line_mixed[7] ||
+            strcmp(sim_test_line[0], "EF") ||
+            0 == sim_test_line_mixed[3] || 27 < sim_test_line_mixed[3] || 0 != sim_test_line_mixed[4] ||
+            strcmp(sim_test_line[1], "0123456789") ||
+            2 != sim_test_line_mixed[5] || strcmp(sim_test_line[2], "OK"));
+}
+
+//====================================================̽====================================================
+static char sim_test_text[1024];
+
+static void sim_case_profile_firmware (void)
+{
+    system_delay_init();
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);
+    profile_init();
+    profile_reset();                                                            // ǰ泡µͳ
+    sim_test_pattern(sim_test_tx, SIM_TEST_LENGTH, 0x41);
+    sim_uart_feed(USART1, sim_test_tx, SIM_TEST_LENGTH);
+    for(uint32 i = 0; i < SIM_TEST_LENGTH; i ++)
+    {
+        sim_test_rx[i] = uart_read_byte(UART_1);
+    }
+    for(uint32 start = PROFILE_CYCLE(); PROFILE_CYCLE() - start < 200 * 72; ); // Ƚ߿гһַʱ
+    profile_dump();
+    uart_tx_flush(UART_1);
+}
+
+static uint8 sim_case_profile_check (void)
+{
+    uint32 length = sim_uart_tx_take(USART1, (uint8 *)sim_test_text, sizeof(sim_test_text) - 1);
+    sim_test_text[length] = '\0';
+    return (memcmp(sim_test_tx, sim_test_rx, SIM_TEST_LENGTH) ||
+            NULL == strstr(sim_test_text, "[profile] uart1_irq n=1 "));       // DMA  ֻ֡һοж
+}
+
+//====================================================W25Q64====================================================
+static void sim_case_w25q64_setup (void)
+{
+    sim_w25q64_init(&sim_test_w25q64);
+    sim_spi_attach(SPI1, GPIOA, GPIO_Pin_4, &sim_test_w25q64.slave);
+}
+
+static void sim_case_w25q64_firmware (void)
+{
+    system_delay_init();
+    sim_test_result = w25q64_init();
+    sim_test_pattern(sim_test_tx, 256, 0x5A);
+    w25q64_sector_erase(SIM_W25Q64_TEST_ADDRESS);
+    w25q64_page_program(SIM_W25Q64_TEST_ADDRESS, sim_test_tx, 256);
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    w25q64_read_data(SIM_W25Q64_TEST_ADDRESS, sim_test_rx, 256);
+}
+
+static uint8 sim_case_w25q64_check (void)
+{
+    return (sim_test_result ||
+            1 != sim_test_w25q64.erase_count || 1 != sim_test_w25q64.program_count ||
+            memcmp(sim_test_tx, sim_test_rx, 256) ||
+            memcmp(sim_test_tx, &sim_test_w25q64.memory[SIM_W25Q64_TEST_ADDRESS], 256));
+}
+
+static spi_xfer_struct      sim_test_xfer[4];
+static uint8                sim_test_cmd[2][4];
+static uint32               sim_test_callback;
+static uint32               sim_test_pending;
+
+static void sim_case_spi_async_callback (spi_xfer_struct *xfer)
+{
+    (void)xfer;
+    sim_test_callback ++;
+}
+
+static void sim_case_spi_async_setup (void)
+{
+    sim_case_w25q64_setup();
+    sim_test_pattern(&sim_test_w25q64.memory[SIM_W25Q64_TEST_ADDRESS], 256, 0x3C);
+}
+
+static void sim_case_spi_async_firmware (void)
+{
+    system_delay_init();
+    sim_test_result = w25q64_init();
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    sim_test_callback = 0;
+    for(uint32 i = 0; i < 2; i ++)                                              // ֡ ÿ֡ +ַ  128 ֽ һ֡
+    {
+        uint32 address = SIM_W25Q64_TEST_ADDRESS + i * 128;
+        sim_test_cmd[i][0] = 0x03;
+        sim_test_cmd[i][1] = (uint8)(address >> 16);
+        sim_test_cmd[i][2] = (uint8)(address >> 8);
+        sim_test_cmd[i][3] = (uint8)(address);
+        sim_test_xfer[i * 2]     = (spi_xfer_struct){W25Q64_CS_PIN, 1, sim_test_cmd[i], NULL, 4, 0, sim_case_spi_async_callback, NULL, SPI_XFER_IDLE};
+        sim_test_xfer[i * 2 + 1] = (spi_xfer_struct){W25Q64_CS_PIN, 0, NULL, &sim_test_rx[i * 128], 128, 0, sim_case_spi_async_callback, NULL, SPI_XFER_IDLE};
+    }
+    for(uint32 i = 0; i < 4; i ++)
+    {
+        sim_test_result |= spi_submit(W25Q64_SPI, &sim_test_xfer[i]);
+    }
+    sim_test_pending = spi_pending(W25Q64_SPI);                                 // ύ δɵĴ
+    spi_flush(W25Q64_SPI);
+}
+
+static uint8 sim_case_spi_async_check (void)
+{
+    return (sim_test_result || 0 == sim_test_pending || 4 != sim_test_callback ||
+            SPI_XFER_DONE != sim_test_xfer[3].state ||
+            memcmp(sim_test_rx, &sim_test_w25q64.memory[SIM_W25Q64_TEST_ADDRESS], 256));
+}
+
+static spi_device_struct    sim_test_device[2];
+static uint16               sim_test_cr1[3];
+static uint8                sim_test_record[64];
+static uint32               sim_test_record_count;
+static uint64_t             sim_test_frame;
+static uint8                sim_test_switch[2];
+
+static uint8 sim_case_spi_record_transfer (void *context, uint8 mosi, uint64_t cycles)
+{
+    (void)context;
+    (void)cycles;
+    sim_test_record[sim_test_record_count ++ & 63] = mosi;
+    return 0xFF;
+}
+
+static void sim_case_spi_device_setup (void)
+{
+    static const sim_spi_slave_struct record = {NULL, sim_case_spi_record_transfer, NULL};
+
+    sim_case_w25q64_setup();
+    sim_spi_attach(SPI1, GPIOA, GPIO_Pin_3, &record);
+}
+
+static void sim_case_spi_device_firmware (void)
+{
+    const uint16 word[4] = {0x1234, 0x5678, 0x9ABC, 0xDEF0};
+
+    system_delay_init();
+    sim_test_result = w25q64_init();
+    sim_test_pattern(sim_test_tx, 256, 0x21);
+    w25q64_sector_erase(SIM_W25Q64_TEST_ADDRESS);
+    w25q64_page_program(SIM_W25Q64_TEST_ADDRESS, sim_test_tx, 256);
+
+    // ͬһ SPI1 һģʽ 31MHz128 Ƶ ʵ 562.5kHz Ƭѡ PA3 ûйҴӻ
+    spi_device_init(&sim_test_device[0], SPI_1, SPI_MODE3, 1000000, PA3);
+    spi_device_init(&sim_test_device[1], SPI_1, SPI_MODE0, 1000000, PA2);
+    sim_test_result |= spi_device_acquire(&sim_test_device[0]);
+    sim_test_result |= !spi_device_acquire(&sim_test_device[1]);             // ѱռ 뷵 1
+    sim_test_record_count = 0;                                                  // PA3 ʼΪ֮ǰĴҲᱻ¼
+    gpio_low(PA3);
+    spi_write_8bit_array(SPI_1, sim_test_tx, 16);
+    sim_test_frame = sim_spi_frame_count(SPI1);
+    spi_write_16bit_array(SPI_1, word, 4);                                      // 16 λ֡ ֡ɴ
+    sim_test_frame = sim_spi_frame_count(SPI1) - sim_test_frame;
+    sim_test_cr1[2] = SPI1->CR1;
+    gpio_high(PA3);
+    sim_test_cr1[0] = SPI1->CR1;
+    spi_device_release(&sim_test_device[0]);
+
+    //  1 Ŷһ첽ͷ ٻ 0 ռʱȶ ֱӷ 1
+    sim_test_result |= spi_device_acquire(&sim_test_device[1]);
+    sim_test_xfer[0] = (spi_xfer_struct){PA2, 0, sim_test_tx, NULL, 256, 0, NULL, NULL, SPI_XFER_IDLE};
+    sim_test_result |= spi_submit(SPI_1, &sim_test_xfer[0]);
+    spi_device_release(&sim_test_device[1]);
+    sim_test_switch[0] = spi_device_acquire(&sim_test_device[0]);
+    sim_test_switch[1] = (SPI_XFER_DONE == sim_test_xfer[0].state);
+    spi_flush(SPI_1);
+
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    w25q64_read_data(SIM_W25Q64_TEST_ADDRESS, sim_test_rx, 256);              // л W25Q64 ģʽ
+    sim_test_cr1[1] = SPI1->CR1;
+}
+
+static uint8 sim_case_spi_device_check (void)
+{
+    const uint8 word[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+    return (sim_test_result ||
+            (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_BaudRatePrescaler_128) != (sim_test_cr1[0] & (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_BR)) ||
+            SPI_BaudRatePrescaler_8 != (sim_test_cr1[1] & (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_BR)) ||
+            !(sim_test_cr1[2] & SPI_CR1_DFF) || (sim_test_cr1[1] & SPI_CR1_DFF) || 4 != sim_test_frame ||
+            16 + 8 != sim_test_record_count || memcmp(sim_test_record, sim_test_tx, 16) || memcmp(&sim_test_record[16], word, 8) ||
+            memcmp(sim_test_tx, sim_test_rx, 256) || 1 != sim_test_switch[0] || sim_test_switch[1]);
+}
+
+#define SIM_LONG_LENGTH             (70000)                                     //  DMA һ 65535 
+
+static uint8                sim_test_long[SIM_LONG_LENGTH];
+static uint16               sim_test_word[4];
+
+static void sim_case_spi_long_setup (void)
+{
+    sim_case_w25q64_setup();
+    for(uint32 i = 0; i < SIM_LONG_LENGTH; i ++)
+    {
+        sim_test_w25q64.memory[i] = (uint8)(i * 7 + (i >> 8));
+    }
+}
+
+static void sim_case_spi_long_firmware (void)
+{
+    const uint8 read_cmd[4]    = {W25Q64_READ_DATA, 0x00, 0x00, 0x10};
+    const uint8 program_cmd[4] = {W25Q64_PAGE_PROGRAM, (SIM_W25Q64_TEST_ADDRESS >> 16) & 0xFF, (SIM_W25Q64_TEST_ADDRESS >> 8) & 0xFF, SIM_W25Q64_TEST_ADDRESS & 0xFF};
+
+    system_delay_init();
+    sim_test_result = w25q64_init();
+    w25q64_read_data(0, sim_test_long, SIM_LONG_LENGTH);                       //  65535 + 4465
+
+    gpio_low(W25Q64_CS_PIN);                                                    // 16 λ֡ȡ ֽǰ
+    spi_write_8bit_array(W25Q64_SPI, read_cmd, 4);
+    spi_read_16bit_array(W25Q64_SPI, sim_test_word, 4);
+    gpio_high(W25Q64_CS_PIN);
+
+    w25q64_sector_erase(SIM_W25Q64_TEST_ADDRESS);
+    gpio_low(W25Q64_CS_PIN);
+    spi_write_8bit(W25Q64_SPI, W25Q64_WRITE_ENABLE);                          // 16 λ֮֡ٷ 8 λ ֡Ҫл
+    gpio_high(W25Q64_CS_PIN);
+    gpio_low(W25Q64_CS_PIN);
+    spi_write_8bit_array(W25Q64_SPI, program_cmd, 4);
+    spi_write_16bit_repeat(W25Q64_SPI, 0x5AA5, 128);                           // Դַ һҳ
+    gpio_high(W25Q64_CS_PIN);
+}
+
+static uint8 sim_case_spi_long_check (void)
+{
+    for(uint32 i = 0; i < 4; i ++)
+    {
+        if(sim_test_word[i] != ((sim_test_w25q64.memory[0x10 + i * 2] << 8) | sim_test_w25q64.memory[0x11 + i * 2]))
+        {
+            return 1;
+        }
+    }
+    for(uint32 i = 0; i < 256; i ++)
+    {
+        if(sim_test_w25q64.memory[SIM_W25Q64_TEST_ADDRESS + i] != ((i & 1) ? 0xA5 : 0x5A))
+        {
+            return 1;
+        }
+    }
+    for(uint32 i = 0; i < SIM_LONG_LENGTH; i ++)
+    {
+        if(sim_test_long[i] != (uint8)(i * 7 + (i >> 8)))                       // Եַҳѱд ԭͼȽ
+        {
+            return 1;
+        }
+    }
+    return (sim_test_result || 1 != sim_test_w25q64.program_count);
+}
+
+//====================================================IIC====================================================
+static sim_i2c_register_struct sim_test_imu;
+static iic_xfer_struct      sim_test_iic_xfer[4];
+static uint16               sim_test_iic_word[2];
+
+static void sim_case_iic_callback (iic_xfer_struct *xfer)
+{
+    (void)xfer;
+    sim_test_callback ++;
+}
+
+static void sim_case_iic_setup (void)
+{
+    sim_i2c_register_init(&sim_test_imu, 0x68);
+    sim_test_pattern(sim_test_imu.memory, 256, 0x21);
+    sim_i2c_attach(I2C1, &sim_test_imu.slave);
+}
+
+static void sim_case_iic_firmware (void)
+{
+    system_delay_init();
+    iic_init(IIC_1, 0x68, 400, IIC1_SCL_PB6, IIC1_SDA_PB7);
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    sim_test_result = 0;
+    sim_test_callback = 0;
+
+    iic_write_8bit_register(IIC_1, 0x6B, 0x01);
+    sim_test_rx[0] = iic_read_8bit_register(IIC_1, 0x6B);                       // ֽڶȡ ADDR ֮ǰ ACK
+    iic_read_8bit_registers(IIC_1, 0x10, &sim_test_rx[1], 2);                   // ֽڶȡ POS ʽ
+
+    sim_test_iic_xfer[0] = (iic_xfer_struct){0x68, 1, 0x3B, NULL, 0, &sim_test_rx[16], 14, 0, sim_case_iic_callback, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+    sim_test_iic_xfer[1] = (iic_xfer_struct){0x68, 1, 0x20, NULL, 0, sim_test_iic_word, 2, IIC_XFER_16BIT, sim_case_iic_callback, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+    sim_test_iic_xfer[2] = (iic_xfer_struct){0x50, 1, 0x00, NULL, 0, &sim_test_rx[40], 4, 0, sim_case_iic_callback, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+    sim_test_iic_xfer[3] = (iic_xfer_struct){0x68, 1, 0x80, NULL, 0, &sim_test_rx[48], 3, 0, sim_case_iic_callback, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+    for(uint32 i = 0; i < 4; i ++)
+    {
+        sim_test_result |= iic_submit(IIC_1, &sim_test_iic_xfer[i]);
+    }
+    sim_test_pending = iic_pending(IIC_1);                                      // ύ ֮жƽ
+    iic_flush(IIC_1);
+}
+
+static uint8 sim_case_iic_check (void)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        if(sim_test_iic_word[i] != ((sim_test_imu.memory[0x20 + i * 2] << 8) | sim_test_imu.memory[0x21 + i * 2]))
+        {
+            return 1;
+        }
+    }
+    return (sim_test_result || 0 == sim_test_pending || 4 != sim_test_callback ||
+            0x01 != sim_test_imu.memory[0x6B] || 0x01 != sim_test_rx[0] ||
+            memcmp(&sim_test_rx[1], &sim_test_imu.memory[0x10], 2) ||
+            memcmp(&sim_test_rx[16], &sim_test_imu.memory[0x3B], 14) ||
+            memcmp(&sim_test_rx[48], &sim_test_imu.memory[0x80], 3) ||
+            IIC_ERROR_NONE != sim_test_iic_xfer[0].error || IIC_ERROR_NONE != sim_test_iic_xfer[1].error ||
+            IIC_ERROR_NACK != sim_test_iic_xfer[2].error || IIC_ERROR_NONE != sim_test_iic_xfer[3].error ||
+            IIC_XFER_DONE != sim_test_iic_xfer[3].state);
+}
+
+//====================================================IIC ߿====================================================
+static iic_error_enum       sim_test_iic_error[4];
+static uint32               sim_test_iic_polls;
+
+static void sim_case_iic_stuck_setup (void)
+{
+    sim_i2c_register_init(&sim_test_imu, 0x68);
+    sim_test_pattern(sim_test_imu.memory, 256, 0x21);
+    sim_i2c_attach(I2C1, &sim_test_imu.slave);
+    sim_i2c_hold(I2C1, 2);                                                      // ַĴַ֮ ӻס SCL
+    sim_set_timeout(2000ULL * SIM_HCLK_HZ);                                     // ѯָ˱ IIC_TIMEOUT βѯķʱԶʵ
+}
+
+static void sim_case_iic_stuck_firmware (void)
+{
+    system_delay_init();
+    iic_init(IIC_1, 0x68, 400, IIC1_SCL_PB6, IIC1_SDA_PB7);
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+
+    sim_test_iic_error[0] = iic_write_8bit_register(IIC_1, 0x6B, 0x01);        // Ȳչ ʱλ
+    sim_test_iic_error[1] = iic_get_error(IIC_1);
+    sim_test_rx[0] = iic_read_8bit_register(IIC_1, 0x6B);                       // λ߻ָ
+    sim_test_iic_error[2] = iic_get_error(IIC_1);
+    sim_test_iic_error[3] = iic_read_8bit_registers(IIC_1, 0x3B, &sim_test_rx[16], 14);
+
+    sim_i2c_hold(I2C1, 2);                                                      // 첽ٿһ ڵõ iic_poll жʱ
+    sim_test_iic_xfer[0] = (iic_xfer_struct){0x68, 1, 0x10, NULL, 0, &sim_test_rx[32], 4, 0, NULL, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+    sim_test_iic_xfer[1] = (iic_xfer_struct){0x68, 1, 0x20, NULL, 0, &sim_test_rx[40], 4, 0, NULL, NULL, IIC_XFER_IDLE, IIC_ERROR_NONE};
+    iic_submit(IIC_1, &sim_test_iic_xfer[0]);
+    iic_submit(IIC_1, &sim_test_iic_xfer[1]);
+    for (sim_test_iic_polls = 0; sim_test_iic_polls < 100 && IIC_XFER_DONE != sim_test_iic_xfer[1].state; sim_test_iic_polls ++)
+    {
+        system_delay_ms(1);
+        iic_poll(IIC_1);
+    }
+}
+
+static uint8 sim_case_iic_stuck_check (void)
+{
+    return (IIC_ERROR_TIMEOUT != sim_test_iic_error[0] || IIC_ERROR_TIMEOUT != sim_test_iic_error[1] ||
+            IIC_ERROR_NONE != sim_test_iic_error[2] || IIC_ERROR_NONE != sim_test_iic_error[3] ||
+            0x01 == sim_test_imu.memory[0x6B] || sim_test_imu.memory[0x6B] != sim_test_rx[0] ||
+            memcmp(&sim_test_rx[16], &sim_test_imu.memory[0x3B], 14) ||
+            IIC_XFER_DONE != sim_test_iic_xfer[0].state || IIC_ERROR_TIMEOUT != sim_test_iic_xfer[0].error ||
+            IIC_XFER_DONE != sim_test_iic_xfer[1].state || IIC_ERROR_NONE != sim_test_iic_xfer[1].error ||
+            IIC_POLL_TIMEOUT > sim_test_iic_polls || memcmp(&sim_test_rx[40], &sim_test_imu.memory[0x20], 4));
+}
+
+//====================================================DMA ͨǼ====================================================
+static dma_owner_enum       sim_test_owner[3];
+static dma_channel_enum     sim_test_channel;
+
+static void sim_case_dma_owner_setup (void)
+{
+    sim_i2c_register_init(&sim_test_imu, 0x68);
+    sim_test_pattern(sim_test_imu.memory, 256, 0x52);
+    sim_i2c_attach(I2C2, &sim_test_imu.slave);
+}
+
+static void sim_case_dma_owner_firmware (void)
+{
+    system_delay_init();
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);                     // ռͨ 4/5
+    iic_init(IIC_2, 0x68, 400, IIC2_SCL_PB10, IIC2_SDA_PB11);                   // ͨ 5 ͻ ΪжϽ
+    iic_read_8bit_registers(IIC_2, 0x3B, &sim_test_rx[16], 14);
+    sim_test_owner[0] = dma1_get_owner(dma1_CH5);
+    sim_test_channel = dma1_alloc(DMA_OWNER_MEMORY);
+    sim_test_owner[1] = dma1_get_owner(sim_test_channel);
+    dma1_release(sim_test_channel, DMA_OWNER_MEMORY);
+    sim_test_owner[2] = dma1_get_owner(sim_test_channel);
+}
+
+static uint8 sim_case_dma_owner_check (void)
+{
+    sim_stat_struct stat;
+    sim_stat_get(&stat);
+    return (0 != stat.dma_transfer || memcmp(&sim_test_rx[16], &sim_test_imu.memory[0x3B], 14) ||
+            DMA_OWNER_UART1_RX != sim_test_owner[0] || dma1_CH7 != sim_test_channel ||
+            DMA_OWNER_MEMORY != sim_test_owner[1] || DMA_OWNER_NONE != sim_test_owner[2]);
+}
+
+static uint8                sim_test_uart_rx[32];
+
+static void sim_case_dma_fallback_firmware (void)
+{
+    system_delay_init();
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    dma1_claim(dma1_CH3, DMA_OWNER_UART3_RX);                                  // ռͨ 3/5
+    dma1_claim(dma1_CH5, DMA_OWNER_IIC2_RX);
+    uart_init(UART_1, 115200, UART1_TX_PA9, UART1_RX_PA10);                     // ͨ 5 ͻ ΪжϽ
+    sim_test_result = w25q64_init();                                            // SPI1 ͨ 3 ͻ Ϊѯ
+    sim_test_pattern(sim_test_tx, 256, 0x6D);
+    w25q64_sector_erase(SIM_W25Q64_TEST_ADDRESS);
+    w25q64_page_program(SIM_W25Q64_TEST_ADDRESS, sim_test_tx, 256);
+    w25q64_read_data(SIM_W25Q64_TEST_ADDRESS, sim_test_rx, 256);
+
+    sim_uart_feed(USART1, sim_test_tx, 32);
+    system_delay_ms(5);                                                         // жϽֻڴ ȵ 32 ֽ
+    for(uint32 length = 0; length < 32; )
+    {
+        length += uart_read_buffer(UART_1, &sim_test_uart_rx[length], 32 - length);
+    }
+    sim_test_owner[0] = dma1_get_owner(dma1_CH5);
+    sim_test_owner[1] = dma1_get_owner(dma1_CH2);                               // SPI1 ͨͻ ͨҲǼ
+    sim_test_owner[2] = dma1_get_owner(dma1_CH4);
+}
+
+static uint8 sim_case_dma_fallback_check (void)
+{
+    sim_stat_struct stat;
+    sim_stat_get(&stat);
+    return (sim_test_result || 0 != stat.dma_transfer ||
+            memcmp(sim_test_tx, sim_test_rx, 256) || memcmp(sim_test_tx, &sim_test_w25q64.memory[SIM_W25Q64_TEST_ADDRESS], 256) ||
+            memcmp(sim_test_tx, sim_test_uart_rx, 32) ||
+            DMA_OWNER_IIC2_RX != sim_test_owner[0] || DMA_OWNER_NONE != sim_test_owner[1] ||
+            DMA_OWNER_UART1_TX != sim_test_owner[2]);
+}
+
+//====================================================洢洢====================================================
+static uint8                sim_test_copy_src[4100];
+static uint8                sim_test_copy_dst[4100];
+static uint16               sim_test_copy_line[160];
+static uint8                sim_test_copy_flag[4];
+static uint32               sim_test_copy_pending;
+
+static void sim_case_dma_copy_callback (void *arg)
+{
+    (*(uint8 *)arg) ++;
+}
+
+static void sim_case_dma_copy_firmware (void)
+{
+    system_delay_init();
+    memset(sim_test_copy_dst, 0, sizeof(sim_test_copy_dst));
+    memset(sim_test_copy_flag, 0, sizeof(sim_test_copy_flag));
+    for(uint32 i = 0; i < sizeof(sim_test_copy_src); i ++)
+    {
+        sim_test_copy_src[i] = (uint8)(i * 13 + 5);
+    }
+    sim_test_result  = dma_memcpy_async(sim_test_copy_dst, sim_test_copy_src, 4096, sim_case_dma_copy_callback, &sim_test_copy_flag[0]);             // ֶ ְ
+    sim_test_result |= dma_memcpy_async(&sim_test_copy_dst[4097], &sim_test_copy_src[1], 3, sim_case_dma_copy_callback, &sim_test_copy_flag[1]) << 1;  // зǿ СͬŶ
+    sim_test_result |= dma_memset16_async(sim_test_copy_line, 0xF800, 160, sim_case_dma_copy_callback, &sim_test_copy_flag[2]) << 2;
+    sim_test_copy_pending = dma_copy_pending();
+    dma_copy_wait();
+    sim_test_result |= dma_memcpy_async(&sim_test_tx[1], &sim_test_copy_src[7], 16, sim_case_dma_copy_callback, &sim_test_copy_flag[3]) << 3;  // Ϊ  CPU 
+}
+
+static uint8 sim_case_dma_copy_check (void)
+{
+    for(uint32 i = 0; i < 160; i ++)
+    {
+        if(0xF800 != sim_test_copy_line[i])
+        {
+            return 1;
+        }
+    }
+    return (0x07 != sim_test_result || 3 != sim_test_copy_pending ||
+            1 != sim_test_copy_flag[0] || 1 != sim_test_copy_flag[1] || 1 != sim_test_copy_flag[2] || 1 != sim_test_copy_flag[3] ||
+            memcmp(sim_test_copy_dst, sim_test_copy_src, 4096) || 0 != sim_test_copy_dst[4096] ||
+            memcmp(&sim_test_copy_dst[4097], &sim_test_copy_src[1], 3) || memcmp(&sim_test_tx[1], &sim_test_copy_src[7], 16));
+}
+
+//==================================================== IIC====================================================
+static sim_i2c_register_struct sim_test_soft_imu[2];
+static soft_iic_info_struct sim_test_soft_iic[2];
+static iic_error_enum       sim_test_soft_error[5];
+static uint8                sim_test_soft_level;
+
+static void sim_case_soft_iic_setup (void)
+{
+    sim_i2c_register_init(&sim_test_soft_imu[0], 0x68);
+    sim_test_pattern(sim_test_soft_imu[0].memory, 256, 0x35);
+    sim_i2c_gpio_attach(GPIOB, GPIO_Pin_8, GPIOB, GPIO_Pin_9, &sim_test_soft_imu[0].slave, 200);
+    sim_i2c_gpio_stuck(&sim_test_soft_imu[0].slave, 5);                        // ϴζȡλ ʣ 5  bit û
+    sim_i2c_register_init(&sim_test_soft_imu[1], 0x69);                         // Ӧһֱ SCL
+    sim_i2c_gpio_attach(GPIOB, GPIO_Pin_8, GPIOB, GPIO_Pin_9, &sim_test_soft_imu[1].slave, SIM_I2C_STRETCH_FOREVER);
+}
+
+static void sim_case_soft_iic_firmware (void)
+{
+    memset(sim_test_rx, 0, sizeof(sim_test_rx));
+    soft_iic_init(&sim_test_soft_iic[0], 0x68, SOFT_IIC_DELAY_400KHZ, PB8, PB9);  // SDA  Ȼָ
+    sim_test_soft_level = sim_gpio_get(GPIOB, GPIO_Pin_9);
+    soft_iic_set_stretch(&sim_test_soft_iic[0], 20);
+
+    sim_test_soft_error[0] = soft_iic_write_8bit_register(&sim_test_soft_iic[0], 0x6B, 0x01);
+    sim_test_rx[0] = soft_iic_read_8bit_register(&sim_test_soft_iic[0], 0x6B);
+    sim_test_soft_error[1] = soft_iic_read_8bit_registers(&sim_test_soft_iic[0], 0x3B, &sim_test_rx[16], 14);
+
+    sim_test_soft_iic[1] = sim_test_soft_iic[0];
+    sim_test_soft_iic[1].addr = 0x50;                                           // ڵ
+    sim_test_soft_error[2] = soft_iic_write_8bit_register(&sim_test_soft_iic[1], 0x00, 0x55);
+    sim_test_rx[1] = soft_iic_read_8bit_register(&sim_test_soft_iic[1], 0x00);
+    sim_test_soft_error[3] = sim_test_soft_iic[1].error;
+
+    sim_test_soft_iic[1].addr = 0x69;
+    soft_iic_set_stretch(&sim_test_soft_iic[1], 20);
+    sim_test_soft_error[4] = soft_iic_write_8bit_register(&sim_test_soft_iic[1], 0x00, 0x55);
+}
+
+static uint8 sim_case_soft_iic_check (void)
+{
+    return (1 != sim_test_soft_level ||
+            IIC_ERROR_NONE != sim_test_soft_error[0] || IIC_ERROR_NONE != sim_test_soft_error[1] ||
+            IIC_ERROR_NACK != sim_test_soft_error[2] || IIC_ERROR_NACK != sim_test_soft_error[3] ||
+            IIC_ERROR_TIMEOUT != sim_test_soft_error[4] ||
+            0x01 != sim_test_soft_imu[0].memory[0x6B] || 0x01 != sim_test_rx[0] || 0x00 != sim_test_rx[1] ||
+            memcmp(&sim_test_rx[16], &sim_test_soft_imu[0].memory[0x3B], 14) ||
+            0x55 == sim_test_soft_imu[1].memory[0x00]);
+}
+
+//==================================================== SPI====================================================
+SOFT_SPI_FAST_DEFINE(sim_test_soft_spi_fast, PB13, PB15, PB14, 0, 0)
+
+static soft_spi_info_struct sim_test_soft_spi[2];
+static uint8                sim_test_soft_rx[4];
+
+static void sim_case_soft_spi_firmware (void)
+{
+    soft_spi_init(&sim_test_soft_spi[0], 0, 0, PB13, PB15, PB14, (gpio_pin_enum)SOFT_SPI_PIN_NULL);
+    soft_spi_init(&sim_test_soft_spi[1], 0, 0, PB13, PB15, PB14, (gpio_pin_enum)SOFT_SPI_PIN_NULL);
+    soft_spi_set_fast(&sim_test_soft_spi[1], sim_test_soft_spi_fast);
+
+    sim_gpio_set_input(GPIOB, GPIO_Pin_14, 1);
+    sim_test_soft_rx[0] = soft_spi_read_8bit(&sim_test_soft_spi[0]);
+    sim_test_soft_rx[1] = soft_spi_read_8bit(&sim_test_soft_spi[1]);
+    sim_gpio_set_input(GPIOB, GPIO_Pin_14, 0);
+    sim_test_soft_rx[2] = soft_spi_read_8bit(&sim_test_soft_spi[0]);
+    sim_test_soft_rx[3] = soft_spi_read_8bit(&sim_test_soft_spi[1]);
+    soft_spi_write_8bit(&sim_test_soft_spi[1], 0x5B);                           // һλΪ 1
+}
+
+static uint8 sim_case_soft_spi_check (void)
+{
+    return (0xFF != sim_test_soft_rx[0] || 0xFF != sim_test_soft_rx[1] ||
+            0x00 != sim_test_soft_rx[2] || 0x00 != sim_test_soft_rx[3] ||
+            0 != sim_gpio_get(GPIOB, GPIO_Pin_13) ||                            // ģʽ 0 SCK صе͵ƽ
+            1 != sim_gpio_get(GPIOB, GPIO_Pin_15));
+}
+
+//====================================================ڲ FLASH====================================================
+static void sim_case_flash_firmware (void)
+{
+    system_delay_init();
+    flash_erase_page(SIM_FLASH_TEST_PAGE);
+    for(uint32 i = 0; i < FLASH_PAGE_SIZE / 4; i ++)
+    {
+        flash_union_buffer[i].uint32_type = 0x12345678 + i;
+    }
+    sim_test_result = flash_write_page_from_buffer(SIM_FLASH_TEST_PAGE);
+}
+
+static uint8 sim_case_flash_check (void)
+{
+    const uint32 *page = (const uint32 *)FLASH_PAGE(SIM_FLASH_TEST_PAGE);
+    if(sim_test_result)
+    {
+        return 1;
+    }
+    for(uint32 i = 0; i < FLASH_PAGE_SIZE / 4; i ++)
+    {
+        if(page[i] != 0x12345678 + i)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//====================================================TFT180====================================================
+static void sim_case_tft180_setup (void)
+{
+    sim_test_lcd.framebuffer = sim_test_framebuffer;
+    sim_lcd_init(&sim_test_lcd, SIM_TFT180_GRAM_WIDTH, SIM_TFT180_GRAM_HEIGHT, GPIOB, GPIO_Pin_0);
+    sim_spi_attach(SPI2, GPIOB, GPIO_Pin_12, &sim_test_lcd.slave);
+}
+
+static void sim_case_tft180_firmware (void)
+{
+    system_delay_init();
+    tft180_init();
+    tft180_draw_point(10, 20, RGB565_BLUE);
+    tft180_show_string(0, 0, "SIM");
+}
+
+static uint8 sim_case_tft180_check (void)
+{
+    uint32 pen = 0;
+    for(uint32 y = 0; y < 16; y ++)
+    {
+        for(uint32 x = 0; x < 8 * 3; x ++)
+        {
+            pen += (RGB565_RED == SIM_TFT180_PIXEL(x, y));                      // "SIM" 
+        }
+    }
+    return (0 == pen ||
+            RGB565_BLUE != SIM_TFT180_PIXEL(10, 20) ||
+            RGB565_WHITE != SIM_TFT180_PIXEL(127, 159) ||
+            RGB565_WHITE != SIM_TFT180_PIXEL(0, 0));
+}
+
+//====================================================LCD ====================================================
+static lcd_canvas_struct    sim_test_canvas;
+static uint8                sim_test_canvas_buffer[LCD_CANVAS_BUFFER_SIZE(128, 32)];
+static uint32               sim_test_canvas_window[3];
+static uint32               sim_test_canvas_pixel[3];
+static uint64_t             sim_test_canvas_frame[2];
+
+static void sim_case_canvas_firmware (void)
+{
+    system_delay_init();
+    tft180_init();
+    lcd_canvas_init(&sim_test_canvas, sim_test_canvas_buffer, 0, 32, 128, 32, tft180_write_window);
+    lcd_canvas_set_color(&sim_test_canvas, RGB565_BLUE, RGB565_WHITE);
+
+    lcd_canvas_show_string(&sim_test_canvas, 0, 0, "RPM");
+    lcd_canvas_show_uint(&sim_test_canvas, 32, 0, 123, 3);
+    sim_test_canvas_pixel[0] = sim_test_lcd.pixel_count;
+    sim_test_canvas_window[0] = lcd_canvas_flush(&sim_test_canvas);             // ״ˢ ϲΪһ
+    sim_test_canvas_pixel[0] = sim_test_lcd.pixel_count - sim_test_canvas_pixel[0];
+
+    sim_test_canvas_frame[0] = sim_spi_frame_count(SPI2);
+    lcd_canvas_show_string(&sim_test_canvas, 0, 0, "RPM");                      // ػͬ Ӧ
+    lcd_canvas_show_uint(&sim_test_canvas, 32, 0, 123, 3);
+    sim_test_canvas_window[1] = lcd_canvas_flush(&sim_test_canvas);
+    sim_test_canvas_frame[1] = sim_spi_frame_count(SPI2);
+
+    lcd_canvas_show_uint(&sim_test_canvas, 32, 0, 124, 3);                     // ֻһλ λڵ 3 п
+    sim_test_canvas_pixel[2] = sim_test_lcd.pixel_count;
+    sim_test_canvas_window[2] = lcd_canvas_flush(&sim_test_canvas);
+    sim_test_canvas_pixel[2] = sim_test_lcd.pixel_count - sim_test_canvas_pixel[2];
+}
+
+static uint8 sim_case_canvas_check (void)
+{
+    uint32 pen = 0, differ = 0;
+    for(uint32 y = 0; y < 32; y ++)
+    {
+        for(uint32 x = 0; x < 128; x ++)
+        {
+            const uint8 *pixel = &sim_test_canvas_buffer[(y * 128 + x) * 2];
+            pen += (RGB565_BLUE == SIM_TFT180_PIXEL(x, y + 32));
+            differ += (((pixel[0] << 8) | pixel[1]) != SIM_TFT180_PIXEL(x, y + 32));   // Ļ뻭һ
+        }
+    }
+    return (0 == pen ||
+            1 != sim_test_canvas_window[0] || 128 * 32 != sim_test_canvas_pixel[0] ||
+            0 != sim_test_canvas_window[1] || sim_test_canvas_frame[0] != sim_test_canvas_frame[1] ||
+            1 != sim_test_canvas_window[2] || 16 * 16 != sim_test_canvas_pixel[2] ||
+            0 != differ ||
+            RGB565_WHITE != SIM_TFT180_PIXEL(127, 63) || RGB565_WHITE != SIM_TFT180_PIXEL(0, 31));
+}
+
+//====================================================LCD λ====================================================
+static uint32               sim_test_glyph_command[2];
+static uint32               sim_test_glyph_pixel;
+static uint32               sim_test_glyph_hit;
+static uint32               sim_test_glyph_miss;
+
+#define SIM_TEST_GLYPH_RUNS(count, pixel)   (((count) + LCD_GLYPH_RUN_BUFFER_SIZE / ((pixel) * 2) - 1) / (LCD_GLYPH_RUN_BUFFER_SIZE / ((pixel) * 2)))  // ֳַɵĴ
+
+static void sim_case_glyph_firmware (void)
+{
+    system_delay_init();
+    tft180_init();
+    tft180_set_color(RGB565_BLUE, RGB565_WHITE);
+
+    sim_test_glyph_command[0] = sim_test_lcd.command_count;
+    sim_test_glyph_pixel = sim_test_lcd.pixel_count;
+    tft180_show_string(0, 0, "0123456789");                                     // 10  8x16 ַ ÿ LCD_GLYPH_RUN_BUFFER_SIZE / 256 
+    sim_test_glyph_command[0] = sim_test_lcd.command_count - sim_test_glyph_command[0];
+    sim_test_glyph_pixel = sim_test_lcd.pixel_count - sim_test_glyph_pixel;
+
+    tft180_set_font(TFT180_6X8_FONT);
+    sim_test_glyph_command[1] = sim_test_lcd.command_count;
+    tft180_show_string(0, 20, "Az~");                                           // '~'  6x8 ֿ ոʾ
+    sim_test_glyph_command[1] = sim_test_lcd.command_count - sim_test_glyph_command[1];
+    tft180_set_font(TFT180_8X16_FONT);
+    tft180_show_char(0, 40, '7');                                               // л
+
+    lcd_glyph_clear_stats();
+    for(uint32 i = 0; i < 4; i ++)
+    {
+        tft180_show_string(0, 60, "-0123456789. ");                             // ֶε 13 ѭˢ
+    }
+    lcd_glyph_get_stats(&sim_test_glyph_hit, &sim_test_glyph_miss);
+}
+
+static uint8 sim_test_glyph_compare (uint32 x, uint32 y, uint8 font, char dat)
+{
+    uint32 width = LCD_GLYPH_WIDTH(font), height = LCD_GLYPH_HEIGHT(font);
+    uint8 ch = (uint8)dat;
+    for(uint32 i = 0; i < width; i ++)
+    {
+        uint16 column = (LCD_GLYPH_6X8_FONT == font) ?
+                        ascii_font_6x8[(0x20 > ch || 'z' < ch) ? 0 : ch - 32][i] :
+                        (uint16)(ascii_font_8x16[ch - 32][i] | (ascii_font_8x16[ch - 32][i + 8] << 8));
+        for(uint32 j = 0; j < height; j ++)
+        {
+            if(SIM_TFT180_PIXEL(x + i, y + j) != (((column >> j) & 0x01) ? RGB565_BLUE : RGB565_WHITE))
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static uint8 sim_case_glyph_check (void)
+{
+    uint8 differ = 0;
+    for(uint32 k = 0; k < 10; k ++)
+    {
+        differ |= sim_test_glyph_compare(k * 8, 0, LCD_GLYPH_8X16_FONT, (char)('0' + k));
+    }
+    differ |= sim_test_glyph_compare(0, 20, LCD_GLYPH_6X8_FONT, 'A');
+    differ |= sim_test_glyph_compare(6, 20, LCD_GLYPH_6X8_FONT, 'z');
+    differ |= sim_test_glyph_compare(12, 20, LCD_GLYPH_6X8_FONT, ' ');
+    differ |= sim_test_glyph_compare(0, 40, LCD_GLYPH_8X16_FONT, '7');
+    differ |= sim_test_glyph_compare(0, 60, LCD_GLYPH_8X16_FONT, '-');
+    differ |= sim_test_glyph_compare(88, 60, LCD_GLYPH_8X16_FONT, '.');
+    return (0 != differ ||
+            3 != sim_test_glyph_miss || 13 * 4 - 3 != sim_test_glyph_hit ||        // ֻ '-' '.' ' ' ״δ ڻ
+            SIM_TEST_GLYPH_RUNS(10, 8 * 16) * 3 != sim_test_glyph_command[0] || 10 * 8 * 16 != sim_test_glyph_pixel ||
+            SIM_TEST_GLYPH_RUNS(3, 6 * 8) * 3 != sim_test_glyph_command[1]);
+}
+
+//====================================================TFT180 ====================================================
+static uint32               sim_test_fill_pixel[2];
+
+static void sim_case_fill_firmware (void)
+{
+    system_delay_init();
+    tft180_init();
+
+    sim_test_fill_pixel[0] = sim_test_lcd.pixel_count;
+    tft180_full(RGB565_GREEN);
+    sim_test_fill_pixel[0] = sim_test_lcd.pixel_count - sim_test_fill_pixel[0];
+
+    sim_test_fill_pixel[1] = sim_test_lcd.pixel_count;
+    tft180_fill_rect(10, 100, 30, 20, RGB565_RED);
+    tft180_fill_rect(0, 0, 0, 5, RGB565_RED);                                   // Ϊ 0 
+    sim_test_fill_pixel[1] = sim_test_lcd.pixel_count - sim_test_fill_pixel[1];
+}
+
+static uint8 sim_case_fill_check (void)
+{
+    uint32 differ = 0;
+    for(uint32 y = 0; y < 160; y ++)
+    {
+        for(uint32 x = 0; x < 128; x ++)
+        {
+            uint16 expect = (10 <= x && 40 > x && 100 <= y && 120 > y) ? RGB565_RED : RGB565_GREEN;
+            differ += (expect != SIM_TFT180_PIXEL(x, y));
+        }
+    }
+    return (0 != differ || 128 * 160 != sim_test_fill_pixel[0] || 30 * 20 != sim_test_fill_pixel[1]);
+}
+
+//====================================================LCD ͼ====================================================
+static uint8                sim_test_gray_image[40][64];
+static uint16               sim_test_rgb_image[8][16];
+static uint8                sim_test_binary_image[8][16 / 8];
+
+static void sim_case_image_firmware (void)
+{
+    for(uint32 y = 0; y < 40; y ++)
+    {
+        for(uint32 x = 0; x < 64; x ++)
+        {
+            sim_test_gray_image[y][x] = (uint8)(x * 4 + y * 3);
+        }
+    }
+    for(uint32 y = 0; y < 8; y ++)
+    {
+        for(uint32 x = 0; x < 16; x ++)
+        {
+            sim_test_rgb_image[y][x] = (uint16)(0x1234 * (x + 1) + y * 0x0811) & 0xFFFF;
+        }
+        sim_test_binary_image[y][0] = (uint8)(0xA5 ^ y);
+        sim_test_binary_image[y][1] = (uint8)(0x3C + y);
+    }
+
+    system_delay_init();
+    tft180_init();
+    tft180_show_gray_image(0, 0, sim_test_gray_image[0], 64, 40, 96, 60, 0);   // Ŵʾ ж
+    tft180_show_gray_image(0, 64, sim_test_gray_image[0], 64, 40, 96, 20, 100); // ֱӸ
+    tft180_show_rgb565_image(0, 90, sim_test_rgb_image[0], 16, 8, 32, 16, 0);
+    tft180_show_binary_image(40, 90, sim_test_binary_image[0], 16, 8, 16, 8);
+}
+
+static uint8 sim_case_image_check (void)
+{
+    uint32 differ = 0;
+    for(uint32 j = 0; j < 60; j ++)
+    {
+        for(uint32 i = 0; i < 96; i ++)
+        {
+            uint8 gray = sim_test_gray_image[j * 40 / 60][i * 64 / 96];
+            differ += (SIM_TFT180_PIXEL(i, j) != (((gray >> 3) << 11) | ((gray >> 2) << 5) | (gray >> 3)));
+        }
+    }
+    for(uint32 j = 0; j < 20; j ++)
+    {
+        for(uint32 i = 0; i < 96; i ++)
+        {
+            uint8 gray = sim_test_gray_image[j * 40 / 20][i * 64 / 96];
+            differ += (SIM_TFT180_PIXEL(i, j + 64) != ((gray < 100) ? RGB565_BLACK : RGB565_WHITE));
+        }
+    }
+    for(uint32 j = 0; j < 16; j ++)
+    {
+        for(uint32 i = 0; i < 32; i ++)
+        {
+            differ += (SIM_TFT180_PIXEL(i, j + 90) != sim_test_rgb_image[j / 2][i / 2]);
+        }
+    }
+    for(uint32 j = 0; j < 8; j ++)
+    {
+        for(uint32 i = 0; i < 16; i ++)
+        {
+            uint8 bit = (sim_test_binary_image[j][i / 8] << (i % 8)) & 0x80;
+            differ += (SIM_TFT180_PIXEL(i + 40, j + 90) != (bit ? RGB565_WHITE : RGB565_BLACK));
+        }
+    }
+    return (0 != differ);
+}
+
+//====================================================OLED Դ滺====================================================
+static uint32               sim_test_oled_data[4];
+static uint8                sim_test_oled_page[3];
+
+static void sim_case_oled_setup (void)
+{
+    sim_oled_init(&sim_test_oled, GPIOA, GPIO_Pin_1);
+    sim_spi_attach(SPI2, GPIOB, GPIO_Pin_12, &sim_test_oled.slave);
+}
+
+static void sim_case_oled_firmware (void)
+{
+    system_delay_init();
+    oled_init();
+    sim_test_oled_data[0] = sim_test_oled.data_count;                           // ʼʱ
+
+    sim_test_oled_data[1] = sim_test_oled.data_count;
+    oled_show_string(0, 0, "SIM");
+    oled_draw_pixel(100, 42, 1);
+    oled_draw_pixel(100, 43, 1);
+    sim_test_oled_data[1] = sim_test_oled.data_count - sim_test_oled_data[1];   // ֻд RAM
+    sim_test_oled_data[2] = sim_test_oled.data_count;
+    sim_test_oled_page[0] = oled_flush();
+    sim_test_oled_data[2] = sim_test_oled.data_count - sim_test_oled_data[2];
+
+    oled_show_string(0, 0, "SIM");                                              // ݲ 
+    oled_draw_pixel(100, 42, 1);
+    sim_test_oled_page[1] = oled_flush();
+
+    sim_test_oled_data[3] = sim_test_oled.data_count;
+    oled_show_string(0, 0, "SIN");                                              // ֻһַı
+    oled_draw_pixel(100, 43, 0);
+    sim_test_oled_page[2] = oled_flush();
+    sim_test_oled_data[3] = sim_test_oled.data_count - sim_test_oled_data[3];
+
+    oled_set_font(OLED_8X16_FONT);
+    oled_show_string(112, 7, "ABC");                                            // һҳֻʾϰ벿 к󳬳ײ C ʾ
+    oled_flush();
+}
+
+static uint32 sim_case_oled_span (const uint8 *a, const uint8 *b, uint32 length)
+{
+    uint32 first = length, last = 0;
+    for(uint32 i = 0; i < length; i ++)
+    {
+        if(a[i] != b[i])
+        {
+            first = (first < i) ? first : i;
+            last = i + 1;
+        }
+    }
+    return (last > first) ? (last - first) : 0;
+}
+
+static uint8 sim_case_oled_check (void)
+{
+    static const uint8 blank[18] = {0};
+    uint8 expect[8][128];
+    uint8 line[2][18];
+
+    for(uint32 i = 0; i < 6; i ++)
+    {
+        line[0][i] = line[1][i] = ascii_font_6x8['S' - 32][i];
+        line[0][i + 6] = line[1][i + 6] = ascii_font_6x8['I' - 32][i];
+        line[0][i + 12] = ascii_font_6x8['M' - 32][i];
+        line[1][i + 12] = ascii_font_6x8['N' - 32][i];
+    }
+    memset(expect, 0, sizeof(expect));
+    memcpy(expect[0], line[1], 18);
+    expect[5][100] = 0x01 << (42 % 8);
+    memcpy(&expect[7][112], ascii_font_8x16['A' - 32], 8);
+    memcpy(&expect[7][120], ascii_font_8x16['B' - 32], 8);
+
+    return (1024 != sim_test_oled_data[0] || 0 != sim_test_oled_data[1] ||
+            2 != sim_test_oled_page[0] || sim_case_oled_span(blank, line[0], 18) + 1 != sim_test_oled_data[2] ||
+            0 != sim_test_oled_page[1] ||
+            2 != sim_test_oled_page[2] || sim_case_oled_span(line[0], line[1], 18) + 1 != sim_test_oled_data[3] ||
+            memcmp(expect, sim_test_oled.gram, sizeof(expect)));
+}
+
+static const sim_case_struct sim_case_table[] =
+{
+    {"uart1_tx_64byte_115200",      NULL,                   sim_case_uart_tx_firmware,  sim_case_uart_tx_check},
+    {"uart1_rx_dma_64byte_115200",  NULL,                   sim_case_uart_rx_firmware,  sim_case_uart_rx_check},
+    {"uart1_rx_dma_read_buffer",    NULL,                   sim_case_uart_rx_buffer_firmware, sim_case_uart_rx_buffer_check},
+    {"uart1_tx_dma_async_600byte",  NULL,                   sim_case_uart_tx_dma_firmware, sim_case_uart_tx_dma_check},
+    {"uart1_read_line_crlf",        NULL,                   sim_case_uart_line_firmware, sim_case_uart_line_check},
+    {"uart1_read_line_mixed_overrun", NULL,                 sim_case_uart_line_mixed_firmware, sim_case_uart_line_mixed_check},
+    {"uart2_user_buffer_64_32byte", NULL,                   sim_case_uart_user_buffer_firmware, sim_case_uart_user_buffer_check},
+    {"uart1_2mbaud_8e2",            NULL,                   sim_case_uart_config_firmware, sim_case_uart_config_check},
+    {"uart1_stats_error_overflow",  NULL,                   sim_case_uart_stats_firmware, sim_case_uart_stats_check},
+    {"profile_uart1_rx_idle",       NULL,                   sim_case_profile_firmware,  sim_case_profile_check},
+    {"w25q64_erase_program_read",   sim_case_w25q64_setup,  sim_case_w25q64_firmware,   sim_case_w25q64_check},
+    {"spi1_async_queue_w25q64_read", sim_case_spi_async_setup, sim_case_spi_async_firmware, sim_case_spi_async_check},
+    {"spi1_shared_bus_two_devices", sim_case_spi_device_setup, sim_case_spi_device_firmware, sim_case_spi_device_check},
+    {"spi1_16bit_long_repeat_dma",  sim_case_spi_long_setup, sim_case_spi_long_firmware, sim_case_spi_long_check},
+    {"iic1_async_register_read_dma", sim_case_iic_setup, sim_case_iic_firmware, sim_case_iic_check},
+    {"iic1_stuck_bus_timeout_reset", sim_case_iic_stuck_setup, sim_case_iic_stuck_firmware, sim_case_iic_stuck_check},
+    {"dma1_owner_conflict_fallback", sim_case_dma_owner_setup, sim_case_dma_owner_firmware, sim_case_dma_owner_check},
+    {"uart_spi_dma_conflict_fallback", sim_case_w25q64_setup, sim_case_dma_fallback_firmware, sim_case_dma_fallback_check},
+    {"dma_memcpy_memset16_async",   NULL,                   sim_case_dma_copy_firmware, sim_case_dma_copy_check},
+    {"soft_iic_recover_stretch_nack", sim_case_soft_iic_setup, sim_case_soft_iic_firmware, sim_case_soft_iic_check},
+    {"soft_spi_fast_path_mode0",    NULL,                   sim_case_soft_spi_firmware, sim_case_soft_spi_check},
+    {"flash_erase_write_page",      NULL,                   sim_case_flash_firmware,    sim_case_flash_check},
+    {"tft180_init_draw",            sim_case_tft180_setup,  sim_case_tft180_firmware,   sim_case_tft180_check},
+    {"tft180_canvas_dirty_flush",   sim_case_tft180_setup,  sim_case_canvas_firmware,   sim_case_canvas_check},
+    {"tft180_glyph_cache_string",   sim_case_tft180_setup,  sim_case_glyph_firmware,    sim_case_glyph_check},
+    {"tft180_fill_rect_repeat_dma", sim_case_tft180_setup,  sim_case_fill_firmware,     sim_case_fill_check},
+    {"tft180_image_scaled_pingpong", sim_case_tft180_setup, sim_case_image_firmware,    sim_case_image_check},
+    {"oled_frame_buffer_dirty_flush", sim_case_oled_setup,  sim_case_oled_firmware,     sim_case_oled_check},
+    {NULL,                          NULL,                   NULL,                       NULL},
+};
+
+int main (int argc, char *argv[])
+{
+    const char *filter = NULL;
+    uint8 csv = 0;
+    uint32 fail = 0;
+
+    for(int i = 1; i < argc; i ++)
+    {
+        if(0 == strcmp(argv[i], "-f") && (i + 1) < argc)
+        {
+            filter = argv[++ i];
+        }
+        else if(0 == strcmp(argv[i], "--csv"))
+        {
+            csv = 1;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-f filter] [--csv]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(csv)
+    {
+        printf("name,cycles,us,bus_read,bus_write,bus_cycles,dma_transfer,irq,result\n");
+    }
+    else
+    {
+        printf("%-32s %12s %10s %8s %8s %9s %8s %6s %6s\n", "scenario", "cycles", "us", "rd", "wr", "bus", "dma", "irq", "result");
+    }
+
+    for(const sim_case_struct *c = sim_case_table; NULL != c->name; c ++)
+    {
+        sim_stat_struct stat;
+        uint8 result;
+
+        if(NULL != filter && NULL == strstr(c->name, filter))
+        {
+            continue;
+        }
+        sim_init();
+        for(uint32 ch = dma1_CH1; ch <= dma1_CH7; ch ++)                       // ÿ൱ϵ ͷϸǼǵ DMA ͨ
+        {
+            dma1_release((dma_channel_enum)ch, dma1_get_owner((dma_channel_enum)ch));
+        }
+        if(NULL != c->setup)
+        {
+            c->setup();
+        }
+        sim_run(c->firmware);
+        sim_stat_get(&stat);
+        result = c->check();
+        fail += result;
+
+        if(csv)
+        {
+            printf("%s,%llu,%.1f,%llu,%llu,%llu,%llu,%llu,%s\n", c->name,
+                   (unsigned long long)stat.cycles, (double)stat.cycles / SIM_CYCLES_PER_US,
+                   (unsigned long long)stat.bus_read, (unsigned long long)stat.bus_write, (unsigned long long)stat.bus_cycles,
+                   (unsigned long long)stat.dma_transfer, (unsigned long long)stat.irq, result ? "FAIL" : "PASS");
+        }
+        else
+        {
+            printf("%-32s %12llu %10.1f %8llu %8llu %9llu %8llu %6llu %6s\n", c->name,
+                   (unsigned long long)stat.cycles, (double)stat.cycles / SIM_CYCLES_PER_US,
+                   (unsigned long long)stat.bus_read, (unsigned long long)stat.bus_write, (unsigned long long)stat.bus_cycles,
+                   (unsigned long long)stat.dma_transfer, (unsigned long long)stat.irq, result ? "FAIL" : "PASS");
+        }
+        fflush(stdout);
+    }
+    return fail ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// 湹ǿưͷļ ͨ -include ÿ̼Դļǰ
+// 1. Ȱʵ stm32f10x.h ĴṹַоƬһ
+// 2. ٰʱɵ sim_common_typedef.h  uint32/int32  long Ϊ int ֤ 64 λϿΪ 32 λ
+// 3.  core_cm3.h е Cortex-M3 ָ滻Ϊ溯
+
+#ifndef _sim_port_h_
+#define _sim_port_h_
+
+#include "stm32f10x.h"
+#include "sim_common_typedef.h"
+
+void     sim_enable_irq             (void);
+void     sim_disable_irq            (void);
+void     sim_wait_for_interrupt     (void);
+
+#undef  __enable_irq
+#undef  __disable_irq
+#undef  __NOP
+#undef  __WFI
+#undef  __WFE
+#undef  __SEV
+#undef  __ISB
+#undef  __DSB
+#undef  __DMB
+
+#define __enable_irq()              sim_enable_irq()
+#define __disable_irq()             sim_disable_irq()
+#define __NOP()                     ((void)0)
+#define __WFI()                     sim_wait_for_interrupt()
+#define __WFE()                     sim_wait_for_interrupt()
+#define __SEV()                     ((void)0)
+#define __ISB()                     ((void)0)
+#define __DSB()                     ((void)0)
+#define __DMB()                     __asm__ volatile("" ::: "memory")                 //  ֹֻ
+
+#endif
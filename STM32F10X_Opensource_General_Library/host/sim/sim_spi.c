@@ -0,0 +1,327 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// SPI Ϊģ
+// TX λĴ һ֡ʱ = (8  16) x 2^(BR+1) x APB Ƶ
+// ֡ʱƬѡЧĴ豸 RXNE δʱյ OVRȶ DR ٶ SR 
+// SPE=0 ʱд DR ݱ TX  SPE λſʼλ
+
+#include "sim_internal.h"
+
+#define SIM_SPI_SLAVE_MAX           (4)
+
+typedef struct
+{
+    GPIO_TypeDef    *cs_port;                                                   // NULL ʾһֱѡ
+    uint16          cs_pin;
+    uint8           selected;
+    sim_spi_slave_struct slave;
+}sim_spi_device_struct;
+
+typedef struct
+{
+    uint32      base;
+    int         irq;
+    uint8       apb;
+    uint8       tx_dma_channel;
+    uint8       rx_dma_channel;
+
+    uint8       tdr_full;
+    uint16      tdr;
+    uint8       shifting;
+    uint16      shift;
+    uint64_t    shift_end;
+    uint16      rdr;
+    uint8       ovr_dr_read;                                                    // OVR  Ѷ DR
+    uint64_t    frame_count;
+
+    sim_spi_device_struct device[SIM_SPI_SLAVE_MAX];
+    uint8       device_count;
+}sim_spi_struct;
+
+static sim_spi_struct sim_spi[2] =
+{
+    {SPI1_BASE, SPI1_IRQn, 2, 3, 2},
+    {SPI2_BASE, SPI2_IRQn, 1, 5, 4},
+};
+
+static sim_spi_struct *sim_spi_find (uint32 addr)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        if((addr & ~0x3FFU) == sim_spi[i].base)
+        {
+            return &sim_spi[i];
+        }
+    }
+    return NULL;
+}
+
+static void sim_spi_sr (sim_spi_struct *spi, uint32 set, uint32 clear)
+{
+    SIM_REG(spi->base + 0x08) = (SIM_REG(spi->base + 0x08) & ~clear) | set;
+}
+
+static void sim_spi_busy_update (sim_spi_struct *spi)
+{
+    uint32 cr1 = SIM_REG(spi->base + 0x00);
+    if(spi->shifting || (spi->tdr_full && (cr1 & SPI_CR1_SPE)))
+    {
+        sim_spi_sr(spi, SPI_SR_BSY, 0);
+    }
+    else
+    {
+        sim_spi_sr(spi, 0, SPI_SR_BSY);
+    }
+}
+
+//  SPE ʹ TX  װλĴʼһ֡
+static void sim_spi_kick (sim_spi_struct *spi, uint64_t t)
+{
+    uint32 cr1 = SIM_REG(spi->base + 0x00);
+
+    if((cr1 & SPI_CR1_SPE) && !spi->shifting && spi->tdr_full)
+    {
+        uint32 bits = (cr1 & SPI_CR1_DFF) ? 16 : 8;
+        uint32 divider = 2U << ((cr1 >> 3) & 0x7);
+        spi->shift = spi->tdr;
+        spi->tdr_full = 0;
+        spi->shifting = 1;
+        spi->shift_end = t + (uint64_t)bits * divider * sim_apb_divider(spi->apb);
+        sim_spi_sr(spi, SPI_SR_TXE, 0);
+    }
+    sim_spi_busy_update(spi);
+}
+
+static uint8 sim_spi_exchange (sim_spi_struct *spi, uint8 mosi, uint64_t t)
+{
+    uint8 miso = 0xFF;
+    for(uint32 i = 0; i < spi->device_count; i ++)
+    {
+        sim_spi_device_struct *device = &spi->device[i];
+        if(device->selected && NULL != device->slave.transfer)
+        {
+            miso &= device->slave.transfer(device->slave.context, mosi, t);
+        }
+    }
+    return miso;
+}
+
+static void sim_spi_frame_done (sim_spi_struct *spi, uint64_t t)
+{
+    uint32 cr1 = SIM_REG(spi->base + 0x00);
+    uint16 miso;
+
+    if(cr1 & SPI_CR1_DFF)
+    {
+        miso  = (uint16)sim_spi_exchange(spi, (uint8)(spi->shift >> 8), t) << 8;
+        miso |= sim_spi_exchange(spi, (uint8)spi->shift, t);
+    }
+    else
+    {
+        miso = sim_spi_exchange(spi, (uint8)spi->shift, t);
+    }
+    spi->frame_count ++;
+
+    if(SIM_REG(spi->base + 0x08) & SPI_SR_RXNE)
+    {
+        sim_spi_sr(spi, SPI_SR_OVR, 0);
+    }
+    else
+    {
+        spi->rdr = miso;
+        SIM_REG(spi->base + 0x0C) = miso;
+        sim_spi_sr(spi, SPI_SR_RXNE, 0);
+    }
+    spi->shifting = 0;
+    spi->shift_end = SIM_NEVER;
+    sim_spi_kick(spi, t);
+}
+
+void sim_spi_reset (void)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        sim_spi_struct *spi = &sim_spi[i];
+        spi->tdr_full = 0;
+        spi->shifting = 0;
+        spi->shift_end = SIM_NEVER;
+        spi->rdr = 0;
+        spi->ovr_dr_read = 0;
+        spi->frame_count = 0;
+        spi->device_count = 0;
+        SIM_REG(spi->base + 0x08) = SPI_SR_TXE;
+        SIM_REG(spi->base + 0x10) = 0x0007;
+    }
+}
+
+uint64_t sim_spi_next (void)
+{
+    return sim_spi[0].shift_end < sim_spi[1].shift_end ? sim_spi[0].shift_end : sim_spi[1].shift_end;
+}
+
+void sim_spi_fire (uint64_t t)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        if(sim_spi[i].shift_end <= t)
+        {
+            sim_spi_frame_done(&sim_spi[i], sim_spi[i].shift_end);
+        }
+    }
+}
+
+void sim_spi_read (uint32 addr)
+{
+    sim_spi_struct *spi = sim_spi_find(addr);
+    uint32 offset = addr & 0x3FF;
+
+    if(0x0C == offset)
+    {
+        SIM_REG(addr) = spi->rdr;
+        sim_spi_sr(spi, 0, SPI_SR_RXNE);
+        spi->ovr_dr_read = (SIM_REG(spi->base + 0x08) & SPI_SR_OVR) ? 1 : 0;
+    }
+    else if(0x08 == offset && spi->ovr_dr_read)
+    {
+        spi->ovr_dr_read = 0;
+        sim_spi_sr(spi, 0, SPI_SR_OVR);
+        SIM_REG(addr) |= SPI_SR_OVR;                                            // ζܿ OVR
+    }
+}
+
+void sim_spi_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    sim_spi_struct *spi = sim_spi_find(addr);
+    uint32 offset = addr & 0x3FF;
+
+    switch(offset)
+    {
+        case 0x00:
+        {
+            sim_spi_kick(spi, sim_cur);
+        }break;
+        case 0x08:
+        {
+            uint32 keep = ~SPI_SR_CRCERR | value;                               // ֻ CRCERR д 0 
+            SIM_REG(addr) = old_value & keep;
+        }break;
+        case 0x0C:
+        {
+            uint32 cr1 = SIM_REG(spi->base + 0x00);
+            SIM_REG(addr) = spi->rdr;
+            spi->tdr = (cr1 & SPI_CR1_DFF) ? (value & 0xFFFF) : (value & 0xFF);
+            spi->tdr_full = 1;
+            sim_spi_sr(spi, 0, SPI_SR_TXE);
+            sim_spi_kick(spi, sim_cur);
+        }break;
+        default:
+        {
+        }break;
+    }
+}
+
+void sim_spi_irq (void)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        uint32 sr = SIM_REG(sim_spi[i].base + 0x08);
+        uint32 cr2 = SIM_REG(sim_spi[i].base + 0x04);
+        uint8 level =
+            ((cr2 & SPI_CR2_TXEIE)  && (sr & SPI_SR_TXE))    ||
+            ((cr2 & SPI_CR2_RXNEIE) && (sr & SPI_SR_RXNE))   ||
+            ((cr2 & SPI_CR2_ERRIE)  && (sr & (SPI_SR_OVR | SPI_SR_MODF | SPI_SR_CRCERR)));
+        sim_irq_line(sim_spi[i].irq, level);
+    }
+}
+
+uint8 sim_spi_dma_request (uint8 channel)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        uint32 sr = SIM_REG(sim_spi[i].base + 0x08);
+        uint32 cr2 = SIM_REG(sim_spi[i].base + 0x04);
+        if(channel == sim_spi[i].tx_dma_channel && (cr2 & SPI_CR2_TXDMAEN) && (sr & SPI_SR_TXE))
+        {
+            return 1;
+        }
+        if(channel == sim_spi[i].rx_dma_channel && (cr2 & SPI_CR2_RXDMAEN) && (sr & SPI_SR_RXNE))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void sim_spi_gpio_changed (GPIO_TypeDef *port)
+{
+    for(uint32 i = 0; i < 2; i ++)
+    {
+        for(uint32 j = 0; j < sim_spi[i].device_count; j ++)
+        {
+            sim_spi_device_struct *device = &sim_spi[i].device[j];
+            uint8 selected;
+            if(device->cs_port != port)
+            {
+                continue;
+            }
+            selected = !sim_gpio_get(port, device->cs_pin);
+            if(selected != device->selected)
+            {
+                device->selected = selected;
+                if(NULL != device->slave.select)
+                {
+                    device->slave.select(device->slave.context, selected, sim_cur);
+                }
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       SPI Ϲҽһ豸
+// ˵     *spix           SPI1/SPI2
+// ˵     *cs_port        Ƭѡ˿ NULL ʾ豸һֱѡ
+// ˵     cs_pin          Ƭѡ GPIO_Pin_x ͵ƽЧ
+// ˵     *slave          豸ص
+// ز     uint8           0-ɹ 1-ҽ
+// ʹʾ     sim_spi_attach(SPI1, GPIOA, GPIO_Pin_4, &flash.slave);
+// עϢ      sim_init ֮ sim_init չҽ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 sim_spi_attach (SPI_TypeDef *spix, GPIO_TypeDef *cs_port, uint16 cs_pin, const sim_spi_slave_struct *slave)
+{
+    sim_spi_struct *spi = sim_spi_find((uint32)(uintptr_t)spix);
+    sim_spi_device_struct *device;
+
+    if(NULL == spi || spi->device_count >= SIM_SPI_SLAVE_MAX)
+    {
+        return 1;
+    }
+    sim_lock();
+    device = &spi->device[spi->device_count];
+    device->cs_port = cs_port;
+    device->cs_pin = cs_pin;
+    device->slave = *slave;
+    device->selected = (NULL == cs_port) ? 1 : 0;                              // Ƭѡŵһ͵ƽʱѡ
+    spi->device_count ++;
+    sim_unlock();
+    return 0;
+}
+
+uint64_t sim_spi_frame_count (SPI_TypeDef *spix)
+{
+    sim_spi_struct *spi = sim_spi_find((uint32)(uintptr_t)spix);
+    return (NULL == spi) ? 0 : spi->frame_count;
+}
@@ -0,0 +1,410 @@
+/*********************************************************************************************************************
+* ļSTM32F10X Դһ
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+* ӭλʹò ޸ʱ뱣Ȩ
+*
+*
+* ޸ļ¼
+*                          ע
+* 2026-10-17        Lihua      first version
+********************************************************************************************************************/
+// USART Ϊģ
+//  TDR λĴ һ֡ʱ = BRR x APB Ƶ x (ʼλ + λ + ֹͣλ)
+//  ⲿֽڰ֡ʱ RXNE δʱٵ ORE ֹͣһ֡ IDLE
+// ȶ SR ٶ DR  IDLE/ORE/NE/FE/PE  TC/RXNE д 0 
+
+#include <string.h>
+#include "sim_internal.h"
+
+#define SIM_UART_RX_QUEUE           (4096)
+#define SIM_UART_TX_LOG             (4096)
+
+#define SIM_UART_SR_ERROR           (USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE)
+
+typedef struct
+{
+    uint32      base;
+    int         irq;
+    uint8       apb;
+    uint8       tx_dma_channel;
+    uint8       rx_dma_channel;
+
+    uint8       tdr_full;
+    uint16      tdr;
+    uint8       shifting;
+    uint16      shift;
+    uint64_t    shift_end;
+
+    uint16      rx_queue[SIM_UART_RX_QUEUE];                                    //  8 λ λΪĴ־
+    uint32      rx_head;
+    uint32      rx_count;
+    uint64_t    rx_next;                                                        // һֽڽʱ
+    uint64_t    rx_line_free;                                                   // һ֡ʱ
+    uint64_t    idle_time;
+    uint16      rdr;
+    uint16      sr_latch;                                                       // ϴζ SR ʱĴ/IDLE λ
+
+    uint8       tx_log[SIM_UART_TX_LOG];
+    uint32      tx_log_head;
+    uint32      tx_log_count;
+    uint64_t    tx_total;
+}sim_uart_struct;
+
+static sim_uart_struct sim_uart[3] =
+{
+    {USART1_BASE, USART1_IRQn, 2, 4, 5},
+    {USART2_BASE, USART2_IRQn, 1, 7, 6},
+    {USART3_BASE, USART3_IRQn, 1, 2, 3},
+};
+
+static sim_uart_struct *sim_uart_find (uint32 addr)
+{
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        if((addr & ~0x3FFU) == sim_uart[i].base)
+        {
+            return &sim_uart[i];
+        }
+    }
+    return NULL;
+}
+
+static sim_uart_struct *sim_uart_get (USART_TypeDef *uartx)
+{
+    sim_uart_struct *uart = sim_uart_find((uint32)(uintptr_t)uartx);
+    if(NULL == uart)
+    {
+        sim_fatal("unknown USART %p", (void *)uartx);
+    }
+    return uart;
+}
+
+static uint64_t sim_uart_frame_cycles (sim_uart_struct *uart)
+{
+    static const uint8 stop_half_bits[4] = {2, 1, 4, 3};                        // 1 0.5 2 1.5 ֹͣλ
+    uint32 brr = SIM_REG(uart->base + 0x08) & 0xFFFF;
+    uint32 cr1 = SIM_REG(uart->base + 0x0C);
+    uint32 cr2 = SIM_REG(uart->base + 0x10);
+    uint32 half_bits = 2 * (1 + ((cr1 & USART_CR1_M) ? 9 : 8)) + stop_half_bits[(cr2 >> 12) & 0x3];
+
+    if(brr < 16)
+    {
+        brr = 16;
+    }
+    return (uint64_t)brr * sim_apb_divider(uart->apb) * half_bits / 2;
+}
+
+static void sim_uart_sr (sim_uart_struct *uart, uint32 set, uint32 clear)
+{
+    SIM_REG(uart->base + 0x00) = (SIM_REG(uart->base + 0x00) & ~clear) | set;
+}
+
+void sim_uart_reset (void)
+{
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        sim_uart_struct *uart = &sim_uart[i];
+        uart->tdr_full = 0;
+        uart->shifting = 0;
+        uart->shift_end = SIM_NEVER;
+        uart->rx_head = 0;
+        uart->rx_count = 0;
+        uart->rx_next = SIM_NEVER;
+        uart->rx_line_free = 0;
+        uart->idle_time = SIM_NEVER;
+        uart->rdr = 0;
+        uart->sr_latch = 0;
+        uart->tx_log_head = 0;
+        uart->tx_log_count = 0;
+        uart->tx_total = 0;
+        SIM_REG(uart->base + 0x00) = USART_SR_TXE | USART_SR_TC;
+    }
+}
+
+uint64_t sim_uart_next (void)
+{
+    uint64_t next = SIM_NEVER;
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        if(sim_uart[i].shift_end < next)    next = sim_uart[i].shift_end;
+        if(sim_uart[i].rx_next < next)      next = sim_uart[i].rx_next;
+        if(sim_uart[i].idle_time < next)    next = sim_uart[i].idle_time;
+    }
+    return next;
+}
+
+static void sim_uart_tx_start (sim_uart_struct *uart, uint64_t t)
+{
+    uart->shift = uart->tdr;
+    uart->tdr_full = 0;
+    uart->shifting = 1;
+    uart->shift_end = t + sim_uart_frame_cycles(uart);
+    sim_uart_sr(uart, USART_SR_TXE, USART_SR_TC);
+}
+
+static void sim_uart_tx_done (sim_uart_struct *uart, uint64_t t)
+{
+    uart->tx_log[(uart->tx_log_head + uart->tx_log_count) % SIM_UART_TX_LOG] = (uint8)uart->shift;
+    if(uart->tx_log_count < SIM_UART_TX_LOG)
+    {
+        uart->tx_log_count ++;
+    }
+    else
+    {
+        uart->tx_log_head = (uart->tx_log_head + 1) % SIM_UART_TX_LOG;
+    }
+    uart->tx_total ++;
+
+    if(uart->tdr_full)
+    {
+        sim_uart_tx_start(uart, t);                                             //  ûпλ
+    }
+    else
+    {
+        uart->shifting = 0;
+        uart->shift_end = SIM_NEVER;
+        sim_uart_sr(uart, USART_SR_TC, 0);
+    }
+}
+
+static void sim_uart_rx_done (sim_uart_struct *uart, uint64_t t)
+{
+    uint32 cr1 = SIM_REG(uart->base + 0x0C);
+    uint16 entry = uart->rx_queue[uart->rx_head];
+
+    uart->rx_head = (uart->rx_head + 1) % SIM_UART_RX_QUEUE;
+    uart->rx_count --;
+    uart->rx_line_free = t;
+
+    if((cr1 & USART_CR1_UE) && (cr1 & USART_CR1_RE))
+    {
+        if(SIM_REG(uart->base + 0x00) & USART_SR_RXNE)
+        {
+            sim_uart_sr(uart, USART_SR_ORE, 0);                                 // һֽڻδ ֽڶʧ
+        }
+        else
+        {
+            uart->rdr = entry & 0xFF;
+            SIM_REG(uart->base + 0x04) = uart->rdr;
+            sim_uart_sr(uart, USART_SR_RXNE | ((entry >> 8) & (USART_SR_PE | USART_SR_FE | USART_SR_NE)), 0);
+        }
+    }
+
+    if(uart->rx_count)
+    {
+        uart->rx_next = t + sim_uart_frame_cycles(uart);
+        uart->idle_time = SIM_NEVER;
+    }
+    else
+    {
+        uart->rx_next = SIM_NEVER;
+        uart->idle_time = t + sim_uart_frame_cycles(uart);
+    }
+}
+
+void sim_uart_fire (uint64_t t)
+{
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        sim_uart_struct *uart = &sim_uart[i];
+        if(uart->shift_end <= t)
+        {
+            sim_uart_tx_done(uart, uart->shift_end);
+        }
+        if(uart->rx_next <= t)
+        {
+            sim_uart_rx_done(uart, uart->rx_next);
+        }
+        if(uart->idle_time <= t)
+        {
+            uart->idle_time = SIM_NEVER;
+            if(SIM_REG(uart->base + 0x0C) & USART_CR1_RE)
+            {
+                sim_uart_sr(uart, USART_SR_IDLE, 0);
+            }
+        }
+    }
+}
+
+void sim_uart_read (uint32 addr)
+{
+    sim_uart_struct *uart = sim_uart_find(addr);
+    uint32 offset = addr & 0x3FF;
+
+    if(0x00 == offset)
+    {
+        uart->sr_latch = SIM_REG(addr) & (SIM_UART_SR_ERROR | USART_SR_IDLE);
+    }
+    else if(0x04 == offset)
+    {
+        SIM_REG(addr) = uart->rdr;
+        sim_uart_sr(uart, 0, USART_SR_RXNE | uart->sr_latch);                   // SR  DR  IDLE
+        uart->sr_latch = 0;
+    }
+}
+
+void sim_uart_write (uint32 addr, uint32 old_value, uint32 value)
+{
+    sim_uart_struct *uart = sim_uart_find(addr);
+    uint32 offset = addr & 0x3FF;
+    uint32 cr1 = SIM_REG(uart->base + 0x0C);
+
+    switch(offset)
+    {
+        case 0x00:
+        {
+            uint32 rc_w0 = USART_SR_TC | USART_SR_RXNE | USART_SR_LBD | USART_SR_CTS;
+            SIM_REG(addr) = old_value & ~(rc_w0 & ~value);
+        }break;
+        case 0x04:
+        {
+            SIM_REG(addr) = uart->rdr;                                          // ǽݼĴ
+            if(!(cr1 & USART_CR1_UE) || !(cr1 & USART_CR1_TE))
+            {
+                break;
+            }
+            uart->tdr = value & 0x1FF;
+            uart->tdr_full = 1;
+            sim_uart_sr(uart, 0, USART_SR_TXE | USART_SR_TC);
+            if(!uart->shifting)
+            {
+                sim_uart_tx_start(uart, sim_cur);
+            }
+        }break;
+        case 0x0C:
+        {
+            if(!(value & USART_CR1_UE))
+            {
+                uart->shifting = 0;
+                uart->tdr_full = 0;
+                uart->shift_end = SIM_NEVER;
+            }
+            if((value & USART_CR1_UE) && !(old_value & USART_CR1_UE))
+            {
+                sim_uart_sr(uart, USART_SR_TXE | USART_SR_TC, 0);
+            }
+        }break;
+        default:
+        {
+        }break;
+    }
+}
+
+void sim_uart_irq (void)
+{
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        sim_uart_struct *uart = &sim_uart[i];
+        uint32 sr = SIM_REG(uart->base + 0x00);
+        uint32 cr1 = SIM_REG(uart->base + 0x0C);
+        uint32 cr3 = SIM_REG(uart->base + 0x14);
+        uint8 level =
+            ((cr1 & USART_CR1_TXEIE)    && (sr & USART_SR_TXE))                         ||
+            ((cr1 & USART_CR1_TCIE)     && (sr & USART_SR_TC))                          ||
+            ((cr1 & USART_CR1_RXNEIE)   && (sr & (USART_SR_RXNE | USART_SR_ORE)))       ||
+            ((cr1 & USART_CR1_IDLEIE)   && (sr & USART_SR_IDLE))                        ||
+            ((cr1 & USART_CR1_PEIE)     && (sr & USART_SR_PE))                          ||
+            ((cr3 & USART_CR3_EIE)      && (cr3 & USART_CR3_DMAR) && (sr & (USART_SR_FE | USART_SR_NE | USART_SR_ORE)));
+        sim_irq_line(uart->irq, level);
+    }
+}
+
+uint8 sim_uart_dma_request (uint8 channel)
+{
+    for(uint32 i = 0; i < 3; i ++)
+    {
+        sim_uart_struct *uart = &sim_uart[i];
+        uint32 sr = SIM_REG(uart->base + 0x00);
+        uint32 cr3 = SIM_REG(uart->base + 0x14);
+        if(channel == uart->tx_dma_channel && (cr3 & USART_CR3_DMAT) && (sr & USART_SR_TXE))
+        {
+            return 1;
+        }
+        if(channel == uart->rx_dma_channel && (cr3 & USART_CR3_DMAR) && (sr & USART_SR_RXNE))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      򴮿 RX 
+// ˵     *uartx          USART1/USART2/USART3
+// ˵     *data           
+// ˵     length          
+// ز     void
+// ʹʾ     sim_uart_feed(USART1, (const uint8 *)"$GNRMC", 6);
+// עϢ     ݴӵǰʱ𰴲ֽڵ ֮ǰδβ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_uart_feed (USART_TypeDef *uartx, const uint8 *data, uint32 length)
+{
+    for(uint32 i = 0; i < length; i ++)
+    {
+        sim_uart_feed_error(uartx, data[i], 0);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      һ·ֽ
+// ˵     *uartx          USART1/USART2/USART3
+// ˵     data            
+// ˵     error_flag      USART_SR_PE / USART_SR_FE / USART_SR_NE 
+// ز     void
+// ʹʾ     sim_uart_feed_error(USART1, 0x55, USART_SR_FE);             // ֡
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void sim_uart_feed_error (USART_TypeDef *uartx, uint8 data, uint16 error_flag)
+{
+    sim_uart_struct *uart = sim_uart_get(uartx);
+
+    sim_lock();
+    if(uart->rx_count >= SIM_UART_RX_QUEUE)
+    {
+        sim_fatal("uart rx stimulus queue full");
+    }
+    uart->rx_queue[(uart->rx_head + uart->rx_count) % SIM_UART_RX_QUEUE] = data | ((error_flag & 0x7) << 8);
+    uart->rx_count ++;
+    if(SIM_NEVER == uart->rx_next)
+    {
+        uint64_t start = uart->rx_line_free > sim_now ? uart->rx_line_free : sim_now;
+        uart->rx_next = start + sim_uart_frame_cycles(uart);
+        uart->idle_time = SIM_NEVER;
+    }
+    sim_unlock();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ TX ѷɵ
+// ˵     *uartx          USART1/USART2/USART3
+// ˵     *buffer         
+// ˵     length          峤
+// ز     uint32          ʵȡֽ
+// ʹʾ     len = sim_uart_tx_take(USART1, buffer, sizeof(buffer));
+// עϢ     ֻ 4096 ֽ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 sim_uart_tx_take (USART_TypeDef *uartx, uint8 *buffer, uint32 length)
+{
+    sim_uart_struct *uart = sim_uart_get(uartx);
+    uint32 count = 0;
+
+    sim_lock();
+    while(count < length && uart->tx_log_count)
+    {
+        buffer[count ++] = uart->tx_log[uart->tx_log_head];
+        uart->tx_log_head = (uart->tx_log_head + 1) % SIM_UART_TX_LOG;
+        uart->tx_log_count --;
+    }
+    sim_unlock();
+    return count;
+}
+
+uint64_t sim_uart_tx_count (USART_TypeDef *uartx)
+{
+    return sim_uart_get(uartx)->tx_total;
+}